@@ -5,33 +5,77 @@
  * @date 2026-03-01
  *
  * 用法：
- *   ./camera_publisher_example [device_path] [control_socket] [data_socket] [--io-method mmap|dmabuf]
+ *   ./camera_publisher_example [device_path] [control_socket] [data_socket]
+ *                              [--io-method mmap|userptr|dmabuf|dmabuf-import]
+ *                              [--data-plane v1|v2|shm]
+ *                              [--backend v4l2|synthetic|memfd|replay:<file>]
+ *                              [--reactor-threads n]
+ *                              [--v1-queue-policy drop-oldest|keep-latest] [--v1-queue-depth n]
+ *                              [--v1-tcp host:port]
  *
  * 默认参数：
  * 1. device_path   : CAMERA_SUBSYSTEM_DEFAULT_CAMERA（通常为 /dev/video0）
  * 2. control_socket: /tmp/camera_subsystem_control.sock
  * 3. data_socket   : /tmp/camera_subsystem_data.sock
- * 4. --io-method   : mmap（默认）；dmabuf 启用 DMA-BUF EXPBUF 零拷贝路径
+ * 4. --io-method   : mmap（默认）；userptr 让驱动直接写入 BufferPool 槽位，省去逐帧拷贝；
+ *                    dmabuf 启用 DMA-BUF EXPBUF 零拷贝路径；
+ *                    dmabuf-import 以 V4L2_MEMORY_DMABUF 采集到 dma-heap/udmabuf 分配的 buffer
+ * 5. --data-plane  : v1（默认，逐帧拷贝写 socket）；v2 配合 dmabuf 传递 fd；
+ *                    shm 使用封印 memfd BufferPool，池 fd 每个客户端只传一次，之后仅发送槽位
+ * 6. --backend     : v4l2（默认）；synthetic 合成色条；memfd 合成色条写入 memfd，配合
+ *                    --io-method dmabuf 走 fd 传递路径；replay:<file> 按 fps 回放录制的原始帧或
+ *                    MJPEG 拼接文件。非 v4l2 后端无需摄像头即可压测整条发布→分发→IPC 链路
+ * 7. --reactor-threads: 所有 camera 共享的采集反应器线程数，默认 1
+ * 8. --v1-queue-policy / --v1-queue-depth：v1 数据面每个客户端的发送队列策略与上限
+ *                    （默认 drop-oldest、2 帧）；发送在独立写线程上非阻塞进行，慢客户端
+ *                    只会在自己的队列里丢帧，不阻塞采集
+ * 9. --v1-tcp       ：v1 数据面额外监听 TCP（跨主机或回环桥接的订阅端），大帧以
+ *                    MSG_ZEROCOPY 发送；TCP 客户端无对端 pid，不适用按 pid 的帧率约定
  *
  * 运行流程：
  * 1. 启动控制面服务端（CameraControlServer）与数据面服务端（Unix Socket）。
  * 2. 注册唯一核心发布端（CameraSessionManager::RegisterCorePublisher）。
- * 3. 子发布端/订阅端通过控制面发起 Subscribe 后，触发 CameraSource 启动采集。
- * 4. 每采集到一帧，发布端将帧头+帧数据发送给已连接的数据面客户端。
- * 5. 当订阅引用归零时，触发 CameraSource 停止采集并释放设备。
+ * 3. 子发布端/订阅端通过控制面发起 Subscribe 后，为该端点创建独立的 CameraSource 启动采集；
+ *    不同端点（camera_id 互不相同）可同时出流，共享一个采集反应器。
+ * 4. 每采集到一帧，发布端将帧头+帧数据发送给订阅了该端点的数据面客户端（按对端 pid
+ *    匹配；从未订阅过的进程接收所有端点的帧）。
+ * 5. 当某端点订阅引用归零时，停止该端点的 CameraSource 并释放设备，其他端点不受影响。
+ *    订阅时声明了 target_fps / frame_stride 的客户端，发送前按约定抽帧。
+ *    会话成员发送 kReconfigure 时经 CameraSource::Reconfigure 热切换分辨率 / 格式 / 帧率，
+ *    连接保持不变，之后的帧携带新的 stream_generation。
  * 6. 默认无限运行，收到 Ctrl+C（SIGINT/SIGTERM）后优雅退出。
  *
  * 输出说明：
- * - 每秒打印一次统计信息：sec | frames | fps | clients | sent_bytes | send_fail
+ * - 每秒打印一次统计信息：sec | frames | fps | clients | sent_bytes | ...，
+ *   以及每个端点一行：camera | device | fps | dropped | generation | pool_in_flight；
+ *   v1 数据面另有每个客户端一行：queued | sent | dropped | blocked | lag_p50/p99，
+ *   以及每个共享内存环一行：published | dropped | consumers，每个环消费者一行：lag | overruns
+ *
+ * v1 数据面同时经控制面提供共享内存帧环（kOpenShmRing）：本机订阅端可改为原地读取，
+ * 每帧只写入环一次，不再按客户端经 socket 拷贝。
+ *
+ * v2 / shm 数据面按连接用 sendmmsg 批量发送描述符：订阅时声明 coalesce_window_ms 的进程，
+ * 其连接上的描述符（含多路 camera）最多攒该窗口再一次发出，攒批期间帧 lease 计入该消费者的
+ * 配额；统计行的 v2_send_calls 为实际 sendmmsg 次数，与 v2_sent 对比即每次系统调用的帧数。
+ *
+ * 订阅时声明 kCameraDataPlaneFeatureV2BufferCache 的进程，每个 DMA-BUF buffer 在每个流代数内
+ * 只随附一次 fd（注册帧），之后的描述符只携带 buffer_id；v2_fd_registered 为注册帧数。
  */
 
 #include "camera_subsystem/camera/camera_session_manager.h"
 #include "camera_subsystem/camera/camera_source.h"
+#include "camera_subsystem/camera/camera_source_registry.h"
+#include "camera_subsystem/camera/file_replay_capture_backend.h"
+#include "camera_subsystem/camera/synthetic_capture_backend.h"
+#include "camera_subsystem/core/buffer_guard.h"
+#include "camera_subsystem/core/frame_decimator.h"
 #include "camera_subsystem/core/frame_lease.h"
 #include "camera_subsystem/ipc/camera_channel_contract.h"
 #include "camera_subsystem/ipc/camera_control_server.h"
 #include "camera_subsystem/ipc/camera_data_ipc.h"
 #include "camera_subsystem/ipc/camera_data_plane_v2.h"
+#include "camera_subsystem/ipc/camera_data_socket_server.h"
+#include "camera_subsystem/ipc/camera_shm_ring_writer.h"
 #include "camera_subsystem/platform/platform_logger.h"
 
 #include <algorithm>
@@ -39,10 +83,14 @@
 #include <cerrno>
 #include <chrono>
 #include <cinttypes>
+#include <condition_variable>
 #include <csignal>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -50,6 +98,7 @@
 #include <sys/un.h>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <unistd.h>
 #include <vector>
 
@@ -58,19 +107,34 @@ namespace
 
 using camera_subsystem::camera::CameraSessionManager;
 using camera_subsystem::camera::CameraSource;
+using camera_subsystem::camera::CameraSourceRegistry;
+using camera_subsystem::core::BufferGuard;
 using camera_subsystem::core::CameraConfig;
+using camera_subsystem::core::FrameDescriptor;
 using camera_subsystem::core::FrameHandle;
 using camera_subsystem::core::FrameLease;
 using camera_subsystem::core::IoMethod;
 using camera_subsystem::core::LogLevel;
 using camera_subsystem::ipc::CameraClientRole;
 using camera_subsystem::ipc::CameraControlServer;
+using camera_subsystem::ipc::CameraDataFrameDescriptorV2;
 using camera_subsystem::ipc::CameraDataFrameHeader;
+using camera_subsystem::ipc::CameraDataFrameSendV2;
+using camera_subsystem::ipc::CameraDataSocketServer;
 using camera_subsystem::ipc::CameraEndpoint;
 using camera_subsystem::ipc::CameraReleaseServer;
+using camera_subsystem::ipc::CameraShmRingWriter;
+using camera_subsystem::ipc::CameraStreamFormat;
+using camera_subsystem::ipc::MakeCameraBufferCachedDescriptorV2;
+using camera_subsystem::ipc::MakeCameraBufferRegisterV2;
 using camera_subsystem::ipc::MakeCameraDataFrameDescriptorV2;
-using camera_subsystem::ipc::SendCameraDataFrameDescriptorV2;
+using camera_subsystem::ipc::MakeCameraShmPoolAnnounceV2;
+using camera_subsystem::ipc::MakeCameraShmSlotDescriptorV2;
+using camera_subsystem::ipc::SendCameraDataFrameDescriptorsV2;
 using camera_subsystem::ipc::kCameraDataMagic;
+using camera_subsystem::ipc::kCameraDataPlaneFeatureV2BufferCache;
+using camera_subsystem::ipc::kCameraDataV2FlagShmPoolAnnounce;
+using camera_subsystem::ipc::kCameraDataV2MaxFds;
 using camera_subsystem::ipc::kCameraDataVersion;
 using camera_subsystem::ipc::kDefaultCameraReleaseV2SocketPath;
 using camera_subsystem::platform::PlatformLogger;
@@ -80,51 +144,131 @@ std::atomic<bool> g_running(true);
 enum class DataPlaneMode
 {
     kV1Copy,
-    kV2DmaBuf
+    kV2DmaBuf,
+    kV2Shm
 };
 
+const char* DataPlaneModeToString(DataPlaneMode mode)
+{
+    switch (mode)
+    {
+        case DataPlaneMode::kV1Copy:
+            return "v1";
+        case DataPlaneMode::kV2DmaBuf:
+            return "v2";
+        case DataPlaneMode::kV2Shm:
+            return "shm";
+    }
+    return "v1";
+}
+
+/**
+ * @brief 按 --backend 参数创建采集后端，v4l2 返回 nullptr
+ * @param ok 参数无法识别时置为 false
+ */
+std::shared_ptr<camera_subsystem::camera::CaptureBackend> MakeCaptureBackend(
+    const std::string& spec, bool& ok)
+{
+    ok = true;
+    const std::string replay_prefix = "replay:";
+    if (spec == "synthetic")
+    {
+        return std::make_shared<camera_subsystem::camera::SyntheticCaptureBackend>();
+    }
+    if (spec == "memfd")
+    {
+        return std::make_shared<camera_subsystem::camera::MemfdCaptureBackend>();
+    }
+    if (spec.compare(0, replay_prefix.size(), replay_prefix) == 0 &&
+        spec.size() > replay_prefix.size())
+    {
+        return std::make_shared<camera_subsystem::camera::FileReplayCaptureBackend>(
+            spec.substr(replay_prefix.size()));
+    }
+    ok = spec == "v4l2";
+    return nullptr;
+}
+
 void SignalHandler(int signo)
 {
     (void)signo;
     g_running.store(false);
 }
 
-bool WriteFull(int fd, const void* buffer, size_t length)
+/**
+ * @brief 取 Unix socket 对端进程 pid，失败返回 0
+ */
+pid_t GetPeerPid(int fd)
+{
+    struct ucred credentials;
+    socklen_t length = sizeof(credentials);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0)
+    {
+        return 0;
+    }
+    return credentials.pid;
+}
+
+/**
+ * @brief v2 数据面连接的发送通道
+ *
+ * 多路 camera 的采集回调可能并发写同一连接：发送方持锁写入，移除方持锁关闭 fd 并置
+ * closed，不会写入已被复用的 fd。
+ *
+ * pending 为合批中尚未发出的描述符，pending_refs 持有对应帧的 lease / 槽位，保证 buffer
+ * 在发出前不被重新排入驱动。描述符中的 fd 是入队时 dup 的副本：Reconfigure 可能在合批窗口内
+ * 关闭并重新导出 buffer，新 buffer 常拿到相同的 fd 号，原 fd 号不能跨窗口保存。
+ */
+struct ClientChannel
 {
-    size_t total = 0;
-    const auto* data = reinterpret_cast<const uint8_t*>(buffer);
+    ~ClientChannel()
+    {
+        ClearPending();
+    }
 
-    while (total < length)
+    /// @brief 持锁调用；关闭待发描述符的 fd 副本并释放帧资源
+    void ClearPending()
     {
-        const ssize_t n = write(fd, data + total, length - total);
-        if (n <= 0)
+        for (const auto& item : pending)
         {
-            if (n < 0 && errno == EINTR)
+            for (uint32_t i = 0; i < item.fd_count; ++i)
             {
-                continue;
+                close(item.fds[i]);
             }
-            return false;
         }
-        total += static_cast<size_t>(n);
+        pending.clear();
+        pending_refs.clear();
     }
 
-    return true;
+    std::mutex mutex;
+    bool closed = false;
+    std::vector<CameraDataFrameSendV2> pending;
+    std::vector<std::shared_ptr<void>> pending_refs;
+    std::chrono::steady_clock::time_point flush_deadline;
+};
+
+/**
+ * @brief 关闭连接：先 shutdown 唤醒阻塞中的发送方，再在通道锁内 close
+ */
+void CloseClientChannel(int fd, const std::shared_ptr<ClientChannel>& channel)
+{
+    shutdown(fd, SHUT_RDWR);
+    std::lock_guard<std::mutex> lock(channel->mutex);
+    channel->closed = true;
+    channel->ClearPending();
+    close(fd);
 }
 
-class DataSocketServer
+class DataPlaneV2SocketServer
 {
 public:
-    DataSocketServer()
-        : server_fd_(-1)
-        , socket_path_()
-        , is_running_(false)
-    {
-    }
-
-    ~DataSocketServer()
+    struct Client
     {
-        Stop();
-    }
+        uint32_t consumer_id = 0;
+        int fd = -1;
+        pid_t pid = 0;
+        std::shared_ptr<ClientChannel> channel;
+    };
 
     bool Start(const std::string& socket_path)
     {
@@ -133,11 +277,11 @@ public:
             return true;
         }
 
-        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        int fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
         if (fd < 0)
         {
             PlatformLogger::Log(LogLevel::kError, "publisher",
-                                "data socket create failed: %s", strerror(errno));
+                                "data v2 socket create failed: %s", strerror(errno));
             return false;
         }
 
@@ -150,7 +294,7 @@ public:
         if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
         {
             PlatformLogger::Log(LogLevel::kError, "publisher",
-                                "data socket bind failed: path=%s err=%s",
+                                "data v2 socket bind failed: path=%s err=%s",
                                 socket_path.c_str(), strerror(errno));
             close(fd);
             return false;
@@ -159,7 +303,7 @@ public:
         if (listen(fd, 16) < 0)
         {
             PlatformLogger::Log(LogLevel::kError, "publisher",
-                                "data socket listen failed: %s", strerror(errno));
+                                "data v2 socket listen failed: %s", strerror(errno));
             close(fd);
             unlink(socket_path.c_str());
             return false;
@@ -168,7 +312,7 @@ public:
         server_fd_ = fd;
         socket_path_ = socket_path;
         is_running_.store(true);
-        accept_thread_ = std::thread(&DataSocketServer::AcceptLoop, this);
+        accept_thread_ = std::thread(&DataPlaneV2SocketServer::AcceptLoop, this);
         return true;
     }
 
@@ -180,7 +324,6 @@ public:
         }
 
         is_running_.store(false);
-
         if (server_fd_ >= 0)
         {
             shutdown(server_fd_, SHUT_RDWR);
@@ -188,14 +331,14 @@ public:
             server_fd_ = -1;
         }
 
+        std::vector<Client> clients;
         {
             std::lock_guard<std::mutex> lock(clients_mutex_);
-            for (const int fd : clients_)
-            {
-                shutdown(fd, SHUT_RDWR);
-                close(fd);
-            }
-            clients_.clear();
+            clients.swap(clients_);
+        }
+        for (const auto& client : clients)
+        {
+            CloseClientChannel(client.fd, client.channel);
         }
 
         if (accept_thread_.joinable())
@@ -210,22 +353,30 @@ public:
         }
     }
 
-    std::vector<int> GetClientsSnapshot() const
+    std::vector<Client> GetClientsSnapshot() const
     {
         std::lock_guard<std::mutex> lock(clients_mutex_);
         return clients_;
     }
 
-    void RemoveClient(int fd)
+    void RemoveClient(uint32_t consumer_id)
     {
-        std::lock_guard<std::mutex> lock(clients_mutex_);
-        auto it = std::find(clients_.begin(), clients_.end(), fd);
-        if (it != clients_.end())
+        Client removed;
         {
-            shutdown(*it, SHUT_RDWR);
-            close(*it);
+            std::lock_guard<std::mutex> lock(clients_mutex_);
+            auto it = std::find_if(clients_.begin(), clients_.end(),
+                                   [consumer_id](const Client& client)
+                                   {
+                                       return client.consumer_id == consumer_id;
+                                   });
+            if (it == clients_.end())
+            {
+                return;
+            }
+            removed = *it;
             clients_.erase(it);
         }
+        CloseClientChannel(removed.fd, removed.channel);
     }
 
     size_t GetClientCount() const
@@ -250,201 +401,843 @@ private:
                 {
                     continue;
                 }
-                PlatformLogger::Log(LogLevel::kWarning, "publisher",
-                                    "data socket accept failed: %s", strerror(errno));
                 std::this_thread::sleep_for(std::chrono::milliseconds(20));
                 continue;
             }
 
+            const uint32_t consumer_id = next_consumer_id_.fetch_add(1);
             {
                 std::lock_guard<std::mutex> lock(clients_mutex_);
-                clients_.push_back(client_fd);
+                clients_.push_back(Client{consumer_id, client_fd, GetPeerPid(client_fd),
+                                          std::make_shared<ClientChannel>()});
             }
-
             PlatformLogger::Log(LogLevel::kInfo, "publisher",
-                                "data client connected, total=%zu", GetClientCount());
+                                "data v2 client connected, consumer_id=%u total=%zu",
+                                consumer_id, GetClientCount());
         }
     }
 
-    int server_fd_;
+    int server_fd_ = -1;
     std::string socket_path_;
-    std::atomic<bool> is_running_;
+    std::atomic<bool> is_running_{false};
+    std::atomic<uint32_t> next_consumer_id_{1};
     std::thread accept_thread_;
 
     mutable std::mutex clients_mutex_;
-    std::vector<int> clients_;
+    std::vector<Client> clients_;
 };
 
-class DataPlaneV2SocketServer
+struct PublisherStats
+{
+    std::atomic<uint64_t> frame_count{0};
+    std::atomic<uint64_t> dmabuf_frame_count{0};
+    std::atomic<uint64_t> v2_sent_frames{0};
+    std::atomic<uint64_t> v2_send_fail_count{0};
+    std::atomic<uint64_t> v2_send_calls{0}; ///< v2 数据面发起的 sendmmsg 次数
+    std::atomic<uint64_t> v2_fd_registrations{0}; ///< 随附 fd 的 DMA-BUF 注册帧数
+    std::atomic<uint64_t> decimated_frames{0};
+};
+
+/**
+ * @brief v2 描述符按连接合批发送
+ *
+ * sendmmsg 只作用于单个 socket，因此合批发生在同一连接的多帧 / 多路 camera 之间：
+ * 合批窗口为 0 的连接每次入队即发送；否则攒到窗口到期、批量满或遇到需立即发出的消息
+ * （池 announce）时用一次 sendmmsg 发出。窗口到期由后台线程检查，低帧率下描述符也不会滞留。
+ */
+class DescriptorBatcher
 {
 public:
-    struct Client
+    /// @brief 后台发送失败时调用，负责移除连接并回收其 lease；调用时不持有通道锁
+    using FailureHandler = std::function<void(uint32_t consumer_id)>;
+
+    DescriptorBatcher(PublisherStats& stats, FailureHandler on_failure)
+        : stats_(stats)
+        , on_failure_(std::move(on_failure))
     {
-        uint32_t consumer_id = 0;
-        int fd = -1;
-    };
+    }
 
-    bool Start(const std::string& socket_path)
+    ~DescriptorBatcher()
     {
-        if (is_running_.load())
+        Stop();
+    }
+
+    void Start()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_)
         {
-            return true;
+            return;
         }
+        running_ = true;
+        flush_thread_ = std::thread(&DescriptorBatcher::FlushLoop, this);
+    }
 
-        int fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
-        if (fd < 0)
+    void Stop()
+    {
         {
-            PlatformLogger::Log(LogLevel::kError, "publisher",
-                                "data v2 socket create failed: %s", strerror(errno));
-            return false;
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_)
+            {
+                return;
+            }
+            running_ = false;
+            armed_.clear();
         }
+        cv_.notify_all();
+        flush_thread_.join();
+    }
 
-        sockaddr_un addr;
-        std::memset(&addr, 0, sizeof(addr));
-        addr.sun_family = AF_UNIX;
-        std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    /**
+     * @brief 每个连接最多攒的帧数，与消费者 lease 配额一致（0 表示不限）
+     *
+     * 攒批中的帧已占用 lease，攒满配额后的帧只会被跳过，此时继续等待窗口没有意义。
+     */
+    void SetMaxPendingFrames(uint32_t max_pending_frames)
+    {
+        max_pending_frames_.store(max_pending_frames);
+    }
 
-        unlink(socket_path.c_str());
-        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    /**
+     * @param frame_ref 描述符发出前需保持存活的帧资源
+     * @param flush_now 连同已攒的描述符立即发出
+     * @return false 表示连接已关闭或发送失败，调用方负责移除连接
+     */
+    bool Queue(const DataPlaneV2SocketServer::Client& client,
+               const CameraDataFrameDescriptorV2& descriptor,
+               const int* fds,
+               uint32_t fd_count,
+               std::shared_ptr<void> frame_ref,
+               std::chrono::milliseconds window,
+               bool flush_now = false)
+    {
+        if (fd_count > kCameraDataV2MaxFds || (fd_count > 0 && fds == nullptr))
         {
-            PlatformLogger::Log(LogLevel::kError, "publisher",
-                                "data v2 socket bind failed: path=%s err=%s",
-                                socket_path.c_str(), strerror(errno));
-            close(fd);
             return false;
         }
 
-        if (listen(fd, 16) < 0)
+        ClientChannel& channel = *client.channel;
+        std::lock_guard<std::mutex> lock(channel.mutex);
+        if (channel.closed)
         {
-            PlatformLogger::Log(LogLevel::kError, "publisher",
-                                "data v2 socket listen failed: %s", strerror(errno));
-            close(fd);
-            unlink(socket_path.c_str());
             return false;
         }
 
-        server_fd_ = fd;
-        socket_path_ = socket_path;
-        is_running_.store(true);
-        accept_thread_ = std::thread(&DataPlaneV2SocketServer::AcceptLoop, this);
+        CameraDataFrameSendV2 item;
+        item.descriptor = descriptor;
+        std::fill(std::begin(item.fds), std::end(item.fds), -1);
+        for (uint32_t i = 0; i < fd_count; ++i)
+        {
+            item.fds[i] = fcntl(fds[i], F_DUPFD_CLOEXEC, 0);
+            if (item.fds[i] < 0)
+            {
+                PlatformLogger::Log(LogLevel::kWarning, "publisher",
+                                    "dup of descriptor fd %d failed: %s", fds[i],
+                                    std::strerror(errno));
+                for (uint32_t j = 0; j < i; ++j)
+                {
+                    close(item.fds[j]);
+                }
+                return false;
+            }
+        }
+        item.fd_count = fd_count;
+        channel.pending.push_back(item);
+        channel.pending_refs.push_back(std::move(frame_ref));
+
+        const uint32_t max_pending = max_pending_frames_.load();
+        const size_t batch_limit =
+            max_pending == 0 ? kMaxBatch : std::min<size_t>(kMaxBatch, max_pending);
+        const auto now = std::chrono::steady_clock::now();
+        if (channel.pending.size() == 1 && batch_limit > 1)
+        {
+            channel.flush_deadline = now + window;
+            if (window.count() > 0 && !flush_now)
+            {
+                Arm(client, channel.flush_deadline);
+                return true;
+            }
+        }
+        if (flush_now || channel.pending.size() >= batch_limit || now >= channel.flush_deadline)
+        {
+            return FlushLocked(client, channel);
+        }
         return true;
     }
 
-    void Stop()
+private:
+    static constexpr size_t kMaxBatch = 16;
+
+    struct ArmedClient
+    {
+        DataPlaneV2SocketServer::Client client;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    void Arm(const DataPlaneV2SocketServer::Client& client,
+             std::chrono::steady_clock::time_point deadline)
     {
-        if (!is_running_.load())
         {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_)
+            {
+                return;
+            }
+            armed_.push_back(ArmedClient{client, deadline});
+        }
+        cv_.notify_one();
+    }
+
+    /// @brief 持通道锁调用；发出或丢弃全部待发描述符
+    bool FlushLocked(const DataPlaneV2SocketServer::Client& client, ClientChannel& channel)
+    {
+        uint64_t calls = 0;
+        const size_t sent = SendCameraDataFrameDescriptorsV2(
+            client.fd, channel.pending.data(), channel.pending.size(), &calls);
+        stats_.v2_send_calls.fetch_add(calls);
+        for (size_t i = 0; i < sent; ++i)
+        {
+            if ((channel.pending[i].descriptor.flags & kCameraDataV2FlagShmPoolAnnounce) == 0)
+            {
+                stats_.v2_sent_frames.fetch_add(1);
+            }
+        }
+        const bool ok = sent == channel.pending.size();
+        channel.ClearPending();
+        return ok;
+    }
+
+    void FlushLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_)
+        {
+            if (armed_.empty())
+            {
+                cv_.wait(lock);
+                continue;
+            }
+
+            auto earliest = std::min_element(armed_.begin(), armed_.end(),
+                                             [](const ArmedClient& a, const ArmedClient& b)
+                                             {
+                                                 return a.deadline < b.deadline;
+                                             });
+            const auto deadline = earliest->deadline;
+            if (std::chrono::steady_clock::now() < deadline)
+            {
+                cv_.wait_until(lock, deadline);
+                continue;
+            }
+            const DataPlaneV2SocketServer::Client client = earliest->client;
+            armed_.erase(earliest);
+            lock.unlock();
+
+            bool ok = true;
+            {
+                ClientChannel& channel = *client.channel;
+                std::lock_guard<std::mutex> channel_lock(channel.mutex);
+                // 该批次可能已随入队提前发出，之后又开始的新批次由其自身的登记负责
+                if (!channel.closed && !channel.pending.empty() &&
+                    std::chrono::steady_clock::now() >= channel.flush_deadline)
+                {
+                    ok = FlushLocked(client, channel);
+                }
+            }
+            if (!ok)
+            {
+                stats_.v2_send_fail_count.fetch_add(1);
+                on_failure_(client.consumer_id);
+            }
+            lock.lock();
+        }
+    }
+
+    PublisherStats& stats_;
+    FailureHandler on_failure_;
+    std::atomic<uint32_t> max_pending_frames_{0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_ = false;
+    std::vector<ArmedClient> armed_;
+    std::thread flush_thread_;
+};
+
+/// @return 待归还帧的键；各 camera 的帧序号独立，需与 stream_id 组合
+uint64_t MakePendingKey(uint32_t stream_id, uint64_t frame_id)
+{
+    return (static_cast<uint64_t>(stream_id) << 32) | (frame_id & 0xFFFFFFFFULL);
+}
+
+/**
+ * @brief 按订阅端帧率约定对数据面连接抽帧，并把帧只分发给订阅了本端点的进程
+ *
+ * 每个端点一个实例。约定由控制面按对端 pid 记录；数据连接通常先于 Subscribe 建立，
+ * 因此约定代数变化后重新查询。只在本端点的采集回调中调用。
+ */
+class SubscriberFrameRateLimiter
+{
+public:
+    enum class Admission
+    {
+        kSend,
+        kDecimated,     ///< 按帧率约定跳过
+        kOtherEndpoint  ///< 该进程只订阅了其他端点
+    };
+
+    SubscriberFrameRateLimiter(const std::atomic<const CameraControlServer*>& control_server,
+                               const CameraEndpoint& endpoint)
+        : control_server_(control_server)
+        , endpoint_(endpoint)
+    {
+    }
+
+    /**
+     * @param client_key v1 为 client_id，v2 为 consumer_id
+     * @return kSend 之外表示订阅端不需要本帧，不必发送
+     */
+    Admission Accept(uint64_t client_key, pid_t pid, uint64_t timestamp_ns)
+    {
+        const CameraControlServer* control_server = control_server_.load();
+        if (control_server == nullptr)
+        {
+            return Admission::kSend;
+        }
+
+        Entry& entry = entries_[client_key];
+        const uint64_t generation = control_server->GetFrameRateContractGeneration();
+        if (entry.pid != pid || entry.generation != generation)
+        {
+            CameraControlServer::FrameRateContract contract;
+            entry.routed = true;
+            if (!control_server->GetFrameRateContract(pid, endpoint_, &contract))
+            {
+                // 从未订阅过的进程（如旧版客户端）照常接收所有端点的帧
+                entry.routed = !control_server->GetFrameRateContract(pid, &contract);
+                contract = CameraControlServer::FrameRateContract();
+            }
+            entry.decimator.Configure(contract.target_fps, contract.frame_stride);
+            entry.coalesce_window = std::chrono::milliseconds(contract.coalesce_window_ms);
+            entry.data_plane_features = contract.data_plane_features;
+            entry.pid = pid;
+            entry.generation = generation;
+        }
+        if (!entry.routed)
+        {
+            return Admission::kOtherEndpoint;
+        }
+        return entry.decimator.Accept(timestamp_ns) ? Admission::kSend : Admission::kDecimated;
+    }
+
+    /// @brief 该连接的 v2 描述符合批窗口，以最近一次 Accept 查询到的约定为准
+    std::chrono::milliseconds CoalesceWindow(uint64_t client_key) const
+    {
+        auto it = entries_.find(client_key);
+        return it != entries_.end() ? it->second.coalesce_window : std::chrono::milliseconds(0);
+    }
+
+    /// @brief 该连接声明的数据面能力位（kCameraDataPlaneFeature*）
+    uint32_t DataPlaneFeatures(uint64_t client_key) const
+    {
+        auto it = entries_.find(client_key);
+        return it != entries_.end() ? it->second.data_plane_features : 0;
+    }
+
+    void Forget(uint64_t client_key)
+    {
+        entries_.erase(client_key);
+    }
+
+private:
+    struct Entry
+    {
+        camera_subsystem::core::FrameDecimator decimator;
+        std::chrono::milliseconds coalesce_window{0};
+        uint32_t data_plane_features = 0;
+        pid_t pid = 0;
+        uint64_t generation = UINT64_MAX;
+        bool routed = true;
+    };
+
+    const std::atomic<const CameraControlServer*>& control_server_;
+    CameraEndpoint endpoint_;
+    std::unordered_map<uint64_t, Entry> entries_;
+};
+
+/**
+ * @brief 单个端点的分发状态，随端点 source 创建，由其采集回调独占使用
+ */
+struct EndpointFanout
+{
+    EndpointFanout(const std::atomic<const CameraControlServer*>& control_server,
+                   const CameraEndpoint& endpoint)
+        : rate_limiter(control_server, endpoint)
+    {
+    }
+
+    SubscriberFrameRateLimiter rate_limiter;
+};
+
+/**
+ * @brief shm 数据面已通告池 fd 的记录：(camera_id, consumer_id) → 通告时的流代数
+ *
+ * 每个端点有自己的 BufferPool，需分别通告；多个端点的回调并发访问。
+ */
+class ShmPoolAnnouncements
+{
+public:
+    bool NeedsAnnounce(uint32_t camera_id, uint32_t consumer_id, uint32_t generation) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = generations_.find(MakeKey(camera_id, consumer_id));
+        return it == generations_.end() || it->second != generation;
+    }
+
+    void MarkAnnounced(uint32_t camera_id, uint32_t consumer_id, uint32_t generation)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generations_[MakeKey(camera_id, consumer_id)] = generation;
+    }
+
+    void Forget(uint32_t camera_id, uint32_t consumer_id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generations_.erase(MakeKey(camera_id, consumer_id));
+    }
+
+private:
+    static uint64_t MakeKey(uint32_t camera_id, uint32_t consumer_id)
+    {
+        return (static_cast<uint64_t>(camera_id) << 32) | consumer_id;
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, uint32_t> generations_;
+};
+
+/**
+ * @brief DMA-BUF fd 注册表：记录每个消费者已收到 fd 的 buffer
+ *
+ * 按 (camera, consumer) 记录流代数与已注册的 buffer_id，代数变化后全部重新注册。
+ * 端点停止后 CameraSource 重建，新流的代数可能与旧流相同，因此停止时需 ForgetCamera。
+ */
+class DmaBufRegistrations
+{
+public:
+    bool NeedsRegister(uint32_t camera_id,
+                       uint32_t consumer_id,
+                       uint32_t generation,
+                       uint32_t buffer_id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(MakeKey(camera_id, consumer_id));
+        return it == entries_.end() || it->second.generation != generation ||
+               it->second.buffer_ids.count(buffer_id) == 0;
+    }
+
+    void MarkRegistered(uint32_t camera_id,
+                        uint32_t consumer_id,
+                        uint32_t generation,
+                        uint32_t buffer_id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry& entry = entries_[MakeKey(camera_id, consumer_id)];
+        if (entry.generation != generation)
+        {
+            entry.generation = generation;
+            entry.buffer_ids.clear();
+        }
+        entry.buffer_ids.insert(buffer_id);
+    }
+
+    /// @brief 消费者断开或发送失败后清除其在所有相机上的注册记录
+    void ForgetConsumer(uint32_t consumer_id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = entries_.begin(); it != entries_.end();)
+        {
+            it = static_cast<uint32_t>(it->first) == consumer_id ? entries_.erase(it)
+                                                                 : std::next(it);
+        }
+    }
+
+    void ForgetCamera(uint32_t camera_id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = entries_.begin(); it != entries_.end();)
+        {
+            it = static_cast<uint32_t>(it->first >> 32) == camera_id ? entries_.erase(it)
+                                                                        : std::next(it);
+        }
+    }
+
+private:
+    struct Entry
+    {
+        uint32_t generation = 0;
+        std::unordered_set<uint32_t> buffer_ids;
+    };
+
+    static uint64_t MakeKey(uint32_t camera_id, uint32_t consumer_id)
+    {
+        return (static_cast<uint64_t>(camera_id) << 32) | consumer_id;
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Entry> entries_;
+};
+
+/**
+ * @brief 按 camera 记录 lease 预算折算的单消费者配额
+ *
+ * 默认配额与批量发送上限是进程级的，多路 camera 同时运行时取各 camera 配额的最小值
+ * （0 表示不限），避免最后启动或扩容的 camera 放大配额，让消费者占满其他 camera 的 lease。
+ * 应用函数在锁内调用，并发更新不会以旧值覆盖新值。
+ */
+class LeaseQuotaTable
+{
+public:
+    explicit LeaseQuotaTable(std::function<void(uint32_t)> apply) : apply_(std::move(apply))
+    {
+    }
+
+    void Update(uint32_t camera_id, size_t lease_max)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 至少留出一个 lease 的余量，单个 lease 时无余量可留，不限制
+        quotas_[camera_id] = lease_max > 1 ? static_cast<uint32_t>(lease_max - 1) : 0;
+        ApplyLocked();
+    }
+
+    void Forget(uint32_t camera_id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (quotas_.erase(camera_id) > 0)
+        {
+            ApplyLocked();
+        }
+    }
+
+private:
+    void ApplyLocked() const
+    {
+        uint32_t quota = 0;
+        for (const auto& item : quotas_)
+        {
+            if (item.second != 0 && (quota == 0 || item.second < quota))
+            {
+                quota = item.second;
+            }
+        }
+        apply_(quota);
+    }
+
+    std::function<void(uint32_t)> apply_;
+    mutable std::mutex mutex_;
+    std::unordered_map<uint32_t, uint32_t> quotas_;
+};
+
+/**
+ * @brief v1 数据面的共享内存帧环，每个端点一个，首个消费者协商时创建
+ *
+ * 帧超出槽位容量（热切换到更大分辨率）时废弃当前环，消费者收到 closed 后重新协商，
+ * 新环按最近一帧的大小分配。废弃的环保留到其消费者全部退出，期间已下发的 fd 始终有效。
+ */
+class ShmRings
+{
+public:
+    struct RingStats
+    {
+        uint32_t camera_id = 0;
+        CameraShmRingWriter::Stats ring;
+    };
+
+    bool Open(pid_t pid,
+              const CameraEndpoint& endpoint,
+              size_t min_capacity,
+              CameraControlServer::ShmRingGrant* grant)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::shared_ptr<CameraShmRingWriter>& ring = active_[endpoint.camera_id];
+        if (!ring)
+        {
+            auto created = std::make_shared<CameraShmRingWriter>();
+            auto last = frame_bytes_.find(endpoint.camera_id);
+            const size_t capacity =
+                std::max(min_capacity, last != frame_bytes_.end() ? last->second : 0);
+            if (!created->Create(kSlotCount, capacity, kMaxConsumers))
+            {
+                active_.erase(endpoint.camera_id);
+                return false;
+            }
+            ring = created;
+            PlatformLogger::Log(LogLevel::kInfo, "publisher",
+                                "shm ring created: camera=%u ring=%" PRIu64 " capacity=%zu",
+                                endpoint.camera_id, ring->GetRingId(), capacity);
+        }
+
+        grant->memfd = ring->GetMemFd();
+        grant->ring_id = ring->GetRingId();
+        return ring->AttachConsumer(pid, &grant->consumer_index, &grant->eventfd);
+    }
+
+    void Close(const CameraEndpoint& endpoint, const CameraControlServer::ShmRingGrant& grant)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = active_.find(endpoint.camera_id);
+        if (it != active_.end() && it->second->GetRingId() == grant.ring_id)
+        {
+            it->second->DetachConsumer(grant.consumer_index);
             return;
         }
+        for (auto retired = retired_.begin(); retired != retired_.end(); ++retired)
+        {
+            if ((*retired)->GetRingId() == grant.ring_id)
+            {
+                (*retired)->DetachConsumer(grant.consumer_index);
+                if ((*retired)->GetConsumerCount() == 0)
+                {
+                    retired_.erase(retired);
+                }
+                return;
+            }
+        }
+    }
 
-        is_running_.store(false);
-        if (server_fd_ >= 0)
+    /// @brief 采集回调中调用：端点没有环时只记录帧大小
+    void Publish(const CameraDataFrameHeader& header, const void* data, size_t size)
+    {
+        std::shared_ptr<CameraShmRingWriter> ring;
         {
-            shutdown(server_fd_, SHUT_RDWR);
-            close(server_fd_);
-            server_fd_ = -1;
+            std::lock_guard<std::mutex> lock(mutex_);
+            frame_bytes_[header.camera_id] = size;
+            auto it = active_.find(header.camera_id);
+            if (it == active_.end())
+            {
+                return;
+            }
+            ring = it->second;
+            if (size > ring->GetSlotCapacity())
+            {
+                ring->Close();
+                if (ring->GetConsumerCount() > 0)
+                {
+                    retired_.push_back(ring);
+                }
+                active_.erase(it);
+                PlatformLogger::Log(LogLevel::kInfo, "publisher",
+                                    "shm ring retired: camera=%u ring=%" PRIu64
+                                    " frame_bytes=%zu",
+                                    header.camera_id, ring->GetRingId(), size);
+                return;
+            }
         }
+        // 槽位全部被固定时丢帧由环自身计数
+        (void)ring->Publish(header, data, size);
+    }
 
+    std::vector<RingStats> GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<RingStats> stats;
+        for (const auto& entry : active_)
         {
-            std::lock_guard<std::mutex> lock(clients_mutex_);
-            for (const auto& client : clients_)
+            RingStats item;
+            item.camera_id = entry.first;
+            item.ring = entry.second->GetStats();
+            stats.push_back(std::move(item));
+        }
+        return stats;
+    }
+
+private:
+    static constexpr uint32_t kSlotCount = 6;
+    static constexpr uint32_t kMaxConsumers = 8;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint32_t, std::shared_ptr<CameraShmRingWriter>> active_;
+    std::vector<std::shared_ptr<CameraShmRingWriter>> retired_;
+    std::unordered_map<uint32_t, size_t> frame_bytes_; ///< camera_id → 最近一帧大小
+};
+
+/**
+ * @brief 由拷贝路径帧句柄构造描述符，plane 偏移相对槽位起始
+ */
+FrameDescriptor MakeShmFrameDescriptor(const FrameHandle& frame, uint32_t buffer_id)
+{
+    FrameDescriptor desc;
+    desc.frame_id = frame.frame_id_;
+    desc.camera_id = frame.camera_id_;
+    desc.timestamp_ns = frame.timestamp_ns_;
+    desc.sequence = frame.sequence_;
+    desc.width = frame.width_;
+    desc.height = frame.height_;
+    desc.pixel_format = frame.format_;
+    desc.memory_type = camera_subsystem::core::MemoryType::kShm;
+    desc.buffer_id = buffer_id;
+    desc.plane_count = std::max<uint32_t>(1, std::min<uint32_t>(frame.plane_count_, 3));
+    desc.fd_count = 1;
+    desc.total_bytes_used = frame.buffer_size_;
+    desc.stream_generation = frame.stream_generation_;
+
+    for (uint32_t i = 0; i < desc.plane_count; ++i)
+    {
+        const uint32_t begin = frame.plane_offset_[i];
+        const uint32_t end = (i + 1 < desc.plane_count)
+                                 ? frame.plane_offset_[i + 1]
+                                 : static_cast<uint32_t>(frame.buffer_size_);
+        desc.planes[i].fd_index = 0;
+        desc.planes[i].offset = begin;
+        desc.planes[i].stride = frame.line_stride_[i];
+        desc.planes[i].length = end > begin ? end - begin : 0;
+        desc.planes[i].bytes_used = desc.planes[i].length;
+    }
+    return desc;
+}
+
+/**
+ * @brief 过滤掉按帧率约定不需要本帧、以及已达到 lease 配额的客户端，被跳过的客户端只错过本帧
+ */
+std::vector<DataPlaneV2SocketServer::Client> AdmitClients(
+    const std::vector<DataPlaneV2SocketServer::Client>& clients,
+    CameraReleaseServer& release_server,
+    SubscriberFrameRateLimiter& rate_limiter,
+    uint64_t timestamp_ns,
+    PublisherStats& stats)
+{
+    std::vector<uint32_t> candidates;
+    candidates.reserve(clients.size());
+    for (const auto& client : clients)
+    {
+        // 抽帧跳过的客户端不占 lease，也不计入配额跳帧
+        const auto admission = rate_limiter.Accept(client.consumer_id, client.pid, timestamp_ns);
+        if (admission != SubscriberFrameRateLimiter::Admission::kSend)
+        {
+            if (admission == SubscriberFrameRateLimiter::Admission::kDecimated)
             {
-                shutdown(client.fd, SHUT_RDWR);
-                close(client.fd);
+                stats.decimated_frames.fetch_add(1);
             }
-            clients_.clear();
+            continue;
         }
+        candidates.push_back(client.consumer_id);
+    }
+    if (candidates.empty())
+    {
+        return {};
+    }
+    const std::vector<uint32_t> admitted_ids = release_server.AdmitConsumers(candidates);
 
-        if (accept_thread_.joinable())
+    std::vector<DataPlaneV2SocketServer::Client> admitted;
+    admitted.reserve(admitted_ids.size());
+    for (const auto& client : clients)
+    {
+        if (std::find(admitted_ids.begin(), admitted_ids.end(), client.consumer_id) !=
+            admitted_ids.end())
         {
-            accept_thread_.join();
+            admitted.push_back(client);
         }
+    }
+    return admitted;
+}
 
-        if (!socket_path_.empty())
-        {
-            unlink(socket_path_.c_str());
-            socket_path_.clear();
-        }
+/**
+ * @brief shm 数据面：首次向客户端传递池 fd，之后只发送槽位描述符
+ *
+ * 重新初始化 / 热切换会重建 BufferPool（新的 memfd），流代数变化后重新通告池 fd；
+ * 每个端点的池分别通告。
+ *
+ * 槽位的 BufferGuard 保存在 pending_slots 中，直到所有客户端归还（或超时）才回到池中。
+ */
+void PublishShmSlot(const FrameHandle& frame,
+                    const std::shared_ptr<BufferGuard>& buffer_ref,
+                    const CameraSource& camera_source,
+                    DataPlaneV2SocketServer& data_v2_server,
+                    DescriptorBatcher& batcher,
+                    CameraReleaseServer& release_server,
+                    std::mutex& lease_mutex,
+                    std::unordered_map<uint64_t, std::shared_ptr<BufferGuard>>& pending_slots,
+                    ShmPoolAnnouncements& announcements,
+                    SubscriberFrameRateLimiter& rate_limiter,
+                    PublisherStats& stats)
+{
+    const int pool_fd = camera_source.GetBufferPoolShareFd();
+    if (!buffer_ref || pool_fd < 0)
+    {
+        return;
     }
 
-    std::vector<Client> GetClientsSnapshot() const
+    const std::vector<DataPlaneV2SocketServer::Client> clients =
+        data_v2_server.GetClientsSnapshot();
+    if (clients.empty())
     {
-        std::lock_guard<std::mutex> lock(clients_mutex_);
-        return clients_;
+        return;
     }
 
-    void RemoveClient(uint32_t consumer_id)
+    const auto pool_stats = camera_source.GetBufferPoolStats();
+    const uint32_t buffer_id = buffer_ref->Id();
+    const uint32_t slot_offset = static_cast<uint32_t>(buffer_id * pool_stats.slot_stride);
+    const FrameDescriptor desc = MakeShmFrameDescriptor(frame, buffer_id);
+
+    const std::vector<DataPlaneV2SocketServer::Client> admitted =
+        AdmitClients(clients, release_server, rate_limiter, frame.timestamp_ns_, stats);
+    if (admitted.empty())
     {
-        std::lock_guard<std::mutex> lock(clients_mutex_);
-        auto it = std::find_if(clients_.begin(), clients_.end(),
-                               [consumer_id](const Client& client)
-                               {
-                                   return client.consumer_id == consumer_id;
-                               });
-        if (it != clients_.end())
-        {
-            shutdown(it->fd, SHUT_RDWR);
-            close(it->fd);
-            clients_.erase(it);
-        }
+        return;
+    }
+    std::vector<uint32_t> consumer_ids;
+    consumer_ids.reserve(admitted.size());
+    for (const auto& client : admitted)
+    {
+        consumer_ids.push_back(client.consumer_id);
     }
 
-    size_t GetClientCount() const
+    const uint64_t pending_key = MakePendingKey(desc.camera_id, desc.frame_id);
     {
-        std::lock_guard<std::mutex> lock(clients_mutex_);
-        return clients_.size();
+        std::lock_guard<std::mutex> lock(lease_mutex);
+        pending_slots[pending_key] = buffer_ref;
+    }
+    if (!release_server.RegisterFrame(desc.camera_id, desc.frame_id, buffer_id, consumer_ids))
+    {
+        std::lock_guard<std::mutex> lock(lease_mutex);
+        pending_slots.erase(pending_key);
+        return;
     }
 
-private:
-    void AcceptLoop()
+    auto announce = MakeCameraShmPoolAnnounceV2(desc.camera_id,
+                                                static_cast<uint32_t>(pool_stats.total),
+                                                static_cast<uint32_t>(pool_stats.slot_stride),
+                                                static_cast<uint32_t>(pool_stats.arena_bytes));
+    auto descriptor_v2 = MakeCameraShmSlotDescriptorV2(desc, slot_offset);
+    for (const auto& client : admitted)
     {
-        while (is_running_.load())
+        bool ok = true;
+        if (announcements.NeedsAnnounce(desc.camera_id, client.consumer_id,
+                                        frame.stream_generation_))
         {
-            const int client_fd = accept(server_fd_, nullptr, nullptr);
-            if (client_fd < 0)
+            // 池 fd 只在本次回调内保证有效：announce 连同此前攒下的旧槽位描述符立即发出
+            announce.consumer_id = client.consumer_id;
+            ok = batcher.Queue(client, announce, &pool_fd, 1, nullptr,
+                               std::chrono::milliseconds(0), true);
+            if (ok)
             {
-                if (!is_running_.load())
-                {
-                    break;
-                }
-                if (errno == EINTR)
-                {
-                    continue;
-                }
-                std::this_thread::sleep_for(std::chrono::milliseconds(20));
-                continue;
+                announcements.MarkAnnounced(desc.camera_id, client.consumer_id,
+                                            frame.stream_generation_);
             }
+        }
 
-            const uint32_t consumer_id = next_consumer_id_.fetch_add(1);
-            {
-                std::lock_guard<std::mutex> lock(clients_mutex_);
-                clients_.push_back(Client{consumer_id, client_fd});
-            }
-            PlatformLogger::Log(LogLevel::kInfo, "publisher",
-                                "data v2 client connected, consumer_id=%u total=%zu",
-                                consumer_id, GetClientCount());
+        descriptor_v2.consumer_id = client.consumer_id;
+        ok = ok && batcher.Queue(client, descriptor_v2, nullptr, 0, buffer_ref,
+                                 rate_limiter.CoalesceWindow(client.consumer_id));
+        if (!ok)
+        {
+            announcements.Forget(desc.camera_id, client.consumer_id);
+            data_v2_server.RemoveClient(client.consumer_id);
+            release_server.ReclaimConsumerDisconnected(client.consumer_id);
+            rate_limiter.Forget(client.consumer_id);
+            stats.v2_send_fail_count.fetch_add(1);
         }
     }
-
-    int server_fd_ = -1;
-    std::string socket_path_;
-    std::atomic<bool> is_running_{false};
-    std::atomic<uint32_t> next_consumer_id_{1};
-    std::thread accept_thread_;
-
-    mutable std::mutex clients_mutex_;
-    std::vector<Client> clients_;
-};
-
-struct PublisherStats
-{
-    std::atomic<uint64_t> frame_count{0};
-    std::atomic<uint64_t> dmabuf_frame_count{0};
-    std::atomic<uint64_t> v2_sent_frames{0};
-    std::atomic<uint64_t> v2_send_fail_count{0};
-    std::atomic<uint64_t> sent_bytes{0};
-    std::atomic<uint64_t> send_fail_count{0};
-};
+}
 
 } // namespace
 
@@ -460,6 +1253,10 @@ int main(int argc, char* argv[])
     std::string release_socket_path = kDefaultCameraReleaseV2SocketPath;
     IoMethod io_method = IoMethod::kMmap;
     DataPlaneMode data_plane_mode = DataPlaneMode::kV1Copy;
+    std::string backend_spec = "v4l2";
+    int consumer_lease_quota = -1; // -1：按 lease 预算自动设置
+    size_t reactor_threads = 1;
+    CameraDataSocketServer::Options data_options;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -472,6 +1269,14 @@ int main(int argc, char* argv[])
             {
                 io_method = IoMethod::kDmaBuf;
             }
+            else if (method == "dmabuf-import")
+            {
+                io_method = IoMethod::kDmaBufImport;
+            }
+            else if (method == "userptr")
+            {
+                io_method = IoMethod::kUserPtr;
+            }
             else if (method == "mmap")
             {
                 io_method = IoMethod::kMmap;
@@ -479,7 +1284,9 @@ int main(int argc, char* argv[])
             else
             {
                 PlatformLogger::Log(LogLevel::kError, "publisher",
-                                    "unknown io-method: %s (use mmap or dmabuf)", method.c_str());
+                                    "unknown io-method: %s (use mmap, userptr, dmabuf or "
+                                    "dmabuf-import)",
+                                    method.c_str());
                 return 1;
             }
         }
@@ -500,19 +1307,106 @@ int main(int argc, char* argv[])
             {
                 data_plane_mode = DataPlaneMode::kV1Copy;
             }
+            else if (mode == "shm")
+            {
+                data_plane_mode = DataPlaneMode::kV2Shm;
+            }
+            else
+            {
+                PlatformLogger::Log(LogLevel::kError, "publisher",
+                                    "unknown data-plane: %s (use v1, v2 or shm)", mode.c_str());
+                return 1;
+            }
+        }
+        else if (arg == "--backend" && i + 1 < argc)
+        {
+            ++i;
+            backend_spec = argv[i];
+        }
+        else if (arg == "--consumer-lease-quota" && i + 1 < argc)
+        {
+            ++i;
+            consumer_lease_quota = std::atoi(argv[i]);
+            if (consumer_lease_quota < 0)
+            {
+                PlatformLogger::Log(LogLevel::kError, "publisher",
+                                    "invalid consumer-lease-quota: %s (0 = unlimited)", argv[i]);
+                return 1;
+            }
+        }
+        else if (arg == "--reactor-threads" && i + 1 < argc)
+        {
+            ++i;
+            const int threads = std::atoi(argv[i]);
+            if (threads <= 0)
+            {
+                PlatformLogger::Log(LogLevel::kError, "publisher",
+                                    "invalid reactor-threads: %s", argv[i]);
+                return 1;
+            }
+            reactor_threads = static_cast<size_t>(threads);
+        }
+        else if (arg == "--v1-queue-policy" && i + 1 < argc)
+        {
+            ++i;
+            const std::string policy = argv[i];
+            if (policy == "drop-oldest")
+            {
+                data_options.policy = CameraDataSocketServer::QueuePolicy::kDropOldest;
+            }
+            else if (policy == "keep-latest")
+            {
+                data_options.policy = CameraDataSocketServer::QueuePolicy::kKeepLatest;
+            }
             else
             {
                 PlatformLogger::Log(LogLevel::kError, "publisher",
-                                    "unknown data-plane: %s (use v1 or v2)", mode.c_str());
+                                    "unknown v1-queue-policy: %s (use drop-oldest or "
+                                    "keep-latest)",
+                                    policy.c_str());
+                return 1;
+            }
+        }
+        else if (arg == "--v1-queue-depth" && i + 1 < argc)
+        {
+            ++i;
+            const int depth = std::atoi(argv[i]);
+            if (depth <= 0)
+            {
+                PlatformLogger::Log(LogLevel::kError, "publisher",
+                                    "invalid v1-queue-depth: %s", argv[i]);
+                return 1;
+            }
+            data_options.max_queued_frames = static_cast<size_t>(depth);
+        }
+        else if (arg == "--v1-tcp" && i + 1 < argc)
+        {
+            ++i;
+            const std::string endpoint = argv[i];
+            const size_t colon = endpoint.rfind(':');
+            const int port = colon == std::string::npos ? -1
+                                                         : std::atoi(endpoint.c_str() + colon + 1);
+            if (colon == 0 || port < 0 || port > 65535)
+            {
+                PlatformLogger::Log(LogLevel::kError, "publisher",
+                                    "invalid v1-tcp: %s (use host:port)", argv[i]);
                 return 1;
             }
+            data_options.tcp_enabled = true;
+            data_options.tcp_bind_host = endpoint.substr(0, colon);
+            data_options.tcp_port = static_cast<uint16_t>(port);
         }
         else if (arg == "--help" || arg == "-h")
         {
             PlatformLogger::Log(LogLevel::kInfo, "publisher",
                                 "usage: %s [device_path] [control_socket] [data_socket] "
-                                "[--io-method mmap|dmabuf] [--data-plane v1|v2] "
-                                "[--release-socket path]",
+                                "[--io-method mmap|userptr|dmabuf|dmabuf-import] "
+                                "[--data-plane v1|v2|shm] "
+                                "[--backend v4l2|synthetic|memfd|replay:<file>] "
+                                "[--release-socket path] [--consumer-lease-quota n] "
+                                "[--reactor-threads n] "
+                                "[--v1-queue-policy drop-oldest|keep-latest] "
+                                "[--v1-queue-depth n] [--v1-tcp host:port]",
                                 argv[0]);
             return 0;
         }
@@ -534,16 +1428,38 @@ int main(int argc, char* argv[])
 
     PlatformLogger::Log(LogLevel::kInfo, "publisher",
                         "publisher start, device=%s, control_socket=%s, data_socket=%s, "
-                        "release_socket=%s, io_method=%s, data_plane=%s",
+                        "release_socket=%s, io_method=%s, data_plane=%s, backend=%s",
                         device_path.c_str(), control_socket_path.c_str(), data_socket_path.c_str(),
                         release_socket_path.c_str(),
-                        io_method == IoMethod::kDmaBuf ? "dmabuf" : "mmap",
-                        data_plane_mode == DataPlaneMode::kV2DmaBuf ? "v2" : "v1");
+                        io_method == IoMethod::kDmaBufImport ? "dmabuf-import"
+                        : io_method == IoMethod::kDmaBuf     ? "dmabuf"
+                        : io_method == IoMethod::kUserPtr    ? "userptr"
+                                                             : "mmap",
+                        DataPlaneModeToString(data_plane_mode), backend_spec.c_str());
+
+    bool backend_ok = true;
+    // 只校验参数；每个端点在创建 source 时各自构造后端
+    (void)MakeCaptureBackend(backend_spec, backend_ok);
+    if (!backend_ok)
+    {
+        PlatformLogger::Log(LogLevel::kError, "publisher",
+                            "unknown backend: %s (use v4l2, synthetic, memfd or replay:<file>)",
+                            backend_spec.c_str());
+        PlatformLogger::Shutdown();
+        return 1;
+    }
 
-    DataSocketServer data_server;
+    // EXPBUF 与 DMABUF 导入两种模式都以 FramePacket + lease 交付帧
+    const bool dma_buf_io =
+        io_method == IoMethod::kDmaBuf || io_method == IoMethod::kDmaBufImport;
+    CameraDataSocketServer data_server(data_options);
     DataPlaneV2SocketServer data_v2_server;
+    // shm 数据面基于 BufferPool，仅在 mmap 拷贝或 userptr 采集下生效
+    const bool use_shm_pool = !dma_buf_io && data_plane_mode == DataPlaneMode::kV2Shm;
     const bool use_data_plane_v2 =
-        io_method == IoMethod::kDmaBuf && data_plane_mode == DataPlaneMode::kV2DmaBuf;
+        (dma_buf_io && data_plane_mode == DataPlaneMode::kV2DmaBuf) ||
+        use_shm_pool;
+    const bool use_release_server = dma_buf_io || use_shm_pool;
 
     if (!use_data_plane_v2 && !data_server.Start(data_socket_path))
     {
@@ -558,37 +1474,96 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    CameraSource camera_source;
     CameraConfig config = CameraConfig::GetDefault();
     config.fps_ = 30;
     config.buffer_count_ = 4;
     config.io_method_ = static_cast<uint32_t>(io_method);
+    // 采集拷贝目标：单块大页 arena、页对齐并预先缺页，避免热路径上的缺页与 TLB 抖动
+    camera_subsystem::core::BufferPool::Options pool_options;
+    pool_options.use_arena = true;
+    pool_options.huge_pages = true;
+    pool_options.alignment = 4096;
+    pool_options.prefault = true;
+    if (!dma_buf_io && !use_data_plane_v2)
+    {
+        // v1 发送队列持有 BufferGuard 直到写出，为排队帧留出槽位，否则采集端频繁丢帧
+        config.buffer_count_ = static_cast<uint32_t>(
+            std::max<size_t>(config.buffer_count_, data_options.max_queued_frames + 4));
+    }
+    if (use_shm_pool)
+    {
+        // 槽位在消费者归还前保持占用，多留几个给采集线程周转
+        config.buffer_count_ = 8;
+        pool_options.shareable = true;
+    }
 
     PublisherStats stats;
+    std::atomic<const CameraControlServer*> control_server_ref{nullptr};
     std::mutex camera_mutex;
+    // camera_id → 热切换后的配置，该端点之后的会话重启沿用
+    std::unordered_map<uint32_t, CameraConfig> endpoint_configs;
     CameraReleaseServer release_server(std::chrono::milliseconds(1000));
     std::mutex lease_mutex;
+    // 键为 MakePendingKey(stream_id, frame_id)
     std::unordered_map<uint64_t, std::shared_ptr<FrameLease>> pending_leases;
-    if (io_method == IoMethod::kDmaBuf)
+    std::unordered_map<uint64_t, std::shared_ptr<BufferGuard>> pending_slots;
+    ShmPoolAnnouncements announcements;
+    DmaBufRegistrations registrations;
+    ShmRings shm_rings;
+    // consumer_id 不复用，后台发送失败时留下的抽帧状态不会被新连接误用
+    DescriptorBatcher batcher(stats,
+                              [&](uint32_t consumer_id)
+                              {
+                                  data_v2_server.RemoveClient(consumer_id);
+                                  release_server.ReclaimConsumerDisconnected(consumer_id);
+                                  registrations.ForgetConsumer(consumer_id);
+                              });
+    if (use_data_plane_v2)
+    {
+        batcher.Start();
+    }
+
+    // 默认给单个消费者留出至少一个 lease 之外的余量，慢消费者无法占满全部 lease；
+    // 自动模式下随各 CameraSource 的 lease 预算变化重算
+    auto apply_lease_quota = [&](uint32_t quota)
+    {
+        release_server.SetDefaultConsumerQuota(quota);
+        batcher.SetMaxPendingFrames(quota);
+        PlatformLogger::Log(LogLevel::kInfo, "publisher", "default consumer lease quota=%u",
+                            quota);
+    };
+    apply_lease_quota(static_cast<uint32_t>(std::max(consumer_lease_quota, 0)));
+    LeaseQuotaTable lease_quotas(apply_lease_quota);
+    if (use_release_server)
     {
         if (!release_server.Start(
                 release_socket_path,
                 [&](const camera_subsystem::ipc::CameraReleaseReclaim& reclaim)
                 {
+                    const uint64_t pending_key =
+                        MakePendingKey(reclaim.stream_id, reclaim.frame_id);
                     std::shared_ptr<FrameLease> lease;
+                    std::shared_ptr<BufferGuard> slot;
                     {
                         std::lock_guard<std::mutex> lock(lease_mutex);
-                        auto it = pending_leases.find(reclaim.frame_id);
+                        auto it = pending_leases.find(pending_key);
                         if (it != pending_leases.end())
                         {
                             lease = std::move(it->second);
                             pending_leases.erase(it);
                         }
+                        auto slot_it = pending_slots.find(pending_key);
+                        if (slot_it != pending_slots.end())
+                        {
+                            slot = std::move(slot_it->second);
+                            pending_slots.erase(slot_it);
+                        }
                     }
                     if (lease)
                     {
                         lease->Release();
                     }
+                    // slot 在此析构，槽位回到 BufferPool
                     PlatformLogger::Log(LogLevel::kInfo, "publisher",
                                         "release reclaim: stream=%u frame=%" PRIu64
                                         " buffer=%u status=%u observed=%u expected=%u",
@@ -598,6 +1573,11 @@ int main(int argc, char* argv[])
                                         static_cast<uint32_t>(reclaim.status),
                                         reclaim.observed_release_count,
                                         reclaim.expected_release_count);
+                },
+                [&](uint32_t consumer_id)
+                {
+                    // consumer_id 不复用，断开后清除其 fd 注册记录，长时间运行时条目不会累积
+                    registrations.ForgetConsumer(consumer_id);
                 }))
         {
             PlatformLogger::Log(LogLevel::kError, "publisher",
@@ -609,155 +1589,278 @@ int main(int argc, char* argv[])
         }
     }
 
-    camera_source.SetFrameCallbackWithBuffer(
-        [&](const FrameHandle& frame,
-            const std::shared_ptr<camera_subsystem::core::BufferGuard>& /*buffer_ref*/)
+    // 每个端点一个 source 与一份分发状态；回调在共享反应器线程上按端点并发执行
+    CameraSourceRegistry::Options registry_options;
+    registry_options.reactor_threads = reactor_threads;
+    CameraSourceRegistry registry(
+        [&](const CameraEndpoint& endpoint, CameraSource& source)
         {
-            if (!frame.IsValid() || frame.virtual_address_ == nullptr || frame.buffer_size_ == 0)
+            bool backend_valid = true;
+            auto backend = MakeCaptureBackend(backend_spec, backend_valid);
+            if (backend)
             {
-                return;
+                source.SetCaptureBackend(backend);
             }
+            source.SetBufferPoolOptions(pool_options);
 
-            stats.frame_count.fetch_add(1);
-
-            CameraDataFrameHeader header;
-            std::memset(&header, 0, sizeof(header));
-            header.magic = kCameraDataMagic;
-            header.version = kCameraDataVersion;
-            header.width = frame.width_;
-            header.height = frame.height_;
-            header.pixel_format = static_cast<uint32_t>(frame.format_);
-            header.frame_size = static_cast<uint32_t>(frame.buffer_size_);
-            header.frame_id = frame.frame_id_;
-            header.timestamp_ns = frame.timestamp_ns_;
-            header.sequence = frame.sequence_;
-
-            const std::vector<int> clients = data_server.GetClientsSnapshot();
-            for (const int fd : clients)
+            const uint32_t camera_id = endpoint.camera_id;
+            if (consumer_lease_quota < 0)
             {
-                const bool header_ok = WriteFull(fd, &header, sizeof(header));
-                const bool body_ok = header_ok &&
-                                     WriteFull(fd, frame.virtual_address_, frame.buffer_size_);
-                if (!header_ok || !body_ok)
-                {
-                    data_server.RemoveClient(fd);
-                    stats.send_fail_count.fetch_add(1);
-                    continue;
-                }
-                stats.sent_bytes.fetch_add(frame.buffer_size_);
+                source.SetLeaseBudgetCallback(
+                    [&, camera_id](size_t lease_max)
+                    { lease_quotas.Update(camera_id, lease_max); });
             }
-        });
 
-    // DMA-BUF 模式：注册 FramePacketCallback 接收零拷贝帧
-    if (io_method == IoMethod::kDmaBuf)
-    {
-        camera_source.SetFramePacketCallback(
-            [&](const camera_subsystem::core::FramePacket& packet)
+            auto fanout = std::make_shared<EndpointFanout>(control_server_ref, endpoint);
+            // v1 客户端队列持有采集 Buffer，Reconfigure 停流后先归还，BufferPool 才能排空
+            source.SetDrainCallback(
+                [&, camera_id]() { data_server.DropQueuedFrames(camera_id); });
+            source.SetFrameCallbackWithBuffer(
+                [&, fanout](const FrameHandle& frame,
+                            const std::shared_ptr<BufferGuard>& buffer_ref)
+                {
+                    if (!frame.IsValid() || frame.virtual_address_ == nullptr ||
+                        frame.buffer_size_ == 0)
+                    {
+                        return;
+                    }
+
+                    stats.frame_count.fetch_add(1);
+
+                    if (use_shm_pool)
+                    {
+                        PublishShmSlot(frame, buffer_ref, source, data_v2_server, batcher,
+                                       release_server, lease_mutex, pending_slots,
+                                       announcements, fanout->rate_limiter, stats);
+                        return;
+                    }
+
+                    CameraDataFrameHeader header;
+                    std::memset(&header, 0, sizeof(header));
+                    header.magic = kCameraDataMagic;
+                    header.version = kCameraDataVersion;
+                    header.width = frame.width_;
+                    header.height = frame.height_;
+                    header.pixel_format = static_cast<uint32_t>(frame.format_);
+                    header.frame_size = static_cast<uint32_t>(frame.buffer_size_);
+                    header.frame_id = frame.frame_id_;
+                    header.timestamp_ns = frame.timestamp_ns_;
+                    header.sequence = frame.sequence_;
+                    header.stream_generation = frame.stream_generation_;
+                    header.camera_id = frame.camera_id_;
+
+                    // 共享内存环：无论多少本机消费者，只写一次
+                    shm_rings.Publish(header, frame.virtual_address_, frame.buffer_size_);
+
+                    // 只入队，不触碰 socket：由数据面写线程非阻塞发送
+                    const std::vector<CameraDataSocketServer::Client> clients =
+                        data_server.GetClientsSnapshot();
+                    for (const auto& client : clients)
+                    {
+                        const auto admission = fanout->rate_limiter.Accept(
+                            client.client_id, client.pid, frame.timestamp_ns_);
+                        if (admission != SubscriberFrameRateLimiter::Admission::kSend)
+                        {
+                            if (admission == SubscriberFrameRateLimiter::Admission::kDecimated)
+                            {
+                                stats.decimated_frames.fetch_add(1);
+                            }
+                            continue;
+                        }
+                        if (!data_server.Enqueue(client.client_id, header, frame.virtual_address_,
+                                                 frame.buffer_size_, buffer_ref))
+                        {
+                            fanout->rate_limiter.Forget(client.client_id);
+                        }
+                    }
+                });
+
+            // DMA-BUF 模式：注册 FramePacketCallback 接收零拷贝帧
+            if (dma_buf_io)
             {
-                stats.frame_count.fetch_add(1);
-                stats.dmabuf_frame_count.fetch_add(1);
+                source.SetFramePacketCallback(
+                    [&, fanout](const camera_subsystem::core::FramePacket& packet)
+                    {
+                        stats.frame_count.fetch_add(1);
+                        stats.dmabuf_frame_count.fetch_add(1);
 
-                const auto& desc = packet.descriptor;
-                if (!use_data_plane_v2)
-                {
-                    PlatformLogger::Log(LogLevel::kDebug, "publisher",
-                                        "dmabuf frame: id=%" PRIu64 " buf=%u fd=%d bytes=%" PRIu64,
-                                        desc.frame_id, desc.buffer_id,
-                                        desc.fd_count > 0 ? desc.fds[0] : -1,
-                                        desc.total_bytes_used);
-                    return;
-                }
+                        const auto& desc = packet.descriptor;
+                        if (!use_data_plane_v2)
+                        {
+                            PlatformLogger::Log(LogLevel::kDebug, "publisher",
+                                                "dmabuf frame: camera=%u id=%" PRIu64
+                                                " buf=%u fd=%d bytes=%" PRIu64,
+                                                desc.camera_id, desc.frame_id, desc.buffer_id,
+                                                desc.fd_count > 0 ? desc.fds[0] : -1,
+                                                desc.total_bytes_used);
+                            return;
+                        }
 
-                const std::vector<DataPlaneV2SocketServer::Client> clients =
-                    data_v2_server.GetClientsSnapshot();
-                if (clients.empty())
-                {
-                    return;
-                }
+                        const std::vector<DataPlaneV2SocketServer::Client> clients =
+                            data_v2_server.GetClientsSnapshot();
+                        if (clients.empty())
+                        {
+                            return;
+                        }
 
-                std::vector<uint32_t> consumer_ids;
-                consumer_ids.reserve(clients.size());
-                for (const auto& client : clients)
-                {
-                    consumer_ids.push_back(client.consumer_id);
-                }
+                        // 已达配额的慢消费者跳过本帧；全部跳过时 packet 析构即归还 buffer
+                        const std::vector<DataPlaneV2SocketServer::Client> admitted =
+                            AdmitClients(clients, release_server, fanout->rate_limiter,
+                                         desc.timestamp_ns, stats);
+                        if (admitted.empty())
+                        {
+                            return;
+                        }
+                        std::vector<uint32_t> consumer_ids;
+                        consumer_ids.reserve(admitted.size());
+                        for (const auto& client : admitted)
+                        {
+                            consumer_ids.push_back(client.consumer_id);
+                        }
 
-                {
-                    std::lock_guard<std::mutex> lock(lease_mutex);
-                    pending_leases[desc.frame_id] = packet.lease;
-                }
+                        const uint64_t pending_key = MakePendingKey(desc.camera_id, desc.frame_id);
+                        {
+                            std::lock_guard<std::mutex> lock(lease_mutex);
+                            pending_leases[pending_key] = packet.lease;
+                        }
 
-                if (!release_server.RegisterFrame(
-                        desc.camera_id,
-                        desc.frame_id,
-                        desc.buffer_id,
-                        consumer_ids))
-                {
-                    std::lock_guard<std::mutex> lock(lease_mutex);
-                    pending_leases.erase(desc.frame_id);
-                    return;
-                }
+                        if (!release_server.RegisterFrame(
+                                desc.camera_id,
+                                desc.frame_id,
+                                desc.buffer_id,
+                                consumer_ids))
+                        {
+                            std::lock_guard<std::mutex> lock(lease_mutex);
+                            pending_leases.erase(pending_key);
+                            return;
+                        }
 
-                auto descriptor_v2 = MakeCameraDataFrameDescriptorV2(desc);
-                for (const auto& client : clients)
-                {
-                    descriptor_v2.consumer_id = client.consumer_id;
-                    if (!SendCameraDataFrameDescriptorV2(
-                            client.fd,
-                            descriptor_v2,
-                            desc.fds.data(),
-                            desc.fd_count))
-                    {
-                        data_v2_server.RemoveClient(client.consumer_id);
-                        release_server.ReclaimConsumerDisconnected(client.consumer_id);
-                        stats.v2_send_fail_count.fetch_add(1);
-                        continue;
-                    }
-                    stats.v2_sent_frames.fetch_add(1);
-                }
+                        // 声明了 fd 缓存的消费者：每个 buffer 首帧随附 fd 注册，之后只带 buffer_id
+                        auto descriptor_v2 = MakeCameraDataFrameDescriptorV2(desc);
+                        auto register_v2 = MakeCameraBufferRegisterV2(desc);
+                        auto cached_v2 = MakeCameraBufferCachedDescriptorV2(desc);
+                        for (const auto& client : admitted)
+                        {
+                            const bool fd_cache =
+                                (fanout->rate_limiter.DataPlaneFeatures(client.consumer_id) &
+                                 kCameraDataPlaneFeatureV2BufferCache) != 0;
+                            const bool registering =
+                                fd_cache && registrations.NeedsRegister(
+                                                desc.camera_id, client.consumer_id,
+                                                desc.stream_generation, desc.buffer_id);
+                            CameraDataFrameDescriptorV2& outgoing =
+                                !fd_cache ? descriptor_v2 : registering ? register_v2 : cached_v2;
+                            const bool with_fds = !fd_cache || registering;
+                            outgoing.consumer_id = client.consumer_id;
+                            if (!batcher.Queue(
+                                    client, outgoing, with_fds ? desc.fds.data() : nullptr,
+                                    with_fds ? desc.fd_count : 0, packet.lease,
+                                    fanout->rate_limiter.CoalesceWindow(client.consumer_id)))
+                            {
+                                data_v2_server.RemoveClient(client.consumer_id);
+                                release_server.ReclaimConsumerDisconnected(client.consumer_id);
+                                fanout->rate_limiter.Forget(client.consumer_id);
+                                registrations.ForgetConsumer(client.consumer_id);
+                                stats.v2_send_fail_count.fetch_add(1);
+                                continue;
+                            }
+                            if (registering)
+                            {
+                                registrations.MarkRegistered(desc.camera_id, client.consumer_id,
+                                                             desc.stream_generation,
+                                                             desc.buffer_id);
+                                stats.v2_fd_registrations.fetch_add(1);
+                            }
+                        }
 
-                PlatformLogger::Log(LogLevel::kDebug, "publisher",
-                                    "dmabuf v2 frame: id=%" PRIu64 " buf=%u fd=%d bytes=%" PRIu64,
-                                    desc.frame_id, desc.buffer_id,
-                                    desc.fd_count > 0 ? desc.fds[0] : -1,
-                                    desc.total_bytes_used);
-            });
-    }
+                        PlatformLogger::Log(LogLevel::kDebug, "publisher",
+                                            "dmabuf v2 frame: camera=%u id=%" PRIu64
+                                            " buf=%u fd=%d bytes=%" PRIu64,
+                                            desc.camera_id, desc.frame_id, desc.buffer_id,
+                                            desc.fd_count > 0 ? desc.fds[0] : -1,
+                                            desc.total_bytes_used);
+                    });
+            }
+            return true;
+        },
+        registry_options);
 
     CameraSessionManager session_manager(
         [&](const CameraEndpoint& endpoint)
         {
-            std::lock_guard<std::mutex> lock(camera_mutex);
-
-            camera_source.Stop();
-            camera_source.SetDevicePath(endpoint.device_path);
-
-            if (!camera_source.Initialize(config))
+            CameraConfig endpoint_config = config;
             {
-                PlatformLogger::Log(LogLevel::kError, "publisher",
-                                    "CameraSource initialize failed, device=%s",
-                                    endpoint.device_path);
-                return false;
+                std::lock_guard<std::mutex> lock(camera_mutex);
+                auto it = endpoint_configs.find(endpoint.camera_id);
+                if (it != endpoint_configs.end())
+                {
+                    endpoint_config = it->second;
+                }
             }
 
-            if (!camera_source.Start())
+            if (!registry.Start(endpoint, endpoint_config))
             {
                 PlatformLogger::Log(LogLevel::kError, "publisher",
-                                    "CameraSource start failed, device=%s",
-                                    endpoint.device_path);
+                                    "CameraSource start failed, camera=%u device=%s",
+                                    endpoint.camera_id, endpoint.device_path);
                 return false;
             }
 
             PlatformLogger::Log(LogLevel::kInfo, "publisher",
-                                "CameraSource started, device=%s", endpoint.device_path);
+                                "CameraSource started, camera=%u device=%s active=%zu",
+                                endpoint.camera_id, endpoint.device_path,
+                                registry.GetSourceCount());
             return true;
         },
         [&](const CameraEndpoint& endpoint)
         {
+            registry.Stop(endpoint);
+            registrations.ForgetCamera(endpoint.camera_id);
+            lease_quotas.Forget(endpoint.camera_id);
+            PlatformLogger::Log(LogLevel::kInfo, "publisher",
+                                "CameraSource stopped, camera=%u device=%s active=%zu",
+                                endpoint.camera_id, endpoint.device_path,
+                                registry.GetSourceCount());
+        });
+
+    session_manager.SetReconfigureCallback(
+        [&](const CameraEndpoint& endpoint, const CameraStreamFormat& format)
+        {
+            const std::shared_ptr<CameraSource> source = registry.Find(endpoint);
+            if (!source)
+            {
+                return false;
+            }
+
             std::lock_guard<std::mutex> lock(camera_mutex);
-            camera_source.Stop();
+            auto it = endpoint_configs.find(endpoint.camera_id);
+            CameraConfig next = it != endpoint_configs.end() ? it->second : config;
+            next.width_ = format.width != 0 ? format.width : next.width_;
+            next.height_ = format.height != 0 ? format.height : next.height_;
+            next.format_ = format.pixel_format != 0
+                               ? static_cast<camera_subsystem::core::PixelFormat>(
+                                     format.pixel_format)
+                               : next.format_;
+            next.fps_ = format.fps != 0 ? format.fps : next.fps_;
+            if (!source->Reconfigure(next))
+            {
+                PlatformLogger::Log(LogLevel::kError, "publisher",
+                                    "CameraSource reconfigure failed, camera=%u device=%s",
+                                    endpoint.camera_id, endpoint.device_path);
+                return false;
+            }
+
+            // 之后该端点的会话重启沿用新格式
+            endpoint_configs[endpoint.camera_id] = next;
             PlatformLogger::Log(LogLevel::kInfo, "publisher",
-                                "CameraSource stopped, device=%s", endpoint.device_path);
+                                "CameraSource reconfigured, camera=%u device=%s %ux%u fps=%u "
+                                "generation=%u took=%.2fms",
+                                endpoint.camera_id, endpoint.device_path,
+                                source->GetConfig().width_, source->GetConfig().height_,
+                                next.fps_, source->GetStreamGeneration(),
+                                static_cast<double>(source->GetLastReconfigureDurationNs()) /
+                                    1e6);
+            return true;
         });
 
     if (!session_manager.RegisterCorePublisher("camera_publisher_core"))
@@ -769,6 +1872,29 @@ int main(int argc, char* argv[])
     }
 
     CameraControlServer control_server(&session_manager);
+    if (!use_data_plane_v2 && !dma_buf_io)
+    {
+        CameraControlServer::ShmRingProvider ring_provider;
+        ring_provider.open = [&](pid_t pid, const CameraEndpoint& endpoint,
+                                 CameraControlServer::ShmRingGrant* grant)
+        {
+            // 首帧到达前按配置估算 YUYV 帧大小，之后按实际帧大小
+            size_t min_capacity = 0;
+            {
+                std::lock_guard<std::mutex> lock(camera_mutex);
+                auto it = endpoint_configs.find(endpoint.camera_id);
+                const CameraConfig& ring_config =
+                    it != endpoint_configs.end() ? it->second : config;
+                min_capacity = static_cast<size_t>(ring_config.width_) * ring_config.height_ * 2;
+            }
+            return shm_rings.Open(pid, endpoint, min_capacity, grant);
+        };
+        ring_provider.close = [&](const CameraEndpoint& endpoint,
+                                  const CameraControlServer::ShmRingGrant& grant)
+        { shm_rings.Close(endpoint, grant); };
+        control_server.SetShmRingProvider(ring_provider);
+    }
+    control_server_ref.store(&control_server);
     if (!control_server.Start(control_socket_path))
     {
         PlatformLogger::Log(LogLevel::kError, "publisher",
@@ -776,27 +1902,39 @@ int main(int argc, char* argv[])
                             control_server.GetLastErrorStage().c_str(),
                             control_server.GetLastErrorNo(),
                             control_server.GetLastErrorMessage().c_str());
+        control_server_ref.store(nullptr);
         data_server.Stop();
         PlatformLogger::Shutdown();
         return 1;
     }
 
-    if (io_method == IoMethod::kDmaBuf)
+    if (use_shm_pool)
+    {
+        PlatformLogger::Log(LogLevel::kInfo, "publisher",
+                            "sec | frames | fps | clients | v2_sent | v2_send_fail | "
+                            "v2_send_calls | release_pending | release_reclaimed | release_timeout | "
+                            "decimated");
+    }
+    else if (dma_buf_io)
     {
         PlatformLogger::Log(LogLevel::kInfo, "publisher",
-                            "sec | frames | fps | clients | sent_bytes | send_fail | "
-                            "dmabuf_enabled | dmabuf_frames | export_fail | lease_exhausted | "
-                            "active_leases | lease_max | min_queued | v2_sent | v2_send_fail | "
-                            "release_pending | release_received | release_reclaimed | release_timeout");
+                            "sec | frames | fps | clients | sent_bytes | closed | "
+                            "dmabuf_frames | v2_sent | v2_send_fail | v2_send_calls | "
+                            "v2_fd_registered | "
+                            "release_pending | release_received | release_reclaimed | release_timeout | "
+                            "decimated");
     }
     else
     {
         PlatformLogger::Log(LogLevel::kInfo, "publisher",
-                            "sec | frames | fps | clients | sent_bytes | send_fail");
+                            "sec | frames | fps | clients | sent_bytes | queue_dropped | closed | "
+                            "decimated");
     }
 
     uint64_t elapsed_sec = 0;
     uint64_t last_frames = 0;
+    // camera_id → 上一秒的采集帧数
+    std::unordered_map<uint32_t, uint64_t> last_endpoint_frames;
     while (g_running.load())
     {
         std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -806,60 +1944,172 @@ int main(int argc, char* argv[])
         const uint64_t fps = frames - last_frames;
         last_frames = frames;
 
-        if (io_method == IoMethod::kDmaBuf)
+        if (use_shm_pool)
+        {
+            PlatformLogger::Log(LogLevel::kInfo, "publisher",
+                                "sec=%" PRIu64 " | frames=%" PRIu64 " | fps=%" PRIu64
+                                " | clients=%zu | v2_sent=%" PRIu64 " | v2_send_fail=%" PRIu64
+                                " | v2_send_calls=%" PRIu64 " | release_pending=%zu"
+                                " | release_reclaimed=%" PRIu64 " | release_timeout=%" PRIu64
+                                " | decimated=%" PRIu64,
+                                elapsed_sec, frames, fps, data_v2_server.GetClientCount(),
+                                stats.v2_sent_frames.load(), stats.v2_send_fail_count.load(),
+                                stats.v2_send_calls.load(), release_server.PendingFrameCount(),
+                                release_server.GetServerStats().reclaimed_frames,
+                                release_server.GetServerStats().expired_reclaims,
+                                stats.decimated_frames.load());
+        }
+        else if (dma_buf_io)
         {
             PlatformLogger::Log(LogLevel::kInfo, "publisher",
                                 "sec=%" PRIu64 " | frames=%" PRIu64 " | fps=%" PRIu64
-                                " | clients=%zu | sent_bytes=%" PRIu64 " | send_fail=%" PRIu64
-                                " | dmabuf_enabled=%u | dmabuf_frames=%" PRIu64
-                                " | export_fail=%" PRIu64 " | lease_exhausted=%" PRIu64
-                                " | active_leases=%zu | lease_max=%zu | min_queued=%zu"
+                                " | clients=%zu | sent_bytes=%" PRIu64 " | closed=%" PRIu64
+                                " | dmabuf_frames=%" PRIu64
                                 " | v2_sent=%" PRIu64 " | v2_send_fail=%" PRIu64
+                                " | v2_send_calls=%" PRIu64 " | v2_fd_registered=%" PRIu64
                                 " | release_pending=%zu | release_received=%" PRIu64
-                                " | release_reclaimed=%" PRIu64 " | release_timeout=%" PRIu64,
+                                " | release_reclaimed=%" PRIu64 " | release_timeout=%" PRIu64
+                                " | decimated=%" PRIu64,
                                 elapsed_sec, frames, fps,
                                 use_data_plane_v2 ? data_v2_server.GetClientCount()
                                                   : data_server.GetClientCount(),
-                                stats.sent_bytes.load(), stats.send_fail_count.load(),
-                                camera_source.IsDmaBufPathEnabled() ? 1U : 0U,
-                                camera_source.GetDmaBufFrameCount(),
-                                camera_source.GetDmaBufExportFailureCount(),
-                                camera_source.GetDmaBufLeaseExhaustedCount(),
-                                camera_source.GetDmaBufActiveLeaseCount(),
-                                camera_source.GetDmaBufLeaseInFlightMax(),
-                                camera_source.GetDmaBufMinQueuedCaptureBuffers(),
+                                data_server.GetServerStats().sent_bytes,
+                                data_server.GetServerStats().closed_clients,
+                                stats.dmabuf_frame_count.load(),
                                 stats.v2_sent_frames.load(),
                                 stats.v2_send_fail_count.load(),
+                                stats.v2_send_calls.load(),
+                                stats.v2_fd_registrations.load(),
                                 release_server.PendingFrameCount(),
                                 release_server.GetServerStats().received_releases,
                                 release_server.GetServerStats().reclaimed_frames,
-                                release_server.GetServerStats().expired_reclaims);
+                                release_server.GetServerStats().expired_reclaims,
+                                stats.decimated_frames.load());
         }
         else
         {
+            const CameraDataSocketServer::ServerStats data_stats = data_server.GetServerStats();
             PlatformLogger::Log(LogLevel::kInfo, "publisher",
                                 "sec=%" PRIu64 " | frames=%" PRIu64 " | fps=%" PRIu64
-                                " | clients=%zu | sent_bytes=%" PRIu64 " | send_fail=%" PRIu64,
+                                " | clients=%zu | sent_bytes=%" PRIu64
+                                " | queue_dropped=%" PRIu64 " | closed=%" PRIu64
+                                " | decimated=%" PRIu64,
                                 elapsed_sec, frames, fps, data_server.GetClientCount(),
-                                stats.sent_bytes.load(), stats.send_fail_count.load());
+                                data_stats.sent_bytes, data_stats.dropped_frames,
+                                data_stats.closed_clients, stats.decimated_frames.load());
+            for (const auto& client : data_server.GetClientStats())
+            {
+                PlatformLogger::Log(LogLevel::kInfo, "publisher",
+                                    "client=%u | pid=%d | transport=%s | policy=%s"
+                                    " | queued=%zu/%zu | peak=%zu | sent=%" PRIu64
+                                    " | dropped=%" PRIu64 " | blocked=%" PRIu64
+                                    " | send_calls=%" PRIu64 " | zc_sends=%" PRIu64
+                                    " | zc_inflight=%zu | lag_p50_us=%" PRIu64
+                                    " | lag_p99_us=%" PRIu64,
+                                    client.client_id, static_cast<int>(client.pid),
+                                    client.tcp ? (client.zero_copy ? "tcp-zc" : "tcp")
+                                               : "unix",
+                                    client.policy ==
+                                            CameraDataSocketServer::QueuePolicy::kKeepLatest
+                                        ? "keep-latest"
+                                        : "drop-oldest",
+                                    client.queued_frames, client.max_queued_frames,
+                                    client.peak_queued_frames, client.sent_frames,
+                                    client.dropped_frames, client.blocked_count,
+                                    client.send_calls, client.zero_copy_sends,
+                                    client.zero_copy_inflight, client.send_lag.p50_ns / 1000,
+                                    client.send_lag.p99_ns / 1000);
+            }
+            for (const auto& ring : shm_rings.GetStats())
+            {
+                PlatformLogger::Log(LogLevel::kInfo, "publisher",
+                                    "ring=%" PRIu64 " | camera=%u | slots=%u | capacity=%zu"
+                                    " | published=%" PRIu64 " | dropped=%" PRIu64
+                                    " | consumers=%zu",
+                                    ring.ring.ring_id, ring.camera_id, ring.ring.slot_count,
+                                    ring.ring.slot_capacity, ring.ring.published_frames,
+                                    ring.ring.dropped_frames, ring.ring.consumers.size());
+                for (const auto& consumer : ring.ring.consumers)
+                {
+                    PlatformLogger::Log(LogLevel::kInfo, "publisher",
+                                        "ring_consumer=%u | pid=%d | read=%" PRIu64
+                                        " | lag=%" PRIu64 " | overruns=%" PRIu64,
+                                        consumer.index, static_cast<int>(consumer.pid),
+                                        consumer.frames_read, consumer.lag, consumer.overruns);
+                }
+            }
+        }
+
+        std::unordered_map<uint32_t, uint64_t> endpoint_frames;
+        for (const auto& endpoint : registry.GetStats())
+        {
+            const uint32_t camera_id = endpoint.endpoint.camera_id;
+            auto last = last_endpoint_frames.find(camera_id);
+            // 重新启动的 source 帧计数从 0 开始
+            const uint64_t endpoint_fps =
+                (last != last_endpoint_frames.end() && endpoint.frames >= last->second)
+                    ? endpoint.frames - last->second
+                    : endpoint.frames;
+            endpoint_frames[camera_id] = endpoint.frames;
+
+            PlatformLogger::Log(LogLevel::kInfo, "publisher",
+                                "camera=%u | device=%s | running=%u | %ux%u | fps=%" PRIu64
+                                " | dropped=%" PRIu64 " | generation=%u | pool_in_flight=%zu",
+                                camera_id, endpoint.endpoint.device_path,
+                                endpoint.running ? 1U : 0U, endpoint.config.width_,
+                                endpoint.config.height_, endpoint_fps, endpoint.dropped_frames,
+                                endpoint.stream_generation, endpoint.pool.in_flight);
+
+            const std::shared_ptr<CameraSource> source = registry.Find(endpoint.endpoint);
+            if (dma_buf_io && source)
+            {
+                PlatformLogger::Log(LogLevel::kInfo, "publisher",
+                                    "camera=%u | dmabuf_enabled=%u | dmabuf_frames=%" PRIu64
+                                    " | export_fail=%" PRIu64 " | lease_exhausted=%" PRIu64
+                                    " | active_leases=%zu | lease_max=%zu | min_queued=%zu",
+                                    camera_id, source->IsDmaBufPathEnabled() ? 1U : 0U,
+                                    source->GetDmaBufFrameCount(),
+                                    source->GetDmaBufExportFailureCount(),
+                                    source->GetDmaBufLeaseExhaustedCount(),
+                                    source->GetDmaBufActiveLeaseCount(),
+                                    source->GetDmaBufLeaseInFlightMax(),
+                                    source->GetDmaBufMinQueuedCaptureBuffers());
+            }
+        }
+        last_endpoint_frames.swap(endpoint_frames);
+
+        if (use_data_plane_v2)
+        {
+            for (const auto& consumer : release_server.GetConsumerStats())
+            {
+                PlatformLogger::Log(LogLevel::kInfo, "publisher",
+                                    "consumer=%u | quota=%u | held=%" PRIu64
+                                    " | granted=%" PRIu64 " | released=%" PRIu64
+                                    " | timeout=%" PRIu64 " | skipped=%" PRIu64
+                                    " | hold_p50_us=%" PRIu64 " | hold_p99_us=%" PRIu64,
+                                    consumer.consumer_id, consumer.quota, consumer.leases_held,
+                                    consumer.leases_granted, consumer.releases, consumer.timeouts,
+                                    consumer.skipped_frames, consumer.hold_time.p50_ns / 1000,
+                                    consumer.hold_time.p99_ns / 1000);
+            }
         }
     }
 
     PlatformLogger::Log(LogLevel::kInfo, "publisher", "publisher stopping...");
     control_server.Stop();
+    control_server_ref.store(nullptr);
     release_server.Stop();
     data_server.Stop();
+    batcher.Stop();
     data_v2_server.Stop();
 
     {
         std::lock_guard<std::mutex> lock(lease_mutex);
         pending_leases.clear();
+        pending_slots.clear();
     }
 
-    {
-        std::lock_guard<std::mutex> lock(camera_mutex);
-        camera_source.Stop();
-    }
+    registry.StopAll();
 
     (void)session_manager.UnregisterCorePublisher("camera_publisher_core");
     PlatformLogger::Shutdown();
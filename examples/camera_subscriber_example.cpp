@@ -6,13 +6,28 @@
  *
  * 用法：
  *   ./camera_subscriber_example [output_dir] [control_socket] [data_socket] [device_path]
- *       [--data-plane v1|v2] [--process-delay-ms N] [--release-delay-ms N]
+ *       [--data-plane v1|v2|shm|ring] [--process-delay-ms N] [--release-delay-ms N]
+ *       [--target-fps N] [--frame-stride N] [--reconfigure WxH[@FPS]] [--camera-id N]
+ *       [--data-tcp host:port] [--coalesce-ms N] [--no-fd-cache]
  *
  * 默认参数：
  * 1. output_dir    : ./subscriber_frames
  * 2. control_socket: /tmp/camera_subsystem_control.sock
  * 3. data_socket   : /tmp/camera_subsystem_data.sock
  * 4. device_path   : CAMERA_SUBSYSTEM_DEFAULT_CAMERA（通常为 /dev/video0）
+ * 5. --data-plane  : v1（默认）；v2 接收 DMA-BUF fd；shm 首帧前接收一次池 fd 并只读映射，
+ *                    之后按槽位偏移直接读取；ring 经控制面申请共享内存帧环，原地读取 v1 帧，
+ *                    发布端不提供时回退 v1 socket
+ * 6. --target-fps / --frame-stride：订阅时声明的帧率约定，发布端在发送前抽帧（默认 0 不限）
+ * 7. --reconfigure : 运行 1 秒后请求发布端热切换分辨率（可带帧率），连接保持不变；
+ *                    收到的帧 stream_generation 变化时打印新尺寸
+ * 8. --camera-id   : 订阅端点的 camera_id（默认 0）；发布端多路采集时每个端点 camera_id
+ *                    互不相同，帧头 / 描述符中的 camera_id / stream_id 与之对应
+ * 9. --data-tcp    : v1 数据面改为连接发布端的 TCP 监听（发布端 --v1-tcp），控制面仍走 Unix
+ * 10. --coalesce-ms: v2 / shm 数据面允许发布端合批发送描述符的最长等待（默认 0 逐帧发送），
+ *                    适合能容忍延迟的分析类消费者；上限 kCameraControlMaxCoalesceWindowMs
+ * 11. --no-fd-cache: v2 数据面默认声明 fd 注册缓存：每个 DMA-BUF buffer 只接收一次 fd 并常驻
+ *                    映射，之后的帧只带 buffer_id；指定此项则逐帧接收 fd 并临时映射
  *
  * 运行流程：
  * 1. 连接数据面 socket，接收核心发布端发送的帧头+帧数据。
@@ -32,20 +47,24 @@
 #include "camera_subsystem/ipc/camera_control_client.h"
 #include "camera_subsystem/ipc/camera_data_ipc.h"
 #include "camera_subsystem/ipc/camera_data_plane_v2.h"
+#include "camera_subsystem/ipc/camera_shm_ring.h"
 #include "camera_subsystem/platform/platform_logger.h"
 
 #include <algorithm>
+#include <arpa/inet.h>
 #include <atomic>
 #include <cerrno>
 #include <chrono>
 #include <cinttypes>
 #include <csignal>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <mutex>
+#include <netinet/in.h>
 #include <poll.h>
 #include <string>
 #include <sys/socket.h>
@@ -67,10 +86,13 @@ using camera_subsystem::ipc::CameraControlClient;
 using camera_subsystem::ipc::CameraControlResponse;
 using camera_subsystem::ipc::CameraDataFrameHeader;
 using camera_subsystem::ipc::CameraDataFrameDescriptorV2;
+using camera_subsystem::ipc::CameraDataV2BufferCache;
 using camera_subsystem::ipc::CameraEndpoint;
 using camera_subsystem::ipc::CameraControlStatus;
 using camera_subsystem::ipc::CameraReleaseFrameV2;
 using camera_subsystem::ipc::CameraReleaseStatus;
+using camera_subsystem::ipc::CameraShmRingReader;
+using camera_subsystem::ipc::CameraStreamFormat;
 using camera_subsystem::ipc::MakeCameraReleaseFrameV2;
 using camera_subsystem::ipc::ReceiveCameraDataFrameDescriptorV2;
 using camera_subsystem::ipc::SendCameraReleaseFrameV2;
@@ -81,7 +103,9 @@ std::atomic<bool> g_running(true);
 enum class DataPlaneMode
 {
     kV1Copy,
-    kV2DmaBuf
+    kV2DmaBuf,
+    kV2Shm,
+    kShmRing
 };
 
 void SignalHandler(int signo)
@@ -138,9 +162,40 @@ int ConnectUnixSocket(const std::string& socket_path, int socket_type)
     return fd;
 }
 
-int ConnectDataSocket(const std::string& socket_path)
+int ConnectTcpSocket(const std::string& endpoint)
 {
-    return ConnectUnixSocket(socket_path, SOCK_STREAM);
+    const size_t colon = endpoint.rfind(':');
+    if (colon == std::string::npos || colon == 0)
+    {
+        return -1;
+    }
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(std::atoi(endpoint.c_str() + colon + 1)));
+    if (inet_pton(AF_INET, endpoint.substr(0, colon).c_str(), &addr.sin_addr) != 1)
+    {
+        return -1;
+    }
+
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int ConnectDataSocket(const std::string& socket_path, const std::string& tcp_endpoint)
+{
+    return tcp_endpoint.empty() ? ConnectUnixSocket(socket_path, SOCK_STREAM)
+                                : ConnectTcpSocket(tcp_endpoint);
 }
 
 struct FrameSnapshot
@@ -254,6 +309,16 @@ int main(int argc, char* argv[])
     DataPlaneMode data_plane_mode = DataPlaneMode::kV1Copy;
     uint32_t process_delay_ms = 5;
     uint32_t release_delay_ms = 0;
+    uint32_t target_fps = 0;
+    uint32_t frame_stride = 0;
+    uint32_t coalesce_window_ms = 0;
+    bool fd_cache = true;
+    CameraStreamFormat reconfigure_format;
+    std::memset(&reconfigure_format, 0, sizeof(reconfigure_format));
+    bool reconfigure_pending = false;
+    std::thread reconfigure_thread;
+    uint32_t camera_id = 0;
+    std::string data_tcp_endpoint;
 
     int pos = 0;
     for (int i = 1; i < argc; ++i)
@@ -271,10 +336,19 @@ int main(int argc, char* argv[])
             {
                 data_plane_mode = DataPlaneMode::kV1Copy;
             }
+            else if (mode == "shm")
+            {
+                data_plane_mode = DataPlaneMode::kV2Shm;
+            }
+            else if (mode == "ring")
+            {
+                data_plane_mode = DataPlaneMode::kShmRing;
+            }
             else
             {
                 PlatformLogger::Log(LogLevel::kError, "subscriber",
-                                    "unknown data-plane: %s (use v1 or v2)", mode.c_str());
+                                    "unknown data-plane: %s (use v1, v2, shm or ring)",
+                                    mode.c_str());
                 return 1;
             }
         }
@@ -293,12 +367,61 @@ int main(int argc, char* argv[])
             ++i;
             release_delay_ms = static_cast<uint32_t>(std::stoul(argv[i]));
         }
+        else if (arg == "--target-fps" && i + 1 < argc)
+        {
+            ++i;
+            target_fps = static_cast<uint32_t>(std::stoul(argv[i]));
+        }
+        else if (arg == "--frame-stride" && i + 1 < argc)
+        {
+            ++i;
+            frame_stride = static_cast<uint32_t>(std::stoul(argv[i]));
+        }
+        else if (arg == "--coalesce-ms" && i + 1 < argc)
+        {
+            ++i;
+            coalesce_window_ms = static_cast<uint32_t>(std::stoul(argv[i]));
+        }
+        else if (arg == "--no-fd-cache")
+        {
+            fd_cache = false;
+        }
+        else if (arg == "--reconfigure" && i + 1 < argc)
+        {
+            ++i;
+            unsigned width = 0;
+            unsigned height = 0;
+            unsigned fps = 0;
+            if (std::sscanf(argv[i], "%ux%u@%u", &width, &height, &fps) < 2)
+            {
+                PlatformLogger::Log(LogLevel::kError, "subscriber",
+                                    "invalid reconfigure format: %s (use WxH[@FPS])", argv[i]);
+                return 1;
+            }
+            reconfigure_format.width = width;
+            reconfigure_format.height = height;
+            reconfigure_format.fps = fps;
+            reconfigure_pending = true;
+        }
+        else if (arg == "--camera-id" && i + 1 < argc)
+        {
+            ++i;
+            camera_id = static_cast<uint32_t>(std::stoul(argv[i]));
+        }
+        else if (arg == "--data-tcp" && i + 1 < argc)
+        {
+            ++i;
+            data_tcp_endpoint = argv[i];
+        }
         else if (arg == "--help" || arg == "-h")
         {
             PlatformLogger::Log(LogLevel::kInfo, "subscriber",
                                 "usage: %s [output_dir] [control_socket] [data_socket] "
-                                "[device_path] [--data-plane v1|v2] [--release-socket path] "
-                                "[--process-delay-ms N] [--release-delay-ms N]",
+                                "[device_path] [--data-plane v1|v2|shm|ring] "
+                                "[--release-socket path] "
+                                "[--process-delay-ms N] [--release-delay-ms N] "
+                                "[--target-fps N] [--frame-stride N] [--reconfigure WxH[@FPS]] "
+                                "[--camera-id N] [--data-tcp host:port]",
                                 argv[0]);
             return 0;
         }
@@ -320,13 +443,15 @@ int main(int argc, char* argv[])
     std::filesystem::create_directories(output_dir);
     const std::filesystem::path output_dir_path = std::filesystem::absolute(output_dir);
 
-    // 先连接数据面，确保订阅建立后可立即收帧
+    // 先连接数据面，确保订阅建立后可立即收帧；帧环在订阅后协商，失败时再连接 v1
     int data_fd = -1;
-    for (int retry = 0; retry < 50 && g_running.load(); ++retry)
+    for (int retry = 0; retry < 50 && g_running.load() &&
+                        data_plane_mode != DataPlaneMode::kShmRing;
+         ++retry)
     {
-        data_fd = data_plane_mode == DataPlaneMode::kV2DmaBuf
+        data_fd = data_plane_mode != DataPlaneMode::kV1Copy
                       ? ConnectUnixSocket(data_socket_path, SOCK_SEQPACKET)
-                      : ConnectDataSocket(data_socket_path);
+                      : ConnectDataSocket(data_socket_path, data_tcp_endpoint);
         if (data_fd >= 0)
         {
             break;
@@ -335,7 +460,7 @@ int main(int argc, char* argv[])
     }
 
     int release_fd = -1;
-    if (data_plane_mode == DataPlaneMode::kV2DmaBuf)
+    if (data_plane_mode == DataPlaneMode::kV2DmaBuf || data_plane_mode == DataPlaneMode::kV2Shm)
     {
         for (int retry = 0; retry < 50 && g_running.load(); ++retry)
         {
@@ -358,7 +483,7 @@ int main(int argc, char* argv[])
         }
     }
 
-    if (data_fd < 0)
+    if (data_fd < 0 && data_plane_mode != DataPlaneMode::kShmRing)
     {
         PlatformLogger::Log(LogLevel::kError, "subscriber",
                             "connect data socket failed: %s", data_socket_path.c_str());
@@ -372,7 +497,10 @@ int main(int argc, char* argv[])
         PlatformLogger::Log(LogLevel::kError, "subscriber",
                             "connect control socket failed: %s",
                             control_socket_path.c_str());
-        close(data_fd);
+        if (data_fd >= 0)
+        {
+            close(data_fd);
+        }
         if (release_fd >= 0)
         {
             close(release_fd);
@@ -383,19 +511,28 @@ int main(int argc, char* argv[])
 
     const std::string client_id = "camera_subscriber_" + std::to_string(getpid());
     const CameraEndpoint endpoint =
-        camera_subsystem::ipc::MakeCameraEndpoint(0,
+        camera_subsystem::ipc::MakeCameraEndpoint(camera_id,
                                                   camera_subsystem::ipc::CameraBusType::kDefault,
                                                   0,
                                                   device_path.c_str());
 
     CameraControlResponse response;
-    if (!control_client.Subscribe(client_id, CameraClientRole::kSubscriber, endpoint, &response))
+    const uint32_t data_plane_features =
+        data_plane_mode == DataPlaneMode::kV2DmaBuf && fd_cache
+            ? camera_subsystem::ipc::kCameraDataPlaneFeatureV2BufferCache
+            : 0;
+    if (!control_client.Subscribe(client_id, CameraClientRole::kSubscriber, endpoint, &response,
+                                  target_fps, frame_stride, coalesce_window_ms,
+                                  data_plane_features))
     {
         PlatformLogger::Log(LogLevel::kError, "subscriber",
                             "subscribe failed: status=%u msg=%s",
                             static_cast<uint32_t>(response.status), response.message);
         control_client.Disconnect();
-        close(data_fd);
+        if (data_fd >= 0)
+        {
+            close(data_fd);
+        }
         if (release_fd >= 0)
         {
             close(release_fd);
@@ -404,11 +541,43 @@ int main(int argc, char* argv[])
         return 1;
     }
 
+    // 帧环不可用（发布端非 v1 拷贝模式或消费者已满）时回退 v1 socket
+    CameraShmRingReader ring_reader;
+    auto open_ring_or_fallback = [&]()
+    {
+        CameraControlResponse ring_response;
+        std::memset(&ring_response, 0, sizeof(ring_response));
+        if (control_client.OpenShmRing(client_id, CameraClientRole::kSubscriber, endpoint,
+                                       &ring_reader, &ring_response))
+        {
+            PlatformLogger::Log(LogLevel::kInfo, "subscriber", "shm ring opened: consumer=%u",
+                                ring_response.shm_ring_consumer_index);
+            return true;
+        }
+        PlatformLogger::Log(LogLevel::kWarning, "subscriber",
+                            "shm ring unavailable (status=%u msg=%s), fall back to v1 socket",
+                            static_cast<uint32_t>(ring_response.status), ring_response.message);
+        data_plane_mode = DataPlaneMode::kV1Copy;
+        data_fd = ConnectDataSocket(data_socket_path, data_tcp_endpoint);
+        return data_fd >= 0;
+    };
+    if (data_plane_mode == DataPlaneMode::kShmRing && !open_ring_or_fallback())
+    {
+        PlatformLogger::Log(LogLevel::kError, "subscriber",
+                            "connect data socket failed: %s", data_socket_path.c_str());
+        control_client.Disconnect();
+        PlatformLogger::Shutdown();
+        return 1;
+    }
+
     PlatformLogger::Log(LogLevel::kInfo, "subscriber",
                         "subscriber started, client_id=%s, output_dir=%s, device=%s, "
                         "data_plane=%s, process_delay_ms=%u, release_delay_ms=%u",
                         client_id.c_str(), output_dir_path.c_str(), endpoint.device_path,
-                        data_plane_mode == DataPlaneMode::kV2DmaBuf ? "v2" : "v1",
+                        data_plane_mode == DataPlaneMode::kShmRing   ? "ring"
+                        : data_plane_mode == DataPlaneMode::kV2Shm   ? "shm"
+                        : data_plane_mode == DataPlaneMode::kV2DmaBuf ? "v2"
+                                                                      : "v1",
                         process_delay_ms, release_delay_ms);
     PlatformLogger::Log(LogLevel::kInfo, "subscriber",
                         "sec | frames | fps | received_bytes | save_fail | image");
@@ -423,19 +592,95 @@ int main(int argc, char* argv[])
     uint64_t elapsed_sec = 0;
     uint64_t last_frames = 0;
 
+    // 流代数变化说明发布端已热切换，尺寸与 buffer 布局以新帧为准
+    uint32_t stream_generation = 0;
+    bool seen_frame = false;
+    auto note_stream_generation = [&](uint32_t generation, uint32_t width, uint32_t height)
+    {
+        if (seen_frame && generation != stream_generation)
+        {
+            PlatformLogger::Log(LogLevel::kInfo, "subscriber",
+                                "stream reconfigured: generation %u -> %u, now %ux%u",
+                                stream_generation, generation, width, height);
+        }
+        seen_frame = true;
+        stream_generation = generation;
+    };
+
+    // shm 数据面：announce 时只读映射整个池，之后的槽位帧直接按偏移读取
+    const uint8_t* shm_pool = nullptr;
+    size_t shm_pool_bytes = 0;
+    CameraDataV2BufferCache buffer_cache;
+
+    // 帧环原地读取，只在每秒保存快照前拷出一帧
+    bool snapshot_wanted = true;
+
     auto next_report_time = std::chrono::steady_clock::now() + std::chrono::seconds(1);
 
     while (g_running.load())
     {
         pollfd pfd;
-        pfd.fd = data_fd;
+        pfd.fd = data_plane_mode == DataPlaneMode::kShmRing ? ring_reader.GetEventFd() : data_fd;
         pfd.events = POLLIN;
         pfd.revents = 0;
 
         const int poll_ret = poll(&pfd, 1, 200);
         if (poll_ret > 0 && (pfd.revents & POLLIN))
         {
-            if (data_plane_mode == DataPlaneMode::kV2DmaBuf)
+            if (data_plane_mode == DataPlaneMode::kShmRing)
+            {
+                uint64_t notifications = 0;
+                (void)!read(ring_reader.GetEventFd(), &notifications, sizeof(notifications));
+
+                CameraShmRingReader::Frame frame;
+                CameraShmRingReader::Result result = CameraShmRingReader::Result::kEmpty;
+                while ((result = ring_reader.Acquire(&frame)) ==
+                       CameraShmRingReader::Result::kFrame)
+                {
+                    note_stream_generation(frame.header->stream_generation, frame.header->width,
+                                           frame.header->height);
+                    if (snapshot_wanted)
+                    {
+                        std::lock_guard<std::mutex> lock(snapshot_mutex);
+                        latest_snapshot.data.assign(frame.data, frame.data + frame.size);
+                        latest_snapshot.width = frame.header->width;
+                        latest_snapshot.height = frame.header->height;
+                        latest_snapshot.format =
+                            static_cast<PixelFormat>(frame.header->pixel_format);
+                        snapshot_wanted = false;
+                    }
+                    ++total_frames;
+                    total_bytes += frame.size;
+
+                    // 模拟上层在槽位内原地处理，处理期间该槽位不会被覆盖
+                    if (process_delay_ms > 0)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(process_delay_ms));
+                    }
+                    ring_reader.Release();
+                }
+
+                if (result == CameraShmRingReader::Result::kClosed)
+                {
+                    // 发布端废弃了环（如热切换到更大分辨率），重新协商
+                    PlatformLogger::Log(LogLevel::kInfo, "subscriber",
+                                        "shm ring closed by publisher, reopening (overruns=%" PRIu64
+                                        ")",
+                                        ring_reader.GetOverruns());
+                    ring_reader.Close();
+                    if (!open_ring_or_fallback())
+                    {
+                        break;
+                    }
+                }
+                else if (result == CameraShmRingReader::Result::kError)
+                {
+                    break;
+                }
+                continue;
+            }
+
+            if (data_plane_mode != DataPlaneMode::kV1Copy)
             {
                 CameraDataFrameDescriptorV2 descriptor;
                 int fds[camera_subsystem::ipc::kCameraDataV2MaxFds] = {-1, -1, -1};
@@ -452,29 +697,100 @@ int main(int argc, char* argv[])
                     break;
                 }
 
+                if ((descriptor.flags & camera_subsystem::ipc::kCameraDataV2FlagShmPoolAnnounce) != 0)
+                {
+                    const size_t pool_bytes = static_cast<size_t>(descriptor.planes[0].length);
+                    void* mapped = received_fd_count > 0
+                                       ? mmap(nullptr, pool_bytes, PROT_READ, MAP_SHARED, fds[0], 0)
+                                       : MAP_FAILED;
+                    for (uint32_t i = 0; i < received_fd_count; ++i)
+                    {
+                        close(fds[i]);
+                    }
+                    if (mapped == MAP_FAILED)
+                    {
+                        PlatformLogger::Log(LogLevel::kWarning, "subscriber",
+                                            "shm pool mmap failed: bytes=%zu err=%s", pool_bytes,
+                                            std::strerror(errno));
+                        continue;
+                    }
+                    if (shm_pool != nullptr)
+                    {
+                        munmap(const_cast<uint8_t*>(shm_pool), shm_pool_bytes);
+                    }
+                    shm_pool = static_cast<const uint8_t*>(mapped);
+                    shm_pool_bytes = pool_bytes;
+                    PlatformLogger::Log(LogLevel::kInfo, "subscriber",
+                                        "shm pool mapped: slots=%u stride=%u bytes=%zu",
+                                        descriptor.buffer_id, descriptor.planes[0].stride,
+                                        pool_bytes);
+                    continue;
+                }
+
+                note_stream_generation(descriptor.stream_generation, descriptor.width,
+                                       descriptor.height);
                 CameraReleaseStatus release_status = CameraReleaseStatus::kOk;
                 std::vector<uint8_t> frame_buffer;
                 const uint32_t fd_index = descriptor.planes[0].fd_index;
-                const int frame_fd = fd_index < received_fd_count ? fds[fd_index] : -1;
-                const size_t bytes_used = static_cast<size_t>(descriptor.planes[0].bytes_used);
+                int frame_fd = fd_index < received_fd_count ? fds[fd_index] : -1;
+                size_t bytes_used = static_cast<size_t>(descriptor.planes[0].bytes_used);
+                const uint8_t* cached_frame = nullptr;
+                if (CameraDataV2BufferCache::Handles(descriptor))
+                {
+                    // 注册帧的 fd 由缓存接管并常驻映射，本帧结束时不关闭
+                    const CameraDataV2BufferCache::Buffer* buffer =
+                        buffer_cache.Resolve(descriptor, fds, received_fd_count);
+                    received_fd_count = 0;
+                    frame_fd = buffer != nullptr && fd_index < buffer->fd_count
+                                   ? buffer->fds[fd_index]
+                                   : -1;
+                    const size_t offset = static_cast<size_t>(descriptor.planes[0].offset);
+                    if (frame_fd >= 0 && buffer->mapped[fd_index] != nullptr &&
+                        offset + bytes_used <= buffer->mapped_bytes[fd_index])
+                    {
+                        cached_frame = buffer->mapped[fd_index] + offset;
+                    }
+                }
 
-                if (frame_fd >= 0 && bytes_used > 0 && bytes_used <= 64U * 1024U * 1024U)
+                if (camera_subsystem::ipc::IsCameraShmSlotDescriptorV2(descriptor))
+                {
+                    // 槽位内各 plane 连续存放，整体拷出用于快照
+                    const size_t offset = static_cast<size_t>(descriptor.planes[0].offset);
+                    bytes_used = static_cast<size_t>(descriptor.total_bytes_used);
+                    if (shm_pool != nullptr && offset + bytes_used <= shm_pool_bytes)
+                    {
+                        frame_buffer.assign(shm_pool + offset, shm_pool + offset + bytes_used);
+                    }
+                    else
+                    {
+                        release_status = CameraReleaseStatus::kError;
+                    }
+                }
+                else if (frame_fd >= 0 && bytes_used > 0 && bytes_used <= 64U * 1024U * 1024U)
                 {
                     if (!DmaBufSyncHelper::StartCpuAccess(frame_fd, DmaBufSyncDirection::kRead))
                     {
                         release_status = CameraReleaseStatus::kError;
                     }
 
-                    void* mapped = mmap(nullptr, bytes_used, PROT_READ, MAP_SHARED, frame_fd, 0);
-                    if (mapped == MAP_FAILED)
+                    if (cached_frame != nullptr)
                     {
-                        release_status = CameraReleaseStatus::kError;
+                        frame_buffer.assign(cached_frame, cached_frame + bytes_used);
                     }
                     else
                     {
-                        const auto* begin = static_cast<const uint8_t*>(mapped);
-                        frame_buffer.assign(begin, begin + bytes_used);
-                        munmap(mapped, bytes_used);
+                        void* mapped =
+                            mmap(nullptr, bytes_used, PROT_READ, MAP_SHARED, frame_fd, 0);
+                        if (mapped == MAP_FAILED)
+                        {
+                            release_status = CameraReleaseStatus::kError;
+                        }
+                        else
+                        {
+                            const auto* begin = static_cast<const uint8_t*>(mapped);
+                            frame_buffer.assign(begin, begin + bytes_used);
+                            munmap(mapped, bytes_used);
+                        }
                     }
 
                     if (!DmaBufSyncHelper::EndCpuAccess(frame_fd, DmaBufSyncDirection::kRead))
@@ -549,6 +865,7 @@ int main(int argc, char* argv[])
                     break;
                 }
 
+                note_stream_generation(header.stream_generation, header.width, header.height);
                 if (header.frame_size > 64U * 1024U * 1024U)
                 {
                     PlatformLogger::Log(LogLevel::kWarning, "subscriber",
@@ -603,6 +920,7 @@ int main(int argc, char* argv[])
 
             uint64_t image_slot = 0;
             std::string image_info = "none";
+            snapshot_wanted = true;
             if (elapsed_sec > 0)
             {
                 image_slot = (elapsed_sec - 1) % 10;
@@ -635,21 +953,69 @@ int main(int argc, char* argv[])
                                 release_fail_count, image_info.c_str());
 
             next_report_time += std::chrono::seconds(1);
+
+            if (reconfigure_pending)
+            {
+                // 切换期间发布端会停流并等待在途帧，请求放到独立线程与连接上，主循环继续收帧
+                reconfigure_pending = false;
+                reconfigure_thread = std::thread(
+                    [&, control_socket_path]()
+                    {
+                        CameraControlClient reconfigure_client;
+                        CameraControlResponse reconfigure_response;
+                        std::memset(&reconfigure_response, 0, sizeof(reconfigure_response));
+                        const auto begin = std::chrono::steady_clock::now();
+                        const bool ok =
+                            reconfigure_client.Connect(control_socket_path) &&
+                            reconfigure_client.Reconfigure(client_id, CameraClientRole::kSubscriber,
+                                                           endpoint, reconfigure_format,
+                                                           &reconfigure_response);
+                        const double elapsed_ms = std::chrono::duration<double, std::milli>(
+                                                      std::chrono::steady_clock::now() - begin)
+                                                      .count();
+                        PlatformLogger::Log(ok ? LogLevel::kInfo : LogLevel::kWarning,
+                                            "subscriber",
+                                            "reconfigure to %ux%u fps=%u %s in %.2f ms: "
+                                            "status=%u msg=%s",
+                                            reconfigure_format.width, reconfigure_format.height,
+                                            reconfigure_format.fps, ok ? "done" : "failed",
+                                            elapsed_ms,
+                                            static_cast<uint32_t>(reconfigure_response.status),
+                                            reconfigure_response.message);
+                    });
+            }
         }
     }
 
+    if (reconfigure_thread.joinable())
+    {
+        reconfigure_thread.join();
+    }
     (void)control_client.Unsubscribe(client_id, CameraClientRole::kSubscriber, endpoint, &response);
     control_client.Disconnect();
-    close(data_fd);
+    ring_reader.Close();
+    if (data_fd >= 0)
+    {
+        close(data_fd);
+    }
     if (release_fd >= 0)
     {
         close(release_fd);
     }
+    if (shm_pool != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(shm_pool), shm_pool_bytes);
+    }
+    const CameraDataV2BufferCache::Stats cache_stats = buffer_cache.GetStats();
+    buffer_cache.Clear();
 
     PlatformLogger::Log(LogLevel::kInfo, "subscriber",
                         "summary: frames=%" PRIu64 " received_bytes=%" PRIu64
-                        " save_fail=%" PRIu64 " release_fail=%" PRIu64,
-                        total_frames, total_bytes, save_fail_count, release_fail_count);
+                        " save_fail=%" PRIu64 " release_fail=%" PRIu64
+                        " fd_cache_registered=%" PRIu64 " fd_cache_hits=%" PRIu64
+                        " fd_cache_misses=%" PRIu64,
+                        total_frames, total_bytes, save_fail_count, release_fail_count,
+                        cache_stats.registrations, cache_stats.hits, cache_stats.misses);
     PlatformLogger::Shutdown();
     return 0;
 }
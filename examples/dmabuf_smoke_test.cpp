@@ -186,6 +186,18 @@ int main(int argc, char* argv[])
     std::printf("sync_end_fail=%" PRIu64 "\n", stats.sync_end_fail.load());
     std::printf("checksum_xor=%" PRIu64 "\n", stats.checksum.load());
 
+    const auto latency = source.GetCaptureLatencyStats();
+    std::printf("driver_ts_frames=%" PRIu64 "\n", latency.driver_timestamp_frames);
+    std::printf("fallback_ts_frames=%" PRIu64 "\n", latency.fallback_timestamp_frames);
+    std::printf("driver_to_dequeue_p50_us=%" PRIu64 "\n", latency.driver_to_dequeue.p50_ns / 1000);
+    std::printf("driver_to_dequeue_p99_us=%" PRIu64 "\n", latency.driver_to_dequeue.p99_ns / 1000);
+    std::printf("dequeue_to_callback_p50_us=%" PRIu64 "\n",
+                latency.dequeue_to_callback.p50_ns / 1000);
+    std::printf("dequeue_to_callback_p99_us=%" PRIu64 "\n",
+                latency.dequeue_to_callback.p99_ns / 1000);
+    std::printf("driver_to_callback_p99_us=%" PRIu64 "\n",
+                latency.driver_to_callback.p99_ns / 1000);
+
     PlatformLogger::Shutdown();
     return ok ? 0 : 1;
 }
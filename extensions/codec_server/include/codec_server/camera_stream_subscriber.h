@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "camera_subsystem/ipc/camera_data_ipc.h"
+#include "camera_subsystem/ipc/camera_shm_ring.h"
 
 namespace camera_subsystem::extensions::codec_server {
 
@@ -20,8 +21,11 @@ struct CameraStreamSubscriberConfig
     std::string client_id = "camera_codec_server";
     uint32_t camera_id = 0;
     uint32_t max_frame_size = 64U * 1024U * 1024U;
+    bool use_shm_ring = true; // 优先经控制面申请共享内存帧环，不可用时回退数据面 socket
+    // data 仅在回调期间有效：帧环模式下指向共享内存槽位，回调返回后槽位才可被覆盖
     std::function<void(const camera_subsystem::ipc::CameraDataFrameHeader&,
-                       const std::vector<uint8_t>&)> frame_callback;
+                       const uint8_t* data,
+                       size_t size)> frame_callback;
 };
 
 struct CameraStreamSubscriberStats
@@ -30,6 +34,8 @@ struct CameraStreamSubscriberStats
     uint64_t input_bytes = 0;
     uint64_t read_failures = 0;
     uint64_t invalid_frames = 0;
+    bool shm_ring = false;
+    uint64_t ring_overruns = 0;
 };
 
 class CameraStreamSubscriber
@@ -50,6 +56,9 @@ private:
     bool ConnectDataSocket();
     bool ConnectControlSocket();
     bool SendControlRequest(uint32_t command);
+    bool OpenShmRing();
+    bool ReadRingFrames();
+    bool ReadSocketFrame();
     void ReadLoop();
     bool ReadFull(int fd, void* buffer, size_t length);
 
@@ -59,11 +68,15 @@ private:
     std::atomic<bool> is_running_{false};
     std::atomic<bool> is_subscribed_{false};
     std::thread reader_thread_;
+    camera_subsystem::ipc::CameraShmRingReader ring_reader_;
+    std::vector<uint8_t> payload_;
 
     std::atomic<uint64_t> input_frames_{0};
     std::atomic<uint64_t> input_bytes_{0};
     std::atomic<uint64_t> read_failures_{0};
     std::atomic<uint64_t> invalid_frames_{0};
+    std::atomic<bool> shm_ring_{false};
+    std::atomic<uint64_t> ring_overruns_{0};
 };
 
 } // namespace camera_subsystem::extensions::codec_server
@@ -39,7 +39,8 @@ private:
     CodecControlStatus BuildStatusLocked(const CodecControlRequest& request,
                                          const std::string& error) const;
     void HandleInputFrame(const camera_subsystem::ipc::CameraDataFrameHeader& header,
-                          const std::vector<uint8_t>& payload);
+                          const uint8_t* data,
+                          size_t size);
     H264EncoderConfig BuildEncoderConfig(const DecodedImageFrame& frame) const;
     static std::string MapWriterError(WriterResult result);
 
@@ -78,7 +78,11 @@ bool CameraStreamSubscriber::Start(const CameraStreamSubscriberConfig& config)
     invalid_frames_.store(0);
     is_subscribed_.store(false);
 
-    if (!ConnectDataSocket())
+    shm_ring_.store(false);
+    ring_overruns_.store(0);
+
+    // 帧环在订阅之后协商；不使用帧环时先连接数据面，订阅建立后即可收帧
+    if (!config_.use_shm_ring && !ConnectDataSocket())
     {
         return false;
     }
@@ -94,6 +98,11 @@ bool CameraStreamSubscriber::Start(const CameraStreamSubscriberConfig& config)
         return false;
     }
     is_subscribed_.store(true);
+    if (config_.use_shm_ring && !OpenShmRing() && !ConnectDataSocket())
+    {
+        Stop();
+        return false;
+    }
 
     is_running_.store(true);
     reader_thread_ = std::thread(&CameraStreamSubscriber::ReadLoop, this);
@@ -107,15 +116,18 @@ void CameraStreamSubscriber::Stop()
     {
         shutdown(data_fd_, SHUT_RDWR);
     }
+    // 读线程可能在帧环废弃后经控制连接重新协商，先等它退出再退订
+    if (reader_thread_.joinable())
+    {
+        reader_thread_.join();
+    }
     if (is_subscribed_.exchange(false) && control_fd_ >= 0)
     {
         (void)SendControlRequest(
             static_cast<uint32_t>(camera_subsystem::ipc::CameraControlCommand::kUnsubscribe));
     }
-    if (reader_thread_.joinable())
-    {
-        reader_thread_.join();
-    }
+    ring_reader_.Close();
+    shm_ring_.store(false);
     if (data_fd_ >= 0)
     {
         close(data_fd_);
@@ -140,6 +152,8 @@ CameraStreamSubscriberStats CameraStreamSubscriber::GetStats() const
     stats.input_bytes = input_bytes_.load();
     stats.read_failures = read_failures_.load();
     stats.invalid_frames = invalid_frames_.load();
+    stats.shm_ring = shm_ring_.load();
+    stats.ring_overruns = ring_overruns_.load();
     return stats;
 }
 
@@ -188,44 +202,114 @@ bool CameraStreamSubscriber::SendControlRequest(uint32_t command)
            response.status == CameraControlStatus::kOk;
 }
 
-void CameraStreamSubscriber::ReadLoop()
+bool CameraStreamSubscriber::OpenShmRing()
 {
     using namespace camera_subsystem::ipc;
 
-    while (is_running_.load())
+    const CameraEndpoint endpoint =
+        MakeCameraEndpoint(config_.camera_id,
+                           CameraBusType::kDefault,
+                           0,
+                           config_.device_path.c_str());
+    CameraControlResponse response;
+    int memfd = -1;
+    int eventfd = -1;
+    const bool ok = RequestCameraShmRing(control_fd_, endpoint, config_.client_id.c_str(),
+                                         CameraClientRole::kSubscriber, &response, &memfd,
+                                         &eventfd) &&
+                    ring_reader_.Open(memfd, eventfd, response.shm_ring_consumer_index);
+    shm_ring_.store(ok);
+    return ok;
+}
+
+bool CameraStreamSubscriber::ReadRingFrames()
+{
+    using namespace camera_subsystem::ipc;
+
+    if (!ring_reader_.WaitReadable(200))
+    {
+        return true;
+    }
+
+    // 录像需要每一帧：按序读取，落后时由读取器跳帧并计数
+    CameraShmRingReader::Frame frame;
+    CameraShmRingReader::Result result = CameraShmRingReader::Result::kEmpty;
+    while (is_running_.load() &&
+           (result = ring_reader_.Acquire(&frame)) == CameraShmRingReader::Result::kFrame)
     {
-        CameraDataFrameHeader header;
-        if (!ReadFull(data_fd_, &header, sizeof(header)))
+        if (frame.size > config_.max_frame_size)
         {
-            if (is_running_.load())
-            {
-                read_failures_.fetch_add(1);
-            }
-            break;
+            invalid_frames_.fetch_add(1);
+            continue;
         }
+        input_frames_.fetch_add(1);
+        input_bytes_.fetch_add(frame.size);
+        if (config_.frame_callback)
+        {
+            config_.frame_callback(*frame.header, frame.data, frame.size);
+        }
+    }
+    ring_reader_.Release();
+    ring_overruns_.store(ring_reader_.GetOverruns());
+
+    if (result == CameraShmRingReader::Result::kClosed)
+    {
+        // 发布端废弃了环（如热切换到更大分辨率）：重新协商，失败时回退数据面 socket
+        ring_reader_.Close();
+        return OpenShmRing() || ConnectDataSocket();
+    }
+    return result != CameraShmRingReader::Result::kError;
+}
+
+bool CameraStreamSubscriber::ReadSocketFrame()
+{
+    using namespace camera_subsystem::ipc;
 
-        if (!IsCameraDataFrameHeaderValid(header) ||
-            header.frame_size > config_.max_frame_size)
+    CameraDataFrameHeader header;
+    if (!ReadFull(data_fd_, &header, sizeof(header)))
+    {
+        if (is_running_.load())
         {
-            invalid_frames_.fetch_add(1);
-            break;
+            read_failures_.fetch_add(1);
         }
+        return false;
+    }
+
+    if (!IsCameraDataFrameHeaderValid(header) ||
+        header.frame_size > config_.max_frame_size)
+    {
+        invalid_frames_.fetch_add(1);
+        return false;
+    }
 
-        std::vector<uint8_t> payload(header.frame_size);
-        if (!ReadFull(data_fd_, payload.data(), payload.size()))
+    // 复用接收缓冲，避免每帧分配
+    payload_.resize(header.frame_size);
+    if (!ReadFull(data_fd_, payload_.data(), payload_.size()))
+    {
+        if (is_running_.load())
         {
-            if (is_running_.load())
-            {
-                read_failures_.fetch_add(1);
-            }
-            break;
+            read_failures_.fetch_add(1);
         }
+        return false;
+    }
 
-        input_frames_.fetch_add(1);
-        input_bytes_.fetch_add(header.frame_size);
-        if (config_.frame_callback)
+    input_frames_.fetch_add(1);
+    input_bytes_.fetch_add(header.frame_size);
+    if (config_.frame_callback)
+    {
+        config_.frame_callback(header, payload_.data(), payload_.size());
+    }
+    return true;
+}
+
+void CameraStreamSubscriber::ReadLoop()
+{
+    while (is_running_.load())
+    {
+        const bool ok = ring_reader_.IsOpen() ? ReadRingFrames() : ReadSocketFrame();
+        if (!ok)
         {
-            config_.frame_callback(header, payload);
+            break;
         }
     }
     is_running_.store(false);
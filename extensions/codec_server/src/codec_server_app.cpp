@@ -32,6 +32,7 @@ CodecServerApp::CodecServerApp(CodecServerConfig config)
               "camera_codec_server",
               0,
               64U * 1024U * 1024U,
+              true,
               nullptr},
           true,
           config_.fps,
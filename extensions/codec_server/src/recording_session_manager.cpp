@@ -51,8 +51,9 @@ CodecControlStatus RecordingSessionManager::StartRecording(
         subscriber_config.client_id = "camera_codec_server_" + request.stream_id;
         subscriber_config.frame_callback =
             [this](const camera_subsystem::ipc::CameraDataFrameHeader& header,
-                   const std::vector<uint8_t>& payload) {
-                HandleInputFrame(header, payload);
+                   const uint8_t* data,
+                   size_t size) {
+                HandleInputFrame(header, data, size);
             };
         if (!subscriber_.Start(subscriber_config))
         {
@@ -137,7 +138,8 @@ CodecControlStatus RecordingSessionManager::BuildStatusLocked(
 
 void RecordingSessionManager::HandleInputFrame(
     const camera_subsystem::ipc::CameraDataFrameHeader& header,
-    const std::vector<uint8_t>& payload)
+    const uint8_t* data,
+    size_t size)
 {
     (void)header;
 
@@ -145,7 +147,7 @@ void RecordingSessionManager::HandleInputFrame(
 
     DecodedImageFrame decoded;
     const JpegDecodeResult decode_result =
-        jpeg_decoder_.Decode(payload.data(), payload.size(), &decoded);
+        jpeg_decoder_.Decode(data, size, &decoded);
     if (decode_result == JpegDecodeResult::kOk)
     {
         decoded_frames_.fetch_add(1);
@@ -11,19 +11,22 @@
 #include <vector>
 
 #include "camera_subsystem/ipc/camera_data_ipc.h"
+#include "camera_subsystem/ipc/camera_shm_ring.h"
 
 namespace web_preview {
 
+// 帧视图：data 仅在回调期间有效，帧环模式下直接指向共享内存槽位
 struct CameraFrame
 {
     camera_subsystem::ipc::CameraDataFrameHeader header{};
-    std::vector<uint8_t> payload;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
 };
 
 class CameraSubscriberClient
 {
 public:
-    using FrameCallback = std::function<void(CameraFrame&&)>;
+    using FrameCallback = std::function<void(const CameraFrame&)>;
     using StatusCallback = std::function<void(const std::string&)>;
 
     CameraSubscriberClient();
@@ -40,6 +43,9 @@ private:
     bool ConnectData();
     bool Subscribe();
     void Unsubscribe();
+    bool OpenShmRing();
+    bool ReadRingFrame();
+    bool ReadSocketFrame();
     void ReadLoop();
 
     bool SendControlRequest(uint32_t command, std::string* message);
@@ -54,6 +60,8 @@ private:
     int control_fd_;
     int data_fd_;
     std::thread read_thread_;
+    camera_subsystem::ipc::CameraShmRingReader ring_reader_;
+    std::vector<uint8_t> payload_;
 };
 
 } // namespace web_preview
@@ -36,7 +36,7 @@ public:
     void SetMaxFps(uint32_t max_fps);
     void SetPacketCallback(PacketCallback callback);
     void SetStatusCallback(StatusCallback callback);
-    void SubmitFrame(CameraFrame&& frame);
+    void SubmitFrame(const CameraFrame& frame);
     StreamStats GetStats() const;
 
 private:
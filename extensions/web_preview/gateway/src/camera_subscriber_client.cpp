@@ -51,19 +51,20 @@ bool CameraSubscriberClient::Start(const GatewayConfig& config,
     frame_callback_ = std::move(frame_callback);
     status_callback_ = std::move(status_callback);
 
-    if (!ConnectData())
+    if (!ConnectControl())
     {
         return false;
     }
-    if (!ConnectControl())
+    if (!Subscribe())
     {
-        CloseFd(&data_fd_);
+        CloseFd(&control_fd_);
         return false;
     }
-    if (!Subscribe())
+    // 本机发布端提供共享内存帧环时原地读取，否则回退数据面 socket
+    if (!OpenShmRing() && !ConnectData())
     {
+        Unsubscribe();
         CloseFd(&control_fd_);
-        CloseFd(&data_fd_);
         return false;
     }
 
@@ -76,17 +77,22 @@ void CameraSubscriberClient::Stop()
 {
     const bool was_running = running_.exchange(false);
 
-    if (was_running)
+    if (data_fd_ >= 0)
     {
-        Unsubscribe();
+        shutdown(data_fd_, SHUT_RDWR);
     }
-    CloseFd(&control_fd_);
-    CloseFd(&data_fd_);
-
+    // 读线程可能在帧环废弃后经控制连接重新协商，先等它退出再退订
     if (read_thread_.joinable())
     {
         read_thread_.join();
     }
+    if (was_running)
+    {
+        Unsubscribe();
+    }
+    ring_reader_.Close();
+    CloseFd(&control_fd_);
+    CloseFd(&data_fd_);
 }
 
 bool CameraSubscriberClient::IsRunning() const
@@ -185,11 +191,13 @@ bool CameraSubscriberClient::SendControlRequest(uint32_t command, std::string* m
                                                        CameraBusType::kDefault,
                                                        0,
                                                        config_.device_path.c_str());
-    const CameraControlRequest request = MakeControlRequest(
+    CameraControlRequest request = MakeControlRequest(
         static_cast<CameraControlCommand>(command),
         CameraClientRole::kSubscriber,
         endpoint,
         config_.client_id.c_str());
+    // 让发布端按预览帧率抽帧，省掉注定被 FramePipeline 限速丢弃的帧的传输与拷贝
+    request.target_fps = config_.max_preview_fps;
 
     if (!WriteFull(control_fd_, &request, sizeof(request)))
     {
@@ -218,46 +226,114 @@ bool CameraSubscriberClient::SendControlRequest(uint32_t command, std::string* m
     return IsControlResponseHeaderValid(response) && response.status == CameraControlStatus::kOk;
 }
 
-void CameraSubscriberClient::ReadLoop()
+bool CameraSubscriberClient::OpenShmRing()
 {
-    while (running_.load())
+    using namespace camera_subsystem::ipc;
+
+    const CameraEndpoint endpoint = MakeCameraEndpoint(config_.camera_id,
+                                                       CameraBusType::kDefault,
+                                                       0,
+                                                       config_.device_path.c_str());
+    CameraControlResponse response;
+    int memfd = -1;
+    int eventfd = -1;
+    const bool ok = RequestCameraShmRing(control_fd_, endpoint, config_.client_id.c_str(),
+                                         CameraClientRole::kSubscriber, &response, &memfd,
+                                         &eventfd) &&
+                    ring_reader_.Open(memfd, eventfd, response.shm_ring_consumer_index);
+    if (status_callback_)
+    {
+        status_callback_(ok ? "shm_ring_opened" : "shm_ring_unavailable");
+    }
+    return ok;
+}
+
+bool CameraSubscriberClient::ReadRingFrame()
+{
+    using camera_subsystem::ipc::CameraShmRingReader;
+
+    if (!ring_reader_.WaitReadable(200))
+    {
+        return true;
+    }
+
+    // 预览只关心最新画面，积压的帧直接跳过
+    CameraShmRingReader::Frame ring_frame;
+    const CameraShmRingReader::Result result = ring_reader_.Acquire(&ring_frame, true);
+    if (result == CameraShmRingReader::Result::kFrame)
     {
-        camera_subsystem::ipc::CameraDataFrameHeader header;
-        if (!ReadFull(data_fd_, &header, sizeof(header)))
+        if (ring_frame.size <= kMaxFrameSize && frame_callback_)
         {
-            if (running_.load() && status_callback_)
-            {
-                status_callback_("data_channel_closed");
-            }
-            break;
+            CameraFrame frame;
+            frame.header = *ring_frame.header;
+            frame.data = ring_frame.data;
+            frame.size = ring_frame.size;
+            frame_callback_(frame);
         }
+        ring_reader_.Release();
+        return true;
+    }
+    if (result == CameraShmRingReader::Result::kClosed)
+    {
+        // 发布端废弃了环（如热切换到更大分辨率）：重新协商，失败时回退数据面 socket
+        ring_reader_.Close();
+        return OpenShmRing() || ConnectData();
+    }
+    return result != CameraShmRingReader::Result::kError;
+}
 
-        if (!camera_subsystem::ipc::IsCameraDataFrameHeaderValid(header) ||
-            header.frame_size > kMaxFrameSize)
+bool CameraSubscriberClient::ReadSocketFrame()
+{
+    camera_subsystem::ipc::CameraDataFrameHeader header;
+    if (!ReadFull(data_fd_, &header, sizeof(header)))
+    {
+        if (running_.load() && status_callback_)
         {
-            if (status_callback_)
-            {
-                status_callback_("invalid_frame_header");
-            }
-            break;
+            status_callback_("data_channel_closed");
         }
+        return false;
+    }
 
-        CameraFrame frame;
-        frame.header = header;
-        frame.payload.resize(header.frame_size);
+    if (!camera_subsystem::ipc::IsCameraDataFrameHeaderValid(header) ||
+        header.frame_size > kMaxFrameSize)
+    {
+        if (status_callback_)
+        {
+            status_callback_("invalid_frame_header");
+        }
+        return false;
+    }
 
-        if (!ReadFull(data_fd_, frame.payload.data(), frame.payload.size()))
+    // 复用接收缓冲，避免每帧分配
+    payload_.resize(header.frame_size);
+    if (!ReadFull(data_fd_, payload_.data(), payload_.size()))
+    {
+        if (running_.load() && status_callback_)
         {
-            if (running_.load() && status_callback_)
-            {
-                status_callback_("data_payload_read_failed");
-            }
-            break;
+            status_callback_("data_payload_read_failed");
         }
+        return false;
+    }
+
+    if (frame_callback_)
+    {
+        CameraFrame frame;
+        frame.header = header;
+        frame.data = payload_.data();
+        frame.size = payload_.size();
+        frame_callback_(frame);
+    }
+    return true;
+}
 
-        if (frame_callback_)
+void CameraSubscriberClient::ReadLoop()
+{
+    while (running_.load())
+    {
+        const bool ok = ring_reader_.IsOpen() ? ReadRingFrame() : ReadSocketFrame();
+        if (!ok)
         {
-            frame_callback_(std::move(frame));
+            break;
         }
     }
 
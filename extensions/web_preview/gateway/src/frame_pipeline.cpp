@@ -30,7 +30,7 @@ void FramePipeline::SetStatusCallback(StatusCallback callback)
     status_callback_ = std::move(callback);
 }
 
-void FramePipeline::SubmitFrame(CameraFrame&& frame)
+void FramePipeline::SubmitFrame(const CameraFrame& frame)
 {
     PacketCallback packet_callback;
     StatusCallback status_callback;
@@ -74,10 +74,9 @@ void FramePipeline::SubmitFrame(CameraFrame&& frame)
             web_header.payload_size = frame.header.frame_size;
             web_header.transform_flags = kTransformNone;
 
-            packet.resize(sizeof(web_header) + frame.payload.size());
+            packet.resize(sizeof(web_header) + frame.size);
             std::memcpy(packet.data(), &web_header, sizeof(web_header));
-            std::memcpy(packet.data() + sizeof(web_header), frame.payload.data(),
-                        frame.payload.size());
+            std::memcpy(packet.data() + sizeof(web_header), frame.data, frame.size);
 
             ++stats_.published_frames;
             stats_.status = "streaming";
@@ -131,7 +130,8 @@ bool FramePipeline::ShouldPublishNow()
         return true;
     }
     const auto min_interval = std::chrono::milliseconds(1000 / (max_fps_ == 0 ? 1 : max_fps_));
-    return now - last_publish_time_ >= min_interval;
+    // 发布端已按 max_fps 抽帧，到达间隔只会因调度抖动略短于 min_interval，留 1/8 余量
+    return now - last_publish_time_ >= min_interval - min_interval / 8;
 }
 
 } // namespace web_preview
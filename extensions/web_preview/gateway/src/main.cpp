@@ -48,8 +48,8 @@ int main(int argc, char* argv[])
     });
 
     web_preview::CameraSubscriberClient camera_client;
-    auto frame_callback = [&pipeline](web_preview::CameraFrame&& frame) {
-        pipeline.SubmitFrame(std::move(frame));
+    auto frame_callback = [&pipeline](const web_preview::CameraFrame& frame) {
+        pipeline.SubmitFrame(frame);
     };
     auto status_callback = [](const std::string& status) {
         std::cerr << "camera status: " << status << "\n";
@@ -9,16 +9,20 @@
 #define CAMERA_SUBSYSTEM_BROKER_FRAME_BROKER_H
 
 #include "camera_subsystem/broker/frame_subscriber.h"
+#include "camera_subsystem/core/bounded_mpmc_ring.h"
 #include "camera_subsystem/core/buffer_guard.h"
 #include "camera_subsystem/core/frame_handle.h"
 #include "camera_subsystem/core/types.h"
+#include "camera_subsystem/platform/platform_thread.h"
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -30,10 +34,86 @@ namespace broker {
  *
  * 负责管理订阅者，并将帧数据分发给订阅者。
  * 支持多线程调度与优先级队列。
+ *
+ * 两种分发模式：
+ * - kSharedQueue：所有订阅者共享一个加锁优先级队列（默认，兼容旧行为）。
+ * - kPerSubscriberRing：每个订阅者独占一个有界无锁环形队列，PublishFrame
+ *   不再获取全局队列锁；有帧待处理的订阅者作为调度单元放入 Worker 的就绪队列，
+ *   Worker 优先处理本地队列中优先级最高的订阅者，空闲时从同组其他 Worker 窃取。
+ *
+ * Worker 线程基于 platform::PlatformThread。kPerSubscriberRing 模式下可通过
+ * SetWorkerGroups() 划分为多个组：每组有独立的线程数、CPU 亲和性与可选 SCHED_FIFO
+ * 优先级，并按订阅者优先级阈值归属（如大核服务编码、小核服务预览/分析）。
+ * kSharedQueue 模式下所有 Worker 从同一队列取任务，无法按组路由，因此不支持线程组。
+ *
+ * 订阅者通过 IFrameSubscriber::GetDeliveryPolicy() 声明投递策略：
+ * - kQueue：按序排队，超过订阅者队列深度时丢弃新帧（共享队列模式下未声明深度时
+ *   仍受全局 max_queue_size 约束）。
+ * - kKeepLatest / kDropOldest：两种模式下均使用订阅者独占的邮箱环形队列，慢订阅者
+ *   只会替换/丢弃自己的旧帧，不会占满共享队列而影响其他订阅者。
+ *
+ * 订阅者可通过 IFrameSubscriber::GetMaxFrameAgeNs() 声明最大帧龄：入队时计算截止
+ * 时间，Worker 出队时跳过已过期的帧并立即释放其 Buffer，计入 expired 统计。
+ * CPU 过载时以此约束实时订阅者的端到端延迟，避免积压。
  */
 class FrameBroker
 {
 public:
+    /**
+     * @brief 分发模式
+     */
+    enum class DispatchMode : uint8_t
+    {
+        kSharedQueue = 0,    ///< 全局共享优先级队列 + 条件变量
+        kPerSubscriberRing   ///< 每订阅者有界无锁环形队列
+    };
+
+    /**
+     * @brief 单个订阅者的分发统计
+     */
+    struct SubscriberStats
+    {
+        std::string name;
+        uint8_t priority = 0;
+        DeliveryPolicy policy = DeliveryPolicy::kQueue;
+        size_t queue_depth = 0;            ///< 当前待分发帧数
+        size_t queue_capacity = 0;         ///< 订阅者队列容量，0 表示不限（受全局上限约束）
+        uint64_t enqueued = 0;             ///< 成功入队数
+        uint64_t dispatched = 0;           ///< 成功回调数
+        uint64_t dropped = 0;              ///< 因队列满丢弃数（含 kDropOldest 淘汰的旧帧）
+        uint64_t replaced = 0;             ///< kKeepLatest 下被新帧替换的未投递帧数
+        uint64_t expired = 0;              ///< 超过最大帧龄、出队时被跳过的帧数
+        uint64_t max_frame_age_ns = 0;     ///< 最大帧龄，0 表示不限
+        uint64_t enqueue_contention = 0;   ///< 入队 CAS 竞争失败次数
+        uint64_t dispatch_contention = 0;  ///< 被其他 Worker 窃取执行的次数
+    };
+
+    /**
+     * @brief Worker 线程组配置
+     */
+    struct WorkerGroupConfig
+    {
+        std::string name = "broker";         ///< 组名，线程名为 组名 + 序号
+        size_t worker_count = 1;             ///< 线程数量
+        std::vector<int> cpu_ids;            ///< 绑定的 CPU 集合，空表示不绑核
+        int realtime_priority = 0;           ///< >0 时以 SCHED_FIFO 该优先级运行
+        uint8_t min_subscriber_priority = 0; ///< 订阅者优先级不低于该值时归属本组
+    };
+
+    /**
+     * @brief 单个 Worker 的运行统计
+     */
+    struct WorkerStats
+    {
+        std::string name;
+        std::string group;
+        uint64_t dispatched = 0;       ///< 完成的回调数
+        uint64_t stolen = 0;           ///< 从同组其他 Worker 窃取的调度单元数
+        uint64_t wakeups = 0;          ///< 休眠后被唤醒次数
+        bool affinity_applied = false; ///< CPU 亲和性是否设置成功
+        bool realtime_applied = false; ///< SCHED_FIFO 是否设置成功
+    };
+
     /**
      * @brief 分发统计信息
      */
@@ -42,8 +122,14 @@ public:
         uint64_t published_frames = 0;
         uint64_t dispatched_tasks = 0;
         uint64_t dropped_tasks = 0;
+        uint64_t replaced_tasks = 0;
+        uint64_t expired_tasks = 0;
         size_t queue_size = 0;
         size_t subscriber_count = 0;
+        DispatchMode dispatch_mode = DispatchMode::kSharedQueue;
+        uint64_t queue_lock_contention = 0;  ///< 共享队列锁竞争次数（仅 kSharedQueue）
+        std::vector<SubscriberStats> subscribers;
+        std::vector<WorkerStats> workers;
     };
 
     FrameBroker();
@@ -51,8 +137,9 @@ public:
 
     /**
      * @brief 启动分发线程
-     * @param worker_count 工作线程数量，0 表示使用硬件并发数
-     * @return 成功返回 true
+     * @param worker_count 工作线程数量，0 表示使用硬件并发数；
+     *        已通过 SetWorkerGroups() 配置线程组时忽略
+     * @return 成功返回 true；任一 Worker 线程启动失败时停止已启动的线程并返回 false
      */
     bool Start(size_t worker_count = 0);
 
@@ -93,6 +180,44 @@ public:
     void PublishFrame(const core::FrameHandle& frame,
                       const std::shared_ptr<core::BufferGuard>& buffer_ref);
 
+    /**
+     * @brief 设置分发模式（仅在未运行时生效）
+     * @return 运行中调用，或已配置线程组时切换到 kSharedQueue 返回 false
+     */
+    bool SetDispatchMode(DispatchMode mode);
+
+    /**
+     * @brief 获取分发模式
+     */
+    DispatchMode GetDispatchMode() const;
+
+    /**
+     * @brief 配置 Worker 线程组（仅在未运行时生效，仅 kPerSubscriberRing 模式）
+     *
+     * 订阅者归属 min_subscriber_priority 不超过其优先级的组中阈值最高者；
+     * 若没有满足条件的组，则归属阈值最低的组。传入空列表恢复默认单组。
+     * 需先调用 SetDispatchMode(kPerSubscriberRing)。
+     *
+     * @return 运行中调用、当前为 kSharedQueue 模式或存在 worker_count 为 0 的组时
+     *         返回 false（空列表在任何模式下均可设置）
+     */
+    bool SetWorkerGroups(const std::vector<WorkerGroupConfig>& groups);
+
+    /**
+     * @brief 获取 Worker 线程组配置
+     */
+    std::vector<WorkerGroupConfig> GetWorkerGroups() const;
+
+    /**
+     * @brief 设置每订阅者默认队列容量（对之后 Subscribe 且未声明队列深度的订阅者生效）
+     */
+    void SetSubscriberQueueCapacity(size_t capacity);
+
+    /**
+     * @brief 获取每订阅者环形队列容量
+     */
+    size_t GetSubscriberQueueCapacity() const;
+
     /**
      * @brief 设置最大队列长度
      */
@@ -109,13 +234,64 @@ public:
     Stats GetStats() const;
 
 private:
+    /**
+     * @brief 环形队列中的待分发帧
+     */
+    struct DispatchItem
+    {
+        core::FrameHandle frame;
+        std::shared_ptr<core::BufferGuard> buffer_ref; // ARCH-001: 绑定 Buffer 生命周期
+        uint64_t sequence = 0;
+        uint64_t deadline_ns = 0; ///< 投递截止时间 (CLOCK_MONOTONIC)，0 表示不限
+    };
+
+    /**
+     * @brief 订阅者通道：订阅者弱引用 + 独占环形队列 + 分发统计
+     */
+    struct SubscriberChannel
+    {
+        SubscriberChannel(const std::shared_ptr<IFrameSubscriber>& sub,
+                          size_t default_capacity);
+
+        /// 是否通过订阅者独占环形队列投递（共享队列模式下仅邮箱类策略为 true）
+        bool UsesRing(DispatchMode mode) const
+        {
+            return mode == DispatchMode::kPerSubscriberRing || policy != DeliveryPolicy::kQueue;
+        }
+
+        std::weak_ptr<IFrameSubscriber> subscriber;
+        const IFrameSubscriber* identity = nullptr;
+        std::string name;
+        uint8_t priority = 0;
+        DeliveryPolicy policy = DeliveryPolicy::kQueue;
+        size_t depth_limit = 0; ///< 订阅者声明的队列深度，0 表示未声明
+        size_t home_slot = 0;   ///< 首选 Worker 槽位（组内取模），保持缓存局部性
+        uint64_t max_age_ns = 0; ///< 最大帧龄，0 表示不限
+        core::BoundedMpmcRing<DispatchItem> ring;
+        std::atomic<bool> removed{false};
+        std::atomic<bool> scheduled{false}; ///< 已有待处理调度令牌（邮箱或就绪队列中）
+
+        std::atomic<size_t> pending{0};
+        std::atomic<uint64_t> enqueued{0};
+        std::atomic<uint64_t> dispatched{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> replaced{0};
+        std::atomic<uint64_t> expired{0};
+        std::atomic<uint64_t> enqueue_contention{0};
+        std::atomic<uint64_t> dispatch_contention{0};
+    };
+
+    using ChannelList = std::vector<std::shared_ptr<SubscriberChannel>>;
+
     struct DispatchTask
     {
         core::FrameHandle frame;
         std::shared_ptr<IFrameSubscriber> subscriber;
+        std::shared_ptr<SubscriberChannel> channel;
         std::shared_ptr<core::BufferGuard> buffer_ref; // ARCH-001: 绑定 Buffer 生命周期
         uint8_t priority = 0;
         uint64_t sequence = 0;
+        uint64_t deadline_ns = 0; ///< 投递截止时间 (CLOCK_MONOTONIC)，0 表示不限
     };
 
     struct TaskCompare
@@ -130,23 +306,125 @@ private:
         }
     };
 
-    void WorkerLoop();
-    void CleanupExpiredSubscribersLocked();
+    /**
+     * @brief 分发线程及其就绪队列
+     *
+     * ready 保存有帧待处理的订阅者通道：所有者取优先级最高者，窃取者取最早入队者。
+     */
+    struct Worker
+    {
+        std::string name;
+        size_t index = 0; ///< 在 workers_ 中的下标
+        size_t group = 0;
+        std::string group_name;
+        std::unique_ptr<platform::PlatformThread> thread;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<std::shared_ptr<SubscriberChannel>> ready; // 受 mutex 保护
+        bool wake = false;                                     // 受 mutex 保护
+        std::atomic<size_t> queued{0};
+        std::atomic<bool> sleeping{false};
+
+        std::atomic<uint64_t> dispatched{0};
+        std::atomic<uint64_t> stolen{0};
+        std::atomic<uint64_t> wakeups{0};
+        bool affinity_applied = false;
+        bool realtime_applied = false;
+    };
+
+    /// 线程组在 workers_ 中的下标区间
+    struct GroupRange
+    {
+        size_t first = 0;
+        size_t count = 0;
+    };
+
+    void PublishShared(const core::FrameHandle& frame,
+                       const std::shared_ptr<core::BufferGuard>& buffer_ref);
+    void PublishPerSubscriber(const core::FrameHandle& frame,
+                              const std::shared_ptr<core::BufferGuard>& buffer_ref);
+    void WorkerLoop(Worker& self);
+    void RingWorkerLoop(Worker& self);
+    void ScheduleChannel(const std::shared_ptr<SubscriberChannel>& channel);
+    void EnqueueReady(Worker& worker, const std::shared_ptr<SubscriberChannel>& channel);
+    std::shared_ptr<SubscriberChannel> TakeReady(Worker& self);
+    bool GroupHasWork(size_t group) const;
+    void WakeWorker(Worker& worker);
+    void WakeForWork(Worker& target);
+    bool PushToChannel(SubscriberChannel& channel, DispatchItem&& item, size_t* evicted);
+    void ScheduleMailboxLocked(const std::shared_ptr<SubscriberChannel>& channel,
+                               const std::shared_ptr<IFrameSubscriber>& subscriber);
+    void RescheduleMailbox(const std::shared_ptr<SubscriberChannel>& channel,
+                           const std::shared_ptr<IFrameSubscriber>& subscriber);
+    size_t DrainChannel(SubscriberChannel& channel, size_t max_items);
+    bool ExpireIfStale(SubscriberChannel& channel, uint64_t deadline_ns);
+    void RetireChannel(SubscriberChannel& channel);
+    void DiscardChannel(SubscriberChannel& channel);
+    void Deliver(SubscriberChannel& channel, IFrameSubscriber& subscriber,
+                 const core::FrameHandle& frame);
+
+    /**
+     * @brief 订阅者快照读侧临界区（RAII）
+     *
+     * 进入时在当前 epoch 奇偶对应的计数器上登记，退出时注销；期间读到的快照
+     * 保证不会被写侧释放。读侧不加锁、不分配内存，临界区内不得回调订阅者。
+     */
+    class SnapshotReadGuard
+    {
+    public:
+        explicit SnapshotReadGuard(const FrameBroker& broker);
+        ~SnapshotReadGuard();
+
+        SnapshotReadGuard(const SnapshotReadGuard&) = delete;
+        SnapshotReadGuard& operator=(const SnapshotReadGuard&) = delete;
+
+        const ChannelList& Channels() const
+        {
+            return *channels_;
+        }
+
+    private:
+        std::atomic<size_t>& readers_;
+        const ChannelList* channels_;
+    };
+
+    const ChannelList& CurrentChannelsLocked() const;
+    void StoreChannelsLocked(ChannelList channels);
+    void SynchronizeSnapshotReaders();
 
     mutable std::mutex subscribers_mutex_;
-    std::vector<std::weak_ptr<IFrameSubscriber>> subscribers_;
+    // 不可变、已按优先级排序的订阅者快照；Subscribe/Unsubscribe 原子替换，
+    // 旧快照在所有读者退出后释放（RCU 风格）
+    std::atomic<const ChannelList*> channels_;
+    mutable std::atomic<uint64_t> snapshot_epoch_{0};
+    mutable std::atomic<size_t> snapshot_readers_[2];
 
     mutable std::mutex queue_mutex_;
     std::condition_variable queue_cv_;
     std::priority_queue<DispatchTask, std::vector<DispatchTask>, TaskCompare> task_queue_;
 
-    std::vector<std::thread> workers_;
+    std::atomic<size_t> pending_items_{0};
+
+    // Worker 线程组：仅在未运行时修改；workers_mutex_ 保护 Start 重建与 GetStats 读取
+    std::vector<WorkerGroupConfig> worker_groups_;
+    mutable std::mutex workers_mutex_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<GroupRange> group_ranges_;
+    std::array<uint8_t, 256> priority_group_{}; ///< 订阅者优先级 -> 组下标
+    std::atomic<size_t> next_home_slot_{0};
+
     std::atomic<bool> is_running_;
+    std::atomic<DispatchMode> dispatch_mode_{DispatchMode::kSharedQueue};
     std::atomic<uint64_t> sequence_;
     std::atomic<uint64_t> published_frames_;
     std::atomic<uint64_t> dispatched_tasks_;
     std::atomic<uint64_t> dropped_tasks_;
+    std::atomic<uint64_t> replaced_tasks_{0};
+    std::atomic<uint64_t> expired_tasks_{0};
+    std::atomic<uint64_t> queue_lock_contention_{0};
     std::atomic<size_t> max_queue_size_;
+    std::atomic<size_t> subscriber_queue_capacity_{16};
 };
 
 } // namespace broker
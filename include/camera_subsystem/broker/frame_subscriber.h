@@ -10,11 +10,26 @@
 
 #include "../core/frame_handle.h"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace camera_subsystem
 {
 namespace broker
 {
 
+/**
+ * @brief 订阅者投递策略
+ *
+ * 决定订阅者待处理帧队列满时的行为，各订阅者互不影响。
+ */
+enum class DeliveryPolicy : uint8_t
+{
+    kQueue = 0,   ///< 按序排队，队列满时丢弃新帧
+    kKeepLatest,  ///< 只保留最新一帧，新帧替换未投递帧并立即释放其 Buffer
+    kDropOldest   ///< 按序排队，队列满时丢弃最旧帧
+};
+
 /**
  * @brief 帧订阅者接口
  *
@@ -47,13 +62,48 @@ class IFrameSubscriber
      * @brief 获取订阅者优先级,用于任务调度
      * @return 优先级值 (0-255, 数值越大优先级越高)
      *
-     * @note 默认实现返回 128 (中等优先级)
+     * @note 默认实现返回 128 (中等优先级)；仅在 Subscribe 时读取一次
      */
     virtual uint8_t GetPriority() const
     {
         return 128;
     }
 
+    /**
+     * @brief 获取投递策略
+     * @return 投递策略，默认 kQueue
+     *
+     * @note 仅在 Subscribe 时读取一次
+     */
+    virtual DeliveryPolicy GetDeliveryPolicy() const
+    {
+        return DeliveryPolicy::kQueue;
+    }
+
+    /**
+     * @brief 获取待处理帧队列深度上限
+     * @return 队列深度，0 表示使用 Broker 默认值；kKeepLatest 策略下忽略
+     *
+     * @note 仅在 Subscribe 时读取一次
+     */
+    virtual size_t GetMaxQueueDepth() const
+    {
+        return 0;
+    }
+
+    /**
+     * @brief 获取帧最大允许帧龄
+     * @return 纳秒，0 表示不限；超龄帧在出队时被跳过并立即释放其 Buffer
+     *
+     * @note 帧龄以 FrameHandle::timestamp_ns_ (CLOCK_MONOTONIC) 为起点，
+     *       时间戳为 0 时以 PublishFrame 时刻为起点
+     * @note 仅在 Subscribe 时读取一次
+     */
+    virtual uint64_t GetMaxFrameAgeNs() const
+    {
+        return 0;
+    }
+
     /**
      * @brief 订阅者被移除时的回调
      *
@@ -27,6 +27,8 @@ class CameraSessionManager
 public:
     using SessionStartCallback = std::function<bool(const ipc::CameraEndpoint&)>;
     using SessionStopCallback = std::function<void(const ipc::CameraEndpoint&)>;
+    using SessionReconfigureCallback =
+        std::function<bool(const ipc::CameraEndpoint&, const ipc::CameraStreamFormat&)>;
 
     struct SessionSnapshot
     {
@@ -51,6 +53,19 @@ public:
 
     bool Unsubscribe(const std::string& client_id, const ipc::CameraEndpoint& endpoint);
 
+    /**
+     * @brief 设置热切换回调，由核心发布端在不停止会话的前提下切换流格式
+     */
+    void SetReconfigureCallback(SessionReconfigureCallback callback);
+
+    /**
+     * @brief 已加入会话的客户端请求切换流格式
+     * @return false 表示会话不存在 / 未出流、客户端不是会话成员或回调失败
+     */
+    bool Reconfigure(const std::string& client_id,
+                     const ipc::CameraEndpoint& endpoint,
+                     const ipc::CameraStreamFormat& format);
+
     uint32_t GetSubscriberCount(const ipc::CameraEndpoint& endpoint) const;
     bool HasActiveSession(const ipc::CameraEndpoint& endpoint) const;
     std::vector<SessionSnapshot> ListSessions() const;
@@ -91,6 +106,7 @@ private:
     std::string core_publisher_id_;
     SessionStartCallback start_callback_;
     SessionStopCallback stop_callback_;
+    SessionReconfigureCallback reconfigure_callback_;
     std::unordered_map<EndpointKey, SessionRecord, EndpointKeyHasher> sessions_;
 };
 
@@ -8,18 +8,24 @@
 #ifndef CAMERA_SUBSYSTEM_CAMERA_CAMERA_SOURCE_H
 #define CAMERA_SUBSYSTEM_CAMERA_CAMERA_SOURCE_H
 
+#include "camera_subsystem/camera/capture_backend.h"
+#include "camera_subsystem/camera/capture_reactor.h"
+#include "camera_subsystem/core/buffer_count_controller.h"
 #include "camera_subsystem/core/buffer_guard.h"
 #include "camera_subsystem/core/camera_config.h"
+#include "camera_subsystem/core/dma_buf_allocator.h"
 #include "camera_subsystem/core/frame_descriptor.h"
 #include "camera_subsystem/core/frame_handle.h"
+#include "camera_subsystem/core/latency_histogram.h"
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
-#include <thread>
 #include <vector>
 
 struct v4l2_buffer;
@@ -35,6 +41,41 @@ namespace camera {
  * VIDIOC_EXPBUF 导出 DMA-BUF fd，并通过 FramePacketCallback 交付
  * FrameDescriptor + FrameLease；如果驱动或板端环境不支持导出，则自动回退
  * 到 MMAP + copy 路径。
+ *
+ * 同时支持单平面（VIDEO_CAPTURE）与多平面（VIDEO_CAPTURE_MPLANE）设备，优先使用单平面
+ * 接口。plane 布局取自 S_FMT 协商出的 bytesperline / sizeimage；MPLANE 下每个内存 plane
+ * 单独 mmap 与 EXPBUF，DMA-BUF 路径按 plane 填充 FrameDescriptor::planes 与 fds，拷贝
+ * 路径把各内存 plane 依次排入同一个 BufferPool Buffer。
+ *
+ * IoMethod::kDmaBufImport 时改用 V4L2_MEMORY_DMABUF：驱动直接写入外部分配的 dma-buf
+ * （SetDmaBufImportFds 传入，或由 DmaBufAllocator 分配），buffer 数量与放置由我们决定；
+ * 帧仍以 FramePacket + DmaBufFrameLease 交付，lease 释放时以原 fd 重新 QBUF。
+ *
+ * IoMethod::kUserPtr 时以 V4L2_MEMORY_USERPTR 把页对齐的 BufferPool 槽位直接交给驱动，
+ * DQBUF 得到的槽位即作为 BufferGuard 发布，并立即换一个空闲槽位补回驱动队列，省去
+ * 拷贝路径的逐帧 memcpy。驱动不支持 USERPTR 或格式为多内存 plane 时回退到 MMAP + copy。
+ *
+ * 帧时间戳优先取驱动在 v4l2_buffer.timestamp 中给出的 CLOCK_MONOTONIC 采集时刻，
+ * 驱动未声明 V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC 时退回 DQBUF 时刻；两者都写入
+ * FrameDescriptor，并按源统计 驱动 → DQBUF → 回调返回 的延迟直方图。
+ *
+ * 采集由 CaptureReactor 驱动：设备 fd 注册到反应器的 epoll 上，就绪时在反应器线程中
+ * DQBUF。多路相机可通过 SetCaptureReactor 共享同一个反应器；未设置时每个 CameraSource
+ * 在 Start 时创建私有的单线程反应器。Stop 经 eventfd 立即唤醒，不再受等待超时影响。
+ *
+ * SetCaptureBackend 挂载 CaptureBackend 后不再打开 V4L2 设备：buffer 由后端提供，
+ * 后端的 poll fd 注册到反应器，出帧转换为 v4l2_buffer 后走同样的拷贝 / DMA-BUF 分发路径。
+ * 后端给出 fd 且 io_method 为 kDmaBuf 时启用 DMA-BUF 路径，其余 io_method 均按拷贝路径处理。
+ *
+ * SetAdaptiveBufferCount 启用后，DMA-BUF 路径按窗口统计 lease 持有时间与驱动队列深度，
+ * 由 BufferCountController 给出 buffer 数：MMAP 导出模式下以 VIDIOC_CREATE_BUFS 在线扩容，
+ * 其余模式的扩容与所有收缩在下次 Initialize / Reconfigure 时生效；lease 预算随 buffer 数
+ * 重新计算。在线扩容中映射 / 导出 / QBUF 失败的 buffer 记为 orphaned：索引保留在驱动中，
+ * 不参与轮转也不计入 lease 预算，下次 REQBUFS 0 时随其余 buffer 一并释放。
+ *
+ * Reconfigure 在保持设备 fd 与订阅者连接的前提下切换分辨率 / 格式 / 帧率。每次重新分配
+ * buffer 后流代数加 1：早于当前代数的 lease 释放时既不 QBUF 也不占用 lease 预算，
+ * 消费者依据帧上的 stream_generation 丢弃按旧尺寸 / 旧 buffer_id 建立的缓存。
  */
 class CameraSource
 {
@@ -44,6 +85,37 @@ public:
         std::function<void(const core::FrameHandle&,
                            const std::shared_ptr<core::BufferGuard>&)>;
     using FramePacketCallback = std::function<void(const core::FramePacket&)>;
+    using DrainCallback = std::function<void()>;
+    using LeaseBudgetCallback = std::function<void(size_t lease_in_flight_max)>;
+
+    /**
+     * @brief 采集延迟统计（纳秒）
+     *
+     * 驱动时间戳相关的两项只统计驱动提供单调时间戳的帧。
+     */
+    struct CaptureLatencyStats
+    {
+        core::LatencyHistogram::Snapshot driver_to_dequeue;   ///< 驱动采集时刻 → DQBUF 返回
+        core::LatencyHistogram::Snapshot dequeue_to_callback; ///< DQBUF 返回 → 帧回调返回
+        core::LatencyHistogram::Snapshot driver_to_callback;  ///< 驱动采集时刻 → 帧回调返回
+        uint64_t driver_timestamp_frames = 0;   ///< 使用驱动时间戳的帧数
+        uint64_t fallback_timestamp_frames = 0; ///< 退回 DQBUF 时刻的帧数
+    };
+
+    /**
+     * @brief 自适应 buffer 数量统计
+     */
+    struct AdaptiveBufferStats
+    {
+        bool enabled = false;
+        uint32_t buffer_count = 0;         ///< 当前 buffer 数
+        uint32_t target_buffer_count = 0;  ///< 控制器最近一次建议值
+        uint64_t live_grow_count = 0;      ///< CREATE_BUFS 在线扩容次数
+        uint32_t orphaned_buffers = 0;     ///< 在线扩容失败、不参与轮转的 buffer 数
+        uint64_t windows = 0;              ///< 已评估的窗口数
+        size_t window_min_queued = 0;      ///< 最近窗口内 DQBUF 后驱动队列最少 buffer 数
+        core::LatencyHistogram::Snapshot lease_hold; ///< 最近窗口的 lease 持有时间
+    };
 
     CameraSource();
     ~CameraSource();
@@ -53,16 +125,120 @@ public:
     void Stop();
     bool IsRunning() const;
 
+    /**
+     * @brief 热切换分辨率 / 格式 / 帧率，不关闭设备、不影响已注册的帧回调
+     *
+     * 停流后在 drain_timeout 内等待消费者归还 DMA-BUF lease 与 BufferPool 槽位，随后释放
+     * 驱动 buffer（REQBUFS 0），按新配置重新 S_FMT / S_PARM 并分配 buffer，流代数加 1 后
+     * 恢复到调用前的运行状态；帧序号连续。超时仍未归还的 lease 被放弃（其 fd 仍可读，
+     * 释放时不再 QBUF）；BufferPool 槽位无法放弃，未归还时不做切换，仅重新排入未被 lease
+     * 持有的 buffer 并按原配置恢复出流，仍被持有的 lease 保持有效、释放时照常 QBUF。
+     * 新配置协商失败时以原配置恢复。未 Initialize 时等同于 Initialize。
+     * @return true 表示已切换到新配置
+     */
+    bool Reconfigure(const core::CameraConfig& config,
+                     std::chrono::milliseconds drain_timeout = std::chrono::milliseconds(50));
+
+    /// @return 流代数，每次重新分配 buffer 后加 1，随帧写入 FrameDescriptor / FrameHandle
+    uint32_t GetStreamGeneration() const;
+
+    /// @return 最近一次 Reconfigure 从停流到恢复出流的耗时（纳秒），未切换过为 0
+    uint64_t GetLastReconfigureDurationNs() const;
+
     void SetDevicePath(const std::string& device_path);
     std::string GetDevicePath() const;
 
+    /**
+     * @brief 设置写入 FrameHandle / FrameDescriptor 的 camera_id（即数据面 stream_id）
+     *
+     * 同一进程内多路采集时用于区分帧来源，默认 0。
+     */
+    void SetCameraId(uint32_t camera_id);
+    uint32_t GetCameraId() const;
+
+    /**
+     * @brief 设置共享采集反应器，需在 Start 之前调用
+     *
+     * 反应器须已 Start；CameraSource 只注册 / 注销自己的设备 fd，不负责其启停。
+     * 传入 nullptr 恢复为私有反应器。
+     */
+    void SetCaptureReactor(std::shared_ptr<CaptureReactor> reactor);
+
+    /**
+     * @brief 以采集后端替代 V4L2 设备（合成图案、文件回放等），传入 nullptr 恢复 V4L2
+     *
+     * 会先停止采集并释放当前 buffer，之后需重新 Initialize。
+     */
+    void SetCaptureBackend(std::shared_ptr<CaptureBackend> backend);
+
+    /**
+     * @brief 设置 DMABUF 导入模式使用的分配器，需在 Initialize 之前调用
+     *
+     * 未设置且未通过 SetDmaBufImportFds 给出 fd 时使用 DmaBufAllocator::CreateDefault()。
+     */
+    void SetDmaBufAllocator(std::shared_ptr<core::DmaBufAllocator> allocator);
+
+    /**
+     * @brief 指定 DMABUF 导入模式使用的外部 fd，需在 Initialize 之前调用
+     *
+     * 按 buffer 优先排列：fds[i * plane_count + p] 为第 i 个 buffer 的第 p 个内存 plane。
+     * CameraSource dup 后持有副本，调用者仍负责关闭原 fd。fd 数量决定 buffer 数量
+     * （受 CameraConfig::buffer_count_ 限制）。
+     */
+    void SetDmaBufImportFds(std::vector<int> fds);
+
+    /**
+     * @brief 设置拷贝路径 BufferPool 的内存后端选项，需在 Initialize 之前调用
+     *
+     * 默认逐个堆分配；需要避免热路径缺页与 TLB 抖动时可改用页对齐、预缺页的大页 arena
+     * （use_arena / huge_pages / prefault），不可用时 BufferPool 自动回退。
+     * MJPEG/H264/H265 等压缩格式（非 shareable）改用弹性多档位池，按实际帧长取 Buffer，
+     * 总字节数不超过 buffer_count * 帧上限，空闲 Buffer 周期性释放。
+     */
+    void SetBufferPoolOptions(const core::BufferPool::Options& options);
+
+    /**
+     * @brief 启用 / 关闭按 lease 持有时间自适应 buffer 数量，需在 Initialize 之前调用
+     *
+     * options.max_buffers 受 CameraConfig 上限（8）约束。
+     */
+    void SetAdaptiveBufferCount(bool enable, const core::BufferCountController::Options& options =
+                                                 core::BufferCountController::Options());
+    AdaptiveBufferStats GetAdaptiveBufferStats() const;
+    core::BufferPool::Stats GetBufferPoolStats() const;
+
+    /**
+     * @brief 获取共享 BufferPool 的 memfd（Options::shareable 时有效，否则返回 -1）
+     *
+     * 槽位偏移为 buffer_id * Stats::slot_stride，可经 SCM_RIGHTS 一次性交给消费者。
+     */
+    int GetBufferPoolShareFd() const;
+
     void SetFrameCallback(FrameCallback callback);
     void SetFrameCallbackWithBuffer(FrameCallbackWithBuffer callback);
     void SetFramePacketCallback(FramePacketCallback callback);
+
+    /**
+     * @brief 设置 Reconfigure 停流后、等待排空前的回调
+     *
+     * 供上层丢弃发送队列中仍持有 BufferGuard 的帧（如 CameraDataSocketServer::DropQueuedFrames），
+     * 使 BufferPool 能在 drain_timeout 内排空。回调在调用 Reconfigure 的线程上执行。
+     */
+    void SetDrainCallback(DrainCallback callback);
+
+    /**
+     * @brief 设置 DMA-BUF lease 预算变化回调，参数为新的 GetDmaBufLeaseInFlightMax()
+     *
+     * DMA-BUF 路径在 Initialize / Reconfigure 中建立以及自适应扩容后调用，上层据此重算
+     * 单消费者配额。扩容时在反应器线程上执行，回调不得阻塞。
+     */
+    void SetLeaseBudgetCallback(LeaseBudgetCallback callback);
     core::CameraConfig GetConfig() const;
     uint64_t GetFrameCount() const;
     uint64_t GetDroppedFrameCount() const;
     bool IsDmaBufPathEnabled() const;
+    bool IsUserPtrPathEnabled() const;
+    bool IsMultiPlanar() const;
     uint64_t GetDmaBufFrameCount() const;
     uint64_t GetDmaBufExportFailureCount() const;
     uint64_t GetDmaBufLeaseExhaustedCount() const;
@@ -70,23 +246,67 @@ public:
     size_t GetDmaBufLeaseInFlightMax() const;
     size_t GetDmaBufMinQueuedCaptureBuffers() const;
 
+    /**
+     * @brief 获取采集延迟统计
+     * @param reset_window true 时读取后清零，按固定周期调用即得到滚动窗口
+     */
+    CaptureLatencyStats GetCaptureLatencyStats(bool reset_window = false);
+
 private:
-    void CaptureLoop();
-    void HandleDequeuedBuffer(struct v4l2_buffer& buf);
-    void HandleDequeuedBufferCopy(struct v4l2_buffer& buf);
-    bool HandleDequeuedBufferDmaBuf(struct v4l2_buffer& buf);
+    /// 单帧 DQBUF 时刻与采集时刻（CLOCK_MONOTONIC 纳秒）
+    struct DequeueTiming
+    {
+        uint64_t capture_ns = 0;
+        uint64_t dequeue_ns = 0;
+        bool driver_timestamp = false;
+    };
+
+    bool StartCapture(bool reset_counters);
+    bool ApplyConfig(const core::CameraConfig& config);
+    bool DrainOutstandingFrames(std::chrono::milliseconds timeout);
+    void InvalidateLeases();
+    void ReleaseDeviceBuffers();
+    bool OnDeviceReadable();
+    bool OnBackendReadable();
+    void NoteDequeueDepth();
+    void EvaluateBufferCount();
+    bool GrowCaptureBuffers(uint32_t count);
+    size_t UsableBufferCount() const;
+    DequeueTiming MakeDequeueTiming(const struct v4l2_buffer& buf);
+    void RecordCallbackLatency(const DequeueTiming& timing);
+    size_t GetPlaneBytesUsed(const struct v4l2_buffer& buf, uint32_t plane) const;
+    void HandleDequeuedBuffer(struct v4l2_buffer& buf, const DequeueTiming& timing);
+    void HandleDequeuedBufferCopy(struct v4l2_buffer& buf, const DequeueTiming& timing);
+    void HandleDequeuedBufferUserPtr(struct v4l2_buffer& buf, const DequeueTiming& timing);
+    uint64_t DeliverPoolFrame(const struct v4l2_buffer& buf,
+                              const std::shared_ptr<core::BufferGuard>& buffer_ref,
+                              size_t frame_size, const DequeueTiming& timing);
+    bool HandleDequeuedBufferDmaBuf(struct v4l2_buffer& buf, const DequeueTiming& timing);
     bool OpenDevice();
     void CloseDevice();
     bool ConfigureDevice();
     bool InitMMap();
+    bool MapBuffer(uint32_t index);
     bool InitDmaBufExport();
+    bool ExportBuffer(uint32_t index);
+    bool InitDmaBufImport();
+    bool InitUserPtr();
+    bool InitBackend();
+    bool ImportPlaneFd(uint32_t buffer_index, uint32_t plane, core::DmaBufAllocator* allocator);
+    bool QueueAllBuffers();
+    bool QueueUnleasedBuffers();
     void CleanupDmaBufExports();
     bool ShouldUseDmaBufPath() const;
     void RequeueBuffer(uint32_t buffer_index);
+    int QueueBuffer(uint32_t buffer_index) const;
+    void UpdateLeaseBudget();
+    void NotifyLeaseBudget();
     bool StartStream();
     void StopStream();
     void CleanupBuffers();
     size_t CalculateBufferSize(const core::CameraConfig& config) const;
+    bool UseElasticBufferPool() const;
+    core::BufferPool::ElasticOptions MakeElasticPoolOptions() const;
     void FillFrameLayout(core::FrameHandle& frame, size_t buffer_size) const;
     uint64_t GetTimestampNs() const;
 
@@ -95,47 +315,111 @@ private:
 
     core::CameraConfig config_;
     std::string device_path_;
+    std::atomic<uint32_t> camera_id_{0};
     int device_fd_;
     bool streaming_;
+    uint32_t buf_type_;   ///< V4L2_BUF_TYPE_VIDEO_CAPTURE 或 _MPLANE
+    uint32_t v4l2_memory_; ///< V4L2_MEMORY_MMAP / _DMABUF / _USERPTR
+    bool multi_planar_ = false;
 
-    struct Buffer
+    /// S_FMT 协商出的单个内存 plane 格式
+    struct PlaneFormat
+    {
+        uint32_t bytes_per_line = 0;
+        uint32_t size_image = 0;
+    };
+    std::array<PlaneFormat, core::kMaxFramePlanes> plane_formats_{};
+    uint32_t memory_plane_count_ = 1;
+    /// 拷贝路径中各内存 plane 在 BufferPool Buffer 内的起始偏移
+    std::array<size_t, core::kMaxFramePlanes> packed_plane_offsets_{};
+
+    struct Plane
     {
         void* start = nullptr;
         size_t length = 0;
         int dma_buf_fd = -1;
+    };
+
+    struct Buffer
+    {
+        std::array<Plane, core::kMaxFramePlanes> planes{};
+        uint32_t plane_count = 0;
         bool dma_buf_exported = false;
+        bool orphaned = false; ///< CREATE_BUFS 已分配但无法投入使用，不再 QBUF
     };
     std::vector<Buffer> buffers_;
+    size_t orphaned_buffer_count_ = 0;
+    /// USERPTR 模式下当前排入驱动的 BufferPool 槽位，按 V4L2 buffer 索引
+    std::vector<std::shared_ptr<core::BufferGuard>> userptr_slots_;
 
     struct RequeueContext
     {
         std::mutex mutex;
         int device_fd = -1;
+        std::shared_ptr<CaptureBackend> backend; ///< 非空时 QBUF 改为 backend->Queue
+        uint32_t buf_type = 0;
+        uint32_t memory = 0;
+        uint32_t plane_count = 1;
+        /// DMABUF 导入模式下 QBUF 需要的各 buffer plane fd 与长度
+        std::vector<std::array<int, core::kMaxFramePlanes>> import_fds;
+        std::vector<std::array<uint32_t, core::kMaxFramePlanes>> import_lengths;
         bool active = false;
+        uint32_t generation = 0; ///< 与 lease 创建时的流代数不一致时不再 QBUF、不计数
         std::atomic<size_t> active_leases{0};
+        std::vector<bool> leased; ///< 按 buffer 索引标记仍被本代 lease 持有的 buffer
+        core::LatencyHistogram lease_hold; ///< lease 从交付到释放的持有时间
     };
     std::shared_ptr<RequeueContext> requeue_context_;
 
     bool dma_buf_path_enabled_ = false;
-    size_t min_queued_capture_buffers_ = 1;
-    size_t global_lease_in_flight_max_ = 1;
+    // 反应器线程扩容时更新，lease 准入与 Getter 在其他线程读取
+    std::atomic<size_t> min_queued_capture_buffers_{1};
+    std::atomic<size_t> global_lease_in_flight_max_{1};
     std::atomic<uint64_t> dma_buf_frame_count_{0};
     std::atomic<uint64_t> dma_buf_export_failures_{0};
     std::atomic<uint64_t> lease_exhausted_count_{0};
 
     std::atomic<bool> is_running_;
+    std::atomic<uint32_t> stream_generation_{0};
+    std::atomic<uint64_t> last_reconfigure_ns_{0};
     std::atomic<uint64_t> frame_count_;
     std::atomic<uint64_t> dropped_frames_;
-    std::thread capture_thread_;
+    core::LatencyHistogram driver_to_dequeue_latency_;
+    core::LatencyHistogram dequeue_to_callback_latency_;
+    core::LatencyHistogram driver_to_callback_latency_;
+    std::atomic<uint64_t> driver_timestamp_frames_{0};
+    std::atomic<uint64_t> fallback_timestamp_frames_{0};
+    std::shared_ptr<CaptureReactor> shared_reactor_;
+    std::shared_ptr<CaptureBackend> capture_backend_;
+    std::shared_ptr<CaptureReactor> capture_reactor_;
+    uint64_t capture_source_id_ = 0;
 
     mutable std::mutex callback_mutex_;
     FrameCallback callback_;
     FrameCallbackWithBuffer callback_with_buffer_;
     FramePacketCallback frame_packet_callback_;
     std::atomic<bool> has_frame_packet_callback_{false};
+    DrainCallback drain_callback_;
+    LeaseBudgetCallback lease_budget_callback_;
+
+    std::shared_ptr<core::DmaBufAllocator> dma_buf_allocator_;
+    std::vector<int> dma_buf_import_fds_;
 
     core::BufferPool buffer_pool_;
+    core::BufferPool::Options buffer_pool_options_;
+    int buffer_pool_share_fd_ = -1;
     size_t pool_buffer_size_ = 0;
+    bool elastic_buffer_pool_ = false;
+
+    bool adaptive_buffers_enabled_ = false;
+    core::BufferCountController buffer_count_controller_;
+    /// 控制器给出的 buffer 数，下次 Initialize 时生效；0 表示沿用配置
+    std::atomic<uint32_t> adaptive_buffer_count_{0};
+    uint64_t adaptive_window_start_ns_ = 0;
+    size_t window_min_queued_ = SIZE_MAX;
+    uint64_t window_lease_exhausted_base_ = 0;
+    mutable std::mutex adaptive_mutex_;
+    AdaptiveBufferStats adaptive_stats_;
 };
 
 } // namespace camera
@@ -0,0 +1,115 @@
+/**
+ * @file camera_source_registry.h
+ * @brief 多路 CameraSource 注册表（每个端点独立采集，共享采集反应器）
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#ifndef CAMERA_SUBSYSTEM_CAMERA_CAMERA_SOURCE_REGISTRY_H
+#define CAMERA_SUBSYSTEM_CAMERA_CAMERA_SOURCE_REGISTRY_H
+
+#include "camera_subsystem/camera/camera_source.h"
+#include "camera_subsystem/camera/capture_reactor.h"
+#include "camera_subsystem/core/buffer_pool.h"
+#include "camera_subsystem/core/camera_config.h"
+#include "camera_subsystem/ipc/camera_channel_contract.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace camera_subsystem
+{
+namespace camera
+{
+
+/**
+ * @brief 按端点管理多路并发采集
+ *
+ * 每个端点拥有独立的 CameraSource（设备 fd、buffer、BufferPool、帧回调），所有 source 的
+ * 设备 fd 注册到同一个 CaptureReactor，由固定数量的反应器线程轮流服务，线程数不随
+ * camera 数增长。端点的 camera_id 写入帧的 camera_id_ / 描述符的 stream_id，因此同时运行
+ * 的端点 camera_id 必须互不相同。
+ *
+ * 典型用法是作为 CameraSessionManager 的启停回调：会话开始时 Start，结束时 Stop。
+ */
+class CameraSourceRegistry
+{
+public:
+    /**
+     * @brief 新建 source 后、Initialize 之前调用，用于设置采集后端、BufferPool 选项与帧回调
+     * @return false 时放弃创建该 source
+     */
+    using SourceSetup = std::function<bool(const ipc::CameraEndpoint&, CameraSource&)>;
+
+    struct Options
+    {
+        size_t reactor_threads = 1; ///< 共享采集反应器线程数
+    };
+
+    /// @brief 单个端点的运行统计
+    struct SourceStats
+    {
+        ipc::CameraEndpoint endpoint;
+        core::CameraConfig config;
+        bool running = false;
+        uint64_t frames = 0;
+        uint64_t dropped_frames = 0;
+        uint32_t stream_generation = 0;
+        core::BufferPool::Stats pool;
+    };
+
+    explicit CameraSourceRegistry(SourceSetup setup);
+    CameraSourceRegistry(SourceSetup setup, const Options& options);
+    ~CameraSourceRegistry();
+
+    CameraSourceRegistry(const CameraSourceRegistry&) = delete;
+    CameraSourceRegistry& operator=(const CameraSourceRegistry&) = delete;
+
+    /**
+     * @brief 按配置启动端点采集；端点已存在时先停止再以新配置重新初始化
+     * @return false 表示 camera_id 与其他端点冲突、setup 拒绝或初始化 / 启动失败
+     */
+    bool Start(const ipc::CameraEndpoint& endpoint, const core::CameraConfig& config);
+
+    /// @brief 停止并移除端点，未注册时无操作
+    void Stop(const ipc::CameraEndpoint& endpoint);
+
+    void StopAll();
+
+    /// @return 端点对应的 source，未注册时为 nullptr
+    std::shared_ptr<CameraSource> Find(const ipc::CameraEndpoint& endpoint) const;
+
+    size_t GetSourceCount() const;
+
+    /// @return 各端点统计，按 camera_id 升序
+    std::vector<SourceStats> GetStats() const;
+
+    std::shared_ptr<CaptureReactor> GetCaptureReactor() const;
+
+private:
+    struct Entry
+    {
+        ipc::CameraEndpoint endpoint;
+        std::shared_ptr<CameraSource> source;
+        std::mutex mutex; ///< 串行化同一端点的 Initialize / Start / Stop
+    };
+
+    static std::string MakeKey(const ipc::CameraEndpoint& endpoint);
+
+    SourceSetup setup_;
+    std::shared_ptr<CaptureReactor> reactor_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries_;
+};
+
+} // namespace camera
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_CAMERA_CAMERA_SOURCE_REGISTRY_H
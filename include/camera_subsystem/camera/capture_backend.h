@@ -0,0 +1,174 @@
+/**
+ * @file capture_backend.h
+ * @brief 可插拔采集后端接口（替代 V4L2 设备，用于无硬件基准与测试）
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#ifndef CAMERA_SUBSYSTEM_CAMERA_CAPTURE_BACKEND_H
+#define CAMERA_SUBSYSTEM_CAMERA_CAPTURE_BACKEND_H
+
+#include "camera_subsystem/core/camera_config.h"
+#include "camera_subsystem/core/dma_buf_allocator.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace camera_subsystem {
+namespace camera {
+
+/**
+ * @brief 采集后端接口
+ *
+ * 语义对齐 V4L2 的 buffer 队列：后端持有固定数量的 buffer，Queue 交给后端填充，
+ * GetPollFd 可读时 Dequeue 取回一帧。CameraSource 通过 SetCaptureBackend 挂载后端后，
+ * 帧仍走原有的拷贝 / DMA-BUF 分发路径，上层无法区分数据来自真实设备还是后端。
+ *
+ * Queue 可能在消费者线程（lease 释放）中调用，实现须线程安全；其余接口只在
+ * CameraSource 的控制线程或反应器线程中调用。
+ */
+class CaptureBackend
+{
+public:
+    struct BufferInfo
+    {
+        void* start = nullptr;
+        size_t length = 0;
+        int dma_buf_fd = -1; ///< 后端持有的可导出 fd，-1 表示不支持 DMA-BUF 路径
+    };
+
+    struct CapturedFrame
+    {
+        uint32_t index = 0;
+        uint32_t bytes_used = 0;
+        uint32_t sequence = 0;
+        uint64_t timestamp_ns = 0; ///< 采集时刻（CLOCK_MONOTONIC）
+    };
+
+    virtual ~CaptureBackend() = default;
+
+    /// @return 后端名称，用于日志
+    virtual const char* Name() const = 0;
+
+    /**
+     * @brief 按配置分配 buffer，所有 buffer 初始均不在队列中
+     * @param buffer_count 期望 buffer 数量
+     */
+    virtual bool Open(const core::CameraConfig& config, uint32_t buffer_count) = 0;
+    virtual void Close() = 0;
+
+    virtual size_t GetBufferCount() const = 0;
+    virtual BufferInfo GetBuffer(uint32_t index) const = 0;
+
+    /// @return 首个 plane 的行跨度，压缩格式返回 0
+    virtual uint32_t GetBytesPerLine() const = 0;
+
+    /// @return 有帧可取时可读的 fd，注册到 CaptureReactor
+    virtual int GetPollFd() const = 0;
+
+    virtual bool StartStreaming() = 0;
+    virtual void StopStreaming() = 0;
+
+    /// @brief 把 buffer 交给后端填充，等价于 VIDIOC_QBUF
+    virtual bool Queue(uint32_t index) = 0;
+
+    /// @brief 取回一帧，等价于 VIDIOC_DQBUF；暂无帧时返回 false
+    virtual bool Dequeue(CapturedFrame& frame) = 0;
+};
+
+/**
+ * @brief 按 fps 定时出帧的后端基类
+ *
+ * 以 timerfd 绝对时刻（TFD_TIMER_ABSTIME）定时，每帧时间戳为理想曝光时刻，节拍不随
+ * 处理耗时漂移。消费跟不上时与真实传感器一致：错过的节拍计入 sequence 跳变，
+ * 队列中没有空闲 buffer 时本节拍的帧被丢弃。
+ *
+ * 传入 DmaBufAllocator 时 buffer 由其分配并 mmap，fd 通过 BufferInfo 暴露给 DMA-BUF 路径；
+ * 否则使用匿名页。
+ */
+class PacedCaptureBackend : public CaptureBackend
+{
+public:
+    explicit PacedCaptureBackend(std::shared_ptr<core::DmaBufAllocator> allocator = nullptr);
+    ~PacedCaptureBackend() override;
+
+    PacedCaptureBackend(const PacedCaptureBackend&) = delete;
+    PacedCaptureBackend& operator=(const PacedCaptureBackend&) = delete;
+
+    bool Open(const core::CameraConfig& config, uint32_t buffer_count) override;
+    void Close() override;
+
+    size_t GetBufferCount() const override;
+    BufferInfo GetBuffer(uint32_t index) const override;
+    uint32_t GetBytesPerLine() const override;
+    int GetPollFd() const override;
+
+    bool StartStreaming() override;
+    void StopStreaming() override;
+    bool Queue(uint32_t index) override;
+    bool Dequeue(CapturedFrame& frame) override;
+
+    /// @return 因无空闲 buffer 而在后端内部丢弃的帧数
+    uint64_t GetStarvedFrameCount() const;
+
+    /// @brief 未压缩格式的紧密排布帧大小，压缩格式按 width * height * 2 估算上限
+    static size_t RawFrameSize(const core::CameraConfig& config);
+
+protected:
+    /// @brief Open 时调用，准备帧数据源
+    /// @return 单帧最大字节数，0 表示失败
+    virtual size_t PrepareFrames(const core::CameraConfig& config) = 0;
+
+    /**
+     * @brief 在反应器线程中填充一帧
+     * @return 有效字节数；0 表示数据源已耗尽，停止出帧
+     */
+    virtual size_t FillFrame(uint8_t* data, size_t capacity, uint32_t sequence) = 0;
+
+    /// @brief 错过 count 个节拍时调用，回放类后端据此跳过对应帧保持实时
+    virtual void SkipFrames(uint64_t count);
+
+    /// @brief Open 后调用，可对每个 buffer 预先写入内容
+    virtual void InitBuffer(uint8_t* data, size_t capacity);
+
+    const core::CameraConfig& Config() const
+    {
+        return config_;
+    }
+
+private:
+    struct Slot
+    {
+        uint8_t* start = nullptr;
+        size_t length = 0;
+        int fd = -1;
+    };
+
+    void ReleaseSlots();
+
+    std::shared_ptr<core::DmaBufAllocator> allocator_;
+    core::CameraConfig config_;
+    std::vector<Slot> slots_;
+    size_t frame_capacity_ = 0;
+    int timer_fd_ = -1;
+    uint64_t period_ns_ = 0;
+    uint64_t start_ns_ = 0;
+    uint64_t ticks_ = 0;
+    uint32_t sequence_ = 0;
+    bool end_of_stream_ = false;
+    std::atomic<uint64_t> starved_frames_{0};
+
+    mutable std::mutex mutex_;
+    std::deque<uint32_t> queued_;
+    std::vector<bool> is_queued_;
+};
+
+} // namespace camera
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_CAMERA_CAPTURE_BACKEND_H
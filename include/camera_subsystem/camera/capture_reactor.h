@@ -0,0 +1,143 @@
+/**
+ * @file capture_reactor.h
+ * @brief 基于 epoll 的多路采集反应器
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#ifndef CAMERA_SUBSYSTEM_CAMERA_CAPTURE_REACTOR_H
+#define CAMERA_SUBSYSTEM_CAMERA_CAPTURE_REACTOR_H
+
+#include "camera_subsystem/platform/platform_epoll.h"
+#include "camera_subsystem/platform/platform_thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace camera_subsystem {
+namespace camera {
+
+/**
+ * @brief 多路采集反应器
+ *
+ * 少量线程（默认 1 个）在同一个 epoll 实例上等待所有已注册的设备 fd，以及一个用于
+ * 控制与唤醒的 eventfd；哪个设备就绪就在反应器线程中调用其回调执行 DQBUF。
+ * 多个 CameraSource 共享同一反应器时，N 路相机只需 1 个采集线程。
+ *
+ * 设备 fd 以 EPOLLONESHOT 注册，回调返回后重新挂载，保证同一个源不会被两个反应器线程
+ * 并发处理。Stop() / RemoveSource() 通过 eventfd 立即唤醒，不依赖等待超时。
+ */
+class CaptureReactor
+{
+public:
+    /**
+     * @brief 就绪回调
+     * @param events epoll 返回的事件位
+     * @return false 表示该源不可恢复，反应器将其移除
+     */
+    using ReadyCallback = std::function<bool(uint32_t events)>;
+    using Task = std::function<void()>;
+
+    struct Stats
+    {
+        size_t thread_count = 0;
+        size_t source_count = 0;
+        uint64_t wait_returns = 0;    ///< epoll_wait 返回次数
+        uint64_t dispatches = 0;      ///< 设备回调次数
+        uint64_t control_wakeups = 0; ///< eventfd 唤醒次数
+        uint64_t tasks_run = 0;       ///< Post 任务执行次数
+        uint64_t error_removals = 0;  ///< 回调返回 false 被移除的源数量
+    };
+
+    CaptureReactor();
+    ~CaptureReactor();
+
+    CaptureReactor(const CaptureReactor&) = delete;
+    CaptureReactor& operator=(const CaptureReactor&) = delete;
+
+    /**
+     * @brief 创建 epoll / eventfd 并启动反应器线程
+     * @param thread_count 反应器线程数，0 按 1 处理
+     * @return 成功返回 true；已运行时直接返回 true
+     */
+    bool Start(size_t thread_count = 1);
+
+    /**
+     * @brief 经 eventfd 唤醒并等待所有反应器线程退出，清除所有已注册的源
+     */
+    void Stop();
+
+    bool IsRunning() const;
+
+    /**
+     * @brief 注册一个设备 fd，需在 Start() 之后调用
+     * @param fd 非阻塞设备 fd，所有权仍归调用者
+     * @param callback 就绪回调，在反应器线程中执行
+     * @param events 关注的事件，默认 EPOLLIN
+     * @return 源 ID，失败返回 0
+     */
+    uint64_t AddSource(int fd, ReadyCallback callback, uint32_t events = EPOLLIN);
+
+    /**
+     * @brief 注销设备 fd，并等待正在执行的该源回调结束
+     *
+     * 返回后回调不会再被调用，调用者可以安全关闭 fd。在该源自己的回调中调用时不等待。
+     * @return 源存在返回 true
+     */
+    bool RemoveSource(uint64_t source_id);
+
+    /**
+     * @brief 投递控制任务，由某个反应器线程在下次唤醒时执行
+     * @return 反应器未运行时返回 false
+     */
+    bool Post(Task task);
+
+    Stats GetStats() const;
+
+private:
+    struct Source
+    {
+        int fd = -1;
+        uint32_t events = 0;
+        ReadyCallback callback;
+        bool removed = false;
+        uint32_t dispatching = 0;
+        std::thread::id dispatch_thread;
+    };
+
+    void Loop();
+    void Dispatch(uint64_t source_id, uint32_t events);
+    void HandleControl();
+    void Notify();
+
+    platform::PlatformEpoll epoll_;
+    int event_fd_ = -1;
+    std::atomic<bool> is_running_{false};
+    std::atomic<bool> stopping_{false};
+    std::vector<std::unique_ptr<platform::PlatformThread>> threads_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable dispatch_cv_;
+    std::unordered_map<uint64_t, std::shared_ptr<Source>> sources_;
+    uint64_t next_source_id_ = 1;
+    std::vector<Task> tasks_;
+
+    std::atomic<uint64_t> wait_returns_{0};
+    std::atomic<uint64_t> dispatches_{0};
+    std::atomic<uint64_t> control_wakeups_{0};
+    std::atomic<uint64_t> tasks_run_{0};
+    std::atomic<uint64_t> error_removals_{0};
+};
+
+} // namespace camera
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_CAMERA_CAPTURE_REACTOR_H
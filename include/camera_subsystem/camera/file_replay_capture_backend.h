@@ -0,0 +1,79 @@
+/**
+ * @file file_replay_capture_backend.h
+ * @brief 录制文件回放采集后端
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#ifndef CAMERA_SUBSYSTEM_CAMERA_FILE_REPLAY_CAPTURE_BACKEND_H
+#define CAMERA_SUBSYSTEM_CAMERA_FILE_REPLAY_CAPTURE_BACKEND_H
+
+#include "camera_subsystem/camera/capture_backend.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace camera_subsystem {
+namespace camera {
+
+/**
+ * @brief 录制文件回放后端
+ *
+ * 文件按 CameraConfig::format_ 解释：
+ * - 未压缩格式：按紧密排布帧大小（如 NV12 为 w*h*3/2）切分的原始帧序列，尾部不足一帧的
+ *   数据被忽略；
+ * - MJPEG：SOI（FFD8）到 EOI（FFD9）依次拼接的 JPEG 序列（如 `ffmpeg -f mjpeg` 输出）。
+ *   内嵌缩略图的 JPEG 会在缩略图 EOI 处被截断，录制时应去掉 EXIF。
+ *
+ * 文件整体只读 mmap，逐帧拷贝进后端 buffer；按配置 fps 定时出帧，落后的节拍跳过对应帧，
+ * 回放进度与墙钟保持一致。
+ */
+class FileReplayCaptureBackend : public PacedCaptureBackend
+{
+public:
+    struct Options
+    {
+        bool loop = true; ///< 播放到末尾后从头开始；false 时停止出帧
+    };
+
+    explicit FileReplayCaptureBackend(std::string path);
+    FileReplayCaptureBackend(std::string path, Options options,
+                             std::shared_ptr<core::DmaBufAllocator> allocator = nullptr);
+    ~FileReplayCaptureBackend() override;
+
+    const char* Name() const override;
+
+    /// @return Open 后文件中的帧数
+    size_t GetFrameCount() const;
+
+protected:
+    size_t PrepareFrames(const core::CameraConfig& config) override;
+    size_t FillFrame(uint8_t* data, size_t capacity, uint32_t sequence) override;
+    void SkipFrames(uint64_t count) override;
+
+private:
+    struct FrameSpan
+    {
+        size_t offset = 0;
+        size_t length = 0;
+    };
+
+    bool MapFile();
+    void UnmapFile();
+    void IndexJpegFrames();
+
+    std::string path_;
+    Options options_;
+    const uint8_t* file_data_ = nullptr;
+    size_t file_size_ = 0;
+    std::vector<FrameSpan> frames_;
+    uint64_t cursor_ = 0;
+};
+
+} // namespace camera
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_CAMERA_FILE_REPLAY_CAPTURE_BACKEND_H
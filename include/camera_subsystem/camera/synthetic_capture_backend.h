@@ -0,0 +1,79 @@
+/**
+ * @file synthetic_capture_backend.h
+ * @brief 合成图案采集后端与 memfd 伪 DMA-BUF 后端
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#ifndef CAMERA_SUBSYSTEM_CAMERA_SYNTHETIC_CAPTURE_BACKEND_H
+#define CAMERA_SUBSYSTEM_CAMERA_SYNTHETIC_CAPTURE_BACKEND_H
+
+#include "camera_subsystem/camera/capture_backend.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace camera_subsystem {
+namespace camera {
+
+/**
+ * @brief 合成图案后端，按配置的分辨率与 fps 出帧
+ *
+ * - NV12 / YUYV：8 色竖条（BT.601），buffer 在 Open 时预先画好，逐帧只写入帧号；
+ *   Options::animate 为 true 时每帧重画并平移色条，代价接近一次整帧写。
+ * - MJPEG：可解码的灰度 baseline JPEG，COM 段携带帧号，帧长约为 像素数 / 256。
+ *
+ * 原始格式的帧首 4 字节固定写入 sequence（小端），便于端到端校验帧内容。
+ */
+class SyntheticCaptureBackend : public PacedCaptureBackend
+{
+public:
+    struct Options
+    {
+        bool animate = false;
+    };
+
+    SyntheticCaptureBackend();
+    explicit SyntheticCaptureBackend(Options options,
+                                     std::shared_ptr<core::DmaBufAllocator> allocator = nullptr);
+
+    const char* Name() const override;
+
+    /// @return MJPEG 帧中 sequence 字段相对帧首的偏移（供测试校验）
+    size_t GetJpegSequenceOffset() const;
+
+protected:
+    size_t PrepareFrames(const core::CameraConfig& config) override;
+    size_t FillFrame(uint8_t* data, size_t capacity, uint32_t sequence) override;
+    void InitBuffer(uint8_t* data, size_t capacity) override;
+
+private:
+    void DrawPattern(uint8_t* data, uint32_t shift) const;
+
+    Options options_;
+    std::vector<uint8_t> jpeg_template_;
+    size_t jpeg_sequence_offset_ = 0;
+};
+
+/**
+ * @brief memfd 伪 DMA-BUF 后端
+ *
+ * 合成图案写入 MemfdAllocator 分配的 memfd，fd 经 CameraSource 的 DMA-BUF 路径以
+ * FramePacket + FrameLease 交付，可跨进程经 SCM_RIGHTS 传递与 mmap。memfd 不是真正的
+ * dma-buf，DMA_BUF_IOCTL_SYNC 会失败，消费者应容忍该错误。
+ */
+class MemfdCaptureBackend final : public SyntheticCaptureBackend
+{
+public:
+    MemfdCaptureBackend();
+    explicit MemfdCaptureBackend(Options options);
+
+    const char* Name() const override;
+};
+
+} // namespace camera
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_CAMERA_SYNTHETIC_CAPTURE_BACKEND_H
@@ -0,0 +1,192 @@
+/**
+ * @file bounded_mpmc_ring.h
+ * @brief 有界无锁多生产者多消费者环形队列
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ *
+ * 基于每个槽位序号（sequence）的经典有界 MPMC 环形队列：
+ * - 生产者/消费者各自通过 CAS 抢占 tail/head 位置，不使用互斥锁。
+ * - 容量向上取整到 2 的幂，便于用掩码取模；序号算法要求至少 2 个槽位，
+ *   容量为 1 时额外在入队时检查 head 以限制逻辑容量。
+ * - TryPop 会把槽位重置为默认值，确保 shared_ptr 等资源（如 BufferGuard）立即释放。
+ */
+
+#ifndef CAMERA_SUBSYSTEM_CORE_BOUNDED_MPMC_RING_H
+#define CAMERA_SUBSYSTEM_CORE_BOUNDED_MPMC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace camera_subsystem {
+namespace core {
+
+/// 缓存行大小，用于隔离生产者/消费者游标，避免伪共享
+constexpr size_t kCacheLineSize = 64;
+
+/**
+ * @brief 有界无锁 MPMC 环形队列
+ *
+ * @tparam T 元素类型，需可默认构造与移动赋值
+ *
+ * @note Size() 只是近似值，仅用于统计与监控。
+ */
+template <typename T>
+class BoundedMpmcRing
+{
+public:
+    /**
+     * @param capacity 期望容量，实际容量向上取整到 2 的幂（最小为 1）
+     */
+    explicit BoundedMpmcRing(size_t capacity)
+        : capacity_(RoundUpPowerOfTwo(capacity))
+        , slots_(capacity_ < 2 ? 2 : capacity_)
+        , mask_(slots_ - 1)
+        , cells_(new Cell[slots_])
+    {
+        for (size_t i = 0; i < slots_; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+
+    BoundedMpmcRing(const BoundedMpmcRing&) = delete;
+    BoundedMpmcRing& operator=(const BoundedMpmcRing&) = delete;
+
+    /**
+     * @brief 尝试入队
+     * @param value 待入队元素（成功时被移动）
+     * @param contention 可选输出，累加 CAS 竞争失败次数
+     * @return 队列已满返回 false
+     */
+    bool TryPush(T&& value, uint64_t* contention = nullptr)
+    {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell& cell = cells_[pos & mask_];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (slots_ != capacity_ && pos - head_.load(std::memory_order_acquire) >= capacity_)
+                {
+                    return false;
+                }
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                if (contention)
+                {
+                    ++(*contention);
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief 尝试出队
+     * @param out 输出元素
+     * @param contention 可选输出，累加 CAS 竞争失败次数
+     * @return 队列为空返回 false
+     */
+    bool TryPop(T* out, uint64_t* contention = nullptr)
+    {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell& cell = cells_[pos & mask_];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff =
+                static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    if (out)
+                    {
+                        *out = std::move(cell.value);
+                    }
+                    cell.value = T();
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+                if (contention)
+                {
+                    ++(*contention);
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @return 近似元素数量
+    size_t Size() const
+    {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t head = head_.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : 0;
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    size_t Capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    static size_t RoundUpPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const size_t capacity_;
+    const size_t slots_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(kCacheLineSize) std::atomic<size_t> head_;
+    alignas(kCacheLineSize) std::atomic<size_t> tail_;
+};
+
+} // namespace core
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_CORE_BOUNDED_MPMC_RING_H
@@ -0,0 +1,80 @@
+/**
+ * @file buffer_count_controller.h
+ * @brief 按消费者 lease 持有时间自适应采集 buffer 数量
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#ifndef CAMERA_SUBSYSTEM_CORE_BUFFER_COUNT_CONTROLLER_H
+#define CAMERA_SUBSYSTEM_CORE_BUFFER_COUNT_CONTROLLER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace camera_subsystem {
+namespace core {
+
+/**
+ * @brief 采集 buffer 数量控制器
+ *
+ * 每个统计窗口输入 lease 持有时间 p99、窗口内驱动队列最少 buffer 数与 lease 耗尽次数，
+ * 估算所需 buffer 数：
+ *
+ *   needed = driver_headroom + 1 + ceil(hold_p99 / frame_interval)
+ *
+ * 即驱动始终保留 driver_headroom 个空 buffer、1 个正在分发，其余覆盖消费者持有期间
+ * 到达的帧。出现欠载（lease 耗尽或驱动队列见底）或 needed 超过当前值时立即增长；
+ * 连续 shrink_after_windows 个窗口都富余才收缩，避免抖动。只做决策，不执行分配。
+ */
+class BufferCountController
+{
+public:
+    struct Options
+    {
+        uint32_t min_buffers = 2;
+        uint32_t max_buffers = 8;
+        uint32_t driver_headroom = 2;      ///< 驱动队列中至少保留的 buffer 数
+        uint32_t shrink_after_windows = 5; ///< 连续富余多少个窗口后收缩
+        uint32_t window_ms = 1000;         ///< 统计窗口长度（由调用者按此周期调用 Update）
+    };
+
+    struct Window
+    {
+        uint32_t buffer_count = 0;       ///< 当前 buffer 数
+        uint64_t frame_interval_ns = 0;  ///< 帧间隔（1e9 / fps）
+        uint64_t leases = 0;             ///< 窗口内完成的 lease 数
+        uint64_t lease_hold_p99_ns = 0;  ///< lease 持有时间 p99
+        size_t min_queued = SIZE_MAX;    ///< 窗口内 DQBUF 后驱动队列最少 buffer 数
+        uint64_t lease_exhausted = 0;    ///< 窗口内 lease 耗尽丢帧次数
+    };
+
+    BufferCountController();
+    explicit BufferCountController(const Options& options);
+
+    /**
+     * @brief 输入一个窗口的观测值
+     * @return 建议的 buffer 数（已限制在 [min_buffers, max_buffers]）
+     */
+    uint32_t Update(const Window& window);
+
+    /// @return 按持有时间估算的所需 buffer 数，未限幅
+    uint32_t EstimateNeeded(const Window& window) const;
+
+    const Options& GetOptions() const
+    {
+        return options_;
+    }
+
+    void Reset();
+
+private:
+    uint32_t Clamp(uint32_t count) const;
+
+    Options options_;
+    uint32_t surplus_windows_ = 0;
+};
+
+} // namespace core
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_CORE_BUFFER_COUNT_CONTROLLER_H
@@ -8,6 +8,7 @@
 #ifndef CAMERA_SUBSYSTEM_CORE_BUFFER_POOL_H
 #define CAMERA_SUBSYSTEM_CORE_BUFFER_POOL_H
 
+#include "camera_subsystem/core/bounded_mpmc_ring.h"
 #include "camera_subsystem/core/buffer_state.h"
 
 #include <atomic>
@@ -15,7 +16,6 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <vector>
 
 namespace camera_subsystem {
@@ -33,14 +33,102 @@ struct BufferBlock
 
 class BufferGuard;
 
+/**
+ * @brief BufferPool 内存后端
+ */
+enum class BufferBacking : uint8_t
+{
+    kHeap = 0,     ///< 每个 Buffer 独立堆分配（默认）
+    kArena,        ///< 单块匿名 mmap 区域，普通 4 KB 页
+    kArenaThp,     ///< 单块匿名 mmap 区域 + madvise(MADV_HUGEPAGE) 透明大页
+    kArenaHugeTlb, ///< 单块 mmap(MAP_HUGETLB) 显式大页
+    kMemfd         ///< memfd_create + 尺寸封印，MAP_SHARED 映射，可经 SCM_RIGHTS 共享
+};
+
+inline const char* BufferBackingToString(BufferBacking backing)
+{
+    switch (backing)
+    {
+        case BufferBacking::kHeap:
+            return "Heap";
+        case BufferBacking::kArena:
+            return "Arena";
+        case BufferBacking::kArenaThp:
+            return "ArenaThp";
+        case BufferBacking::kArenaHugeTlb:
+            return "ArenaHugeTlb";
+        case BufferBacking::kMemfd:
+            return "Memfd";
+        default:
+            return "Unknown";
+    }
+}
+
 /**
  * @brief BufferPool 统一管理 Buffer 生命周期与复用
  *
+ * 空闲 Buffer ID 保存在有界无锁 MPMC 环形队列中，每个 Buffer 的状态为独立原子量，
+ * 统计计数使用 relaxed 原子操作：Acquire / 归还 / MarkInFlight 均不加锁，
+ * 采集线程不会与其他核上归还 Buffer 的消费者争用同一把锁。
+ * 互斥锁保护 Initialize / Clear 等结构性操作，二者不得与 Acquire 或归还并发调用；
+ * GetStats 在遍历尺寸类与槽位时同样持锁，可与 Initialize / Clear 并发调用。
+ *
+ * 可选 arena 后端：所有 Buffer 位于同一块 mmap 区域（优先 MAP_HUGETLB，其次 THP），
+ * 槽位按 Options::alignment 对齐，并可预先触发缺页与 mlock，避免采集热路径上的缺页
+ * 与 TLB 抖动。大页或 mmap 不可用时逐级回退，最终回退到堆分配。
+ *
+ * 可选共享后端（Options::shareable）：整个池位于一个封印尺寸的 memfd 中，槽位按页对齐。
+ * 发布端只需经 SCM_RIGHTS 传递一次 GetShareFd()，之后只发送槽位 ID / 偏移，
+ * 消费者直接映射读取，省去逐帧拷贝与 socket 写入。
+ *
+ * 可选弹性模式（InitializeElastic）：按多个尺寸档位（默认 64KB 至 8MB，按 2 倍递增）
+ * 管理堆 Buffer，Acquire(size_hint) 选择能容纳 size_hint 的最小档位，档位耗尽时
+ * 按需分配新 Buffer（受每档数量与总字节上限约束），并由 TrimIdle 释放观察窗口内
+ * 始终空闲的 Buffer。适用于 MJPEG/H264 等实际帧长远小于上限的压缩格式。
+ *
  * 注意：BufferPool 必须比获取到的 BufferGuard 生命周期更长。
  */
 class BufferPool
 {
 public:
+    /**
+     * @brief 初始化选项
+     */
+    struct Options
+    {
+        bool use_arena = false;   ///< true 使用单块 mmap 区域，false 为逐个堆分配
+        bool huge_pages = true;   ///< arena 下优先尝试 MAP_HUGETLB，失败回退 THP
+        size_t alignment = 64;    ///< 槽位对齐字节数（2 的幂，64 至页大小）
+        bool prefault = false;    ///< 初始化时逐页写入，预先完成缺页
+        bool lock_memory = false; ///< mlock 整个区域，失败时仅告警
+        bool shareable = false;   ///< true 使用封印 memfd 后端（页对齐，忽略 use_arena）
+    };
+
+    /**
+     * @brief 弹性多档位初始化选项
+     */
+    struct ElasticOptions
+    {
+        std::vector<size_t> class_sizes;       ///< 档位大小，升序；为空时使用 64KB ~ 8MB
+        size_t max_buffers_per_class = 8;      ///< 每个档位最多分配的 Buffer 数
+        size_t min_buffers_per_class = 0;      ///< 初始化时预分配且 TrimIdle 保留的数量
+        size_t max_total_bytes = 0;            ///< 所有档位已分配字节上限，0 表示不限
+        uint64_t idle_trim_ns = 1000000000ULL; ///< TrimIdle 观察窗口长度
+    };
+
+    /**
+     * @brief 单个尺寸档位的统计
+     */
+    struct SizeClassStats
+    {
+        size_t buffer_size = 0;
+        size_t allocated = 0;   ///< 已分配存储的 Buffer 数
+        size_t available = 0;   ///< 已分配且空闲的 Buffer 数
+        size_t max_buffers = 0;
+        uint64_t grow_count = 0;
+        uint64_t trim_count = 0;
+    };
+
     struct Stats
     {
         size_t total = 0;
@@ -52,6 +140,12 @@ public:
         uint64_t acquire_count = 0;
         uint64_t release_count = 0;
         uint64_t acquire_fail = 0;
+        BufferBacking backing = BufferBacking::kHeap; ///< 实际使用的内存后端
+        size_t slot_stride = 0;                       ///< 相邻 Buffer 起始地址间距
+        size_t arena_bytes = 0;                       ///< arena 映射总字节数，堆模式为 0
+        bool memory_locked = false;                   ///< arena 是否已 mlock
+        size_t allocated_bytes = 0;                   ///< 弹性模式下已分配的 Buffer 字节数
+        std::vector<SizeClassStats> size_classes;     ///< 弹性模式下各档位统计，固定模式为空
     };
 
     BufferPool();
@@ -65,12 +159,51 @@ public:
      */
     bool Initialize(size_t buffer_count, size_t buffer_size);
 
+    /**
+     * @brief 按选项初始化 BufferPool
+     * @param buffer_count Buffer 数量
+     * @param buffer_size 每个 Buffer 的大小
+     * @param options 内存后端选项，arena 映射失败时回退到堆分配
+     * @return 成功返回 true
+     */
+    bool Initialize(size_t buffer_count, size_t buffer_size, const Options& options);
+
+    /**
+     * @brief 以弹性多档位模式初始化 BufferPool（堆分配，忽略 arena / 共享后端）
+     * @param options 档位与容量选项
+     * @return 成功返回 true
+     */
+    bool InitializeElastic(const ElasticOptions& options);
+
     /**
      * @brief 获取一个 Buffer
      * @return shared_ptr 持有 BufferGuard, 释放时自动归还到池中
      */
     std::shared_ptr<BufferGuard> Acquire();
 
+    /**
+     * @brief 获取一个不小于 size_hint 的 Buffer
+     *
+     * 弹性模式下选择能容纳 size_hint 的最小档位；该档位无空闲且无法增长时尝试更大档位。
+     * 固定模式下 size_hint 超过 Buffer 大小时返回 nullptr。
+     * @return shared_ptr 持有 BufferGuard，Size() 为所在档位大小
+     */
+    std::shared_ptr<BufferGuard> Acquire(size_t size_hint);
+
+    /**
+     * @brief 释放观察窗口内始终空闲的弹性 Buffer
+     *
+     * 距上次收缩不足 idle_trim_ns 时直接返回；否则每个档位释放窗口内空闲低水位的一半
+     * （向上取整），并保留 min_buffers_per_class。可在采集线程周期性调用。
+     * @return 本次释放的 Buffer 数
+     */
+    size_t TrimIdle();
+
+    /**
+     * @brief 生成按 2 倍递增的档位序列，最后一档不小于 max_size
+     */
+    static std::vector<size_t> MakeSizeClasses(size_t min_size, size_t max_size);
+
     /**
      * @brief 清空并释放所有 Buffer
      */
@@ -78,6 +211,9 @@ public:
 
     /**
      * @brief 获取统计信息
+     *
+     * @note 各计数器独立读取，并发 Acquire/归还期间得到的是近似快照；
+     *       尺寸类与槽位遍历持有 mutex_，不会访问 Clear() 正在释放的存储
      */
     Stats GetStats() const;
 
@@ -90,6 +226,17 @@ public:
     size_t GetBufferCount() const;
     size_t GetBufferSize() const;
 
+    /**
+     * @brief 获取共享后端的 memfd
+     * @return fd，非 kMemfd 后端返回 -1；所有权归 BufferPool，传递前无需 dup
+     */
+    int GetShareFd() const;
+
+    /**
+     * @brief 获取槽位在池内存（共享后端下即 memfd）中的字节偏移
+     */
+    size_t GetSlotOffset(uint32_t buffer_id) const;
+
 private:
     friend class BufferGuard;
     void ReleaseInternal(uint32_t buffer_id);
@@ -98,21 +245,83 @@ private:
     void MarkError(uint32_t buffer_id);       // 新增：标记错误状态
     bool TransitionState(uint32_t buffer_id, BufferState from, BufferState to);  // 新增：状态转换验证
     std::vector<uint32_t> CollectLeaksLocked() const;
+    static void UpdateMax(std::atomic<size_t>& max_value, size_t value);
+    bool MapArenaLocked(size_t buffer_count, size_t buffer_size, const Options& options);
+    bool MapMemfdLocked(size_t buffer_count, size_t buffer_size, const Options& options);
+    void AdoptArenaLocked(void* region, size_t bytes, size_t stride, BufferBacking backing,
+                          const Options& options);
+    void UnmapArenaLocked();
+
+    struct SizeClass;
+    SizeClass& ClassOf(uint32_t buffer_id);
+    bool GrowClass(SizeClass& size_class, uint32_t* buffer_id);
+    void FreeStorage(SizeClass& size_class, uint32_t buffer_id);
+    std::shared_ptr<BufferGuard> MakeGuard(uint32_t buffer_id);
 
     struct BufferEntry
     {
         BufferBlock block;
         std::unique_ptr<uint8_t[]> storage;
-        BufferState state = BufferState::kFree;
+        std::atomic<BufferState> state{BufferState::kFree};
+    };
+
+    /**
+     * @brief 原子统计计数（relaxed），GetStats 时汇总为 Stats
+     *
+     * 热路径上只维护必要计数：in_use / in_flight 由 GetStats 扫描各 Buffer 状态得到，
+     * acquire_count 由 release_count + 活跃 Guard 数 + acquire_fail 推算。
+     * 获取侧与归还侧计数分属不同缓存行，避免采集线程与消费者线程伪共享。
+     */
+    struct AtomicStats
+    {
+        alignas(kCacheLineSize) std::atomic<uint64_t> acquire_fail{0};
+        std::atomic<size_t> max_in_use{0};
+        std::atomic<size_t> max_in_flight{0};
+        alignas(kCacheLineSize) std::atomic<uint64_t> release_count{0};
+        std::atomic<size_t> in_flight{0};
+    };
+
+    /**
+     * @brief 尺寸档位：Buffer ID 连续划分，[first_id, first_id + class_capacity_)
+     *
+     * 固定模式只有一个档位且全部已分配；弹性模式下未分配存储的 ID 位于 spare_ids。
+     */
+    struct SizeClass
+    {
+        size_t buffer_size = 0;
+        uint32_t first_id = 0;
+        std::unique_ptr<BoundedMpmcRing<uint32_t>> free_ids;  ///< 已分配且空闲
+        std::unique_ptr<BoundedMpmcRing<uint32_t>> spare_ids; ///< 未分配存储，仅弹性模式
+        std::atomic<size_t> allocated{0};
+        std::atomic<size_t> min_free{0};  ///< 本观察窗口内 free_ids 的低水位
+        std::atomic<uint64_t> grow_count{0};
+        std::atomic<uint64_t> trim_count{0};
     };
 
-    mutable std::mutex mutex_;
-    std::vector<BufferEntry> buffers_;
-    std::queue<uint32_t> free_ids_;
-    size_t buffer_size_;
-    bool initialized_;
+    mutable std::mutex mutex_;  // 保护 Initialize / Clear / TrimIdle 与 GetStats 的遍历
+    std::unique_ptr<BufferEntry[]> buffers_;
+    std::unique_ptr<SizeClass[]> classes_;
+    size_t class_count_ = 0;
+    size_t class_capacity_ = 0;
+    std::atomic<size_t> buffer_count_{0};
+    std::atomic<size_t> buffer_size_;
+    std::atomic<bool> initialized_;
+
+    void* arena_ = nullptr;
+    int share_fd_ = -1;
+    size_t arena_bytes_ = 0;
+    size_t slot_stride_ = 0;
+    BufferBacking backing_ = BufferBacking::kHeap;
+    bool memory_locked_ = false;
+
+    bool elastic_ = false;
+    size_t min_buffers_per_class_ = 0;
+    size_t max_total_bytes_ = 0;
+    uint64_t idle_trim_ns_ = 0;
+    uint64_t trim_window_start_ns_ = 0;
+    std::atomic<size_t> allocated_bytes_{0};
 
-    Stats stats_;
+    AtomicStats stats_;
     std::atomic<uint32_t> active_guard_count_{0};  // 新增：活跃的 BufferGuard 数量
 };
 
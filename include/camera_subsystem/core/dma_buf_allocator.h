@@ -0,0 +1,107 @@
+/**
+ * @file dma_buf_allocator.h
+ * @brief 外部 DMA-BUF 分配器（供 V4L2_MEMORY_DMABUF 导入模式使用）
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#ifndef CAMERA_SUBSYSTEM_CORE_DMA_BUF_ALLOCATOR_H
+#define CAMERA_SUBSYSTEM_CORE_DMA_BUF_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace camera_subsystem {
+namespace core {
+
+/**
+ * @brief DMA-BUF 分配器接口
+ *
+ * 分配出的 fd 归调用者所有，由调用者 close。大小按页向上取整，可通过 lseek(SEEK_END)
+ * 查询实际长度。
+ */
+class DmaBufAllocator
+{
+public:
+    virtual ~DmaBufAllocator() = default;
+
+    /**
+     * @brief 分配一块 buffer
+     * @param size 请求字节数
+     * @return 新 fd，失败返回 -1
+     */
+    virtual int Allocate(size_t size) = 0;
+
+    /// @return 分配器名称，用于日志
+    virtual const char* Name() const = 0;
+
+    /**
+     * @brief 创建板端默认分配器：优先 dma-heap，其次 udmabuf
+     * @return 均不可用时返回 nullptr
+     */
+    static std::unique_ptr<DmaBufAllocator> CreateDefault();
+};
+
+/**
+ * @brief dma-heap 分配器（/dev/dma_heap/<name>），分配结果可被 V4L2/RGA/MPP 导入
+ */
+class DmaHeapAllocator final : public DmaBufAllocator
+{
+public:
+    explicit DmaHeapAllocator(std::string heap_path = "/dev/dma_heap/system");
+    ~DmaHeapAllocator() override;
+
+    DmaHeapAllocator(const DmaHeapAllocator&) = delete;
+    DmaHeapAllocator& operator=(const DmaHeapAllocator&) = delete;
+
+    /// @return heap 节点可打开返回 true
+    bool IsAvailable() const;
+
+    int Allocate(size_t size) override;
+    const char* Name() const override;
+
+private:
+    std::string heap_path_;
+    int heap_fd_ = -1;
+};
+
+/**
+ * @brief udmabuf 分配器：memfd 页经 /dev/udmabuf 包装成真正的 dma-buf
+ *
+ * 适合无 dma-heap 的内核，以及把同一块内存同时作为共享内存和 V4L2 导入 buffer。
+ */
+class UdmabufAllocator final : public DmaBufAllocator
+{
+public:
+    UdmabufAllocator();
+    ~UdmabufAllocator() override;
+
+    UdmabufAllocator(const UdmabufAllocator&) = delete;
+    UdmabufAllocator& operator=(const UdmabufAllocator&) = delete;
+
+    bool IsAvailable() const;
+
+    int Allocate(size_t size) override;
+    const char* Name() const override;
+
+private:
+    int udmabuf_fd_ = -1;
+};
+
+/**
+ * @brief 纯 memfd 分配器
+ *
+ * 结果不是 dma-buf，真实 V4L2 驱动会拒绝导入；用于测试和不经过驱动的共享内存场景。
+ */
+class MemfdAllocator final : public DmaBufAllocator
+{
+public:
+    int Allocate(size_t size) override;
+    const char* Name() const override;
+};
+
+} // namespace core
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_CORE_DMA_BUF_ALLOCATOR_H
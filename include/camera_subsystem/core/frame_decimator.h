@@ -0,0 +1,82 @@
+/**
+ * @file frame_decimator.h
+ * @brief 按目标帧率 / 帧步长抽帧
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#ifndef CAMERA_SUBSYSTEM_CORE_FRAME_DECIMATOR_H
+#define CAMERA_SUBSYSTEM_CORE_FRAME_DECIMATOR_H
+
+#include <cstdint>
+
+namespace camera_subsystem {
+namespace core {
+
+/**
+ * @brief 发送端抽帧器
+ *
+ * 先按 frame_stride 每 N 帧取 1 帧，再按 target_fps 以帧时间戳限速。限速使用累加的
+ * 截止时间而不是“距上次发送的间隔”，并容忍 1/8 间隔的时间戳抖动：60fps 抽到 15fps 时
+ * 稳定地每 4 帧取 1 帧，不会因抖动退化为每 5 帧取 1 帧。落后超过一个间隔（源帧率低于
+ * 目标或中途断流）时重新对齐，不会补发突发帧。两者都为 0 时不抽帧。
+ *
+ * 非线程安全，每个订阅端一个实例，由发送线程独占使用。
+ */
+class FrameDecimator
+{
+public:
+    FrameDecimator() = default;
+    FrameDecimator(uint32_t target_fps, uint32_t frame_stride);
+
+    /// @brief 修改约定并重新开始计数；参数不变时保留当前相位
+    void Configure(uint32_t target_fps, uint32_t frame_stride);
+
+    /**
+     * @brief 判断本帧是否发送
+     * @param timestamp_ns 帧的单调时钟时间戳
+     */
+    bool Accept(uint64_t timestamp_ns);
+
+    void Reset();
+
+    bool IsPassThrough() const
+    {
+        return target_fps_ == 0 && frame_stride_ <= 1;
+    }
+
+    uint32_t GetTargetFps() const
+    {
+        return target_fps_;
+    }
+
+    uint32_t GetFrameStride() const
+    {
+        return frame_stride_;
+    }
+
+    uint64_t GetAcceptedCount() const
+    {
+        return accepted_;
+    }
+
+    uint64_t GetSkippedCount() const
+    {
+        return skipped_;
+    }
+
+private:
+    uint32_t target_fps_ = 0;
+    uint32_t frame_stride_ = 0;
+    uint64_t interval_ns_ = 0;
+    uint64_t stride_counter_ = 0;
+    uint64_t next_due_ns_ = 0;
+    bool has_due_ = false;
+    uint64_t accepted_ = 0;
+    uint64_t skipped_ = 0;
+};
+
+} // namespace core
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_CORE_FRAME_DECIMATOR_H
@@ -73,7 +73,8 @@ struct FrameDescriptor
     // --- 帧标识与时间 ---
     uint64_t frame_id = 0;       ///< 帧序号，全局递增
     uint32_t camera_id = 0;      ///< 摄像头 ID / 流 ID
-    uint64_t timestamp_ns = 0;   ///< 采集时间戳（纳秒，来自 V4L2 DQBUF 或 CLOCK_MONOTONIC）
+    uint64_t timestamp_ns = 0;   ///< 采集时间戳（纳秒，CLOCK_MONOTONIC；优先取驱动时间戳）
+    uint64_t dequeue_timestamp_ns = 0;  ///< DQBUF 返回时刻（纳秒，CLOCK_MONOTONIC）
     uint32_t sequence = 0;       ///< V4L2 sequence 号，驱动填充
 
     // --- 图像格式 ---
@@ -90,6 +91,9 @@ struct FrameDescriptor
     std::array<FramePlaneDescriptor, kMaxFramePlanes> planes{};  ///< plane 描述数组
     uint64_t total_bytes_used = 0;  ///< 所有 plane 的 bytes_used 之和
     uint32_t flags = 0;         ///< 扩展标志位（关键帧、压缩等）
+    /// 流代数：生产端每次重新分配 buffer（如热切换分辨率）后递增，消费者据此重建按
+    /// buffer_id / 尺寸缓存的映射
+    uint32_t stream_generation = 0;
 
     /// @return true 表示描述符包含有效帧元数据
     bool IsValid() const;
@@ -56,7 +56,8 @@ struct FrameHandle
     // --- 扩展字段 ---
     uint32_t sequence_;    // 帧序列号 (V4L2)
     uint32_t flags_;       // 标志位 (保留)
-    uint8_t reserved_[56]; // 预留扩展空间 (总计 64 字节)
+    uint32_t stream_generation_; // 流代数 (Reconfigure 后递增, 分辨率/格式/buffer 可能已变)
+    uint8_t reserved_[52]; // 预留扩展空间 (总计 64 字节)
 
     /**
      * @brief 默认构造函数
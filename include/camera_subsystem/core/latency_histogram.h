@@ -0,0 +1,80 @@
+/**
+ * @file latency_histogram.h
+ * @brief 无锁对数分桶延迟直方图
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#ifndef CAMERA_SUBSYSTEM_CORE_LATENCY_HISTOGRAM_H
+#define CAMERA_SUBSYSTEM_CORE_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace camera_subsystem {
+namespace core {
+
+/**
+ * @brief 延迟直方图（纳秒）
+ *
+ * 每个 2 的幂区间再线性切成 4 个子桶，相对误差不超过 25%，覆盖 0 ~ 2^64 ns。
+ * Record 只做 relaxed 原子加，可在采集热路径上调用；TakeSnapshot 读取并清零，
+ * 由调用者按固定周期调用即得到滚动窗口统计。
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr size_t kSubBucketBits = 2;
+    static constexpr size_t kSubBuckets = 1u << kSubBucketBits;
+    static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    struct Snapshot
+    {
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+        uint64_t min_ns = 0;
+        uint64_t max_ns = 0;
+        uint64_t p50_ns = 0; ///< 分位数取所在桶上界，并以 max_ns 封顶
+        uint64_t p90_ns = 0;
+        uint64_t p99_ns = 0;
+
+        uint64_t MeanNs() const
+        {
+            return count == 0 ? 0 : sum_ns / count;
+        }
+    };
+
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void Record(uint64_t latency_ns);
+
+    /// @brief 读取当前窗口统计，不清零
+    Snapshot GetSnapshot() const;
+
+    /// @brief 读取并清零，开始新窗口；与并发 Record 交错时个别样本可能计入下一窗口
+    Snapshot TakeSnapshot();
+
+    void Reset();
+
+    static size_t BucketIndex(uint64_t latency_ns);
+    static uint64_t BucketUpperBound(size_t index);
+
+private:
+    Snapshot BuildSnapshot(const std::array<uint64_t, kBucketCount>& buckets, uint64_t sum_ns,
+                           uint64_t min_ns, uint64_t max_ns) const;
+
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+    std::atomic<uint64_t> sum_ns_{0};
+    std::atomic<uint64_t> min_ns_{UINT64_MAX};
+    std::atomic<uint64_t> max_ns_{0};
+};
+
+} // namespace core
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_CORE_LATENCY_HISTOGRAM_H
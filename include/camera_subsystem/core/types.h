@@ -49,7 +49,8 @@ enum class IoMethod : uint32_t
 {
     kMmap = 0,
     kDmaBuf,
-    kUserPtr
+    kUserPtr,
+    kDmaBufImport  // V4L2_MEMORY_DMABUF，导入外部分配的 dma-buf fd
 };
 
 /**
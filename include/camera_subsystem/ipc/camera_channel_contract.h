@@ -62,6 +62,17 @@ struct CameraSubscriptionRequest
     uint8_t reserved[32];
 };
 
+/**
+ * @brief 流格式（热切换请求），字段为 0 表示保持当前值
+ */
+struct CameraStreamFormat
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t pixel_format; ///< core::PixelFormat 数值
+    uint32_t fps;
+};
+
 inline CameraEndpoint MakeDefaultCameraEndpoint(uint32_t camera_id = 0)
 {
     CameraEndpoint endpoint;
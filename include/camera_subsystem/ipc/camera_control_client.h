@@ -17,6 +17,8 @@ namespace camera_subsystem
 namespace ipc
 {
 
+class CameraShmRingReader;
+
 class CameraControlClient
 {
 public:
@@ -27,16 +29,46 @@ public:
     void Disconnect();
     bool IsConnected() const;
 
+    /**
+     * @param target_fps 期望的最高帧率，0 表示不限
+     * @param frame_stride 每 N 帧取 1 帧，0/1 表示不抽帧
+     * @param coalesce_window_ms 允许发布端合批发送 v2 描述符的最长等待，0 表示逐帧发送
+     * @param data_plane_features 订阅端数据面能力位（kCameraDataPlaneFeature*）
+     */
     bool Subscribe(const std::string& client_id,
                    CameraClientRole role,
                    const CameraEndpoint& endpoint,
-                   CameraControlResponse* response);
+                   CameraControlResponse* response,
+                   uint32_t target_fps = 0,
+                   uint32_t frame_stride = 0,
+                   uint32_t coalesce_window_ms = 0,
+                   uint32_t data_plane_features = 0);
 
     bool Unsubscribe(const std::string& client_id,
                      CameraClientRole role,
                      const CameraEndpoint& endpoint,
                      CameraControlResponse* response);
 
+    /**
+     * @brief 请求发布端热切换流格式，需先以同一 client_id 订阅该端点
+     * @param format 字段为 0 表示保持当前值
+     */
+    bool Reconfigure(const std::string& client_id,
+                     CameraClientRole role,
+                     const CameraEndpoint& endpoint,
+                     const CameraStreamFormat& format,
+                     CameraControlResponse* response);
+
+    /**
+     * @brief 申请共享内存帧环并交给 reader 映射，需先以同一 client_id 订阅该端点
+     * @return 发布端不提供（kShmRingUnavailable）或映射失败时返回 false，调用者回退 socket 数据面
+     */
+    bool OpenShmRing(const std::string& client_id,
+                     CameraClientRole role,
+                     const CameraEndpoint& endpoint,
+                     CameraShmRingReader* reader,
+                     CameraControlResponse* response);
+
     bool Ping(CameraControlResponse* response);
 
 private:
@@ -22,6 +22,10 @@ constexpr uint32_t kCameraControlMagic = 0x434D4950;   // "CMIP"
 constexpr uint32_t kCameraControlVersion = 1;
 constexpr uint32_t kCameraControlClientIdMaxLength = 64;
 constexpr uint32_t kCameraControlMessageTextMaxLength = 128;
+// 远小于发布端 lease 回收超时，攒批中的帧不会在发出前被回收
+constexpr uint32_t kCameraControlMaxCoalesceWindowMs = 100;
+// CameraControlRequest::data_plane_features：订阅端数据面能力位
+constexpr uint32_t kCameraDataPlaneFeatureV2BufferCache = 1u << 0; ///< 支持 v2 fd 注册缓存
 constexpr const char* kDefaultCameraControlSocketPath = "/tmp/camera_subsystem_control.sock";
 
 enum class CameraControlCommand : uint32_t
@@ -29,7 +33,9 @@ enum class CameraControlCommand : uint32_t
     kUnknown = 0,
     kSubscribe = 1,
     kUnsubscribe = 2,
-    kPing = 3
+    kPing = 3,
+    kReconfigure = 4,
+    kOpenShmRing = 5 ///< 申请共享内存帧环，应答以 SCM_RIGHTS 携带 memfd + eventfd
 };
 
 enum class CameraControlStatus : uint32_t
@@ -39,9 +45,30 @@ enum class CameraControlStatus : uint32_t
     kInvalidRole = 2,
     kCorePublisherUnavailable = 3,
     kSessionOperationFailed = 4,
-    kInternalError = 5
+    kInternalError = 5,
+    kShmRingUnavailable = 6 ///< 发布端不提供共享内存环，客户端回退 socket 数据面
 };
 
+/**
+ * @brief 控制面请求
+ *
+ * target_fps / frame_stride 占用原 reserved 的前 8 字节，旧客户端填 0 即不限速：
+ * - target_fps：订阅端期望的最高帧率，发布端按帧时间戳抽帧；
+ * - frame_stride：每 N 帧取 1 帧，与 target_fps 同时设置时先按步长再按帧率抽帧。
+ * 发布端按控制连接的对端 pid 把帧率约定关联到同一进程的数据面连接，在发送前抽帧。
+ *
+ * stream_format 紧随其后占用 16 字节，仅 kReconfigure 使用：已订阅该端点的客户端请求
+ * 发布端热切换分辨率 / 格式 / 帧率，订阅关系与数据面连接保持不变，之后的帧携带新的
+ * stream_generation。
+ *
+ * coalesce_window_ms 占用 stream_format 之后 reserved 的前 4 字节，仅 kSubscribe 使用：
+ * 能容忍延迟的分析类消费者允许发布端把 v2 描述符最多攒这么久再一次性发送，0 表示逐帧立即发送，
+ * 超过 kCameraControlMaxCoalesceWindowMs 时按上限处理。
+ *
+ * data_plane_features 占用最后 4 字节，仅 kSubscribe 使用：订阅端声明数据面能力位。
+ * 声明 kCameraDataPlaneFeatureV2BufferCache 的进程，发布端对每个 DMA-BUF buffer 只传一次 fd，
+ * 之后的描述符只携带 buffer_id。
+ */
 struct CameraControlRequest
 {
     uint32_t magic;
@@ -50,9 +77,18 @@ struct CameraControlRequest
     CameraClientRole role;
     CameraEndpoint endpoint;
     char client_id[kCameraControlClientIdMaxLength];
-    uint8_t reserved[32];
+    uint32_t target_fps;
+    uint32_t frame_stride;
+    CameraStreamFormat stream_format;
+    uint32_t coalesce_window_ms;
+    uint32_t data_plane_features;
 };
 
+/**
+ * @brief 控制面应答
+ *
+ * shm_ring_consumer_index 占用原 reserved 的前 4 字节，仅 kOpenShmRing 成功时有效。
+ */
 struct CameraControlResponse
 {
     uint32_t magic;
@@ -60,7 +96,8 @@ struct CameraControlResponse
     CameraControlStatus status;
     uint32_t active_subscriber_count;
     char message[kCameraControlMessageTextMaxLength];
-    uint8_t reserved[32];
+    uint32_t shm_ring_consumer_index;
+    uint8_t reserved[28];
 };
 
 inline CameraControlRequest MakeControlRequest(CameraControlCommand command,
@@ -79,7 +116,11 @@ inline CameraControlRequest MakeControlRequest(CameraControlCommand command,
     {
         std::strncpy(request.client_id, client_id, sizeof(request.client_id) - 1);
     }
-    std::memset(request.reserved, 0, sizeof(request.reserved));
+    request.target_fps = 0;
+    request.frame_stride = 0;
+    std::memset(&request.stream_format, 0, sizeof(request.stream_format));
+    request.coalesce_window_ms = 0;
+    request.data_plane_features = 0;
     return request;
 }
 
@@ -97,6 +138,7 @@ inline CameraControlResponse MakeControlResponse(CameraControlStatus status,
     {
         std::strncpy(response.message, message, sizeof(response.message) - 1);
     }
+    response.shm_ring_consumer_index = 0;
     std::memset(response.reserved, 0, sizeof(response.reserved));
     return response;
 }
@@ -13,8 +13,10 @@
 
 #include <atomic>
 #include <cstdint>
+#include <functional>
 #include <mutex>
 #include <string>
+#include <sys/types.h>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
@@ -30,13 +32,49 @@ namespace ipc
  *
  * 核心发布端进程持有该服务端，通过 Unix Domain Socket 接收
  * 子发布端/订阅端的订阅控制请求，并驱动 CameraSessionManager。
+ *
+ * 订阅请求携带的帧率约定按控制连接的对端 pid（SO_PEERCRED）记录，发布端据此对同一
+ * 进程的数据面连接抽帧。
  */
 class CameraControlServer
 {
 public:
+    /// @brief 订阅端帧率约定，字段含义同 CameraControlRequest；全 0 表示不限速
+    struct FrameRateContract
+    {
+        uint32_t target_fps = 0;
+        uint32_t frame_stride = 0;
+        uint32_t coalesce_window_ms = 0; ///< v2 描述符合批窗口，0 表示立即发送
+        uint32_t data_plane_features = 0; ///< 同一进程所有订阅都声明的数据面能力位
+    };
+
+    /// @brief 共享内存环授权；fd 归发布端所有，服务端只负责随应答发送
+    struct ShmRingGrant
+    {
+        int memfd = -1;
+        int eventfd = -1;
+        uint32_t consumer_index = 0;
+        uint64_t ring_id = 0;
+    };
+
+    /**
+     * @brief 发布端提供的共享内存环分配接口
+     *
+     * open 为订阅端分配消费者位置，返回 false 时应答 kShmRingUnavailable；
+     * close 在订阅端退订该端点或控制连接断开时调用。
+     */
+    struct ShmRingProvider
+    {
+        std::function<bool(pid_t, const CameraEndpoint&, ShmRingGrant*)> open;
+        std::function<void(const CameraEndpoint&, const ShmRingGrant&)> close;
+    };
+
     explicit CameraControlServer(camera::CameraSessionManager* session_manager);
     ~CameraControlServer();
 
+    /// @brief 设置共享内存环分配接口，须在 Start 之前调用；未设置时 kOpenShmRing 不可用
+    void SetShmRingProvider(ShmRingProvider provider);
+
     bool Start(const std::string& socket_path = kDefaultCameraControlSocketPath);
     void Stop();
     bool IsRunning() const;
@@ -45,26 +83,66 @@ public:
     std::string GetLastErrorStage() const;
     std::string GetLastErrorMessage() const;
 
+    /**
+     * @brief 查询某进程当前订阅的帧率约定
+     *
+     * 同一进程有多个订阅时取最宽松的约定（数据面连接无法区分订阅）。
+     * @return 该进程没有任何订阅时返回 false
+     */
+    bool GetFrameRateContract(pid_t peer_pid, FrameRateContract* contract) const;
+
+    /**
+     * @brief 查询某进程对指定端点的帧率约定，多路采集时按端点分发帧
+     * @return 该进程没有订阅此端点时返回 false
+     */
+    bool GetFrameRateContract(pid_t peer_pid,
+                              const CameraEndpoint& endpoint,
+                              FrameRateContract* contract) const;
+
+    /// @return 帧率约定每次变化后递增，调用者据此判断是否需要重新查询
+    uint64_t GetFrameRateContractGeneration() const;
+
 private:
     struct ClientSubscription
     {
         std::string client_id;
         CameraEndpoint endpoint;
+        FrameRateContract contract;
+    };
+
+    struct ClientShmRing
+    {
+        CameraEndpoint endpoint;
+        ShmRingGrant grant;
     };
 
     void AcceptLoop();
     void ClientLoop(int client_fd);
     void CleanupClientSubscriptions(int client_fd);
 
-    CameraControlResponse ProcessRequest(int client_fd, const CameraControlRequest& request);
+    CameraControlResponse ProcessRequest(int client_fd,
+                                         const CameraControlRequest& request,
+                                         ShmRingGrant* grant);
+    CameraControlResponse OpenShmRing(int client_fd,
+                                      const std::string& client_id,
+                                      const CameraEndpoint& endpoint,
+                                      ShmRingGrant* grant);
+    void CloseShmRings(int client_fd, const CameraEndpoint* endpoint);
+    static bool SendResponse(int fd, const CameraControlResponse& response,
+                             const ShmRingGrant& grant);
 
     bool AddClientSubscriptionLocked(int client_fd,
                                      const std::string& client_id,
-                                     const CameraEndpoint& endpoint);
+                                     const CameraEndpoint& endpoint,
+                                     const FrameRateContract& contract);
     void RemoveClientSubscriptionLocked(int client_fd,
                                         const std::string& client_id,
                                         const CameraEndpoint& endpoint);
 
+    bool MergeFrameRateContract(pid_t peer_pid,
+                                const CameraEndpoint* endpoint,
+                                FrameRateContract* contract) const;
+
     static bool EndpointEquals(const CameraEndpoint& lhs, const CameraEndpoint& rhs);
     static bool ReadFull(int fd, void* buffer, size_t length);
     static bool WriteFull(int fd, const void* buffer, size_t length);
@@ -79,6 +157,10 @@ private:
     mutable std::mutex clients_mutex_;
     std::unordered_set<int> client_fds_;
     std::unordered_map<int, std::vector<ClientSubscription>> client_subscriptions_;
+    std::unordered_map<int, pid_t> client_pids_;
+    std::unordered_map<int, std::vector<ClientShmRing>> client_shm_rings_;
+    ShmRingProvider shm_ring_provider_;
+    std::atomic<uint64_t> contract_generation_{0};
     std::vector<std::thread> client_threads_;
 
     mutable std::mutex error_mutex_;
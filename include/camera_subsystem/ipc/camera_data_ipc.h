@@ -30,8 +30,9 @@ struct CameraDataFrameHeader
     uint64_t frame_id;
     uint64_t timestamp_ns;
     uint32_t sequence;
-    uint32_t reserved0;
-    uint8_t reserved1[32];
+    uint32_t stream_generation; ///< 原 reserved0；变化时宽高 / 格式可能已切换
+    uint32_t camera_id;         ///< 帧来源 camera，多路采集时用于区分
+    uint8_t reserved1[28];
 };
 
 inline bool IsCameraDataFrameHeaderValid(const CameraDataFrameHeader& header)
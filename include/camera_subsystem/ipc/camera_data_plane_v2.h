@@ -7,12 +7,14 @@
 #define CAMERA_SUBSYSTEM_IPC_CAMERA_DATA_PLANE_V2_H
 
 #include "camera_subsystem/core/frame_descriptor.h"
+#include "camera_subsystem/core/latency_histogram.h"
 #include "camera_subsystem/core/types.h"
 
 #include <chrono>
 #include <atomic>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -31,6 +33,11 @@ constexpr uint32_t kCameraReleaseV2Magic = 0x43525632; // "CRV2"
 constexpr uint32_t kCameraReleaseV2Version = 1;
 constexpr uint32_t kCameraDataV2MaxPlanes = core::kMaxFramePlanes;
 constexpr uint32_t kCameraDataV2MaxFds = core::kMaxFrameFds;
+// kShm 池模式：池 fd 仅随 announce 传递一次，之后的槽位帧不携带 fd
+constexpr uint32_t kCameraDataV2FlagBufferCached = 1u << 28;
+constexpr uint32_t kCameraDataV2FlagBufferRegister = 1u << 29;
+constexpr uint32_t kCameraDataV2FlagShmPoolAnnounce = 1u << 30;
+constexpr uint32_t kCameraDataV2FlagShmSlot = 1u << 31;
 constexpr const char* kDefaultCameraDataV2SocketPath = "/tmp/camera_subsystem_data_v2.sock";
 constexpr const char* kDefaultCameraReleaseV2SocketPath = "/tmp/camera_subsystem_release_v2.sock";
 
@@ -79,7 +86,7 @@ struct CameraDataFrameDescriptorV2
     uint32_t fd_count;
     uint64_t total_bytes_used;
     uint32_t flags;
-    uint32_t reserved1;
+    uint32_t stream_generation; ///< 原 reserved1；变化时消费者应丢弃按 buffer_id 缓存的映射
 
     CameraDataPlaneDescriptorV2 planes[kCameraDataV2MaxPlanes];
     uint8_t reserved2[64];
@@ -105,6 +112,27 @@ CameraDataFrameDescriptorV2 MakeCameraDataFrameDescriptorV2(
     const core::FrameDescriptor& descriptor);
 bool IsCameraDataFrameDescriptorV2Valid(const CameraDataFrameDescriptorV2& descriptor);
 
+// Announce a sealed memfd pool once per consumer: buffer_id carries the slot count,
+// planes[0].stride the slot stride and planes[0].length the pool size. Send with the pool fd.
+CameraDataFrameDescriptorV2 MakeCameraShmPoolAnnounceV2(uint32_t stream_id,
+                                                        uint32_t slot_count,
+                                                        uint32_t slot_stride,
+                                                        uint32_t pool_bytes);
+// Describe a frame that lives in a previously announced pool. planes[*].offset is relative to
+// the pool mapping; the descriptor is sent without fds (fd_index refers to the announced fd).
+CameraDataFrameDescriptorV2 MakeCameraShmSlotDescriptorV2(const core::FrameDescriptor& descriptor,
+                                                          uint32_t slot_offset);
+bool IsCameraShmSlotDescriptorV2(const CameraDataFrameDescriptorV2& descriptor);
+
+// DMA-BUF fd registration: the first frame of each buffer_id (per consumer and
+// stream_generation) is sent with its fds and kCameraDataV2FlagBufferRegister; the consumer
+// keeps those fds. Later frames of that buffer are sent without fds and fd_index refers to
+// the registered list. A new stream_generation invalidates every registration of the stream.
+CameraDataFrameDescriptorV2 MakeCameraBufferRegisterV2(const core::FrameDescriptor& descriptor);
+CameraDataFrameDescriptorV2 MakeCameraBufferCachedDescriptorV2(
+    const core::FrameDescriptor& descriptor);
+bool IsCameraBufferCachedDescriptorV2(const CameraDataFrameDescriptorV2& descriptor);
+
 CameraReleaseFrameV2 MakeCameraReleaseFrameV2(uint32_t stream_id,
                                              uint64_t frame_id,
                                              uint32_t buffer_id,
@@ -117,6 +145,31 @@ bool SendCameraDataFrameDescriptorV2(int socket_fd,
                                      const CameraDataFrameDescriptorV2& descriptor,
                                      const int* fds,
                                      uint32_t fd_count);
+/**
+ * @brief 批量发送中的一条描述符及其随附 fd
+ *
+ * fds 只在发送期间被读取，调用方需保证此前 fd 仍有效（例如持有对应帧的 lease）。
+ */
+struct CameraDataFrameSendV2
+{
+    CameraDataFrameDescriptorV2 descriptor;
+    int fds[kCameraDataV2MaxFds];
+    uint32_t fd_count;
+};
+
+/**
+ * @brief 用 sendmmsg 向同一连接批量发送描述符，每条仍是独立的 SEQPACKET 消息
+ *
+ * sendmmsg 只作用于单个 socket，批量发生在同一消费者的多帧 / 多路 camera 之间。
+ * 内核部分发送时继续发送剩余消息。
+ *
+ * @param syscall_count 可选，累加本次实际发起的 sendmmsg 次数
+ * @return 按顺序成功发送的条数；小于 count 表示其后的消息未发送（无效描述符或连接错误）
+ */
+size_t SendCameraDataFrameDescriptorsV2(int socket_fd,
+                                        const CameraDataFrameSendV2* items,
+                                        size_t count,
+                                        uint64_t* syscall_count);
 bool ReceiveCameraDataFrameDescriptorV2(int socket_fd,
                                         CameraDataFrameDescriptorV2* descriptor,
                                         int* fds,
@@ -125,6 +178,65 @@ bool ReceiveCameraDataFrameDescriptorV2(int socket_fd,
 bool SendCameraReleaseFrameV2(int socket_fd, const CameraReleaseFrameV2& release);
 bool ReceiveCameraReleaseFrameV2(int socket_fd, CameraReleaseFrameV2* release);
 
+/**
+ * @brief 消费者侧 DMA-BUF fd 注册缓存
+ *
+ * 保存注册帧随附的 fd 并常驻映射，之后的缓存帧按 (stream_id, buffer_id) 直接取用，稳态路径上
+ * 没有 fd 安装、close 与 mmap / munmap。某路流的 stream_generation 变化时释放该流的全部注册，
+ * 旧 buffer 已由发布端重建。非线程安全，由接收线程独占使用。
+ */
+class CameraDataV2BufferCache
+{
+public:
+    struct Buffer
+    {
+        int fds[kCameraDataV2MaxFds] = {};
+        uint32_t fd_count = 0;
+        const uint8_t* mapped[kCameraDataV2MaxFds] = {}; ///< 映射失败时为 nullptr
+        size_t mapped_bytes[kCameraDataV2MaxFds] = {};
+    };
+
+    struct Stats
+    {
+        uint64_t registrations = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;        ///< 缓存帧找不到对应注册
+        uint64_t invalidations = 0; ///< 因代数变化释放的注册
+    };
+
+    CameraDataV2BufferCache() = default;
+    ~CameraDataV2BufferCache();
+
+    CameraDataV2BufferCache(const CameraDataV2BufferCache&) = delete;
+    CameraDataV2BufferCache& operator=(const CameraDataV2BufferCache&) = delete;
+
+    /// @return 描述符为注册帧或缓存帧，应交给 Resolve 处理
+    static bool Handles(const CameraDataFrameDescriptorV2& descriptor);
+
+    /**
+     * @brief 解析本帧所在的 buffer
+     *
+     * 注册帧：接管 fds 的所有权（替换同一 buffer 的旧注册）并映射；缓存帧：fds 应为空。
+     * @return 找不到注册或描述符不由缓存处理时返回 nullptr；指针在下一次 Resolve / Clear 前有效
+     */
+    const Buffer* Resolve(const CameraDataFrameDescriptorV2& descriptor,
+                          const int* fds,
+                          uint32_t fd_count);
+
+    void Clear();
+    size_t GetBufferCount() const;
+    Stats GetStats() const;
+
+private:
+    static uint64_t MakeKey(uint32_t stream_id, uint32_t buffer_id);
+    static void ReleaseBuffer(Buffer* buffer);
+    void InvalidateStream(uint32_t stream_id);
+
+    std::unordered_map<uint64_t, Buffer> buffers_;
+    std::unordered_map<uint32_t, uint32_t> stream_generations_;
+    Stats stats_;
+};
+
 struct CameraReleaseReclaim
 {
     uint32_t stream_id = 0;
@@ -145,6 +257,19 @@ struct CameraReleaseTrackerStats
     uint64_t unknown_releases = 0;
 };
 
+// 单个消费者的 lease 统计；quota 为 0 表示不限额
+struct CameraReleaseConsumerStats
+{
+    uint32_t consumer_id = 0;
+    uint32_t quota = 0;
+    uint64_t leases_held = 0;
+    uint64_t leases_granted = 0;
+    uint64_t releases = 0;
+    uint64_t timeouts = 0;
+    uint64_t skipped_frames = 0;
+    core::LatencyHistogram::Snapshot hold_time;
+};
+
 struct CameraReleaseServerStats
 {
     uint64_t accepted_clients = 0;
@@ -168,8 +293,17 @@ public:
     std::vector<CameraReleaseReclaim> ReclaimExpired();
     std::vector<CameraReleaseReclaim> ReclaimConsumerDisconnected(uint32_t consumer_id);
 
+    // Per-consumer lease quotas: a consumer already holding `max_in_flight` unreleased frames
+    // is skipped for new frames instead of the frame being dropped for everyone. 0 = unlimited.
+    void SetDefaultConsumerQuota(uint32_t max_in_flight);
+    void SetConsumerQuota(uint32_t consumer_id, uint32_t max_in_flight);
+    // Return the candidates that are below their quota and count a skip for the rest. Call it
+    // right before RegisterFrame from the same publishing thread.
+    std::vector<uint32_t> AdmitConsumers(const std::vector<uint32_t>& candidates);
+
     size_t PendingFrameCount() const;
     CameraReleaseTrackerStats GetStats() const;
+    std::vector<CameraReleaseConsumerStats> GetConsumerStats() const;
 
 private:
     struct FrameKey
@@ -191,15 +325,28 @@ private:
         FrameKey key;
         std::unordered_set<uint32_t> expected_consumers;
         std::unordered_set<uint32_t> released_consumers;
+        std::chrono::steady_clock::time_point registered_at;
         std::chrono::steady_clock::time_point deadline;
     };
 
+    struct ConsumerState
+    {
+        bool has_quota = false; // false 时跟随 default_consumer_quota_
+        uint32_t quota = 0;
+        CameraReleaseConsumerStats stats;
+        std::unique_ptr<core::LatencyHistogram> hold_time;
+    };
+
     CameraReleaseReclaim MakeReclaimLocked(const PendingFrame& frame,
                                            CameraReleaseStatus status) const;
+    ConsumerState& ConsumerLocked(uint32_t consumer_id);
+    uint32_t QuotaLocked(const ConsumerState& consumer) const;
 
     std::chrono::milliseconds release_timeout_;
     mutable std::mutex mutex_;
     std::unordered_map<FrameKey, PendingFrame, FrameKeyHash> pending_frames_;
+    std::unordered_map<uint32_t, ConsumerState> consumers_;
+    uint32_t default_consumer_quota_ = 0;
     CameraReleaseTrackerStats stats_;
 };
 
@@ -207,13 +354,16 @@ class CameraReleaseServer
 {
 public:
     using ReclaimCallback = std::function<void(const CameraReleaseReclaim&)>;
+    /// 释放连接断开、其 consumer 的待归还帧回收之后，对连接上出现过的每个 consumer_id 调用
+    using DisconnectCallback = std::function<void(uint32_t consumer_id)>;
 
     explicit CameraReleaseServer(std::chrono::milliseconds release_timeout =
                                      std::chrono::milliseconds(1000));
     ~CameraReleaseServer();
 
     bool Start(const std::string& socket_path = kDefaultCameraReleaseV2SocketPath,
-               ReclaimCallback reclaim_callback = ReclaimCallback());
+               ReclaimCallback reclaim_callback = ReclaimCallback(),
+               DisconnectCallback disconnect_callback = DisconnectCallback());
     void Stop();
     bool IsRunning() const;
     std::string GetSocketPath() const;
@@ -224,8 +374,13 @@ public:
                        const std::vector<uint32_t>& expected_consumers);
     std::vector<CameraReleaseReclaim> ReclaimConsumerDisconnected(uint32_t consumer_id);
 
+    void SetDefaultConsumerQuota(uint32_t max_in_flight);
+    void SetConsumerQuota(uint32_t consumer_id, uint32_t max_in_flight);
+    std::vector<uint32_t> AdmitConsumers(const std::vector<uint32_t>& candidates);
+
     CameraReleaseServerStats GetServerStats() const;
     CameraReleaseTrackerStats GetTrackerStats() const;
+    std::vector<CameraReleaseConsumerStats> GetConsumerStats() const;
     size_t PendingFrameCount() const;
 
 private:
@@ -236,6 +391,7 @@ private:
 
     CameraReleaseTracker tracker_;
     ReclaimCallback reclaim_callback_;
+    DisconnectCallback disconnect_callback_;
 
     int server_fd_ = -1;
     std::string socket_path_;
@@ -0,0 +1,248 @@
+/**
+ * @file camera_data_socket_server.h
+ * @brief v1 数据面服务端（非阻塞发送 + 每客户端有界队列）
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#ifndef CAMERA_SUBSYSTEM_IPC_CAMERA_DATA_SOCKET_SERVER_H
+#define CAMERA_SUBSYSTEM_IPC_CAMERA_DATA_SOCKET_SERVER_H
+
+#include "camera_subsystem/core/buffer_guard.h"
+#include "camera_subsystem/core/latency_histogram.h"
+#include "camera_subsystem/ipc/camera_data_ipc.h"
+#include "camera_subsystem/platform/platform_epoll.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace camera_subsystem
+{
+namespace ipc
+{
+
+/**
+ * @brief v1 数据面服务端
+ *
+ * 采集线程只调用 Enqueue：把帧头与持有 BufferGuard 引用的帧数据放入客户端队列后立即返回，
+ * 不触碰 socket。所有客户端 socket 均为非阻塞，由单个 epoll 写线程以 sendmsg 发送；
+ * 写满时等待 EPOLLOUT，期间新帧按客户端的队列策略丢弃，慢客户端只影响自己。
+ *
+ * 已开始发送的帧不会被丢弃（否则字节流错位），因此队列长度可能短暂比上限多 1。
+ * 队列中的帧持有 BufferGuard，发送完成或丢弃后才归还 BufferPool；池耗尽时采集端丢帧，
+ * 同样不会阻塞。
+ *
+ * 帧头与帧数据由一次 sendmsg 聚合发送。可选的 TCP 监听供跨主机或回环桥接的客户端使用，
+ * 大帧以 MSG_ZEROCOPY 发送：内核直接引用 BufferGuard 内存，帧发完后转入在途列表，
+ * 直到错误队列报告完成才释放。内核报告退化为拷贝（如回环投递）时该客户端改回普通发送。
+ * Unix socket 不支持 MSG_ZEROCOPY，始终走普通发送。
+ */
+class CameraDataSocketServer
+{
+public:
+    /// @brief 队列满时的处理策略
+    enum class QueuePolicy : uint32_t
+    {
+        kDropOldest = 0, ///< 丢弃最旧的未发送帧，保留最近 max_queued_frames 帧
+        kKeepLatest = 1  ///< 只保留最新一帧，适合只关心实时画面的预览类客户端
+    };
+
+    struct Options
+    {
+        QueuePolicy policy = QueuePolicy::kDropOldest; ///< 新连接的默认策略
+        size_t max_queued_frames = 2;                  ///< 新连接的默认队列上限
+        /// Unix 客户端的 SO_SNDBUF（受 net.core.wmem_max 限制），0 保持系统默认；
+        /// 默认 208KB 时一帧 1080p 需要数十次非阻塞 sendmsg
+        size_t unix_send_buffer_bytes = 4 * 1024 * 1024;
+        bool tcp_enabled = false;         ///< 额外监听 TCP
+        std::string tcp_bind_host = "127.0.0.1";
+        uint16_t tcp_port = 0;            ///< 0 表示由内核分配，见 GetTcpPort
+        bool tcp_zero_copy = true;        ///< TCP 客户端启用 MSG_ZEROCOPY
+    };
+
+    struct Client
+    {
+        uint32_t client_id = 0;
+        pid_t pid = 0;
+    };
+
+    /// @brief 单个客户端的发送统计
+    struct ClientStats
+    {
+        uint32_t client_id = 0;
+        pid_t pid = 0;
+        QueuePolicy policy = QueuePolicy::kDropOldest;
+        size_t max_queued_frames = 0;
+        size_t queued_frames = 0;      ///< 当前排队帧数（含发送中的帧）
+        size_t peak_queued_frames = 0;
+        uint64_t enqueued_frames = 0;
+        uint64_t sent_frames = 0;
+        uint64_t dropped_frames = 0;   ///< 队列满被丢弃的帧
+        uint64_t sent_bytes = 0;
+        uint64_t blocked_count = 0;    ///< 发送遇到 EAGAIN 的次数
+        uint64_t send_calls = 0;       ///< sendmsg 调用次数（含 EAGAIN）
+        bool tcp = false;
+        bool zero_copy = false;        ///< 当前是否以 MSG_ZEROCOPY 发送
+        uint64_t zero_copy_sends = 0;
+        uint64_t zero_copy_copied = 0; ///< 内核报告退化为拷贝的完成通知数
+        size_t zero_copy_inflight = 0; ///< 已发完、等待内核完成通知的帧
+        core::LatencyHistogram::Snapshot send_lag; ///< 入队到最后一个字节写入 socket 的耗时
+    };
+
+    struct ServerStats
+    {
+        uint64_t accepted_clients = 0;
+        uint64_t closed_clients = 0;   ///< 对端关闭或发送失败而移除的连接
+        uint64_t sent_frames = 0;
+        uint64_t sent_bytes = 0;
+        uint64_t dropped_frames = 0;
+        uint64_t send_calls = 0;
+    };
+
+    CameraDataSocketServer();
+    explicit CameraDataSocketServer(const Options& options);
+    ~CameraDataSocketServer();
+
+    CameraDataSocketServer(const CameraDataSocketServer&) = delete;
+    CameraDataSocketServer& operator=(const CameraDataSocketServer&) = delete;
+
+    bool Start(const std::string& socket_path = kDefaultCameraDataSocketPath);
+    void Stop();
+    bool IsRunning() const;
+
+    /// @brief 实际监听的 TCP 端口，未启用 TCP 时为 0
+    uint16_t GetTcpPort() const;
+
+    /**
+     * @brief 把一帧放入客户端发送队列，不阻塞
+     * @param data 帧数据，须在 buffer 存活期间有效
+     * @param buffer 帧数据所在的 BufferGuard；为空时拷贝 data
+     * @return false 表示客户端不存在或正在关闭
+     */
+    bool Enqueue(uint32_t client_id,
+                 const CameraDataFrameHeader& header,
+                 const void* data,
+                 size_t length,
+                 std::shared_ptr<core::BufferGuard> buffer);
+
+    /**
+     * @brief 丢弃指定 camera 尚未发送的排队帧，归还其 BufferGuard
+     *
+     * 在 CameraSource::Reconfigure 前调用，使采集 BufferPool 能够排空。已开始发送的队首帧
+     * 不能丢弃，改为拷贝到自有存储后释放 BufferGuard；写线程正在发送该帧时，由写线程在
+     * 本次 sendmsg 返回后完成拷贝。已发完、等待零拷贝完成通知的帧仍在内核完成后释放。
+     * @return 丢弃的帧数
+     */
+    size_t DropQueuedFrames(uint32_t camera_id);
+
+    /// @brief 调整客户端的队列策略，max_queued_frames 至少为 1
+    bool SetClientQueuePolicy(uint32_t client_id, QueuePolicy policy, size_t max_queued_frames);
+
+    /// @brief 关闭客户端连接，由写线程异步完成
+    void RemoveClient(uint32_t client_id);
+
+    std::vector<Client> GetClientsSnapshot() const;
+    size_t GetClientCount() const;
+    std::vector<ClientStats> GetClientStats() const;
+    ServerStats GetServerStats() const;
+
+private:
+    struct PendingFrame
+    {
+        /// 帧头单独分配：零拷贝发送后内核仍引用其地址，队列搬移元素时地址不能变
+        std::unique_ptr<CameraDataFrameHeader> header;
+        const uint8_t* data = nullptr;
+        size_t length = 0;
+        std::shared_ptr<const void> owner; ///< BufferGuard 或拷贝出的数据
+        bool pooled = false;               ///< owner 为 BufferGuard，帧数据位于采集 BufferPool
+        size_t sent = 0;                   ///< 已写出的字节数（帧头 + 数据）
+        uint64_t enqueue_ns = 0;
+        bool zero_copy = false;            ///< 至少一次以 MSG_ZEROCOPY 发送
+        uint32_t zero_copy_seq = 0;        ///< 最后一次零拷贝发送的内核序号
+    };
+
+    struct ClientState
+    {
+        uint32_t client_id = 0;
+        int fd = -1;
+        pid_t pid = 0;
+
+        std::mutex mutex;
+        std::deque<PendingFrame> queue;
+        QueuePolicy policy = QueuePolicy::kDropOldest;
+        size_t max_queued_frames = 2;
+        bool writing = false;  ///< 写线程正在发送队首帧，队首不可丢弃
+        bool detach_head = false; ///< sendmsg 返回后把队首帧转为自有拷贝
+        bool writable = true;  ///< false 表示遇到 EAGAIN，等待 EPOLLOUT
+        bool closing = false;
+        bool tcp = false;
+        bool zero_copy = false;
+
+        // 零拷贝完成跟踪：内核按 sendmsg 调用顺序编号，完成通知为闭区间
+        uint32_t zero_copy_next_seq = 0;
+        uint32_t zero_copy_completed = 0;              ///< 此序号之前的发送均已完成
+        std::map<uint32_t, uint32_t> zero_copy_ranges; ///< 乱序到达的完成区间
+        std::deque<PendingFrame> zero_copy_inflight;
+
+        size_t peak_queued_frames = 0;
+        uint64_t enqueued_frames = 0;
+        uint64_t sent_frames = 0;
+        uint64_t dropped_frames = 0;
+        uint64_t sent_bytes = 0;
+        uint64_t blocked_count = 0;
+        uint64_t send_calls = 0;
+        uint64_t zero_copy_sends = 0;
+        uint64_t zero_copy_copied = 0;
+        core::LatencyHistogram send_lag;
+    };
+
+    void WriterLoop();
+    bool StartTcpListener();
+    void AcceptClients(int listen_fd, bool tcp);
+    void ReapZeroCopyCompletions(ClientState& client);
+    void HandleClientEvent(const std::shared_ptr<ClientState>& client, uint32_t events);
+    bool FlushClient(const std::shared_ptr<ClientState>& client);
+    void FlushPendingClients();
+    void CloseClient(const std::shared_ptr<ClientState>& client);
+    void Notify();
+
+    std::shared_ptr<ClientState> FindClient(uint32_t client_id) const;
+    size_t DropFramesLocked(ClientState& client);
+    void DetachHeadLocked(ClientState& client);
+
+    Options options_;
+    int server_fd_ = -1;
+    int tcp_server_fd_ = -1;
+    uint16_t tcp_port_ = 0;
+    int event_fd_ = -1;
+    std::string socket_path_;
+    platform::PlatformEpoll epoll_;
+    std::atomic<bool> is_running_{false};
+    std::thread writer_thread_;
+
+    mutable std::mutex clients_mutex_;
+    std::unordered_map<uint32_t, std::shared_ptr<ClientState>> clients_;
+    uint32_t next_client_id_ = 1;
+
+    std::atomic<uint64_t> accepted_clients_{0};
+    std::atomic<uint64_t> closed_clients_{0};
+    std::atomic<uint64_t> sent_frames_{0};
+    std::atomic<uint64_t> sent_bytes_{0};
+    std::atomic<uint64_t> dropped_frames_{0};
+    std::atomic<uint64_t> send_calls_{0};
+};
+
+} // namespace ipc
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_IPC_CAMERA_DATA_SOCKET_SERVER_H
@@ -0,0 +1,457 @@
+/**
+ * @file camera_shm_ring.h
+ * @brief 共享内存帧环数据面：布局定义、消费端读取器与控制面协商（仅头文件）
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ *
+ * 发布端把每帧写入 memfd 中的一个槽位（只写一次），所有本机消费者按各自的读游标原地读取，
+ * 新帧通过每个消费者独立的 eventfd 通知。memfd / eventfd 经控制面 kOpenShmRing 以
+ * SCM_RIGHTS 下发；发布端不提供时应答 kShmRingUnavailable，客户端回退 socket 数据面。
+ *
+ * 读取器只依赖本头文件，扩展进程（codec server / web gateway）无需链接 ipc 库。
+ */
+
+#ifndef CAMERA_SUBSYSTEM_IPC_CAMERA_SHM_RING_H
+#define CAMERA_SUBSYSTEM_IPC_CAMERA_SHM_RING_H
+
+#include "camera_subsystem/ipc/camera_control_ipc.h"
+#include "camera_subsystem/ipc/camera_data_ipc.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace camera_subsystem
+{
+namespace ipc
+{
+
+constexpr uint32_t kCameraShmRingMagic = 0x43534852; // "CSHR"
+constexpr uint32_t kCameraShmRingVersion = 1;
+constexpr uint32_t kCameraShmRingMaxSlots = 32;
+constexpr uint32_t kCameraShmRingMaxConsumers = 16;
+constexpr uint32_t kCameraShmRingNoSlot = UINT32_MAX;
+constexpr uint64_t kCameraShmRingSeqEmpty = UINT64_MAX - 1;
+constexpr uint64_t kCameraShmRingSeqWriting = UINT64_MAX;
+/// 槽位头（序号 + 帧头）占用的字节数，帧数据紧随其后
+constexpr size_t kCameraShmRingSlotHeaderSize = 128;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shm ring requires address-free 64-bit atomics");
+
+/**
+ * @brief 消费者记录，位于可写的头部区域；只有对应消费者写 pinned_slot / read_seq / 计数
+ */
+struct alignas(64) CameraShmRingConsumer
+{
+    std::atomic<uint32_t> active;
+    std::atomic<uint32_t> pinned_slot; ///< 正在原地读取的槽位，发布端不会覆盖
+    std::atomic<uint64_t> read_seq;    ///< 下一帧期望的序号
+    std::atomic<uint64_t> frames_read;
+    std::atomic<uint64_t> overruns;    ///< 未读即被覆盖而跳过的帧
+    int32_t pid;
+};
+
+/// @brief 帧序号到槽位的索引，下标为 seq % slot_count
+struct CameraShmRingFrameEntry
+{
+    std::atomic<uint64_t> seq;
+    std::atomic<uint32_t> slot;
+    uint32_t reserved;
+};
+
+/**
+ * @brief 环头部，位于 memfd 偏移 0，按页对齐后接槽位区域
+ */
+struct CameraShmRingHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t max_consumers;
+    uint64_t slot_capacity;  ///< 每个槽位可容纳的帧数据字节数
+    uint64_t slot_stride;
+    uint64_t slots_offset;   ///< 槽位区域在 memfd 中的偏移（页对齐）
+    std::atomic<uint64_t> write_seq; ///< 已发布的帧数，最新帧序号为 write_seq - 1
+    std::atomic<uint32_t> closed;    ///< 非 0 表示发布端已废弃该环，消费者应重新协商
+    uint32_t reserved0;
+    uint8_t reserved[64];
+    CameraShmRingFrameEntry frames[kCameraShmRingMaxSlots];
+    CameraShmRingConsumer consumers[kCameraShmRingMaxConsumers];
+};
+
+/// @brief 槽位头，位于每个槽位起始处
+struct CameraShmRingSlot
+{
+    std::atomic<uint64_t> seq; ///< 槽位中帧的序号；写入中为 kCameraShmRingSeqWriting
+    uint64_t reserved;
+    CameraDataFrameHeader header;
+};
+
+static_assert(sizeof(CameraShmRingSlot) <= kCameraShmRingSlotHeaderSize,
+              "shm ring slot header overflow");
+
+/**
+ * @brief 消费端读取器
+ *
+ * Acquire 取到的帧在 Release（或下一次 Acquire）之前原地有效：读取器先在自己的记录中
+ * 固定槽位，再确认槽位序号未变，发布端选槽时跳过被固定的槽位。读取器落后超过环长度时
+ * 跳到仍在环中的最旧帧并计入 overruns，发布端不会因消费者变慢而阻塞。
+ */
+class CameraShmRingReader
+{
+public:
+    enum class Result
+    {
+        kFrame,
+        kEmpty,
+        kClosed,
+        kError
+    };
+
+    struct Frame
+    {
+        const CameraDataFrameHeader* header = nullptr;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        uint64_t seq = 0;
+    };
+
+    CameraShmRingReader() = default;
+    ~CameraShmRingReader()
+    {
+        Close();
+    }
+
+    CameraShmRingReader(const CameraShmRingReader&) = delete;
+    CameraShmRingReader& operator=(const CameraShmRingReader&) = delete;
+
+    /**
+     * @brief 映射环并接管 memfd / eventfd（失败时同样关闭）
+     */
+    bool Open(int memfd, int eventfd, uint32_t consumer_index)
+    {
+        Close();
+        memfd_ = memfd;
+        eventfd_ = eventfd;
+
+        struct stat file_stat;
+        if (memfd_ < 0 || eventfd_ < 0 || fstat(memfd_, &file_stat) != 0 ||
+            static_cast<size_t>(file_stat.st_size) < sizeof(CameraShmRingHeader))
+        {
+            Close();
+            return false;
+        }
+        file_bytes_ = static_cast<size_t>(file_stat.st_size);
+
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        header_bytes_ = (sizeof(CameraShmRingHeader) + page - 1) / page * page;
+        void* header = mmap(nullptr, header_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, memfd_, 0);
+        if (header == MAP_FAILED)
+        {
+            header_bytes_ = 0;
+            Close();
+            return false;
+        }
+        header_ = static_cast<CameraShmRingHeader*>(header);
+
+        if (header_->magic != kCameraShmRingMagic || header_->version != kCameraShmRingVersion ||
+            header_->slot_count == 0 || header_->slot_count > kCameraShmRingMaxSlots ||
+            consumer_index >= header_->max_consumers ||
+            header_->max_consumers > kCameraShmRingMaxConsumers ||
+            header_->slots_offset < header_bytes_ ||
+            header_->slots_offset + header_->slot_stride * header_->slot_count > file_bytes_)
+        {
+            Close();
+            return false;
+        }
+
+        // 槽位区域只读映射，消费者只能写自己的记录
+        slots_bytes_ = static_cast<size_t>(header_->slot_stride * header_->slot_count);
+        void* slots = mmap(nullptr, slots_bytes_, PROT_READ, MAP_SHARED, memfd_,
+                           static_cast<off_t>(header_->slots_offset));
+        if (slots == MAP_FAILED)
+        {
+            slots_bytes_ = 0;
+            Close();
+            return false;
+        }
+        slots_ = static_cast<const uint8_t*>(slots);
+        consumer_ = &header_->consumers[consumer_index];
+        cursor_ = consumer_->read_seq.load(std::memory_order_acquire);
+        return true;
+    }
+
+    void Close()
+    {
+        if (consumer_ != nullptr)
+        {
+            consumer_->pinned_slot.store(kCameraShmRingNoSlot);
+            consumer_ = nullptr;
+        }
+        if (slots_ != nullptr)
+        {
+            munmap(const_cast<uint8_t*>(slots_), slots_bytes_);
+            slots_ = nullptr;
+        }
+        if (header_ != nullptr)
+        {
+            munmap(header_, header_bytes_);
+            header_ = nullptr;
+        }
+        if (memfd_ >= 0)
+        {
+            close(memfd_);
+            memfd_ = -1;
+        }
+        if (eventfd_ >= 0)
+        {
+            close(eventfd_);
+            eventfd_ = -1;
+        }
+    }
+
+    bool IsOpen() const
+    {
+        return consumer_ != nullptr;
+    }
+
+    int GetEventFd() const
+    {
+        return eventfd_;
+    }
+
+    /**
+     * @brief 等待新帧通知并清空 eventfd 计数
+     * @param timeout_ms 小于 0 时一直等待
+     * @return 超时或出错返回 false
+     */
+    bool WaitReadable(int timeout_ms)
+    {
+        if (eventfd_ < 0)
+        {
+            return false;
+        }
+        pollfd pfd;
+        pfd.fd = eventfd_;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, timeout_ms) <= 0)
+        {
+            return false;
+        }
+        uint64_t value = 0;
+        return read(eventfd_, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value));
+    }
+
+    /**
+     * @brief 固定并返回下一帧；latest_only 时跳过积压只取最新帧（不计入 overruns）
+     */
+    Result Acquire(Frame* frame, bool latest_only = false)
+    {
+        if (consumer_ == nullptr || frame == nullptr)
+        {
+            return Result::kError;
+        }
+        Release();
+        if (header_->closed.load(std::memory_order_acquire) != 0)
+        {
+            return Result::kClosed;
+        }
+
+        const uint32_t slot_count = header_->slot_count;
+        const uint64_t write_seq = header_->write_seq.load(std::memory_order_acquire);
+        if (write_seq == 0 || cursor_ >= write_seq)
+        {
+            return Result::kEmpty;
+        }
+
+        const uint64_t oldest = write_seq > slot_count ? write_seq - slot_count : 0;
+        uint64_t want = cursor_;
+        if (latest_only)
+        {
+            want = write_seq - 1;
+        }
+        else if (want < oldest)
+        {
+            consumer_->overruns.fetch_add(oldest - want, std::memory_order_relaxed);
+            want = oldest;
+        }
+
+        for (; want < write_seq; ++want)
+        {
+            const CameraShmRingFrameEntry& entry = header_->frames[want % slot_count];
+            const uint64_t entry_seq = entry.seq.load(std::memory_order_acquire);
+            const uint32_t slot_index = entry.slot.load(std::memory_order_acquire);
+            if (entry_seq == want && slot_index < slot_count)
+            {
+                // 先固定再核对：与发布端“先标记写入再检查固定”构成互斥
+                consumer_->pinned_slot.store(slot_index);
+                const auto* slot = SlotAt(slot_index);
+                if (slot->seq.load() == want && slot->header.frame_size <= header_->slot_capacity)
+                {
+                    cursor_ = want + 1;
+                    consumer_->read_seq.store(cursor_, std::memory_order_release);
+                    consumer_->frames_read.fetch_add(1, std::memory_order_relaxed);
+                    frame->header = &slot->header;
+                    frame->data = reinterpret_cast<const uint8_t*>(slot) +
+                                  kCameraShmRingSlotHeaderSize;
+                    frame->size = slot->header.frame_size;
+                    frame->seq = want;
+                    return Result::kFrame;
+                }
+                consumer_->pinned_slot.store(kCameraShmRingNoSlot);
+            }
+            if (!latest_only)
+            {
+                consumer_->overruns.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        cursor_ = write_seq;
+        consumer_->read_seq.store(cursor_, std::memory_order_release);
+        return Result::kEmpty;
+    }
+
+    /// @brief 解除固定，之后上一帧的指针不再有效
+    void Release()
+    {
+        if (consumer_ != nullptr &&
+            consumer_->pinned_slot.load(std::memory_order_relaxed) != kCameraShmRingNoSlot)
+        {
+            consumer_->pinned_slot.store(kCameraShmRingNoSlot, std::memory_order_release);
+        }
+    }
+
+    uint64_t GetOverruns() const
+    {
+        return consumer_ != nullptr ? consumer_->overruns.load(std::memory_order_relaxed) : 0;
+    }
+
+private:
+    const CameraShmRingSlot* SlotAt(uint32_t slot_index) const
+    {
+        return reinterpret_cast<const CameraShmRingSlot*>(slots_ +
+                                                          header_->slot_stride * slot_index);
+    }
+
+    int memfd_ = -1;
+    int eventfd_ = -1;
+    size_t file_bytes_ = 0;
+    size_t header_bytes_ = 0;
+    size_t slots_bytes_ = 0;
+    CameraShmRingHeader* header_ = nullptr;
+    const uint8_t* slots_ = nullptr;
+    CameraShmRingConsumer* consumer_ = nullptr;
+    uint64_t cursor_ = 0;
+};
+
+/**
+ * @brief 经控制面申请共享内存环
+ *
+ * 调用前须已用同一 client_id 订阅该端点。成功时 memfd / eventfd 归调用者所有；
+ * 应答为 kShmRingUnavailable 等非 kOk 状态时返回 false 且 response 有效，调用者应回退
+ * socket 数据面。
+ */
+inline bool RequestCameraShmRing(int control_fd,
+                                 const CameraEndpoint& endpoint,
+                                 const char* client_id,
+                                 CameraClientRole role,
+                                 CameraControlResponse* response,
+                                 int* memfd,
+                                 int* eventfd)
+{
+    if (control_fd < 0 || response == nullptr || memfd == nullptr || eventfd == nullptr)
+    {
+        return false;
+    }
+    *memfd = -1;
+    *eventfd = -1;
+
+    const CameraControlRequest request =
+        MakeControlRequest(CameraControlCommand::kOpenShmRing, role, endpoint, client_id);
+    const auto* out = reinterpret_cast<const uint8_t*>(&request);
+    size_t written = 0;
+    while (written < sizeof(request))
+    {
+        const ssize_t n = send(control_fd, out + written, sizeof(request) - written, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+
+    // fd 随应答的第一段字节到达，之后的分段读取不再携带控制消息
+    auto* in = reinterpret_cast<uint8_t*>(response);
+    size_t received = 0;
+    while (received < sizeof(*response))
+    {
+        iovec iov;
+        iov.iov_base = in + received;
+        iov.iov_len = sizeof(*response) - received;
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 2)];
+        msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        const ssize_t n = recvmsg(control_fd, &message, MSG_CMSG_CLOEXEC);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            break;
+        }
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+             cmsg = CMSG_NXTHDR(&message, cmsg))
+        {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
+                cmsg->cmsg_len == CMSG_LEN(sizeof(int) * 2))
+            {
+                int fds[2];
+                std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+                *memfd = fds[0];
+                *eventfd = fds[1];
+            }
+        }
+        received += static_cast<size_t>(n);
+    }
+
+    const bool ok = received == sizeof(*response) && IsControlResponseHeaderValid(*response) &&
+                    response->status == CameraControlStatus::kOk && *memfd >= 0 &&
+                    *eventfd >= 0;
+    if (!ok)
+    {
+        if (*memfd >= 0)
+        {
+            close(*memfd);
+            *memfd = -1;
+        }
+        if (*eventfd >= 0)
+        {
+            close(*eventfd);
+            *eventfd = -1;
+        }
+    }
+    return ok;
+}
+
+} // namespace ipc
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_IPC_CAMERA_SHM_RING_H
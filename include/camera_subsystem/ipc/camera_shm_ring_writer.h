@@ -0,0 +1,122 @@
+/**
+ * @file camera_shm_ring_writer.h
+ * @brief 共享内存帧环发布端
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#ifndef CAMERA_SUBSYSTEM_IPC_CAMERA_SHM_RING_WRITER_H
+#define CAMERA_SUBSYSTEM_IPC_CAMERA_SHM_RING_WRITER_H
+
+#include "camera_subsystem/ipc/camera_shm_ring.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <sys/types.h>
+#include <vector>
+
+namespace camera_subsystem
+{
+namespace ipc
+{
+
+/**
+ * @brief 共享内存帧环发布端
+ *
+ * 每帧只写入一个槽位一次，不随消费者数量增加拷贝。选槽时跳过被任一消费者固定的槽位，
+ * 全部被固定时丢弃该帧；消费者变慢只会被跳帧，发布端从不等待。
+ *
+ * Publish 由采集线程调用，AttachConsumer / DetachConsumer 由控制面线程调用，均线程安全。
+ * 消费者以读写方式映射头部，写端只读取其中各消费者的 pinned_slot / read_seq 等原子量，
+ * 且仅用于比较，不作为下标或长度使用。
+ */
+class CameraShmRingWriter
+{
+public:
+    struct ConsumerStats
+    {
+        uint32_t index = 0;
+        pid_t pid = 0;
+        uint64_t frames_read = 0;
+        uint64_t overruns = 0;
+        uint64_t lag = 0; ///< 已发布但尚未读取的帧数
+    };
+
+    struct Stats
+    {
+        uint64_t ring_id = 0;
+        uint32_t slot_count = 0;
+        size_t slot_capacity = 0;
+        uint64_t published_frames = 0;
+        uint64_t dropped_frames = 0;  ///< 所有槽位都被固定而丢弃的帧
+        std::vector<ConsumerStats> consumers;
+    };
+
+    CameraShmRingWriter();
+    ~CameraShmRingWriter();
+
+    CameraShmRingWriter(const CameraShmRingWriter&) = delete;
+    CameraShmRingWriter& operator=(const CameraShmRingWriter&) = delete;
+
+    /**
+     * @brief 创建 memfd 并初始化环
+     * @param slot_count 槽位数，不超过 kCameraShmRingMaxSlots
+     * @param slot_capacity 单个槽位可容纳的帧数据字节数
+     * @param max_consumers 消费者上限，不超过 kCameraShmRingMaxConsumers
+     */
+    bool Create(uint32_t slot_count, size_t slot_capacity, uint32_t max_consumers);
+
+    /**
+     * @brief 分配消费者位置，读游标从下一帧开始
+     * @param eventfd 输出该消费者的通知 fd，归写端所有，随授权发送给消费者
+     */
+    bool AttachConsumer(pid_t pid, uint32_t* index, int* eventfd);
+    void DetachConsumer(uint32_t index);
+
+    /**
+     * @brief 写入一帧并通知所有消费者
+     * @return 环已关闭、帧超出槽位容量或全部槽位被固定时返回 false
+     */
+    bool Publish(const CameraDataFrameHeader& header, const void* data, size_t size);
+
+    /// @brief 标记环废弃并唤醒消费者，消费者据此重新协商
+    void Close();
+
+    int GetMemFd() const;
+    uint64_t GetRingId() const;
+    size_t GetSlotCapacity() const;
+    size_t GetConsumerCount() const;
+    Stats GetStats() const;
+
+private:
+    CameraShmRingSlot* SlotAt(uint32_t slot_index) const;
+    bool IsSlotPinnedLocked(uint32_t slot_index) const;
+    void Notify(int fd) const;
+    void Destroy();
+
+    mutable std::mutex mutex_;
+    int memfd_ = -1;
+    size_t mapped_bytes_ = 0;
+    CameraShmRingHeader* header_ = nullptr;
+    uint8_t* slots_ = nullptr;
+    // 几何参数只在 Create 时记录，消费者可写映射头部，写端从不回读共享内存中的副本
+    uint32_t slot_count_ = 0;
+    size_t slot_capacity_ = 0;
+    size_t slot_stride_ = 0;
+    uint32_t max_consumers_ = 0;
+    std::array<int, kCameraShmRingMaxConsumers> eventfds_{};
+    std::array<pid_t, kCameraShmRingMaxConsumers> consumer_pids_{};
+    uint32_t next_slot_ = 0;
+    uint64_t write_seq_ = 0;
+    bool closed_ = false;
+    uint64_t ring_id_ = 0;
+    uint64_t published_frames_ = 0;
+    uint64_t dropped_frames_ = 0;
+};
+
+} // namespace ipc
+} // namespace camera_subsystem
+
+#endif // CAMERA_SUBSYSTEM_IPC_CAMERA_SHM_RING_WRITER_H
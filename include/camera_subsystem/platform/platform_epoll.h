@@ -71,6 +71,17 @@ class PlatformEpoll
      */
     bool Modify(int fd, uint32_t events);
 
+    /**
+     * @brief 修改文件描述符的事件与用户数据
+     * @param fd 文件描述符
+     * @param events 事件类型 (EPOLLONESHOT 源重新挂载时使用)
+     * @param data 用户数据
+     * @return 成功返回 true,失败返回 false
+     *
+     * @note 该函数是线程安全的
+     */
+    bool Modify(int fd, uint32_t events, uint64_t data);
+
     /**
      * @brief 从 Epoll 移除文件描述符
      * @param fd 文件描述符
@@ -106,6 +106,16 @@ class PlatformThread
      */
     bool SetPriority(int priority);
 
+    /**
+     * @brief 以 SCHED_FIFO 实时调度运行线程
+     * @param priority 实时优先级 (1-99, 数值越大优先级越高)
+     * @return 成功返回 true,失败返回 false
+     *
+     * @note 该函数是线程安全的
+     * @note 需要 root 或 CAP_SYS_NICE 权限
+     */
+    bool SetRealtimePriority(int priority);
+
     /**
      * @brief 设置线程 CPU 亲和性
      * @param cpu_ids CPU 核心 ID 列表
@@ -3,21 +3,76 @@
 #include "camera_subsystem/platform/platform_logger.h"
 
 #include <algorithm>
+#include <chrono>
 
 namespace camera_subsystem
 {
 namespace broker
 {
 
+namespace
+{
+
+// Worker 每次认领订阅者后最多连续分发的帧数，之后重新按优先级扫描
+constexpr size_t kRingDrainBatch = 4;
+
+uint64_t NowNs()
+{
+    // steady_clock 在 Linux 上即 CLOCK_MONOTONIC，与 FrameHandle::timestamp_ns_ 同源
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+/// 帧龄起点：帧时间戳有效时取时间戳，否则（或时间戳晚于当前时刻）取发布时刻
+uint64_t FrameAgeBase(const core::FrameHandle& frame, uint64_t publish_ns)
+{
+    if (frame.timestamp_ns_ == 0 || frame.timestamp_ns_ > publish_ns)
+    {
+        return publish_ns;
+    }
+    return frame.timestamp_ns_;
+}
+
+} // namespace
+
+FrameBroker::SubscriberChannel::SubscriberChannel(
+    const std::shared_ptr<IFrameSubscriber>& sub, size_t default_capacity)
+    : subscriber(sub)
+    , identity(sub.get())
+    , name(sub->GetSubscriberName() ? sub->GetSubscriberName() : "")
+    , priority(sub->GetPriority())
+    , policy(sub->GetDeliveryPolicy())
+    , depth_limit(policy == DeliveryPolicy::kKeepLatest ? 1 : sub->GetMaxQueueDepth())
+    , max_age_ns(sub->GetMaxFrameAgeNs())
+    , ring(depth_limit > 0 ? depth_limit : default_capacity)
+{
+}
+
+FrameBroker::SnapshotReadGuard::SnapshotReadGuard(const FrameBroker& broker)
+    : readers_(broker.snapshot_readers_[broker.snapshot_epoch_.load() & 1])
+{
+    readers_.fetch_add(1);
+    channels_ = broker.channels_.load();
+}
+
+FrameBroker::SnapshotReadGuard::~SnapshotReadGuard()
+{
+    readers_.fetch_sub(1, std::memory_order_release);
+}
+
 FrameBroker::FrameBroker()
-    : is_running_(false), sequence_(0), published_frames_(0), dispatched_tasks_(0),
-      dropped_tasks_(0), max_queue_size_(1024)
+    : channels_(new ChannelList()), is_running_(false), sequence_(0), published_frames_(0),
+      dispatched_tasks_(0), dropped_tasks_(0), max_queue_size_(1024)
 {
+    snapshot_readers_[0].store(0);
+    snapshot_readers_[1].store(0);
 }
 
 FrameBroker::~FrameBroker()
 {
     Stop();
+    delete channels_.load();
 }
 
 bool FrameBroker::Start(size_t worker_count)
@@ -32,11 +87,144 @@ bool FrameBroker::Start(size_t worker_count)
         worker_count = std::max(1u, std::thread::hardware_concurrency());
     }
 
+    std::vector<WorkerGroupConfig> groups = worker_groups_;
+    if (groups.empty())
+    {
+        WorkerGroupConfig group;
+        group.name = "broker_worker";
+        group.worker_count = worker_count;
+        groups.push_back(group);
+    }
+
+    // 订阅者优先级 -> 组：取阈值不超过该优先级的组中阈值最高者，否则取阈值最低的组
+    size_t lowest_group = 0;
+    for (size_t g = 1; g < groups.size(); ++g)
+    {
+        if (groups[g].min_subscriber_priority < groups[lowest_group].min_subscriber_priority)
+        {
+            lowest_group = g;
+        }
+    }
+    for (size_t priority = 0; priority < priority_group_.size(); ++priority)
+    {
+        size_t selected = lowest_group;
+        bool found = false;
+        for (size_t g = 0; g < groups.size(); ++g)
+        {
+            if (groups[g].min_subscriber_priority > priority)
+            {
+                continue;
+            }
+            if (!found ||
+                groups[g].min_subscriber_priority > groups[selected].min_subscriber_priority)
+            {
+                selected = g;
+                found = true;
+            }
+        }
+        priority_group_[priority] = static_cast<uint8_t>(selected);
+    }
+
+    {
+        // 预留共享队列存储，避免发布路径上扩容分配
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        std::vector<DispatchTask> storage;
+        storage.reserve(max_queue_size_.load());
+        task_queue_ = decltype(task_queue_)(TaskCompare(), std::move(storage));
+    }
+
+    {
+        // 清理上次停止时与发布并发遗留的帧和调度标志
+        SnapshotReadGuard snapshot(*this);
+        for (const auto& channel : snapshot.Channels())
+        {
+            DiscardChannel(*channel);
+            channel->scheduled.store(false);
+        }
+    }
+    pending_items_.store(0);
+
+    std::lock_guard<std::mutex> workers_lock(workers_mutex_);
+    group_ranges_.clear();
+    workers_.clear();
+    size_t subscriber_count = 0;
+    {
+        SnapshotReadGuard snapshot(*this);
+        subscriber_count = snapshot.Channels().size();
+    }
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+        GroupRange range;
+        range.first = workers_.size();
+        range.count = groups[g].worker_count;
+        group_ranges_.push_back(range);
+
+        for (size_t i = 0; i < groups[g].worker_count; ++i)
+        {
+            auto worker = std::make_unique<Worker>();
+            worker->name = groups[g].name + "_" + std::to_string(i);
+            worker->index = workers_.size();
+            worker->group = g;
+            worker->group_name = groups[g].name;
+            worker->ready.reserve(std::max<size_t>(16, subscriber_count * 2));
+            workers_.push_back(std::move(worker));
+        }
+    }
+
     is_running_ = true;
-    workers_.reserve(worker_count);
-    for (size_t i = 0; i < worker_count; ++i)
+    const bool ring_mode = dispatch_mode_.load() == DispatchMode::kPerSubscriberRing;
+    bool start_failed = false;
+    for (auto& worker_ptr : workers_)
     {
-        workers_.emplace_back(&FrameBroker::WorkerLoop, this);
+        Worker& worker = *worker_ptr;
+        const WorkerGroupConfig& group = groups[worker.group];
+        if (ring_mode)
+        {
+            worker.thread = std::make_unique<platform::PlatformThread>(
+                worker.name, [this, &worker]() { RingWorkerLoop(worker); });
+        }
+        else
+        {
+            worker.thread = std::make_unique<platform::PlatformThread>(
+                worker.name, [this, &worker]() { WorkerLoop(worker); });
+        }
+
+        if (!worker.thread->Start())
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "frame_broker",
+                                          "Failed to start worker %s", worker.name.c_str());
+            start_failed = true;
+            break;
+        }
+
+        if (!group.cpu_ids.empty())
+        {
+            worker.affinity_applied = worker.thread->SetCpuAffinity(group.cpu_ids);
+            if (!worker.affinity_applied)
+            {
+                platform::PlatformLogger::Log(core::LogLevel::kWarning, "frame_broker",
+                                              "Failed to set CPU affinity for %s",
+                                              worker.name.c_str());
+            }
+        }
+
+        if (group.realtime_priority > 0)
+        {
+            worker.realtime_applied = worker.thread->SetRealtimePriority(group.realtime_priority);
+            if (!worker.realtime_applied)
+            {
+                platform::PlatformLogger::Log(core::LogLevel::kWarning, "frame_broker",
+                                              "Failed to set SCHED_FIFO %d for %s",
+                                              group.realtime_priority, worker.name.c_str());
+            }
+        }
+    }
+
+    if (start_failed)
+    {
+        // 组内缺少 Worker 时路由到该槽位的订阅者将无人服务，整体回退为未运行
+        Stop();
+        return false;
     }
 
     return true;
@@ -51,20 +239,40 @@ void FrameBroker::Stop()
 
     is_running_ = false;
     queue_cv_.notify_all();
+    for (auto& worker : workers_)
+    {
+        WakeWorker(*worker);
+    }
 
     for (auto& worker : workers_)
     {
-        if (worker.joinable())
+        if (worker->thread)
         {
-            worker.join();
+            worker->thread->Join();
         }
     }
-    workers_.clear();
 
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    while (!task_queue_.empty())
     {
-        task_queue_.pop();
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        while (!task_queue_.empty())
+        {
+            task_queue_.pop();
+        }
+    }
+
+    for (auto& worker : workers_)
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->ready.clear();
+        worker->queued.store(0);
+    }
+
+    // 释放环形队列中残留帧持有的 BufferGuard
+    SnapshotReadGuard snapshot(*this);
+    for (const auto& channel : snapshot.Channels())
+    {
+        DiscardChannel(*channel);
+        channel->scheduled.store(false);
     }
 }
 
@@ -81,17 +289,36 @@ bool FrameBroker::Subscribe(const std::shared_ptr<IFrameSubscriber>& subscriber)
     }
 
     std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    const ChannelList& current = CurrentChannelsLocked();
 
-    for (const auto& weak_sub : subscribers_)
+    ChannelList channels;
+    ChannelList expired;
+    channels.reserve(current.size() + 1);
+    for (const auto& channel : current)
     {
-        auto existing = weak_sub.lock();
-        if (existing && existing.get() == subscriber.get())
+        auto existing = channel->subscriber.lock();
+        if (!existing)
+        {
+            expired.push_back(channel);
+            continue;
+        }
+        if (existing.get() == subscriber.get())
         {
             return false;
         }
+        channels.push_back(channel);
     }
 
-    subscribers_.push_back(subscriber);
+    auto channel =
+        std::make_shared<SubscriberChannel>(subscriber, subscriber_queue_capacity_.load());
+    channel->home_slot = next_home_slot_.fetch_add(1);
+    channels.push_back(std::move(channel));
+    StoreChannelsLocked(std::move(channels));
+
+    for (const auto& channel : expired)
+    {
+        RetireChannel(*channel);
+    }
     return true;
 }
 
@@ -103,28 +330,47 @@ void FrameBroker::Unsubscribe(const std::shared_ptr<IFrameSubscriber>& subscribe
     }
 
     std::lock_guard<std::mutex> lock(subscribers_mutex_);
-    subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
-                                      [&](const std::weak_ptr<IFrameSubscriber>& weak_sub)
-                                      {
-                                          auto existing = weak_sub.lock();
-                                          return !existing || existing.get() == subscriber.get();
-                                      }),
-                       subscribers_.end());
+    const ChannelList& current = CurrentChannelsLocked();
+
+    ChannelList channels;
+    ChannelList removed;
+    channels.reserve(current.size());
+    for (const auto& channel : current)
+    {
+        if (channel->subscriber.expired() || channel->identity == subscriber.get())
+        {
+            removed.push_back(channel);
+            continue;
+        }
+        channels.push_back(channel);
+    }
+    StoreChannelsLocked(std::move(channels));
+
+    for (const auto& channel : removed)
+    {
+        RetireChannel(*channel);
+    }
 }
 
 void FrameBroker::ClearSubscribers()
 {
     std::lock_guard<std::mutex> lock(subscribers_mutex_);
-    subscribers_.clear();
+    const ChannelList removed = CurrentChannelsLocked();
+    StoreChannelsLocked(ChannelList());
+
+    for (const auto& channel : removed)
+    {
+        RetireChannel(*channel);
+    }
 }
 
 size_t FrameBroker::GetSubscriberCount() const
 {
-    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    SnapshotReadGuard snapshot(*this);
     size_t count = 0;
-    for (const auto& weak_sub : subscribers_)
+    for (const auto& channel : snapshot.Channels())
     {
-        if (!weak_sub.expired())
+        if (!channel->subscriber.expired())
         {
             ++count;
         }
@@ -145,31 +391,27 @@ void FrameBroker::PublishFrame(const core::FrameHandle& frame,
         return;
     }
 
-    std::vector<std::shared_ptr<IFrameSubscriber>> subscribers;
+    if (dispatch_mode_.load() == DispatchMode::kPerSubscriberRing)
     {
-        std::lock_guard<std::mutex> lock(subscribers_mutex_);
-        CleanupExpiredSubscribersLocked();
-
-        for (const auto& weak_sub : subscribers_)
-        {
-            auto sub = weak_sub.lock();
-            if (sub)
-            {
-                subscribers.push_back(sub);
-            }
-        }
+        PublishPerSubscriber(frame, buffer_ref);
+    }
+    else
+    {
+        PublishShared(frame, buffer_ref);
     }
+}
 
-    if (subscribers.empty())
+void FrameBroker::PublishShared(const core::FrameHandle& frame,
+                                const std::shared_ptr<core::BufferGuard>& buffer_ref)
+{
+    // 快照已按优先级排序：发布路径不加订阅者锁、不分配、不排序
+    SnapshotReadGuard snapshot(*this);
+    const ChannelList& channels = snapshot.Channels();
+    if (channels.empty())
     {
         return;
     }
 
-    std::sort(
-        subscribers.begin(), subscribers.end(),
-        [](const std::shared_ptr<IFrameSubscriber>& a, const std::shared_ptr<IFrameSubscriber>& b)
-        { return a->GetPriority() > b->GetPriority(); });
-
     if (buffer_ref)
     {
         // ARCH-002: Buffer 从 InUse 进入 InFlight 状态
@@ -177,24 +419,61 @@ void FrameBroker::PublishFrame(const core::FrameHandle& frame,
     }
 
     published_frames_.fetch_add(1);
+    const uint64_t age_base_ns = FrameAgeBase(frame, NowNs());
 
     {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        for (const auto& sub : subscribers)
+        std::unique_lock<std::mutex> lock(queue_mutex_, std::try_to_lock);
+        if (!lock.owns_lock())
         {
-            if (task_queue_.size() >= max_queue_size_.load())
+            queue_lock_contention_.fetch_add(1);
+            lock.lock();
+        }
+
+        for (const auto& channel_ref : channels)
+        {
+            SubscriberChannel& channel = *channel_ref;
+            auto subscriber = channel.subscriber.lock();
+            if (!subscriber)
+            {
+                continue;
+            }
+
+            if (channel.UsesRing(DispatchMode::kSharedQueue))
+            {
+                // 邮箱类策略：帧进入订阅者独占环形队列，共享队列中只保留一个调度令牌
+                DispatchItem item;
+                item.frame = frame;
+                item.buffer_ref = buffer_ref;
+                item.sequence = sequence_.fetch_add(1);
+                item.deadline_ns = channel.max_age_ns > 0 ? age_base_ns + channel.max_age_ns : 0;
+
+                size_t evicted = 0;
+                if (PushToChannel(channel, std::move(item), &evicted))
+                {
+                    ScheduleMailboxLocked(channel_ref, subscriber);
+                }
+                continue;
+            }
+
+            if (task_queue_.size() >= max_queue_size_.load() ||
+                (channel.depth_limit > 0 && channel.pending.load() >= channel.depth_limit))
             {
                 dropped_tasks_.fetch_add(1);
+                channel.dropped.fetch_add(1);
                 continue;
             }
 
             DispatchTask task;
             task.frame = frame;
-            task.subscriber = sub;
+            task.subscriber = std::move(subscriber);
+            task.channel = channel_ref;
             task.buffer_ref = buffer_ref;
-            task.priority = sub->GetPriority();
+            task.priority = channel.priority;
             task.sequence = sequence_.fetch_add(1);
+            task.deadline_ns = channel.max_age_ns > 0 ? age_base_ns + channel.max_age_ns : 0;
 
+            channel.enqueued.fetch_add(1);
+            channel.pending.fetch_add(1);
             task_queue_.push(std::move(task));
         }
     }
@@ -202,6 +481,202 @@ void FrameBroker::PublishFrame(const core::FrameHandle& frame,
     queue_cv_.notify_all();
 }
 
+void FrameBroker::PublishPerSubscriber(const core::FrameHandle& frame,
+                                       const std::shared_ptr<core::BufferGuard>& buffer_ref)
+{
+    SnapshotReadGuard snapshot(*this);
+    const ChannelList& channels = snapshot.Channels();
+    if (channels.empty())
+    {
+        return;
+    }
+
+    if (buffer_ref)
+    {
+        // ARCH-002: Buffer 从 InUse 进入 InFlight 状态
+        buffer_ref->MarkInFlight();
+    }
+
+    published_frames_.fetch_add(1);
+    const uint64_t age_base_ns = FrameAgeBase(frame, NowNs());
+
+    for (const auto& channel : channels)
+    {
+        if (channel->subscriber.expired())
+        {
+            continue;
+        }
+
+        DispatchItem item;
+        item.frame = frame;
+        item.buffer_ref = buffer_ref;
+        item.sequence = sequence_.fetch_add(1);
+        item.deadline_ns = channel->max_age_ns > 0 ? age_base_ns + channel->max_age_ns : 0;
+
+        // 先计数再入队，保证 Worker 出队后的递减不会出现下溢
+        pending_items_.fetch_add(1);
+        size_t evicted = 0;
+        const bool ok = PushToChannel(*channel, std::move(item), &evicted);
+        if (evicted > 0)
+        {
+            pending_items_.fetch_sub(evicted);
+        }
+
+        if (!ok)
+        {
+            pending_items_.fetch_sub(1);
+            continue;
+        }
+
+        if (!channel->scheduled.exchange(true))
+        {
+            ScheduleChannel(channel);
+        }
+
+        // 与 RetireChannel 配对：若订阅者已在入队期间被移除，由发布方负责清理
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (channel->removed.load(std::memory_order_relaxed))
+        {
+            DiscardChannel(*channel);
+        }
+    }
+}
+
+bool FrameBroker::PushToChannel(SubscriberChannel& channel, DispatchItem&& item,
+                                size_t* evicted)
+{
+    *evicted = 0;
+    uint64_t contention = 0;
+    bool ok = channel.ring.TryPush(std::move(item), &contention);
+
+    // kKeepLatest / kDropOldest：淘汰最旧的未投递帧（同时释放其 BufferGuard）后重试
+    while (!ok && channel.policy != DeliveryPolicy::kQueue && *evicted < channel.ring.Capacity())
+    {
+        if (channel.ring.TryPop(nullptr, &contention))
+        {
+            ++(*evicted);
+            if (channel.policy == DeliveryPolicy::kKeepLatest)
+            {
+                channel.replaced.fetch_add(1);
+                replaced_tasks_.fetch_add(1);
+            }
+            else
+            {
+                channel.dropped.fetch_add(1);
+                dropped_tasks_.fetch_add(1);
+            }
+        }
+        ok = channel.ring.TryPush(std::move(item), &contention);
+    }
+
+    if (contention > 0)
+    {
+        channel.enqueue_contention.fetch_add(contention);
+    }
+
+    if (!ok)
+    {
+        channel.dropped.fetch_add(1);
+        dropped_tasks_.fetch_add(1);
+        return false;
+    }
+
+    channel.enqueued.fetch_add(1);
+    return true;
+}
+
+void FrameBroker::ScheduleMailboxLocked(const std::shared_ptr<SubscriberChannel>& channel,
+                                        const std::shared_ptr<IFrameSubscriber>& subscriber)
+{
+    if (channel->scheduled.exchange(true))
+    {
+        return;
+    }
+
+    DispatchTask task;
+    task.subscriber = subscriber;
+    task.channel = channel;
+    task.priority = channel->priority;
+    task.sequence = sequence_.fetch_add(1);
+    task_queue_.push(std::move(task));
+}
+
+void FrameBroker::RescheduleMailbox(const std::shared_ptr<SubscriberChannel>& channel,
+                                    const std::shared_ptr<IFrameSubscriber>& subscriber)
+{
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    channel->scheduled.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!channel->ring.Empty() && is_running_)
+    {
+        ScheduleMailboxLocked(channel, subscriber);
+        queue_cv_.notify_one();
+    }
+}
+
+bool FrameBroker::SetWorkerGroups(const std::vector<WorkerGroupConfig>& groups)
+{
+    if (is_running_)
+    {
+        return false;
+    }
+
+    // 共享队列由所有 Worker 竞争出队，无法按组路由
+    if (!groups.empty() && dispatch_mode_.load() != DispatchMode::kPerSubscriberRing)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "frame_broker",
+                                      "Worker groups require kPerSubscriberRing dispatch mode");
+        return false;
+    }
+
+    for (const auto& group : groups)
+    {
+        if (group.worker_count == 0)
+        {
+            return false;
+        }
+    }
+
+    worker_groups_ = groups;
+    return true;
+}
+
+std::vector<FrameBroker::WorkerGroupConfig> FrameBroker::GetWorkerGroups() const
+{
+    return worker_groups_;
+}
+
+bool FrameBroker::SetDispatchMode(DispatchMode mode)
+{
+    if (is_running_)
+    {
+        return false;
+    }
+    if (mode != DispatchMode::kPerSubscriberRing && !worker_groups_.empty())
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "frame_broker",
+                                      "Clear worker groups before switching to kSharedQueue");
+        return false;
+    }
+    dispatch_mode_.store(mode);
+    return true;
+}
+
+FrameBroker::DispatchMode FrameBroker::GetDispatchMode() const
+{
+    return dispatch_mode_.load();
+}
+
+void FrameBroker::SetSubscriberQueueCapacity(size_t capacity)
+{
+    subscriber_queue_capacity_.store(std::max<size_t>(1, capacity));
+}
+
+size_t FrameBroker::GetSubscriberQueueCapacity() const
+{
+    return subscriber_queue_capacity_.load();
+}
+
 void FrameBroker::SetMaxQueueSize(size_t max_queue_size)
 {
     max_queue_size_.store(max_queue_size);
@@ -218,23 +693,87 @@ FrameBroker::Stats FrameBroker::GetStats() const
     stats.published_frames = published_frames_.load();
     stats.dispatched_tasks = dispatched_tasks_.load();
     stats.dropped_tasks = dropped_tasks_.load();
-    stats.subscriber_count = GetSubscriberCount();
+    stats.replaced_tasks = replaced_tasks_.load();
+    stats.expired_tasks = expired_tasks_.load();
+    stats.dispatch_mode = dispatch_mode_.load();
+    stats.queue_lock_contention = queue_lock_contention_.load();
 
+    const bool ring_mode = stats.dispatch_mode == DispatchMode::kPerSubscriberRing;
+    if (ring_mode)
+    {
+        stats.queue_size = pending_items_.load();
+    }
+    else
     {
         std::lock_guard<std::mutex> lock(queue_mutex_);
         stats.queue_size = task_queue_.size();
     }
 
+    SnapshotReadGuard snapshot(*this);
+    stats.subscribers.reserve(snapshot.Channels().size());
+    for (const auto& channel : snapshot.Channels())
+    {
+        if (channel->subscriber.expired())
+        {
+            continue;
+        }
+
+        SubscriberStats sub_stats;
+        sub_stats.name = channel->name;
+        sub_stats.priority = channel->priority;
+        sub_stats.policy = channel->policy;
+        if (channel->UsesRing(stats.dispatch_mode))
+        {
+            sub_stats.queue_depth = channel->ring.Size();
+            sub_stats.queue_capacity = channel->ring.Capacity();
+        }
+        else
+        {
+            sub_stats.queue_depth = channel->pending.load();
+            sub_stats.queue_capacity = channel->depth_limit;
+        }
+        sub_stats.enqueued = channel->enqueued.load();
+        sub_stats.dispatched = channel->dispatched.load();
+        sub_stats.dropped = channel->dropped.load();
+        sub_stats.replaced = channel->replaced.load();
+        sub_stats.expired = channel->expired.load();
+        sub_stats.max_frame_age_ns = channel->max_age_ns;
+        sub_stats.enqueue_contention = channel->enqueue_contention.load();
+        sub_stats.dispatch_contention = channel->dispatch_contention.load();
+        stats.subscribers.push_back(std::move(sub_stats));
+    }
+    stats.subscriber_count = stats.subscribers.size();
+
+    std::lock_guard<std::mutex> workers_lock(workers_mutex_);
+    stats.workers.reserve(workers_.size());
+    for (const auto& worker : workers_)
+    {
+        WorkerStats worker_stats;
+        worker_stats.name = worker->name;
+        worker_stats.group = worker->group_name;
+        worker_stats.dispatched = worker->dispatched.load();
+        worker_stats.stolen = worker->stolen.load();
+        worker_stats.wakeups = worker->wakeups.load();
+        worker_stats.affinity_applied = worker->affinity_applied;
+        worker_stats.realtime_applied = worker->realtime_applied;
+        stats.workers.push_back(std::move(worker_stats));
+    }
+
     return stats;
 }
 
-void FrameBroker::WorkerLoop()
+void FrameBroker::WorkerLoop(Worker& self)
 {
     while (true)
     {
         DispatchTask task;
         {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
+            std::unique_lock<std::mutex> lock(queue_mutex_, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                queue_lock_contention_.fetch_add(1);
+                lock.lock();
+            }
             queue_cv_.wait(lock, [&]() { return !task_queue_.empty() || !is_running_; });
 
             if (!is_running_ && task_queue_.empty())
@@ -242,33 +781,324 @@ void FrameBroker::WorkerLoop()
                 return;
             }
 
-            task = std::move(task_queue_.top());
+            task = std::move(const_cast<DispatchTask&>(task_queue_.top()));
             task_queue_.pop();
         }
 
+        if (!task.channel)
+        {
+            continue;
+        }
+
+        if (task.channel->UsesRing(DispatchMode::kSharedQueue))
+        {
+            // 邮箱调度令牌：每次只投递一帧，剩余帧重新排队以保持订阅者间的优先级交错；
+            // 过期帧直接跳过，继续取下一帧
+            DispatchItem item;
+            while (task.channel->ring.TryPop(&item))
+            {
+                if (ExpireIfStale(*task.channel, item.deadline_ns))
+                {
+                    item = DispatchItem();
+                    continue;
+                }
+                if (task.subscriber)
+                {
+                    Deliver(*task.channel, *task.subscriber, item.frame);
+                    self.dispatched.fetch_add(1);
+                }
+                break;
+            }
+            item.buffer_ref.reset();
+            RescheduleMailbox(task.channel, task.subscriber);
+            continue;
+        }
+
+        task.channel->pending.fetch_sub(1);
+        if (ExpireIfStale(*task.channel, task.deadline_ns))
+        {
+            continue;
+        }
         if (task.subscriber)
         {
-            try
+            Deliver(*task.channel, *task.subscriber, task.frame);
+            self.dispatched.fetch_add(1);
+        }
+    }
+}
+
+void FrameBroker::RingWorkerLoop(Worker& self)
+{
+    while (true)
+    {
+        auto channel = TakeReady(self);
+        if (channel)
+        {
+            self.dispatched.fetch_add(DrainChannel(*channel, kRingDrainBatch));
+
+            // 仍有帧则放回本地就绪队列（保持调度令牌）；否则释放令牌后复查，
+            // 避免与发布方的 scheduled.exchange 交错导致帧滞留
+            if (!channel->ring.Empty())
             {
-                task.subscriber->OnFrame(task.frame);
-                dispatched_tasks_.fetch_add(1);
+                EnqueueReady(self, channel);
+                continue;
             }
-            catch (const std::exception& e)
+            channel->scheduled.store(false);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!channel->ring.Empty() && !channel->scheduled.exchange(true))
             {
-                platform::PlatformLogger::Log(core::LogLevel::kError, "frame_broker",
-                                              "Subscriber %s threw exception: %s",
-                                              task.subscriber->GetSubscriberName(), e.what());
+                EnqueueReady(self, channel);
             }
+            continue;
+        }
+
+        if (!is_running_ && !GroupHasWork(self.group))
+        {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(self.mutex);
+        self.sleeping.store(true);
+        // 与 WakeForWork 配对：先声明休眠再复查组内待处理单元，两侧均为 seq_cst
+        if (!self.wake && is_running_ && !GroupHasWork(self.group))
+        {
+            self.cv.wait(lock, [&]() { return self.wake || !is_running_; });
+            self.wakeups.fetch_add(1);
         }
+        self.wake = false;
+        self.sleeping.store(false);
+    }
+}
+
+void FrameBroker::ScheduleChannel(const std::shared_ptr<SubscriberChannel>& channel)
+{
+    const GroupRange& range = group_ranges_[priority_group_[channel->priority]];
+    if (range.count == 0)
+    {
+        return;
     }
+
+    Worker& target = *workers_[range.first + channel->home_slot % range.count];
+    EnqueueReady(target, channel);
+    WakeForWork(target);
 }
 
-void FrameBroker::CleanupExpiredSubscribersLocked()
+void FrameBroker::EnqueueReady(Worker& worker, const std::shared_ptr<SubscriberChannel>& channel)
 {
-    subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
-                                      [](const std::weak_ptr<IFrameSubscriber>& weak_sub)
-                                      { return weak_sub.expired(); }),
-                       subscribers_.end());
+    size_t queued = 0;
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.ready.push_back(channel);
+        queued = worker.queued.fetch_add(1) + 1;
+    }
+
+    // 本地积压多于一个单元时唤醒同组空闲 Worker 来窃取
+    if (queued > 1 && !worker.sleeping.load())
+    {
+        WakeForWork(worker);
+    }
+}
+
+std::shared_ptr<FrameBroker::SubscriberChannel> FrameBroker::TakeReady(Worker& self)
+{
+    {
+        std::lock_guard<std::mutex> lock(self.mutex);
+        if (!self.ready.empty())
+        {
+            // 本地：取优先级最高者（同优先级取最早入队者）
+            size_t best = 0;
+            for (size_t i = 1; i < self.ready.size(); ++i)
+            {
+                if (self.ready[i]->priority > self.ready[best]->priority)
+                {
+                    best = i;
+                }
+            }
+            auto channel = std::move(self.ready[best]);
+            self.ready.erase(self.ready.begin() + static_cast<std::ptrdiff_t>(best));
+            self.queued.fetch_sub(1);
+            return channel;
+        }
+    }
+
+    // 窃取：从同组其他 Worker 的队首取最早入队的单元
+    const GroupRange& range = group_ranges_[self.group];
+    for (size_t offset = 1; offset < range.count; ++offset)
+    {
+        Worker& victim =
+            *workers_[range.first + (self.index - range.first + offset) % range.count];
+        if (victim.queued.load() == 0)
+        {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.ready.empty())
+        {
+            continue;
+        }
+        auto channel = std::move(victim.ready.front());
+        victim.ready.erase(victim.ready.begin());
+        victim.queued.fetch_sub(1);
+        self.stolen.fetch_add(1);
+        channel->dispatch_contention.fetch_add(1);
+        return channel;
+    }
+
+    return nullptr;
+}
+
+bool FrameBroker::GroupHasWork(size_t group) const
+{
+    const GroupRange& range = group_ranges_[group];
+    for (size_t i = 0; i < range.count; ++i)
+    {
+        if (workers_[range.first + i]->queued.load() > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FrameBroker::WakeWorker(Worker& worker)
+{
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.wake = true;
+    }
+    worker.cv.notify_one();
+}
+
+void FrameBroker::WakeForWork(Worker& target)
+{
+    // 优先唤醒目标 Worker；其忙碌时唤醒同组一个休眠 Worker 去窃取
+    if (target.sleeping.load())
+    {
+        WakeWorker(target);
+        return;
+    }
+
+    const GroupRange& range = group_ranges_[target.group];
+    for (size_t i = 0; i < range.count; ++i)
+    {
+        Worker& sibling = *workers_[range.first + i];
+        if (&sibling != &target && sibling.sleeping.load())
+        {
+            WakeWorker(sibling);
+            return;
+        }
+    }
+}
+
+size_t FrameBroker::DrainChannel(SubscriberChannel& channel, size_t max_items)
+{
+    size_t delivered = 0;
+    DispatchItem item;
+    for (size_t processed = 0; processed < max_items; ++processed)
+    {
+        if (!channel.ring.TryPop(&item))
+        {
+            break;
+        }
+        pending_items_.fetch_sub(1);
+
+        if (ExpireIfStale(channel, item.deadline_ns))
+        {
+            item = DispatchItem();
+            continue;
+        }
+        ++delivered;
+
+        auto subscriber = channel.subscriber.lock();
+        if (subscriber)
+        {
+            Deliver(channel, *subscriber, item.frame);
+        }
+        item.buffer_ref.reset();
+    }
+    return delivered;
+}
+
+bool FrameBroker::ExpireIfStale(SubscriberChannel& channel, uint64_t deadline_ns)
+{
+    if (deadline_ns == 0 || NowNs() <= deadline_ns)
+    {
+        return false;
+    }
+
+    channel.expired.fetch_add(1);
+    expired_tasks_.fetch_add(1);
+    return true;
+}
+
+void FrameBroker::RetireChannel(SubscriberChannel& channel)
+{
+    // 被移除的订阅者不再被调度，需主动丢弃其残留帧，避免 pending_items_ 无法归零
+    channel.removed.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    DiscardChannel(channel);
+}
+
+void FrameBroker::DiscardChannel(SubscriberChannel& channel)
+{
+    const bool ring_mode = dispatch_mode_.load() == DispatchMode::kPerSubscriberRing;
+    while (channel.ring.TryPop(nullptr))
+    {
+        if (ring_mode)
+        {
+            pending_items_.fetch_sub(1);
+        }
+    }
+}
+
+void FrameBroker::Deliver(SubscriberChannel& channel, IFrameSubscriber& subscriber,
+                          const core::FrameHandle& frame)
+{
+    try
+    {
+        subscriber.OnFrame(frame);
+        dispatched_tasks_.fetch_add(1);
+        channel.dispatched.fetch_add(1);
+    }
+    catch (const std::exception& e)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "frame_broker",
+                                      "Subscriber %s threw exception: %s",
+                                      subscriber.GetSubscriberName(), e.what());
+    }
+}
+
+const FrameBroker::ChannelList& FrameBroker::CurrentChannelsLocked() const
+{
+    // 写侧持有 subscribers_mutex_，快照不会被并发替换
+    return *channels_.load();
+}
+
+void FrameBroker::StoreChannelsLocked(ChannelList channels)
+{
+    // 快照按优先级降序排列，Worker 与 PublishFrame 只读访问
+    std::stable_sort(channels.begin(), channels.end(),
+                     [](const std::shared_ptr<SubscriberChannel>& a,
+                        const std::shared_ptr<SubscriberChannel>& b)
+                     { return a->priority > b->priority; });
+
+    const ChannelList* previous = channels_.exchange(new ChannelList(std::move(channels)));
+    SynchronizeSnapshotReaders();
+    delete previous;
+}
+
+void FrameBroker::SynchronizeSnapshotReaders()
+{
+    // 两次翻转 epoch 并分别等待对应奇偶的读者退出：之后不可能再有读者持有旧快照
+    for (int i = 0; i < 2; ++i)
+    {
+        const uint64_t epoch = snapshot_epoch_.fetch_add(1);
+        while (snapshot_readers_[epoch & 1].load() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
 }
 
 } // namespace broker
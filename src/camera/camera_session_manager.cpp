@@ -22,6 +22,7 @@ CameraSessionManager::CameraSessionManager(SessionStartCallback start_callback,
     : core_publisher_id_()
     , start_callback_(std::move(start_callback))
     , stop_callback_(std::move(stop_callback))
+    , reconfigure_callback_()
     , sessions_()
 {
 }
@@ -232,6 +233,62 @@ bool CameraSessionManager::Unsubscribe(const std::string& client_id,
     return true;
 }
 
+void CameraSessionManager::SetReconfigureCallback(SessionReconfigureCallback callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    reconfigure_callback_ = std::move(callback);
+}
+
+bool CameraSessionManager::Reconfigure(const std::string& client_id,
+                                       const ipc::CameraEndpoint& endpoint,
+                                       const ipc::CameraStreamFormat& format)
+{
+    if (client_id.empty())
+    {
+        return false;
+    }
+
+    const EndpointKey key = BuildEndpointKey(NormalizeEndpoint(endpoint));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(key);
+    if (it == sessions_.end() || !it->second.is_streaming ||
+        it->second.members.find(client_id) == it->second.members.end())
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kWarning,
+                                      "camera_session_manager",
+                                      "Reconfigure rejected: %s is not streaming from this "
+                                      "session",
+                                      client_id.c_str());
+        return false;
+    }
+
+    if (!reconfigure_callback_)
+    {
+        return false;
+    }
+
+    // 与启停回调一样在锁内执行，切换期间不会有并发的订阅 / 退订改变会话状态
+    try
+    {
+        return reconfigure_callback_(it->second.endpoint, format);
+    }
+    catch (const std::exception& e)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError,
+                                      "camera_session_manager",
+                                      "Reconfigure callback exception: %s",
+                                      e.what());
+    }
+    catch (...)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError,
+                                      "camera_session_manager",
+                                      "Reconfigure callback exception: unknown");
+    }
+    return false;
+}
+
 uint32_t CameraSessionManager::GetSubscriberCount(const ipc::CameraEndpoint& endpoint) const
 {
     const EndpointKey key = BuildEndpointKey(NormalizeEndpoint(endpoint));
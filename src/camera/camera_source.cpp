@@ -4,6 +4,7 @@
 #include "camera_subsystem/platform/platform_logger.h"
 
 #include <algorithm>
+#include <array>
 #include <cerrno>
 #include <chrono>
 #include <cstring>
@@ -13,7 +14,6 @@
 #include <memory>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
-#include <sys/select.h>
 #include <thread>
 #include <unistd.h>
 
@@ -25,6 +25,18 @@ namespace camera
 namespace
 {
 
+constexpr size_t kElasticMinClassSize = 64 * 1024;
+constexpr uint64_t kElasticTrimFrameInterval = 64;
+/// CameraConfig::IsValid 允许的最大 buffer 数
+constexpr uint32_t kMaxCaptureBufferCount = 8;
+
+uint64_t MonotonicNowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
 int Xioctl(int fd, int request, void* arg)
 {
     int ret = 0;
@@ -35,6 +47,52 @@ int Xioctl(int fd, int request, void* arg)
     return ret;
 }
 
+/**
+ * @brief 按缓冲区类型初始化 v4l2_buffer；MPLANE 时挂上调用者提供的 plane 数组
+ */
+void InitV4L2Buffer(struct v4l2_buffer& buf, struct v4l2_plane* planes, uint32_t buf_type,
+                    uint32_t memory, uint32_t plane_count)
+{
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = buf_type;
+    buf.memory = memory;
+    if (buf_type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE)
+    {
+        std::memset(planes, 0, sizeof(struct v4l2_plane) * VIDEO_MAX_PLANES);
+        buf.m.planes = planes;
+        buf.length = plane_count;
+    }
+}
+
+/**
+ * @brief QBUF 一个采集 buffer；DMABUF 导入模式需给出该 buffer 各 plane 的 fd 与长度
+ */
+int QueueCaptureBuffer(int device_fd, uint32_t buf_type, uint32_t memory, uint32_t index,
+                       uint32_t plane_count, const int* fds, const uint32_t* lengths)
+{
+    struct v4l2_buffer buf;
+    struct v4l2_plane planes[VIDEO_MAX_PLANES];
+    InitV4L2Buffer(buf, planes, buf_type, memory, plane_count);
+    buf.index = index;
+    if (memory == V4L2_MEMORY_DMABUF && fds != nullptr && lengths != nullptr)
+    {
+        if (buf_type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE)
+        {
+            for (uint32_t p = 0; p < plane_count; ++p)
+            {
+                planes[p].m.fd = fds[p];
+                planes[p].length = lengths[p];
+            }
+        }
+        else
+        {
+            buf.m.fd = fds[0];
+            buf.length = lengths[0];
+        }
+    }
+    return Xioctl(device_fd, VIDIOC_QBUF, &buf);
+}
+
 } // namespace
 
 CameraSource::CameraSource()
@@ -42,6 +100,8 @@ CameraSource::CameraSource()
     , device_path_("/dev/video0")
     , device_fd_(-1)
     , streaming_(false)
+    , buf_type_(V4L2_BUF_TYPE_VIDEO_CAPTURE)
+    , v4l2_memory_(V4L2_MEMORY_MMAP)
     , requeue_context_(std::make_shared<RequeueContext>())
     , is_running_(false)
     , frame_count_(0)
@@ -61,6 +121,7 @@ bool CameraSource::Initialize(const core::CameraConfig& config)
 {
     Stop();
     CleanupDmaBufExports();
+    InvalidateLeases();
     CleanupBuffers();
     CloseDevice();
 
@@ -69,49 +130,116 @@ bool CameraSource::Initialize(const core::CameraConfig& config)
         return false;
     }
 
-    config_ = config;
-
-    if (!OpenDevice())
+    if (!capture_backend_ && !OpenDevice())
     {
         return false;
     }
 
-    if (!ConfigureDevice())
+    if (!ApplyConfig(config))
     {
+        CleanupDmaBufExports();
+        CleanupBuffers();
         CloseDevice();
         return false;
     }
+    return true;
+}
 
-    if (!InitMMap())
+bool CameraSource::ApplyConfig(const core::CameraConfig& config)
+{
+    config_ = config;
+    if (adaptive_buffers_enabled_ && adaptive_buffer_count_.load() != 0)
+    {
+        // 上次运行中控制器给出的 buffer 数在重新初始化时生效，收缩只发生在这里
+        config_.buffer_count_ = adaptive_buffer_count_.load();
+    }
+
+    if (!capture_backend_ && !ConfigureDevice())
+    {
+        return false;
+    }
+
+    bool buffers_ok = false;
+    if (capture_backend_)
+    {
+        buffers_ok = InitBackend();
+    }
+    else if (config_.io_method_ == static_cast<uint32_t>(core::IoMethod::kDmaBufImport))
+    {
+        buffers_ok = InitDmaBufImport();
+    }
+    else if (config_.io_method_ == static_cast<uint32_t>(core::IoMethod::kUserPtr))
+    {
+        buffers_ok = InitUserPtr();
+        if (!buffers_ok)
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                          "USERPTR capture unavailable, falling back to MMAP copy");
+            CleanupBuffers();
+            buffers_ok = InitMMap();
+        }
+    }
+    else
+    {
+        buffers_ok = InitMMap();
+    }
+    if (!buffers_ok)
     {
-        CleanupDmaBufExports();
-        CleanupBuffers();
-        CloseDevice();
         return false;
     }
 
+    // 拷贝路径把所有内存 plane 依次排入同一个 Buffer
     pool_buffer_size_ = 0;
     if (!buffers_.empty())
     {
-        pool_buffer_size_ = buffers_[0].length;
+        for (uint32_t p = 0; p < buffers_[0].plane_count; ++p)
+        {
+            pool_buffer_size_ += buffers_[0].planes[p].length;
+        }
     }
     if (pool_buffer_size_ == 0)
     {
         pool_buffer_size_ = CalculateBufferSize(config_);
     }
 
-    if (!buffer_pool_.Initialize(config_.buffer_count_, pool_buffer_size_))
+    // USERPTR 模式的 BufferPool 已在 InitUserPtr 中按驱动 buffer 数建立
+    buffer_pool_share_fd_ = -1;
+    elastic_buffer_pool_ = v4l2_memory_ != V4L2_MEMORY_USERPTR && UseElasticBufferPool();
+    bool pool_ok = true;
+    if (elastic_buffer_pool_)
+    {
+        pool_ok = buffer_pool_.InitializeElastic(MakeElasticPoolOptions());
+    }
+    else if (v4l2_memory_ != V4L2_MEMORY_USERPTR)
+    {
+        pool_ok = buffer_pool_.Initialize(config_.buffer_count_, pool_buffer_size_,
+                                          buffer_pool_options_);
+    }
+    if (!pool_ok)
     {
-        CleanupDmaBufExports();
-        CleanupBuffers();
-        CloseDevice();
         return false;
     }
 
+    buffer_pool_share_fd_ = buffer_pool_.GetShareFd();
+    const auto pool_stats = buffer_pool_.GetStats();
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_source",
+                                  "BufferPool backing=%s stride=%zu arena_bytes=%zu locked=%d "
+                                  "elastic_classes=%zu",
+                                  core::BufferBackingToString(pool_stats.backing),
+                                  pool_stats.slot_stride, pool_stats.arena_bytes,
+                                  pool_stats.memory_locked ? 1 : 0,
+                                  pool_stats.size_classes.size());
+
+    NotifyLeaseBudget();
     return true;
 }
 
 bool CameraSource::Start()
+{
+    return StartCapture(true);
+}
+
+bool CameraSource::StartCapture(bool reset_counters)
 {
     if (is_running_)
     {
@@ -133,13 +261,76 @@ bool CameraSource::Start()
     {
         std::lock_guard<std::mutex> lock(requeue_context_->mutex);
         requeue_context_->device_fd = device_fd_;
+        requeue_context_->backend = capture_backend_;
+        requeue_context_->buf_type = buf_type_;
+        requeue_context_->memory = v4l2_memory_;
+        requeue_context_->plane_count = memory_plane_count_;
+        requeue_context_->import_fds.clear();
+        requeue_context_->import_lengths.clear();
+        if (v4l2_memory_ == V4L2_MEMORY_DMABUF)
+        {
+            for (const auto& buffer : buffers_)
+            {
+                std::array<int, core::kMaxFramePlanes> fds{{-1, -1, -1}};
+                std::array<uint32_t, core::kMaxFramePlanes> lengths{};
+                for (uint32_t p = 0; p < buffer.plane_count; ++p)
+                {
+                    fds[p] = buffer.planes[p].dma_buf_fd;
+                    lengths[p] = static_cast<uint32_t>(buffer.planes[p].length);
+                }
+                requeue_context_->import_fds.push_back(fds);
+                requeue_context_->import_lengths.push_back(lengths);
+            }
+        }
         requeue_context_->active = true;
     }
 
+    capture_reactor_ = shared_reactor_;
+    if (!capture_reactor_)
+    {
+        capture_reactor_ = std::make_shared<CaptureReactor>();
+        if (!capture_reactor_->Start(1))
+        {
+            capture_reactor_.reset();
+        }
+    }
+
     is_running_ = true;
-    frame_count_ = 0;
-    dropped_frames_ = 0;
-    capture_thread_ = std::thread(&CameraSource::CaptureLoop, this);
+    if (reset_counters)
+    {
+        frame_count_ = 0;
+        dropped_frames_ = 0;
+    }
+    adaptive_window_start_ns_ = 0;
+    window_min_queued_ = SIZE_MAX;
+    window_lease_exhausted_base_ = lease_exhausted_count_.load();
+    buffer_count_controller_.Reset();
+    requeue_context_->lease_hold.Reset();
+    {
+        std::lock_guard<std::mutex> lock(adaptive_mutex_);
+        adaptive_stats_.buffer_count = static_cast<uint32_t>(UsableBufferCount());
+        adaptive_stats_.orphaned_buffers = static_cast<uint32_t>(orphaned_buffer_count_);
+    }
+    capture_source_id_ =
+        capture_reactor_
+            ? capture_reactor_->AddSource(capture_backend_ ? capture_backend_->GetPollFd()
+                                                           : device_fd_,
+                                          [this](uint32_t /*events*/) { return OnDeviceReadable(); })
+            : 0;
+    if (capture_source_id_ == 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                      "register device with capture reactor failed: %s",
+                                      device_path_.c_str());
+        is_running_ = false;
+        capture_reactor_.reset();
+        {
+            std::lock_guard<std::mutex> lock(requeue_context_->mutex);
+            requeue_context_->active = false;
+        }
+        StopStream();
+        return false;
+    }
     return true;
 }
 
@@ -151,9 +342,16 @@ void CameraSource::Stop()
     }
 
     is_running_ = false;
-    if (capture_thread_.joinable())
+    if (capture_reactor_)
     {
-        capture_thread_.join();
+        // 返回时本源回调已结束，之后可以安全 STREAMOFF
+        capture_reactor_->RemoveSource(capture_source_id_);
+        if (capture_reactor_ != shared_reactor_)
+        {
+            capture_reactor_->Stop();
+        }
+        capture_reactor_.reset();
+        capture_source_id_ = 0;
     }
 
     {
@@ -169,6 +367,183 @@ bool CameraSource::IsRunning() const
     return is_running_.load();
 }
 
+bool CameraSource::Reconfigure(const core::CameraConfig& config,
+                               std::chrono::milliseconds drain_timeout)
+{
+    if (!config.IsValid())
+    {
+        return false;
+    }
+
+    if (buffers_.empty())
+    {
+        return Initialize(config);
+    }
+
+    const uint64_t begin_ns = MonotonicNowNs();
+    const bool was_running = is_running_.load();
+    const core::CameraConfig previous = config_;
+    Stop();
+
+    DrainCallback drain_callback;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        drain_callback = drain_callback_;
+    }
+    if (drain_callback)
+    {
+        // 停流后不再有新帧进入发送队列，此时丢弃的排队帧不会被后续帧补上
+        drain_callback();
+    }
+
+    if (!DrainOutstandingFrames(drain_timeout))
+    {
+        // 槽位内存仍被消费者引用，不能重建 BufferPool；按原配置继续出流
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                      "reconfigure skipped: BufferPool slots still held "
+                                      "after %lld ms",
+                                      static_cast<long long>(drain_timeout.count()));
+        // STREAMOFF 清空了驱动队列，后端的队列则保持不变；仍被 lease 持有的 buffer 由
+        // 释放回调 QBUF，这里重复排入会让驱动覆写消费者正在读的内容
+        if (!capture_backend_ && !QueueUnleasedBuffers())
+        {
+            return false;
+        }
+        if (was_running && !StartCapture(false))
+        {
+            {
+                std::lock_guard<std::mutex> lock(requeue_context_->mutex);
+                requeue_context_->active = false;
+            }
+            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                          "reconfigure skipped and restart with previous "
+                                          "configuration failed, camera stopped");
+        }
+        return false;
+    }
+
+    ReleaseDeviceBuffers();
+    const bool applied = ApplyConfig(config);
+    if (!applied)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                      "reconfigure to %ux%u format=%u fps=%u failed, "
+                                      "restoring %ux%u",
+                                      config.width_, config.height_,
+                                      static_cast<uint32_t>(config.format_), config.fps_,
+                                      previous.width_, previous.height_);
+        ReleaseDeviceBuffers();
+        if (!ApplyConfig(previous))
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                          "restore previous configuration failed");
+            CleanupDmaBufExports();
+            CleanupBuffers();
+            CloseDevice();
+            return false;
+        }
+    }
+
+    if (was_running && !StartCapture(false))
+    {
+        return false;
+    }
+
+    const uint64_t elapsed_ns = MonotonicNowNs() - begin_ns;
+    if (applied)
+    {
+        last_reconfigure_ns_ = elapsed_ns;
+        platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_source",
+                                      "reconfigured to %ux%u format=%u fps=%u buffers=%zu "
+                                      "generation=%u in %.2f ms",
+                                      config_.width_, config_.height_,
+                                      static_cast<uint32_t>(config_.format_), config_.fps_,
+                                      buffers_.size(), stream_generation_.load(),
+                                      static_cast<double>(elapsed_ns) / 1e6);
+    }
+    return applied;
+}
+
+uint32_t CameraSource::GetStreamGeneration() const
+{
+    return stream_generation_.load();
+}
+
+uint64_t CameraSource::GetLastReconfigureDurationNs() const
+{
+    return last_reconfigure_ns_.load();
+}
+
+bool CameraSource::DrainOutstandingFrames(std::chrono::milliseconds timeout)
+{
+    // USERPTR 模式下排入驱动的槽位由 CameraSource 自己持有，不算外借
+    size_t own_slots = 0;
+    for (const auto& slot : userptr_slots_)
+    {
+        own_slots += slot ? 1 : 0;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    size_t leases = 0;
+    size_t slots = 0;
+    while (true)
+    {
+        leases = requeue_context_->active_leases.load();
+        const core::BufferPool::Stats stats = buffer_pool_.GetStats();
+        const size_t held = stats.in_use + stats.in_flight;
+        slots = held > own_slots ? held - own_slots : 0;
+        if ((leases == 0 && slots == 0) || std::chrono::steady_clock::now() >= deadline)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    if (slots == 0 && leases > 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                      "reconfigure abandons %zu DMA-BUF leases", leases);
+    }
+    return slots == 0;
+}
+
+void CameraSource::InvalidateLeases()
+{
+    if (buffers_.empty())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(requeue_context_->mutex);
+    requeue_context_->generation = stream_generation_.fetch_add(1) + 1;
+    requeue_context_->active_leases = 0;
+    requeue_context_->leased.clear();
+}
+
+void CameraSource::ReleaseDeviceBuffers()
+{
+    // 先让未归还的 lease 失效，CleanupDmaBufExports 不再等待
+    InvalidateLeases();
+    CleanupDmaBufExports();
+    CleanupBuffers();
+    if (capture_backend_ || device_fd_ < 0)
+    {
+        return;
+    }
+
+    // S_FMT 改变尺寸前必须释放驱动 buffer；导出的 DMA-BUF 由持有者的 fd 继续保活
+    struct v4l2_requestbuffers req;
+    memset(&req, 0, sizeof(req));
+    req.count = 0;
+    req.type = buf_type_;
+    req.memory = v4l2_memory_;
+    if (Xioctl(device_fd_, VIDIOC_REQBUFS, &req) < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                      "VIDIOC_REQBUFS(0) failed: %s", strerror(errno));
+    }
+}
+
 void CameraSource::SetFrameCallback(FrameCallback callback)
 {
     std::lock_guard<std::mutex> lock(callback_mutex_);
@@ -188,6 +563,18 @@ void CameraSource::SetFramePacketCallback(FramePacketCallback callback)
     has_frame_packet_callback_ = static_cast<bool>(frame_packet_callback_);
 }
 
+void CameraSource::SetDrainCallback(DrainCallback callback)
+{
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    drain_callback_ = std::move(callback);
+}
+
+void CameraSource::SetLeaseBudgetCallback(LeaseBudgetCallback callback)
+{
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    lease_budget_callback_ = std::move(callback);
+}
+
 void CameraSource::SetDevicePath(const std::string& device_path)
 {
     if (is_running_)
@@ -202,6 +589,93 @@ std::string CameraSource::GetDevicePath() const
     return device_path_;
 }
 
+void CameraSource::SetCameraId(uint32_t camera_id)
+{
+    camera_id_.store(camera_id);
+}
+
+uint32_t CameraSource::GetCameraId() const
+{
+    return camera_id_.load();
+}
+
+void CameraSource::SetCaptureReactor(std::shared_ptr<CaptureReactor> reactor)
+{
+    if (is_running_)
+    {
+        return;
+    }
+    shared_reactor_ = std::move(reactor);
+}
+
+void CameraSource::SetCaptureBackend(std::shared_ptr<CaptureBackend> backend)
+{
+    // 现有 buffer 归属旧的设备或后端，切换前全部释放
+    Stop();
+    CleanupDmaBufExports();
+    CleanupBuffers();
+    CloseDevice();
+    capture_backend_ = std::move(backend);
+}
+
+void CameraSource::SetDmaBufAllocator(std::shared_ptr<core::DmaBufAllocator> allocator)
+{
+    if (is_running_)
+    {
+        return;
+    }
+    dma_buf_allocator_ = std::move(allocator);
+}
+
+void CameraSource::SetDmaBufImportFds(std::vector<int> fds)
+{
+    if (is_running_)
+    {
+        return;
+    }
+    dma_buf_import_fds_ = std::move(fds);
+}
+
+void CameraSource::SetBufferPoolOptions(const core::BufferPool::Options& options)
+{
+    if (is_running_)
+    {
+        return;
+    }
+    buffer_pool_options_ = options;
+}
+
+void CameraSource::SetAdaptiveBufferCount(bool enable,
+                                          const core::BufferCountController::Options& options)
+{
+    core::BufferCountController::Options bounded = options;
+    bounded.max_buffers = std::min(bounded.max_buffers, kMaxCaptureBufferCount);
+    bounded.min_buffers = std::min(bounded.min_buffers, bounded.max_buffers);
+    adaptive_buffers_enabled_ = enable;
+    buffer_count_controller_ = core::BufferCountController(bounded);
+    adaptive_buffer_count_ = 0;
+    std::lock_guard<std::mutex> lock(adaptive_mutex_);
+    adaptive_stats_ = AdaptiveBufferStats();
+}
+
+CameraSource::AdaptiveBufferStats CameraSource::GetAdaptiveBufferStats() const
+{
+    std::lock_guard<std::mutex> lock(adaptive_mutex_);
+    AdaptiveBufferStats stats = adaptive_stats_;
+    stats.enabled = adaptive_buffers_enabled_;
+    return stats;
+}
+
+core::BufferPool::Stats CameraSource::GetBufferPoolStats() const
+{
+    return buffer_pool_.GetStats();
+}
+
+int CameraSource::GetBufferPoolShareFd() const
+{
+    return buffer_pool_share_fd_;
+}
+
 core::CameraConfig CameraSource::GetConfig() const
 {
     return config_;
@@ -222,6 +696,16 @@ bool CameraSource::IsDmaBufPathEnabled() const
     return dma_buf_path_enabled_;
 }
 
+bool CameraSource::IsUserPtrPathEnabled() const
+{
+    return v4l2_memory_ == V4L2_MEMORY_USERPTR;
+}
+
+bool CameraSource::IsMultiPlanar() const
+{
+    return multi_planar_;
+}
+
 uint64_t CameraSource::GetDmaBufFrameCount() const
 {
     return dma_buf_frame_count_.load();
@@ -244,63 +728,274 @@ size_t CameraSource::GetDmaBufActiveLeaseCount() const
 
 size_t CameraSource::GetDmaBufLeaseInFlightMax() const
 {
-    return global_lease_in_flight_max_;
+    return global_lease_in_flight_max_.load();
 }
 
 size_t CameraSource::GetDmaBufMinQueuedCaptureBuffers() const
 {
-    return min_queued_capture_buffers_;
+    return min_queued_capture_buffers_.load();
 }
 
-void CameraSource::CaptureLoop()
+bool CameraSource::OnDeviceReadable()
 {
-    while (is_running_)
+    if (adaptive_buffers_enabled_)
+    {
+        EvaluateBufferCount();
+    }
+
+    if (capture_backend_)
     {
-        fd_set fds;
-        FD_ZERO(&fds);
-        FD_SET(device_fd_, &fds);
+        return OnBackendReadable();
+    }
 
-        struct timeval tv;
-        tv.tv_sec = 2;
-        tv.tv_usec = 0;
+    // 一次唤醒取完所有已就绪的 buffer，直到 EAGAIN
+    for (size_t i = 0; i < buffers_.size() && is_running_; ++i)
+    {
+        struct v4l2_buffer buf;
+        struct v4l2_plane planes[VIDEO_MAX_PLANES];
+        InitV4L2Buffer(buf, planes, buf_type_, v4l2_memory_, memory_plane_count_);
 
-        int ret = select(device_fd_ + 1, &fds, nullptr, nullptr, &tv);
-        if (ret == -1)
+        if (Xioctl(device_fd_, VIDIOC_DQBUF, &buf) < 0)
         {
-            if (errno == EINTR)
+            if (errno == EAGAIN)
             {
-                continue;
+                return true;
             }
             platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
-                                          "select failed: %s", strerror(errno));
-            break;
+                                          "VIDIOC_DQBUF failed: %s", strerror(errno));
+            return false;
         }
-        if (ret == 0)
+
+        NoteDequeueDepth();
+        HandleDequeuedBuffer(buf, MakeDequeueTiming(buf));
+    }
+    return true;
+}
+
+bool CameraSource::OnBackendReadable()
+{
+    CaptureBackend::CapturedFrame captured;
+    for (size_t i = 0; i < buffers_.size() && is_running_; ++i)
+    {
+        if (!capture_backend_->Dequeue(captured))
         {
-            continue;
+            return true;
         }
 
+        // 后端帧按驱动语义填成 v4l2_buffer，复用同一套分发路径
         struct v4l2_buffer buf;
-        memset(&buf, 0, sizeof(buf));
-        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-        buf.memory = V4L2_MEMORY_MMAP;
+        struct v4l2_plane planes[VIDEO_MAX_PLANES];
+        InitV4L2Buffer(buf, planes, buf_type_, v4l2_memory_, memory_plane_count_);
+        buf.index = captured.index;
+        buf.bytesused = captured.bytes_used;
+        buf.sequence = captured.sequence;
+        buf.flags = V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC;
+        buf.timestamp.tv_sec = static_cast<time_t>(captured.timestamp_ns / 1000000000ULL);
+        buf.timestamp.tv_usec =
+            static_cast<suseconds_t>(captured.timestamp_ns % 1000000000ULL / 1000ULL);
+
+        NoteDequeueDepth();
+        HandleDequeuedBuffer(buf, MakeDequeueTiming(buf));
+    }
+    return true;
+}
 
-        if (Xioctl(device_fd_, VIDIOC_DQBUF, &buf) < 0)
+void CameraSource::NoteDequeueDepth()
+{
+    // 刚取出的 buffer 与消费者持有的 lease 之外，其余都还在驱动队列中
+    const size_t held = requeue_context_->active_leases.load() + 1;
+    const size_t usable = UsableBufferCount();
+    const size_t queued = usable > held ? usable - held : 0;
+    window_min_queued_ = std::min(window_min_queued_, queued);
+}
+
+void CameraSource::EvaluateBufferCount()
+{
+    const uint64_t now_ns = GetTimestampNs();
+    const auto& options = buffer_count_controller_.GetOptions();
+    if (adaptive_window_start_ns_ == 0)
+    {
+        adaptive_window_start_ns_ = now_ns;
+        return;
+    }
+    if (now_ns - adaptive_window_start_ns_ < static_cast<uint64_t>(options.window_ms) * 1000000ULL)
+    {
+        return;
+    }
+    adaptive_window_start_ns_ = now_ns;
+
+    core::BufferCountController::Window window;
+    window.buffer_count = static_cast<uint32_t>(UsableBufferCount());
+    window.frame_interval_ns = 1000000000ULL / std::max<uint32_t>(config_.fps_, 1);
+    const auto lease_hold = requeue_context_->lease_hold.TakeSnapshot();
+    window.leases = lease_hold.count;
+    window.lease_hold_p99_ns = lease_hold.p99_ns;
+    window.min_queued = window_min_queued_;
+    const uint64_t exhausted = lease_exhausted_count_.load();
+    window.lease_exhausted = exhausted - window_lease_exhausted_base_;
+    window_lease_exhausted_base_ = exhausted;
+    window_min_queued_ = SIZE_MAX;
+
+    // 只有 DMA-BUF 路径的 buffer 会被消费者持有；拷贝路径 DQBUF 后立即回队，无需调整
+    if (!ShouldUseDmaBufPath())
+    {
+        return;
+    }
+
+    const uint32_t target = buffer_count_controller_.Update(window);
+    bool grown = false;
+    if (target > window.buffer_count && !capture_backend_ &&
+        v4l2_memory_ == V4L2_MEMORY_MMAP)
+    {
+        grown = GrowCaptureBuffers(target - window.buffer_count);
+    }
+    if (target != window.buffer_count)
+    {
+        adaptive_buffer_count_ = target;
+    }
+
+    std::lock_guard<std::mutex> lock(adaptive_mutex_);
+    adaptive_stats_.buffer_count = static_cast<uint32_t>(UsableBufferCount());
+    adaptive_stats_.orphaned_buffers = static_cast<uint32_t>(orphaned_buffer_count_);
+    adaptive_stats_.target_buffer_count = target;
+    adaptive_stats_.live_grow_count += grown ? 1 : 0;
+    adaptive_stats_.windows += 1;
+    adaptive_stats_.window_min_queued = window.min_queued == SIZE_MAX ? 0 : window.min_queued;
+    adaptive_stats_.lease_hold = lease_hold;
+}
+
+bool CameraSource::GrowCaptureBuffers(uint32_t count)
+{
+    struct v4l2_create_buffers create;
+    std::memset(&create, 0, sizeof(create));
+    create.count = count;
+    create.memory = V4L2_MEMORY_MMAP;
+    create.format.type = buf_type_;
+    if (Xioctl(device_fd_, VIDIOC_G_FMT, &create.format) < 0 ||
+        Xioctl(device_fd_, VIDIOC_CREATE_BUFS, &create) < 0 || create.count == 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                      "VIDIOC_CREATE_BUFS of %u buffers failed: %s, "
+                                      "growth deferred to next restart",
+                                      count, strerror(errno));
+        return false;
+    }
+
+    // 在反应器线程中执行，与 DQBUF 处理串行，buffers_ 扩容无需额外加锁。
+    // V4L2 索引必须与 buffers_ 下标一致，单个失败不能截断：驱动已分配的 buffer 只能由
+    // REQBUFS 0 释放，失败的索引标记为 orphaned 后继续处理其余索引
+    const uint32_t first = create.index;
+    buffers_.resize(first + create.count);
+    uint32_t added = 0;
+    for (uint32_t i = first; i < first + create.count; ++i)
+    {
+        if (MapBuffer(i) && (!dma_buf_path_enabled_ || ExportBuffer(i)) && QueueBuffer(i) >= 0)
         {
-            if (errno == EAGAIN)
+            ++added;
+            continue;
+        }
+
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                      "grown buffer %u unusable: %s, left out of rotation",
+                                      i, strerror(errno));
+        for (auto& plane : buffers_[i].planes)
+        {
+            if (plane.start != nullptr)
             {
-                continue;
+                munmap(plane.start, plane.length);
+            }
+            if (plane.dma_buf_fd >= 0)
+            {
+                close(plane.dma_buf_fd);
             }
-            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
-                                          "VIDIOC_DQBUF failed: %s", strerror(errno));
-            break;
         }
+        buffers_[i] = Buffer();
+        buffers_[i].orphaned = true;
+        ++orphaned_buffer_count_;
+    }
+    UpdateLeaseBudget();
+    NotifyLeaseBudget();
+
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_source",
+                                  "capture buffers grown to %zu (%zu orphaned), "
+                                  "lease_in_flight_max=%zu",
+                                  UsableBufferCount(), orphaned_buffer_count_,
+                                  global_lease_in_flight_max_.load());
+    return added > 0;
+}
+
+size_t CameraSource::UsableBufferCount() const
+{
+    return buffers_.size() - orphaned_buffer_count_;
+}
 
-        HandleDequeuedBuffer(buf);
+CameraSource::DequeueTiming CameraSource::MakeDequeueTiming(const struct v4l2_buffer& buf)
+{
+    DequeueTiming timing;
+    timing.dequeue_ns = GetTimestampNs();
+    timing.capture_ns = timing.dequeue_ns;
+
+    // 只信任声明为 CLOCK_MONOTONIC 的驱动时间戳；晚于 DQBUF 时刻说明时钟域不一致
+    const uint64_t driver_ns =
+        static_cast<uint64_t>(buf.timestamp.tv_sec) * 1000000000ULL +
+        static_cast<uint64_t>(buf.timestamp.tv_usec) * 1000ULL;
+    if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC &&
+        driver_ns != 0 && driver_ns <= timing.dequeue_ns)
+    {
+        timing.capture_ns = driver_ns;
+        timing.driver_timestamp = true;
+        driver_timestamp_frames_.fetch_add(1, std::memory_order_relaxed);
+        driver_to_dequeue_latency_.Record(timing.dequeue_ns - driver_ns);
+    }
+    else
+    {
+        fallback_timestamp_frames_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return timing;
+}
+
+void CameraSource::RecordCallbackLatency(const DequeueTiming& timing)
+{
+    const uint64_t now_ns = GetTimestampNs();
+    dequeue_to_callback_latency_.Record(now_ns - timing.dequeue_ns);
+    if (timing.driver_timestamp)
+    {
+        driver_to_callback_latency_.Record(now_ns - timing.capture_ns);
     }
 }
 
-void CameraSource::HandleDequeuedBuffer(struct v4l2_buffer& buf)
+CameraSource::CaptureLatencyStats CameraSource::GetCaptureLatencyStats(bool reset_window)
+{
+    CaptureLatencyStats stats;
+    if (reset_window)
+    {
+        stats.driver_to_dequeue = driver_to_dequeue_latency_.TakeSnapshot();
+        stats.dequeue_to_callback = dequeue_to_callback_latency_.TakeSnapshot();
+        stats.driver_to_callback = driver_to_callback_latency_.TakeSnapshot();
+    }
+    else
+    {
+        stats.driver_to_dequeue = driver_to_dequeue_latency_.GetSnapshot();
+        stats.dequeue_to_callback = dequeue_to_callback_latency_.GetSnapshot();
+        stats.driver_to_callback = driver_to_callback_latency_.GetSnapshot();
+    }
+    stats.driver_timestamp_frames = driver_timestamp_frames_.load(std::memory_order_relaxed);
+    stats.fallback_timestamp_frames = fallback_timestamp_frames_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+size_t CameraSource::GetPlaneBytesUsed(const struct v4l2_buffer& buf, uint32_t plane) const
+{
+    size_t used_size = multi_planar_ ? static_cast<size_t>(buf.m.planes[plane].bytesused)
+                                     : static_cast<size_t>(buf.bytesused);
+    if (used_size == 0)
+    {
+        used_size = buffers_[buf.index].planes[plane].length;
+    }
+    return used_size;
+}
+
+void CameraSource::HandleDequeuedBuffer(struct v4l2_buffer& buf, const DequeueTiming& timing)
 {
     if (buf.index >= buffers_.size())
     {
@@ -310,17 +1005,40 @@ void CameraSource::HandleDequeuedBuffer(struct v4l2_buffer& buf)
         return;
     }
 
-    if (ShouldUseDmaBufPath() && HandleDequeuedBufferDmaBuf(buf))
+    if (v4l2_memory_ == V4L2_MEMORY_USERPTR)
     {
+        HandleDequeuedBufferUserPtr(buf, timing);
         return;
     }
 
-    HandleDequeuedBufferCopy(buf);
+    if (ShouldUseDmaBufPath() && HandleDequeuedBufferDmaBuf(buf, timing))
+    {
+        return;
+    }
+
+    HandleDequeuedBufferCopy(buf, timing);
 }
 
-void CameraSource::HandleDequeuedBufferCopy(struct v4l2_buffer& buf)
+void CameraSource::HandleDequeuedBufferCopy(struct v4l2_buffer& buf,
+                                            const DequeueTiming& timing)
 {
-    auto buffer_ref = buffer_pool_.Acquire();
+    const Buffer& buffer = buffers_[buf.index];
+    if (buffer.planes[0].start == nullptr)
+    {
+        // 导入的 dma-buf 不支持 CPU 映射时无法走拷贝路径
+        dropped_frames_.fetch_add(1);
+        RequeueBuffer(buf.index);
+        return;
+    }
+
+    size_t used_size = 0;
+    for (uint32_t p = 0; p < buffer.plane_count; ++p)
+    {
+        used_size += GetPlaneBytesUsed(buf, p);
+    }
+
+    // 弹性池按实际帧长选择档位；固定池的 size_hint 不超过 Buffer 大小，行为不变
+    auto buffer_ref = buffer_pool_.Acquire(std::min(used_size, pool_buffer_size_));
     if (!buffer_ref)
     {
         dropped_frames_.fetch_add(1);
@@ -328,32 +1046,83 @@ void CameraSource::HandleDequeuedBufferCopy(struct v4l2_buffer& buf)
         return;
     }
 
+    // 各内存 plane 按 packed_plane_offsets_ 排布，单平面时等价于整块拷贝
+    size_t copy_size = 0;
+    auto* destination = static_cast<uint8_t*>(buffer_ref->Data());
+    for (uint32_t p = 0; p < buffer.plane_count; ++p)
+    {
+        const size_t offset = packed_plane_offsets_[p];
+        if (offset >= buffer_ref->Size())
+        {
+            break;
+        }
+        const size_t plane_copy = std::min(GetPlaneBytesUsed(buf, p), buffer_ref->Size() - offset);
+        std::memcpy(destination + offset, buffer.planes[p].start, plane_copy);
+        copy_size = offset + plane_copy;
+    }
+
+    const uint64_t frame_id = DeliverPoolFrame(buf, buffer_ref, copy_size, timing);
+
+    RequeueBuffer(buf.index);
+
+    if (elastic_buffer_pool_ && frame_id % kElasticTrimFrameInterval == 0)
+    {
+        buffer_pool_.TrimIdle();
+    }
+}
+
+void CameraSource::HandleDequeuedBufferUserPtr(struct v4l2_buffer& buf,
+                                               const DequeueTiming& timing)
+{
+    const uint32_t index = buf.index;
+    std::shared_ptr<core::BufferGuard> filled = userptr_slots_[index];
+    auto replacement = buffer_pool_.Acquire();
+    if (!filled || !replacement)
+    {
+        // 消费者占满了所有槽位：丢弃本帧，原槽位直接回到驱动队列
+        dropped_frames_.fetch_add(1);
+        RequeueBuffer(index);
+        return;
+    }
+
+    // 先补回驱动队列再回调，回调耗时不影响驱动可用 buffer 数
+    userptr_slots_[index] = replacement;
+    RequeueBuffer(index);
+
+    const size_t frame_size = std::min(GetPlaneBytesUsed(buf, 0), filled->Size());
+    DeliverPoolFrame(buf, filled, frame_size, timing);
+}
+
+uint64_t CameraSource::DeliverPoolFrame(const struct v4l2_buffer& buf,
+                                        const std::shared_ptr<core::BufferGuard>& buffer_ref,
+                                        size_t frame_size, const DequeueTiming& timing)
+{
     core::FrameHandle frame;
     frame.Reset();
 
     const uint64_t frame_id = frame_count_.fetch_add(1);
     frame.frame_id_ = static_cast<uint32_t>(frame_id);
-    frame.camera_id_ = 0;
-    frame.timestamp_ns_ = GetTimestampNs();
+    frame.camera_id_ = camera_id_.load();
+    frame.timestamp_ns_ = timing.capture_ns;
     frame.width_ = config_.width_;
     frame.height_ = config_.height_;
     frame.format_ = config_.format_;
     frame.sequence_ = static_cast<uint32_t>(buf.sequence);
-    frame.memory_type_ = core::MemoryType::kHeap;
-
-    size_t used_size = static_cast<size_t>(buf.bytesused);
-    if (used_size == 0)
+    frame.stream_generation_ = stream_generation_.load();
+    if (buffer_pool_share_fd_ >= 0)
     {
-        used_size = buffers_[buf.index].length;
+        frame.memory_type_ = core::MemoryType::kShm;
+        frame.buffer_fd_ = buffer_pool_share_fd_;
+    }
+    else
+    {
+        frame.memory_type_ = core::MemoryType::kHeap;
     }
-
-    const size_t copy_size = std::min(used_size, buffer_ref->Size());
-    std::memcpy(buffer_ref->Data(), buffers_[buf.index].start, copy_size);
 
     frame.virtual_address_ = buffer_ref->Data();
-    frame.buffer_size_ = copy_size;
+    frame.buffer_size_ = frame_size;
 
-    FillFrameLayout(frame, copy_size);
+    FillFrameLayout(frame, frame_size);
 
     FrameCallback callback;
     FrameCallbackWithBuffer callback_with_buffer;
@@ -371,20 +1140,21 @@ void CameraSource::HandleDequeuedBufferCopy(struct v4l2_buffer& buf)
     {
         callback(frame);
     }
-
-    RequeueBuffer(buf.index);
+    RecordCallbackLatency(timing);
+    return frame_id;
 }
 
-bool CameraSource::HandleDequeuedBufferDmaBuf(struct v4l2_buffer& buf)
+bool CameraSource::HandleDequeuedBufferDmaBuf(struct v4l2_buffer& buf,
+                                              const DequeueTiming& timing)
 {
     Buffer& buffer = buffers_[buf.index];
-    if (!buffer.dma_buf_exported || buffer.dma_buf_fd < 0)
+    if (!buffer.dma_buf_exported || buffer.planes[0].dma_buf_fd < 0)
     {
         return false;
     }
 
     const size_t active_leases = requeue_context_->active_leases.load();
-    if (active_leases >= global_lease_in_flight_max_)
+    if (active_leases >= global_lease_in_flight_max_.load())
     {
         lease_exhausted_count_.fetch_add(1);
         dropped_frames_.fetch_add(1);
@@ -402,10 +1172,10 @@ bool CameraSource::HandleDequeuedBufferDmaBuf(struct v4l2_buffer& buf)
         return false;
     }
 
-    size_t used_size = static_cast<size_t>(buf.bytesused);
-    if (used_size == 0)
+    size_t used_size = 0;
+    for (uint32_t p = 0; p < buffer.plane_count; ++p)
     {
-        used_size = buffer.length;
+        used_size += GetPlaneBytesUsed(buf, p);
     }
 
     const uint64_t frame_id = frame_count_.fetch_add(1);
@@ -414,14 +1184,16 @@ bool CameraSource::HandleDequeuedBufferDmaBuf(struct v4l2_buffer& buf)
     core::FrameHandle frame;
     frame.Reset();
     frame.frame_id_ = static_cast<uint32_t>(frame_id);
-    frame.camera_id_ = 0;
-    frame.timestamp_ns_ = GetTimestampNs();
+    frame.camera_id_ = camera_id_.load();
+    frame.timestamp_ns_ = timing.capture_ns;
     frame.width_ = config_.width_;
     frame.height_ = config_.height_;
     frame.format_ = config_.format_;
     frame.sequence_ = static_cast<uint32_t>(buf.sequence);
+    frame.stream_generation_ = stream_generation_.load();
     frame.memory_type_ = core::MemoryType::kDmaBuf;
-    frame.buffer_fd_ = buffer.dma_buf_fd;
+    // FrameHandle 只能表达单 fd；多 fd 时消费者应以 FrameDescriptor 为准
+    frame.buffer_fd_ = buffer.planes[0].dma_buf_fd;
     frame.virtual_address_ = nullptr;
     frame.buffer_size_ = used_size;
     FillFrameLayout(frame, used_size);
@@ -430,6 +1202,7 @@ bool CameraSource::HandleDequeuedBufferDmaBuf(struct v4l2_buffer& buf)
     descriptor.frame_id = frame_id;
     descriptor.camera_id = frame.camera_id_;
     descriptor.timestamp_ns = frame.timestamp_ns_;
+    descriptor.dequeue_timestamp_ns = timing.dequeue_ns;
     descriptor.sequence = frame.sequence_;
     descriptor.width = frame.width_;
     descriptor.height = frame.height_;
@@ -437,45 +1210,88 @@ bool CameraSource::HandleDequeuedBufferDmaBuf(struct v4l2_buffer& buf)
     descriptor.memory_type = core::MemoryType::kDmaBuf;
     descriptor.buffer_id = buf.index;
     descriptor.plane_count = frame.plane_count_;
-    descriptor.fd_count = 1;
-    descriptor.fds[0] = buffer.dma_buf_fd;
+    descriptor.fd_count = buffer.plane_count;
+    for (uint32_t p = 0; p < buffer.plane_count; ++p)
+    {
+        descriptor.fds[p] = buffer.planes[p].dma_buf_fd;
+    }
     descriptor.total_bytes_used = used_size;
     descriptor.flags = frame.flags_;
+    descriptor.stream_generation = frame.stream_generation_;
     for (uint32_t i = 0; i < frame.plane_count_ && i < core::kMaxFramePlanes; ++i)
     {
-        descriptor.planes[i].fd_index = 0;
-        descriptor.planes[i].offset = frame.plane_offset_[i];
+        // 每个内存 plane 一个 fd（如 NV12M）；共享 fd 的逻辑 plane 以 offset 区分
+        const uint32_t fd_index = buffer.plane_count > 1 && i < buffer.plane_count ? i : 0;
+        descriptor.planes[i].fd_index = fd_index;
+        descriptor.planes[i].offset =
+            frame.plane_offset_[i] - static_cast<uint32_t>(packed_plane_offsets_[fd_index]);
         descriptor.planes[i].stride = frame.line_stride_[i];
         descriptor.planes[i].length = frame.plane_size_[i];
         descriptor.planes[i].bytes_used = frame.plane_size_[i];
     }
 
     std::weak_ptr<RequeueContext> weak_context = requeue_context_;
+    {
+        std::lock_guard<std::mutex> lock(requeue_context_->mutex);
+        if (requeue_context_->leased.size() < buffers_.size())
+        {
+            requeue_context_->leased.resize(buffers_.size(), false);
+        }
+        requeue_context_->leased[buf.index] = true;
+    }
     requeue_context_->active_leases.fetch_add(1);
+    const uint64_t leased_ns = GetTimestampNs();
+    const uint32_t generation = frame.stream_generation_;
     auto lease = std::make_shared<core::DmaBufFrameLease>(
         buf.index,
-        [weak_context](uint32_t buffer_index)
+        [weak_context, leased_ns, generation](uint32_t buffer_index)
         {
             if (auto context = weak_context.lock())
             {
+                context->lease_hold.Record(MonotonicNowNs() - leased_ns);
+
+                std::lock_guard<std::mutex> lock(context->mutex);
+                if (context->generation != generation)
+                {
+                    // buffer 已随重新配置释放，计数也已清零
+                    return;
+                }
                 size_t current = context->active_leases.load();
                 while (current > 0 &&
                        !context->active_leases.compare_exchange_weak(current, current - 1))
                 {
                 }
+                if (buffer_index < context->leased.size())
+                {
+                    context->leased[buffer_index] = false;
+                }
 
-                std::lock_guard<std::mutex> lock(context->mutex);
-                if (!context->active || context->device_fd < 0)
+                if (!context->active || (context->device_fd < 0 && !context->backend))
+                {
+                    return;
+                }
+
+                if (context->backend)
                 {
+                    if (!context->backend->Queue(buffer_index))
+                    {
+                        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                                      "backend requeue of buffer %u failed",
+                                                      buffer_index);
+                    }
                     return;
                 }
 
-                struct v4l2_buffer qbuf;
-                std::memset(&qbuf, 0, sizeof(qbuf));
-                qbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                qbuf.memory = V4L2_MEMORY_MMAP;
-                qbuf.index = buffer_index;
-                if (Xioctl(context->device_fd, VIDIOC_QBUF, &qbuf) < 0)
+                const bool imported = buffer_index < context->import_fds.size();
+                if (QueueCaptureBuffer(context->device_fd,
+                                       context->buf_type,
+                                       context->memory,
+                                       buffer_index,
+                                       context->plane_count,
+                                       imported ? context->import_fds[buffer_index].data()
+                                                : nullptr,
+                                       imported ? context->import_lengths[buffer_index].data()
+                                                : nullptr) < 0)
                 {
                     platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
                                                   "VIDIOC_QBUF failed: %s", strerror(errno));
@@ -489,6 +1305,7 @@ bool CameraSource::HandleDequeuedBufferDmaBuf(struct v4l2_buffer& buf)
     packet.lease = lease;
 
     frame_packet_callback(packet);
+    RecordCallbackLatency(timing);
     return true;
 }
 
@@ -499,183 +1316,584 @@ bool CameraSource::OpenDevice()
         return true;
     }
 
-    device_fd_ = open(device_path_.c_str(), O_RDWR | O_NONBLOCK, 0);
-    if (device_fd_ < 0)
+    device_fd_ = open(device_path_.c_str(), O_RDWR | O_NONBLOCK, 0);
+    if (device_fd_ < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                      "Failed to open %s: %s", device_path_.c_str(),
+                                      strerror(errno));
+        return false;
+    }
+
+    struct v4l2_capability cap;
+    memset(&cap, 0, sizeof(cap));
+    if (Xioctl(device_fd_, VIDIOC_QUERYCAP, &cap) < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                      "VIDIOC_QUERYCAP failed: %s", strerror(errno));
+        CloseDevice();
+        return false;
+    }
+
+    // 优先看节点自身的 device_caps；同时支持两种接口时选择单平面
+    const uint32_t caps =
+        (cap.capabilities & V4L2_CAP_DEVICE_CAPS) ? cap.device_caps : cap.capabilities;
+    if (caps & V4L2_CAP_VIDEO_CAPTURE)
+    {
+        buf_type_ = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        multi_planar_ = false;
+    }
+    else if (caps & V4L2_CAP_VIDEO_CAPTURE_MPLANE)
+    {
+        buf_type_ = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+        multi_planar_ = true;
+    }
+    else
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                      "Device does not support V4L2 video capture");
+        CloseDevice();
+        return false;
+    }
+
+    if (!(caps & V4L2_CAP_STREAMING))
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                      "Device does not support streaming I/O");
+        CloseDevice();
+        return false;
+    }
+
+    return true;
+}
+
+void CameraSource::CloseDevice()
+{
+    if (capture_backend_)
+    {
+        capture_backend_->Close();
+    }
+    if (device_fd_ >= 0)
+    {
+        close(device_fd_);
+        device_fd_ = -1;
+    }
+}
+
+bool CameraSource::ConfigureDevice()
+{
+    struct v4l2_format fmt;
+    memset(&fmt, 0, sizeof(fmt));
+    fmt.type = buf_type_;
+    if (multi_planar_)
+    {
+        fmt.fmt.pix_mp.width = config_.width_;
+        fmt.fmt.pix_mp.height = config_.height_;
+        fmt.fmt.pix_mp.pixelformat = ToV4L2PixelFormat(config_.format_);
+        fmt.fmt.pix_mp.field = V4L2_FIELD_NONE;
+    }
+    else
+    {
+        fmt.fmt.pix.width = config_.width_;
+        fmt.fmt.pix.height = config_.height_;
+        fmt.fmt.pix.pixelformat = ToV4L2PixelFormat(config_.format_);
+        fmt.fmt.pix.field = V4L2_FIELD_NONE;
+    }
+
+    if (Xioctl(device_fd_, VIDIOC_S_FMT, &fmt) < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                      "VIDIOC_S_FMT failed: %s", strerror(errno));
+        return false;
+    }
+
+    uint32_t fourcc = 0;
+    plane_formats_ = {};
+    if (multi_planar_)
+    {
+        const uint32_t num_planes = fmt.fmt.pix_mp.num_planes;
+        if (num_planes == 0 || num_planes > core::kMaxFramePlanes)
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                          "unsupported MPLANE plane count: %u", num_planes);
+            return false;
+        }
+        memory_plane_count_ = num_planes;
+        for (uint32_t p = 0; p < num_planes; ++p)
+        {
+            plane_formats_[p].bytes_per_line = fmt.fmt.pix_mp.plane_fmt[p].bytesperline;
+            plane_formats_[p].size_image = fmt.fmt.pix_mp.plane_fmt[p].sizeimage;
+        }
+        config_.width_ = fmt.fmt.pix_mp.width;
+        config_.height_ = fmt.fmt.pix_mp.height;
+        fourcc = fmt.fmt.pix_mp.pixelformat;
+    }
+    else
+    {
+        memory_plane_count_ = 1;
+        plane_formats_[0].bytes_per_line = fmt.fmt.pix.bytesperline;
+        plane_formats_[0].size_image = fmt.fmt.pix.sizeimage;
+        config_.width_ = fmt.fmt.pix.width;
+        config_.height_ = fmt.fmt.pix.height;
+        fourcc = fmt.fmt.pix.pixelformat;
+    }
+
+    const core::PixelFormat negotiated_format = FromV4L2PixelFormat(fourcc);
+    if (negotiated_format != core::PixelFormat::kUnknown)
+    {
+        config_.format_ = negotiated_format;
+    }
+
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_source",
+                                  "negotiated format: width=%u height=%u fourcc=%c%c%c%c "
+                                  "mplane=%d planes=%u bytesperline=%u sizeimage=%u",
+                                  config_.width_,
+                                  config_.height_,
+                                  fourcc & 0xff,
+                                  (fourcc >> 8) & 0xff,
+                                  (fourcc >> 16) & 0xff,
+                                  (fourcc >> 24) & 0xff,
+                                  multi_planar_ ? 1 : 0,
+                                  memory_plane_count_,
+                                  plane_formats_[0].bytes_per_line,
+                                  plane_formats_[0].size_image);
+
+    struct v4l2_streamparm parm;
+    memset(&parm, 0, sizeof(parm));
+    parm.type = buf_type_;
+    parm.parm.capture.timeperframe.numerator = 1;
+    parm.parm.capture.timeperframe.denominator = std::max<uint32_t>(1, config_.fps_);
+
+    if (Xioctl(device_fd_, VIDIOC_S_PARM, &parm) < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                      "VIDIOC_S_PARM failed: %s", strerror(errno));
+    }
+
+    return true;
+}
+
+bool CameraSource::InitMMap()
+{
+    struct v4l2_requestbuffers req;
+    memset(&req, 0, sizeof(req));
+    req.count = config_.buffer_count_;
+    req.type = buf_type_;
+    req.memory = V4L2_MEMORY_MMAP;
+    v4l2_memory_ = V4L2_MEMORY_MMAP;
+
+    if (Xioctl(device_fd_, VIDIOC_REQBUFS, &req) < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                      "VIDIOC_REQBUFS failed: %s", strerror(errno));
+        return false;
+    }
+
+    if (req.count < 2)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                      "Insufficient buffer memory");
+        return false;
+    }
+
+    buffers_.clear();
+    buffers_.resize(req.count);
+
+    for (uint32_t i = 0; i < req.count; ++i)
+    {
+        if (!MapBuffer(i))
+        {
+            return false;
+        }
+    }
+
+    packed_plane_offsets_ = {};
+    for (uint32_t p = 1; p < memory_plane_count_; ++p)
+    {
+        packed_plane_offsets_[p] = packed_plane_offsets_[p - 1] + buffers_[0].planes[p - 1].length;
+    }
+
+    dma_buf_path_enabled_ = false;
+    dma_buf_frame_count_ = 0;
+    dma_buf_export_failures_ = 0;
+    lease_exhausted_count_ = 0;
+    if (config_.io_method_ == static_cast<uint32_t>(core::IoMethod::kDmaBuf))
+    {
+        dma_buf_path_enabled_ = InitDmaBufExport();
+        if (!dma_buf_path_enabled_)
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                          "DMA-BUF export unavailable, falling back to MMAP copy");
+        }
+    }
+
+    return QueueAllBuffers();
+}
+
+bool CameraSource::MapBuffer(uint32_t index)
+{
+    struct v4l2_buffer buf;
+    struct v4l2_plane planes[VIDEO_MAX_PLANES];
+    InitV4L2Buffer(buf, planes, buf_type_, V4L2_MEMORY_MMAP, memory_plane_count_);
+    buf.index = index;
+
+    if (Xioctl(device_fd_, VIDIOC_QUERYBUF, &buf) < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                      "VIDIOC_QUERYBUF failed: %s", strerror(errno));
+        return false;
+    }
+
+    buffers_[index].plane_count = memory_plane_count_;
+    for (uint32_t p = 0; p < memory_plane_count_; ++p)
+    {
+        Plane& plane = buffers_[index].planes[p];
+        const size_t length = multi_planar_ ? planes[p].length : buf.length;
+        const off_t offset = multi_planar_ ? planes[p].m.mem_offset : buf.m.offset;
+        plane.start =
+            mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, device_fd_, offset);
+        if (plane.start == MAP_FAILED)
+        {
+            plane.start = nullptr;
+            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                          "mmap failed: buffer=%u plane=%u %s", index, p,
+                                          strerror(errno));
+            return false;
+        }
+        plane.length = length;
+    }
+    return true;
+}
+
+bool CameraSource::InitDmaBufImport()
+{
+    std::shared_ptr<core::DmaBufAllocator> allocator = dma_buf_allocator_;
+    if (dma_buf_import_fds_.empty() && !allocator)
+    {
+        allocator = core::DmaBufAllocator::CreateDefault();
+        if (!allocator)
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                          "DMA-BUF import: no dma-heap or udmabuf allocator");
+            return false;
+        }
+    }
+
+    uint32_t requested_count = config_.buffer_count_;
+    if (!dma_buf_import_fds_.empty())
+    {
+        if (dma_buf_import_fds_.size() % memory_plane_count_ != 0)
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                          "DMA-BUF import: %zu fds do not match %u planes",
+                                          dma_buf_import_fds_.size(), memory_plane_count_);
+            return false;
+        }
+        requested_count = std::min<uint32_t>(
+            requested_count,
+            static_cast<uint32_t>(dma_buf_import_fds_.size() / memory_plane_count_));
+    }
+
+    struct v4l2_requestbuffers req;
+    memset(&req, 0, sizeof(req));
+    req.count = requested_count;
+    req.type = buf_type_;
+    req.memory = V4L2_MEMORY_DMABUF;
+
+    if (Xioctl(device_fd_, VIDIOC_REQBUFS, &req) < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                      "VIDIOC_REQBUFS(DMABUF) failed: %s", strerror(errno));
+        return false;
+    }
+
+    // 驱动可能上调 buffer 数量；外部 fd 不足时无法满足
+    if (req.count < 2 ||
+        (!dma_buf_import_fds_.empty() &&
+         req.count * memory_plane_count_ > dma_buf_import_fds_.size()))
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                      "DMA-BUF import: driver requires %u buffers, have %u",
+                                      req.count, requested_count);
+        return false;
+    }
+
+    v4l2_memory_ = V4L2_MEMORY_DMABUF;
+    buffers_.clear();
+    buffers_.resize(req.count);
+    for (uint32_t i = 0; i < req.count; ++i)
+    {
+        buffers_[i].plane_count = memory_plane_count_;
+        for (uint32_t p = 0; p < memory_plane_count_; ++p)
+        {
+            if (!ImportPlaneFd(i, p, allocator.get()))
+            {
+                return false;
+            }
+        }
+        buffers_[i].dma_buf_exported = true;
+    }
+
+    packed_plane_offsets_ = {};
+    for (uint32_t p = 1; p < memory_plane_count_; ++p)
+    {
+        packed_plane_offsets_[p] = packed_plane_offsets_[p - 1] + buffers_[0].planes[p - 1].length;
+    }
+
+    dma_buf_frame_count_ = 0;
+    dma_buf_export_failures_ = 0;
+    lease_exhausted_count_ = 0;
+    dma_buf_path_enabled_ = true;
+    UpdateLeaseBudget();
+
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_source",
+                                  "DMA-BUF import enabled: allocator=%s buffer_count=%zu "
+                                  "fds_per_buffer=%u lease_in_flight_max=%zu",
+                                  dma_buf_import_fds_.empty() ? allocator->Name() : "external",
+                                  buffers_.size(),
+                                  memory_plane_count_,
+                                  global_lease_in_flight_max_.load());
+    return QueueAllBuffers();
+}
+
+bool CameraSource::InitUserPtr()
+{
+    if (memory_plane_count_ != 1)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                      "USERPTR capture needs a single memory plane, got %u",
+                                      memory_plane_count_);
+        return false;
+    }
+
+    struct v4l2_requestbuffers req;
+    memset(&req, 0, sizeof(req));
+    req.count = config_.buffer_count_;
+    req.type = buf_type_;
+    req.memory = V4L2_MEMORY_USERPTR;
+
+    if (Xioctl(device_fd_, VIDIOC_REQBUFS, &req) < 0)
     {
-        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
-                                      "Failed to open %s: %s", device_path_.c_str(),
-                                      strerror(errno));
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                      "VIDIOC_REQBUFS(USERPTR) failed: %s", strerror(errno));
         return false;
     }
-
-    struct v4l2_capability cap;
-    memset(&cap, 0, sizeof(cap));
-    if (Xioctl(device_fd_, VIDIOC_QUERYCAP, &cap) < 0)
+    if (req.count < 2)
     {
-        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
-                                      "VIDIOC_QUERYCAP failed: %s", strerror(errno));
-        CloseDevice();
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                      "USERPTR capture: insufficient buffers (%u)", req.count);
         return false;
     }
 
-    if (!(cap.capabilities & V4L2_CAP_VIDEO_CAPTURE))
+    // 槽位整页对齐，长度覆盖驱动要求的 sizeimage；一半排在驱动队列，一半留给消费者持有
+    const long page = sysconf(_SC_PAGESIZE);
+    const size_t page_size = page > 0 ? static_cast<size_t>(page) : 4096;
+    size_t slot_size = plane_formats_[0].size_image;
+    if (slot_size == 0)
     {
-        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
-                                      "Device does not support V4L2 video capture");
-        CloseDevice();
-        return false;
+        slot_size = CalculateBufferSize(config_);
     }
+    slot_size = (slot_size + page_size - 1) / page_size * page_size;
 
-    if (!(cap.capabilities & V4L2_CAP_STREAMING))
+    core::BufferPool::Options options = buffer_pool_options_;
+    options.use_arena = true;
+    options.alignment = page_size;
+    if (!buffer_pool_.Initialize(req.count * 2, slot_size, options))
     {
-        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
-                                      "Device does not support streaming I/O");
-        CloseDevice();
         return false;
     }
 
-    return true;
-}
-
-void CameraSource::CloseDevice()
-{
-    if (device_fd_ >= 0)
+    buffers_.clear();
+    buffers_.resize(req.count);
+    userptr_slots_.assign(req.count, nullptr);
+    for (uint32_t i = 0; i < req.count; ++i)
     {
-        close(device_fd_);
-        device_fd_ = -1;
+        auto slot = buffer_pool_.Acquire();
+        if (!slot || reinterpret_cast<uintptr_t>(slot->Data()) % page_size != 0)
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                          "USERPTR capture: BufferPool slot %u not page aligned",
+                                          i);
+            userptr_slots_.clear();
+            return false;
+        }
+        userptr_slots_[i] = std::move(slot);
+        buffers_[i].plane_count = 1;
+        buffers_[i].planes[0].length = slot_size;
     }
+
+    v4l2_memory_ = V4L2_MEMORY_USERPTR;
+    pool_buffer_size_ = slot_size;
+    packed_plane_offsets_ = {};
+    dma_buf_path_enabled_ = false;
+
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_source",
+                                  "USERPTR capture enabled: buffer_count=%u slot_size=%zu "
+                                  "pool_slots=%u",
+                                  req.count, slot_size, req.count * 2);
+    return QueueAllBuffers();
 }
 
-bool CameraSource::ConfigureDevice()
+bool CameraSource::InitBackend()
 {
-    struct v4l2_format fmt;
-    memset(&fmt, 0, sizeof(fmt));
-    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    fmt.fmt.pix.width = config_.width_;
-    fmt.fmt.pix.height = config_.height_;
-    fmt.fmt.pix.pixelformat = ToV4L2PixelFormat(config_.format_);
-    fmt.fmt.pix.field = V4L2_FIELD_NONE;
-
-    if (Xioctl(device_fd_, VIDIOC_S_FMT, &fmt) < 0)
+    if (!capture_backend_->Open(config_, config_.buffer_count_) ||
+        capture_backend_->GetBufferCount() < 2)
     {
         platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
-                                      "VIDIOC_S_FMT failed: %s", strerror(errno));
+                                      "capture backend %s open failed", capture_backend_->Name());
         return false;
     }
 
-    const core::PixelFormat negotiated_format = FromV4L2PixelFormat(fmt.fmt.pix.pixelformat);
-    config_.width_ = fmt.fmt.pix.width;
-    config_.height_ = fmt.fmt.pix.height;
-    if (negotiated_format != core::PixelFormat::kUnknown)
+    buf_type_ = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    v4l2_memory_ = V4L2_MEMORY_MMAP;
+    multi_planar_ = false;
+    memory_plane_count_ = 1;
+    plane_formats_ = {};
+    packed_plane_offsets_ = {};
+
+    // buffer 内存归后端所有，CleanupBuffers 不做 munmap
+    buffers_.clear();
+    buffers_.resize(capture_backend_->GetBufferCount());
+    for (uint32_t i = 0; i < buffers_.size(); ++i)
     {
-        config_.format_ = negotiated_format;
+        const CaptureBackend::BufferInfo info = capture_backend_->GetBuffer(i);
+        buffers_[i].plane_count = 1;
+        buffers_[i].planes[0].start = info.start;
+        buffers_[i].planes[0].length = info.length;
     }
+    plane_formats_[0].bytes_per_line = capture_backend_->GetBytesPerLine();
+    plane_formats_[0].size_image = static_cast<uint32_t>(buffers_[0].planes[0].length);
 
-    platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_source",
-                                  "negotiated format: width=%u height=%u fourcc=%c%c%c%c",
-                                  config_.width_,
-                                  config_.height_,
-                                  fmt.fmt.pix.pixelformat & 0xff,
-                                  (fmt.fmt.pix.pixelformat >> 8) & 0xff,
-                                  (fmt.fmt.pix.pixelformat >> 16) & 0xff,
-                                  (fmt.fmt.pix.pixelformat >> 24) & 0xff);
-
-    struct v4l2_streamparm parm;
-    memset(&parm, 0, sizeof(parm));
-    parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    parm.parm.capture.timeperframe.numerator = 1;
-    parm.parm.capture.timeperframe.denominator = std::max<uint32_t>(1, config_.fps_);
-
-    if (Xioctl(device_fd_, VIDIOC_S_PARM, &parm) < 0)
+    dma_buf_path_enabled_ = false;
+    dma_buf_frame_count_ = 0;
+    dma_buf_export_failures_ = 0;
+    lease_exhausted_count_ = 0;
+    if (config_.io_method_ == static_cast<uint32_t>(core::IoMethod::kDmaBuf))
     {
-        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
-                                      "VIDIOC_S_PARM failed: %s", strerror(errno));
+        // 与 EXPBUF 一致，CameraSource 持有 fd 副本，由 CleanupDmaBufExports 关闭
+        bool all_exported = true;
+        for (uint32_t i = 0; i < buffers_.size() && all_exported; ++i)
+        {
+            const int backend_fd = capture_backend_->GetBuffer(i).dma_buf_fd;
+            const int fd = backend_fd >= 0 ? fcntl(backend_fd, F_DUPFD_CLOEXEC, 0) : -1;
+            buffers_[i].planes[0].dma_buf_fd = fd;
+            buffers_[i].dma_buf_exported = fd >= 0;
+            all_exported = fd >= 0;
+        }
+
+        if (all_exported)
+        {
+            UpdateLeaseBudget();
+            dma_buf_path_enabled_ = true;
+        }
+        else
+        {
+            CleanupDmaBufExports();
+            platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                          "capture backend %s has no DMA-BUF fds, "
+                                          "falling back to copy",
+                                          capture_backend_->Name());
+        }
     }
 
-    return true;
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_source",
+                                  "capture backend %s: buffers=%zu buffer_size=%zu dma_buf=%d",
+                                  capture_backend_->Name(), buffers_.size(),
+                                  buffers_[0].planes[0].length, dma_buf_path_enabled_ ? 1 : 0);
+    return QueueAllBuffers();
 }
 
-bool CameraSource::InitMMap()
+bool CameraSource::ImportPlaneFd(uint32_t buffer_index, uint32_t plane,
+                                 core::DmaBufAllocator* allocator)
 {
-    struct v4l2_requestbuffers req;
-    memset(&req, 0, sizeof(req));
-    req.count = config_.buffer_count_;
-    req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    req.memory = V4L2_MEMORY_MMAP;
+    size_t required = plane_formats_[plane].size_image;
+    if (required == 0)
+    {
+        required = CalculateBufferSize(config_);
+    }
 
-    if (Xioctl(device_fd_, VIDIOC_REQBUFS, &req) < 0)
+    int fd = -1;
+    if (!dma_buf_import_fds_.empty())
+    {
+        const int external_fd = dma_buf_import_fds_[buffer_index * memory_plane_count_ + plane];
+        fd = fcntl(external_fd, F_DUPFD_CLOEXEC, 0);
+    }
+    else
+    {
+        fd = allocator->Allocate(required);
+    }
+    if (fd < 0)
     {
         platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
-                                      "VIDIOC_REQBUFS failed: %s", strerror(errno));
+                                      "DMA-BUF import: no fd for buffer %u plane %u: %s",
+                                      buffer_index, plane, strerror(errno));
         return false;
     }
 
-    if (req.count < 2)
+    Plane& target = buffers_[buffer_index].planes[plane];
+    target.dma_buf_fd = fd;
+
+    const off_t size = lseek(fd, 0, SEEK_END);
+    if (size < 0 || static_cast<size_t>(size) < required)
     {
         platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
-                                      "Insufficient buffer memory");
+                                      "DMA-BUF import: buffer %u plane %u has %lld bytes, "
+                                      "need %zu",
+                                      buffer_index, plane, static_cast<long long>(size), required);
         return false;
     }
+    target.length = static_cast<size_t>(size);
 
-    buffers_.clear();
-    buffers_.resize(req.count);
-
-    for (uint32_t i = 0; i < req.count; ++i)
+    // CPU 映射仅供拷贝回退路径使用，部分 heap（如安全 heap）不支持，失败不影响零拷贝
+    void* start = mmap(nullptr, target.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (start == MAP_FAILED)
     {
-        struct v4l2_buffer buf;
-        memset(&buf, 0, sizeof(buf));
-        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-        buf.memory = V4L2_MEMORY_MMAP;
-        buf.index = i;
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                      "DMA-BUF import: buffer %u plane %u not CPU mappable: %s",
+                                      buffer_index, plane, strerror(errno));
+        start = nullptr;
+    }
+    target.start = start;
+    return true;
+}
 
-        if (Xioctl(device_fd_, VIDIOC_QUERYBUF, &buf) < 0)
+bool CameraSource::QueueAllBuffers()
+{
+    for (uint32_t i = 0; i < buffers_.size(); ++i)
+    {
+        if (buffers_[i].orphaned)
         {
-            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
-                                          "VIDIOC_QUERYBUF failed: %s", strerror(errno));
-            return false;
+            continue;
         }
-
-        buffers_[i].length = buf.length;
-        buffers_[i].start =
-            mmap(nullptr, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, device_fd_, buf.m.offset);
-        if (buffers_[i].start == MAP_FAILED)
+        if (QueueBuffer(i) < 0)
         {
             platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
-                                          "mmap failed: %s", strerror(errno));
+                                          "VIDIOC_QBUF failed: %s", strerror(errno));
             return false;
         }
     }
+    return true;
+}
 
-    dma_buf_path_enabled_ = false;
-    dma_buf_frame_count_ = 0;
-    dma_buf_export_failures_ = 0;
-    lease_exhausted_count_ = 0;
-    if (config_.io_method_ == static_cast<uint32_t>(core::IoMethod::kDmaBuf))
+bool CameraSource::QueueUnleasedBuffers()
+{
+    // 持锁排入并置 active，之后归还的 lease 由释放回调自行 QBUF，不会漏排
+    std::lock_guard<std::mutex> lock(requeue_context_->mutex);
+    const std::vector<bool>& leased = requeue_context_->leased;
+    for (uint32_t i = 0; i < buffers_.size(); ++i)
     {
-        dma_buf_path_enabled_ = InitDmaBufExport();
-        if (!dma_buf_path_enabled_)
+        if (buffers_[i].orphaned || (i < leased.size() && leased[i]))
         {
-            platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
-                                          "DMA-BUF export unavailable, falling back to MMAP copy");
+            continue;
         }
-    }
-
-    for (uint32_t i = 0; i < buffers_.size(); ++i)
-    {
-        struct v4l2_buffer buf;
-        memset(&buf, 0, sizeof(buf));
-        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-        buf.memory = V4L2_MEMORY_MMAP;
-        buf.index = i;
-
-        if (Xioctl(device_fd_, VIDIOC_QBUF, &buf) < 0)
+        if (QueueBuffer(i) < 0)
         {
             platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
                                           "VIDIOC_QBUF failed: %s", strerror(errno));
             return false;
         }
     }
-
+    requeue_context_->active = true;
     return true;
 }
 
@@ -687,27 +1905,9 @@ bool CameraSource::InitDmaBufExport()
     }
 
     bool all_exported = true;
-    for (uint32_t i = 0; i < buffers_.size(); ++i)
+    for (uint32_t i = 0; i < buffers_.size() && all_exported; ++i)
     {
-        struct v4l2_exportbuffer expbuf;
-        std::memset(&expbuf, 0, sizeof(expbuf));
-        expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-        expbuf.index = i;
-        expbuf.plane = 0;
-        expbuf.flags = O_CLOEXEC;
-
-        if (Xioctl(device_fd_, VIDIOC_EXPBUF, &expbuf) < 0)
-        {
-            dma_buf_export_failures_.fetch_add(1);
-            all_exported = false;
-            platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
-                                          "VIDIOC_EXPBUF failed for buffer %u: %s",
-                                          i, strerror(errno));
-            break;
-        }
-
-        buffers_[i].dma_buf_fd = expbuf.fd;
-        buffers_[i].dma_buf_exported = true;
+        all_exported = ExportBuffer(i);
     }
 
     if (!all_exported)
@@ -716,22 +1916,44 @@ bool CameraSource::InitDmaBufExport()
         return false;
     }
 
-    min_queued_capture_buffers_ = buffers_.size() >= 4 ? 2 : 1;
-    if (buffers_.size() <= min_queued_capture_buffers_)
-    {
-        global_lease_in_flight_max_ = 1;
-    }
-    else
-    {
-        global_lease_in_flight_max_ = buffers_.size() - min_queued_capture_buffers_;
-    }
+    UpdateLeaseBudget();
 
     platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_source",
                                   "DMA-BUF export enabled: actual_buffer_count=%zu "
-                                  "min_queued_capture_buffers=%zu lease_in_flight_max=%zu",
+                                  "fds_per_buffer=%u min_queued_capture_buffers=%zu "
+                                  "lease_in_flight_max=%zu",
                                   buffers_.size(),
-                                  min_queued_capture_buffers_,
-                                  global_lease_in_flight_max_);
+                                  memory_plane_count_,
+                                  min_queued_capture_buffers_.load(),
+                                  global_lease_in_flight_max_.load());
+    return true;
+}
+
+bool CameraSource::ExportBuffer(uint32_t index)
+{
+    // MPLANE 下每个内存 plane 各导出一个 fd
+    Buffer& buffer = buffers_[index];
+    for (uint32_t p = 0; p < buffer.plane_count; ++p)
+    {
+        struct v4l2_exportbuffer expbuf;
+        std::memset(&expbuf, 0, sizeof(expbuf));
+        expbuf.type = buf_type_;
+        expbuf.index = index;
+        expbuf.plane = p;
+        expbuf.flags = O_CLOEXEC;
+
+        if (Xioctl(device_fd_, VIDIOC_EXPBUF, &expbuf) < 0)
+        {
+            dma_buf_export_failures_.fetch_add(1);
+            platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
+                                          "VIDIOC_EXPBUF failed for buffer %u plane %u: %s",
+                                          index, p, strerror(errno));
+            return false;
+        }
+
+        buffer.planes[p].dma_buf_fd = expbuf.fd;
+    }
+    buffer.dma_buf_exported = true;
     return true;
 }
 
@@ -755,11 +1977,14 @@ void CameraSource::CleanupDmaBufExports()
 
     for (auto& buffer : buffers_)
     {
-        if (buffer.dma_buf_fd >= 0)
+        for (auto& plane : buffer.planes)
         {
-            close(buffer.dma_buf_fd);
+            if (plane.dma_buf_fd >= 0)
+            {
+                close(plane.dma_buf_fd);
+            }
+            plane.dma_buf_fd = -1;
         }
-        buffer.dma_buf_fd = -1;
         buffer.dma_buf_exported = false;
     }
     dma_buf_path_enabled_ = false;
@@ -777,19 +2002,94 @@ bool CameraSource::ShouldUseDmaBufPath() const
 
 void CameraSource::RequeueBuffer(uint32_t buffer_index)
 {
-    struct v4l2_buffer qbuf;
-    std::memset(&qbuf, 0, sizeof(qbuf));
-    qbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    qbuf.memory = V4L2_MEMORY_MMAP;
-    qbuf.index = buffer_index;
-
-    if (Xioctl(device_fd_, VIDIOC_QBUF, &qbuf) < 0)
+    if (QueueBuffer(buffer_index) < 0)
     {
         platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
                                       "VIDIOC_QBUF failed: %s", strerror(errno));
     }
 }
 
+int CameraSource::QueueBuffer(uint32_t buffer_index) const
+{
+    if (capture_backend_)
+    {
+        return capture_backend_->Queue(buffer_index) ? 0 : -1;
+    }
+
+    if (v4l2_memory_ == V4L2_MEMORY_USERPTR)
+    {
+        if (buffer_index >= userptr_slots_.size() || !userptr_slots_[buffer_index])
+        {
+            errno = EINVAL;
+            return -1;
+        }
+
+        const auto& slot = userptr_slots_[buffer_index];
+        struct v4l2_buffer buf;
+        struct v4l2_plane planes[VIDEO_MAX_PLANES];
+        InitV4L2Buffer(buf, planes, buf_type_, V4L2_MEMORY_USERPTR, 1);
+        buf.index = buffer_index;
+        if (multi_planar_)
+        {
+            planes[0].m.userptr = reinterpret_cast<unsigned long>(slot->Data());
+            planes[0].length = static_cast<uint32_t>(slot->Size());
+        }
+        else
+        {
+            buf.m.userptr = reinterpret_cast<unsigned long>(slot->Data());
+            buf.length = static_cast<uint32_t>(slot->Size());
+        }
+        return Xioctl(device_fd_, VIDIOC_QBUF, &buf);
+    }
+
+    std::array<int, core::kMaxFramePlanes> fds{{-1, -1, -1}};
+    std::array<uint32_t, core::kMaxFramePlanes> lengths{};
+    if (buffer_index < buffers_.size())
+    {
+        const Buffer& buffer = buffers_[buffer_index];
+        for (uint32_t p = 0; p < buffer.plane_count; ++p)
+        {
+            fds[p] = buffer.planes[p].dma_buf_fd;
+            lengths[p] = static_cast<uint32_t>(buffer.planes[p].length);
+        }
+    }
+    return QueueCaptureBuffer(device_fd_, buf_type_, v4l2_memory_, buffer_index,
+                              memory_plane_count_, fds.data(), lengths.data());
+}
+
+void CameraSource::UpdateLeaseBudget()
+{
+    const size_t usable = UsableBufferCount();
+    const size_t min_queued = usable >= 4 ? 2 : 1;
+    min_queued_capture_buffers_.store(min_queued);
+    if (usable <= min_queued)
+    {
+        global_lease_in_flight_max_.store(1);
+    }
+    else
+    {
+        global_lease_in_flight_max_.store(usable - min_queued);
+    }
+}
+
+void CameraSource::NotifyLeaseBudget()
+{
+    if (!dma_buf_path_enabled_)
+    {
+        return;
+    }
+
+    LeaseBudgetCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callback = lease_budget_callback_;
+    }
+    if (callback)
+    {
+        callback(global_lease_in_flight_max_.load());
+    }
+}
+
 bool CameraSource::StartStream()
 {
     if (streaming_)
@@ -797,7 +2097,20 @@ bool CameraSource::StartStream()
         return true;
     }
 
-    enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (capture_backend_)
+    {
+        if (!capture_backend_->StartStreaming())
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
+                                          "capture backend %s start failed",
+                                          capture_backend_->Name());
+            return false;
+        }
+        streaming_ = true;
+        return true;
+    }
+
+    enum v4l2_buf_type type = static_cast<enum v4l2_buf_type>(buf_type_);
     if (Xioctl(device_fd_, VIDIOC_STREAMON, &type) < 0)
     {
         platform::PlatformLogger::Log(core::LogLevel::kError, "camera_source",
@@ -816,7 +2129,14 @@ void CameraSource::StopStream()
         return;
     }
 
-    enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (capture_backend_)
+    {
+        capture_backend_->StopStreaming();
+        streaming_ = false;
+        return;
+    }
+
+    enum v4l2_buf_type type = static_cast<enum v4l2_buf_type>(buf_type_);
     if (Xioctl(device_fd_, VIDIOC_STREAMOFF, &type) < 0)
     {
         platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_source",
@@ -827,14 +2147,20 @@ void CameraSource::StopStream()
 
 void CameraSource::CleanupBuffers()
 {
+    // USERPTR 槽位归还 BufferPool；调用时流已停止，驱动不再访问这些页
+    userptr_slots_.clear();
+    orphaned_buffer_count_ = 0;
     for (auto& buffer : buffers_)
     {
-        if (buffer.start && buffer.length > 0)
+        for (auto& plane : buffer.planes)
         {
-            munmap(buffer.start, buffer.length);
+            if (plane.start && plane.length > 0 && !capture_backend_)
+            {
+                munmap(plane.start, plane.length);
+            }
+            plane.start = nullptr;
+            plane.length = 0;
         }
-        buffer.start = nullptr;
-        buffer.length = 0;
     }
     buffers_.clear();
 }
@@ -862,25 +2188,79 @@ size_t CameraSource::CalculateBufferSize(const core::CameraConfig& config) const
     }
 }
 
+bool CameraSource::UseElasticBufferPool() const
+{
+    if (buffer_pool_options_.shareable)
+    {
+        return false;
+    }
+
+    switch (config_.format_)
+    {
+        case core::PixelFormat::kMJPEG:
+        case core::PixelFormat::kH264:
+        case core::PixelFormat::kH265:
+            return true;
+        default:
+            return false;
+    }
+}
+
+core::BufferPool::ElasticOptions CameraSource::MakeElasticPoolOptions() const
+{
+    core::BufferPool::ElasticOptions options;
+    // 最大档位必须容纳驱动上报的整块 buffer，避免大帧被截断
+    options.class_sizes =
+        core::BufferPool::MakeSizeClasses(kElasticMinClassSize, pool_buffer_size_);
+    options.max_buffers_per_class = config_.buffer_count_;
+    options.max_total_bytes = config_.buffer_count_ * pool_buffer_size_;
+    return options;
+}
+
 void CameraSource::FillFrameLayout(core::FrameHandle& frame, size_t buffer_size) const
 {
     const uint32_t width = frame.width_;
     const uint32_t height = frame.height_;
+    // 行跨度取 S_FMT 协商出的 bytesperline（含 ISP 对齐 padding），驱动未填时按紧密排布估算
+    const uint32_t negotiated_stride = plane_formats_[0].bytes_per_line;
 
     if (frame.format_ == core::PixelFormat::kNV12)
     {
+        const uint32_t y_stride = negotiated_stride != 0 ? negotiated_stride : width;
         frame.plane_count_ = 2;
-        frame.line_stride_[0] = width;
-        frame.line_stride_[1] = width;
+        frame.line_stride_[0] = y_stride;
         frame.plane_offset_[0] = 0;
-        frame.plane_offset_[1] = width * height;
-        frame.plane_size_[0] = width * height;
-        frame.plane_size_[1] = width * height / 2;
+        frame.plane_size_[0] = y_stride * height;
+        if (memory_plane_count_ >= 2)
+        {
+            // NV12M：UV 位于独立内存 plane，拷贝路径中紧随 Y plane 的整块 buffer
+            const uint32_t uv_stride = plane_formats_[1].bytes_per_line != 0
+                                           ? plane_formats_[1].bytes_per_line
+                                           : y_stride;
+            frame.line_stride_[1] = uv_stride;
+            frame.plane_offset_[1] = static_cast<uint32_t>(packed_plane_offsets_[1]);
+            frame.plane_size_[1] = uv_stride * height / 2;
+        }
+        else
+        {
+            // 部分 ISP 把 Y plane 高度对齐到 16 / 32 行，UV 紧随对齐后的 Y plane；按驱动给出的
+            // sizeimage 反推实际高度。后端 buffer 按页取整且帧紧密排布，不做推算
+            uint32_t y_height = height;
+            const uint64_t packed_size = static_cast<uint64_t>(y_stride) * height * 3 / 2;
+            if (!capture_backend_ && plane_formats_[0].size_image > packed_size)
+            {
+                y_height = static_cast<uint32_t>(
+                    static_cast<uint64_t>(plane_formats_[0].size_image) * 2 / (y_stride * 3ULL));
+            }
+            frame.line_stride_[1] = y_stride;
+            frame.plane_offset_[1] = y_stride * y_height;
+            frame.plane_size_[1] = y_stride * y_height / 2;
+        }
     }
     else
     {
         frame.plane_count_ = 1;
-        frame.line_stride_[0] = width * 2;
+        frame.line_stride_[0] = negotiated_stride != 0 ? negotiated_stride : width * 2;
         frame.plane_offset_[0] = 0;
         frame.plane_size_[0] = static_cast<uint32_t>(buffer_size);
     }
@@ -888,9 +2268,7 @@ void CameraSource::FillFrameLayout(core::FrameHandle& frame, size_t buffer_size)
 
 uint64_t CameraSource::GetTimestampNs() const
 {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    return MonotonicNowNs();
 }
 
 uint32_t CameraSource::ToV4L2PixelFormat(core::PixelFormat format) const
@@ -922,6 +2300,7 @@ core::PixelFormat CameraSource::FromV4L2PixelFormat(uint32_t format) const
     switch (format)
     {
         case V4L2_PIX_FMT_NV12:
+        case V4L2_PIX_FMT_NV12M:
             return core::PixelFormat::kNV12;
         case V4L2_PIX_FMT_YUYV:
             return core::PixelFormat::kYUYV;
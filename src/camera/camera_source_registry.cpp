@@ -0,0 +1,213 @@
+/**
+ * @file camera_source_registry.cpp
+ * @brief 多路 CameraSource 注册表实现
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#include "camera_subsystem/camera/camera_source_registry.h"
+
+#include "camera_subsystem/platform/platform_logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace camera_subsystem
+{
+namespace camera
+{
+
+CameraSourceRegistry::CameraSourceRegistry(SourceSetup setup)
+    : CameraSourceRegistry(std::move(setup), Options())
+{
+}
+
+CameraSourceRegistry::CameraSourceRegistry(SourceSetup setup, const Options& options)
+    : setup_(std::move(setup))
+    , reactor_(std::make_shared<CaptureReactor>())
+{
+    if (!reactor_->Start(std::max<size_t>(options.reactor_threads, 1)))
+    {
+        // 各 source 退回私有反应器，功能不受影响
+        platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_registry",
+                                      "shared capture reactor start failed, "
+                                      "sources use private reactors");
+        reactor_.reset();
+    }
+}
+
+CameraSourceRegistry::~CameraSourceRegistry()
+{
+    StopAll();
+    if (reactor_)
+    {
+        reactor_->Stop();
+    }
+}
+
+bool CameraSourceRegistry::Start(const ipc::CameraEndpoint& endpoint,
+                                 const core::CameraConfig& config)
+{
+    const std::string key = MakeKey(endpoint);
+    std::shared_ptr<Entry> entry;
+    bool created = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& item : entries_)
+        {
+            if (item.first != key && item.second->endpoint.camera_id == endpoint.camera_id)
+            {
+                platform::PlatformLogger::Log(core::LogLevel::kError, "camera_registry",
+                                              "camera_id %u of %s already used by %s",
+                                              endpoint.camera_id, endpoint.device_path,
+                                              item.second->endpoint.device_path);
+                return false;
+            }
+        }
+
+        auto it = entries_.find(key);
+        if (it == entries_.end())
+        {
+            entry = std::make_shared<Entry>();
+            entry->endpoint = endpoint;
+            entry->source = std::make_shared<CameraSource>();
+            entries_.emplace(key, entry);
+            created = true;
+        }
+        else
+        {
+            entry = it->second;
+        }
+    }
+
+    bool ok = true;
+    {
+        std::lock_guard<std::mutex> entry_lock(entry->mutex);
+        CameraSource& source = *entry->source;
+        source.Stop();
+        if (created)
+        {
+            source.SetDevicePath(endpoint.device_path);
+            source.SetCameraId(endpoint.camera_id);
+            source.SetCaptureReactor(reactor_);
+            ok = !setup_ || setup_(endpoint, source);
+        }
+        ok = ok && source.Initialize(config) && source.Start();
+    }
+
+    if (!ok)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_registry",
+                                      "start failed: camera_id=%u device=%s",
+                                      endpoint.camera_id, endpoint.device_path);
+        Stop(endpoint);
+        return false;
+    }
+
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_registry",
+                                  "started: camera_id=%u device=%s active=%zu",
+                                  endpoint.camera_id, endpoint.device_path, GetSourceCount());
+    return true;
+}
+
+void CameraSourceRegistry::Stop(const ipc::CameraEndpoint& endpoint)
+{
+    std::shared_ptr<Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(MakeKey(endpoint));
+        if (it == entries_.end())
+        {
+            return;
+        }
+        entry = std::move(it->second);
+        entries_.erase(it);
+    }
+
+    // 停流在注册表锁外进行，不阻塞其他端点
+    std::lock_guard<std::mutex> entry_lock(entry->mutex);
+    entry->source->Stop();
+}
+
+void CameraSourceRegistry::StopAll()
+{
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries.swap(entries_);
+    }
+    for (auto& item : entries)
+    {
+        std::lock_guard<std::mutex> entry_lock(item.second->mutex);
+        item.second->source->Stop();
+    }
+}
+
+std::shared_ptr<CameraSource>
+CameraSourceRegistry::Find(const ipc::CameraEndpoint& endpoint) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(MakeKey(endpoint));
+    return it == entries_.end() ? nullptr : it->second->source;
+}
+
+size_t CameraSourceRegistry::GetSourceCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+std::vector<CameraSourceRegistry::SourceStats> CameraSourceRegistry::GetStats() const
+{
+    std::vector<std::shared_ptr<Entry>> entries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries.reserve(entries_.size());
+        for (const auto& item : entries_)
+        {
+            entries.push_back(item.second);
+        }
+    }
+
+    std::vector<SourceStats> stats;
+    stats.reserve(entries.size());
+    for (const auto& entry : entries)
+    {
+        const CameraSource& source = *entry->source;
+        SourceStats item;
+        item.endpoint = entry->endpoint;
+        item.config = source.GetConfig();
+        item.running = source.IsRunning();
+        item.frames = source.GetFrameCount();
+        item.dropped_frames = source.GetDroppedFrameCount();
+        item.stream_generation = source.GetStreamGeneration();
+        item.pool = source.GetBufferPoolStats();
+        stats.push_back(item);
+    }
+    std::sort(stats.begin(), stats.end(),
+              [](const SourceStats& lhs, const SourceStats& rhs)
+              {
+                  return lhs.endpoint.camera_id < rhs.endpoint.camera_id;
+              });
+    return stats;
+}
+
+std::shared_ptr<CaptureReactor> CameraSourceRegistry::GetCaptureReactor() const
+{
+    return reactor_;
+}
+
+std::string CameraSourceRegistry::MakeKey(const ipc::CameraEndpoint& endpoint)
+{
+    const size_t path_length =
+        strnlen(endpoint.device_path, sizeof(endpoint.device_path));
+    std::string key = std::to_string(endpoint.camera_id) + ":" +
+                      std::to_string(static_cast<uint32_t>(endpoint.bus_type)) + ":" +
+                      std::to_string(endpoint.bus_index) + ":";
+    key.append(endpoint.device_path, path_length);
+    return key;
+}
+
+} // namespace camera
+} // namespace camera_subsystem
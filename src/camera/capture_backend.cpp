@@ -0,0 +1,340 @@
+/**
+ * @file capture_backend.cpp
+ * @brief 定时出帧采集后端基类实现
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#include "camera_subsystem/camera/capture_backend.h"
+
+#include "camera_subsystem/platform/platform_logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <sys/mman.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <utility>
+
+namespace camera_subsystem {
+namespace camera {
+
+namespace {
+
+size_t RoundUpToPage(size_t size)
+{
+    const long page = sysconf(_SC_PAGESIZE);
+    const size_t page_size = page > 0 ? static_cast<size_t>(page) : 4096;
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+uint64_t MonotonicNowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+struct timespec ToTimespec(uint64_t ns)
+{
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1000000000ULL);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000ULL);
+    return ts;
+}
+
+} // namespace
+
+PacedCaptureBackend::PacedCaptureBackend(std::shared_ptr<core::DmaBufAllocator> allocator)
+    : allocator_(std::move(allocator))
+{
+}
+
+PacedCaptureBackend::~PacedCaptureBackend()
+{
+    PacedCaptureBackend::Close();
+}
+
+size_t PacedCaptureBackend::RawFrameSize(const core::CameraConfig& config)
+{
+    const size_t width = config.width_;
+    const size_t height = config.height_;
+    switch (config.format_)
+    {
+        case core::PixelFormat::kNV12:
+            return width * height * 3 / 2;
+        case core::PixelFormat::kRGB888:
+            return width * height * 3;
+        case core::PixelFormat::kRGBA8888:
+            return width * height * 4;
+        case core::PixelFormat::kYUYV:
+        default:
+            return width * height * 2;
+    }
+}
+
+bool PacedCaptureBackend::Open(const core::CameraConfig& config, uint32_t buffer_count)
+{
+    Close();
+
+    if (!config.IsValid())
+    {
+        return false;
+    }
+    config_ = config;
+
+    frame_capacity_ = PrepareFrames(config_);
+    if (frame_capacity_ == 0)
+    {
+        return false;
+    }
+
+    const size_t length = RoundUpToPage(frame_capacity_);
+    slots_.resize(std::max<uint32_t>(buffer_count, 2));
+    for (size_t i = 0; i < slots_.size(); ++i)
+    {
+        Slot& slot = slots_[i];
+        void* start = MAP_FAILED;
+        if (allocator_)
+        {
+            slot.fd = allocator_->Allocate(length);
+            if (slot.fd >= 0)
+            {
+                start = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, slot.fd, 0);
+            }
+        }
+        else
+        {
+            start = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                         -1, 0);
+        }
+
+        if (start == MAP_FAILED)
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "capture_backend",
+                                          "%s buffer %zu allocation of %zu bytes failed: %s",
+                                          Name(), i, length, strerror(errno));
+            ReleaseSlots();
+            return false;
+        }
+        slot.start = static_cast<uint8_t*>(start);
+        slot.length = length;
+        InitBuffer(slot.start, frame_capacity_);
+    }
+
+    timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd_ < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "capture_backend",
+                                      "timerfd_create failed: %s", strerror(errno));
+        ReleaseSlots();
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued_.clear();
+        is_queued_.assign(slots_.size(), false);
+    }
+    period_ns_ = 1000000000ULL / config_.fps_;
+    starved_frames_ = 0;
+
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "capture_backend",
+                                  "%s opened: %ux%u fps=%u buffers=%zu frame_capacity=%zu "
+                                  "dma_buf=%d",
+                                  Name(), config_.width_, config_.height_, config_.fps_,
+                                  slots_.size(), frame_capacity_, allocator_ ? 1 : 0);
+    return true;
+}
+
+void PacedCaptureBackend::Close()
+{
+    if (timer_fd_ >= 0)
+    {
+        close(timer_fd_);
+        timer_fd_ = -1;
+    }
+    ReleaseSlots();
+}
+
+void PacedCaptureBackend::ReleaseSlots()
+{
+    for (auto& slot : slots_)
+    {
+        if (slot.start != nullptr)
+        {
+            munmap(slot.start, slot.length);
+        }
+        if (slot.fd >= 0)
+        {
+            close(slot.fd);
+        }
+    }
+    slots_.clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    queued_.clear();
+    is_queued_.clear();
+}
+
+size_t PacedCaptureBackend::GetBufferCount() const
+{
+    return slots_.size();
+}
+
+CaptureBackend::BufferInfo PacedCaptureBackend::GetBuffer(uint32_t index) const
+{
+    BufferInfo info;
+    if (index < slots_.size())
+    {
+        info.start = slots_[index].start;
+        info.length = slots_[index].length;
+        info.dma_buf_fd = slots_[index].fd;
+    }
+    return info;
+}
+
+uint32_t PacedCaptureBackend::GetBytesPerLine() const
+{
+    switch (config_.format_)
+    {
+        case core::PixelFormat::kNV12:
+            return config_.width_;
+        case core::PixelFormat::kYUYV:
+            return config_.width_ * 2;
+        case core::PixelFormat::kRGB888:
+            return config_.width_ * 3;
+        case core::PixelFormat::kRGBA8888:
+            return config_.width_ * 4;
+        default:
+            return 0;
+    }
+}
+
+int PacedCaptureBackend::GetPollFd() const
+{
+    return timer_fd_;
+}
+
+bool PacedCaptureBackend::StartStreaming()
+{
+    if (timer_fd_ < 0)
+    {
+        return false;
+    }
+
+    start_ns_ = MonotonicNowNs();
+    ticks_ = 0;
+    end_of_stream_ = false;
+
+    // 绝对时刻定时：第 k 帧的节拍固定在 start + k * period，不随处理耗时累积误差
+    struct itimerspec spec;
+    std::memset(&spec, 0, sizeof(spec));
+    spec.it_value = ToTimespec(start_ns_ + period_ns_);
+    spec.it_interval = ToTimespec(period_ns_);
+    if (timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr) != 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "capture_backend",
+                                      "timerfd_settime failed: %s", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void PacedCaptureBackend::StopStreaming()
+{
+    if (timer_fd_ < 0)
+    {
+        return;
+    }
+
+    struct itimerspec spec;
+    std::memset(&spec, 0, sizeof(spec));
+    timerfd_settime(timer_fd_, 0, &spec, nullptr);
+
+    // 清掉已到期未读的节拍，避免下次 Start 立即出一帧旧节拍
+    uint64_t expirations = 0;
+    (void)read(timer_fd_, &expirations, sizeof(expirations));
+}
+
+bool PacedCaptureBackend::Queue(uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index >= is_queued_.size() || is_queued_[index])
+    {
+        errno = EINVAL;
+        return false;
+    }
+    is_queued_[index] = true;
+    queued_.push_back(index);
+    return true;
+}
+
+bool PacedCaptureBackend::Dequeue(CapturedFrame& frame)
+{
+    uint64_t expirations = 0;
+    if (timer_fd_ < 0 ||
+        read(timer_fd_, &expirations, sizeof(expirations)) != sizeof(expirations) ||
+        expirations == 0 || end_of_stream_)
+    {
+        return false;
+    }
+
+    // 一次读到多个节拍说明消费方落后，与传感器一样只出最新一帧，sequence 体现跳变
+    if (expirations > 1)
+    {
+        SkipFrames(expirations - 1);
+    }
+    ticks_ += expirations;
+
+    uint32_t index = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queued_.empty())
+        {
+            starved_frames_.fetch_add(1);
+            SkipFrames(1);
+            return false;
+        }
+        index = queued_.front();
+        queued_.pop_front();
+        is_queued_[index] = false;
+    }
+
+    // 出队后的 buffer 只属于反应器线程，填充无需持锁
+    const auto sequence = static_cast<uint32_t>(ticks_ - 1);
+    const size_t bytes_used = FillFrame(slots_[index].start, frame_capacity_, sequence);
+    if (bytes_used == 0)
+    {
+        end_of_stream_ = true;
+        StopStreaming();
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_queued_[index] = true;
+        queued_.push_front(index);
+        return false;
+    }
+
+    frame.index = index;
+    frame.bytes_used = static_cast<uint32_t>(std::min(bytes_used, frame_capacity_));
+    frame.sequence = sequence;
+    frame.timestamp_ns = start_ns_ + ticks_ * period_ns_;
+    return true;
+}
+
+uint64_t PacedCaptureBackend::GetStarvedFrameCount() const
+{
+    return starved_frames_.load();
+}
+
+void PacedCaptureBackend::SkipFrames(uint64_t /*count*/)
+{
+}
+
+void PacedCaptureBackend::InitBuffer(uint8_t* /*data*/, size_t /*capacity*/)
+{
+}
+
+} // namespace camera
+} // namespace camera_subsystem
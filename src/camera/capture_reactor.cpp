@@ -0,0 +1,317 @@
+/**
+ * @file capture_reactor.cpp
+ * @brief 基于 epoll 的多路采集反应器实现
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#include "camera_subsystem/camera/capture_reactor.h"
+
+#include "camera_subsystem/platform/platform_logger.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace camera_subsystem {
+namespace camera {
+
+namespace {
+
+// epoll 用户数据 0 保留给控制 eventfd，源 ID 从 1 开始
+constexpr uint64_t kControlId = 0;
+
+} // namespace
+
+CaptureReactor::CaptureReactor() = default;
+
+CaptureReactor::~CaptureReactor()
+{
+    Stop();
+}
+
+bool CaptureReactor::Start(size_t thread_count)
+{
+    if (is_running_.load())
+    {
+        return true;
+    }
+
+    if (!epoll_.Create())
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "capture_reactor",
+                                      "epoll create failed: %s", std::strerror(errno));
+        return false;
+    }
+
+    event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (event_fd_ < 0 || !epoll_.Add(event_fd_, EPOLLIN, kControlId))
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "capture_reactor",
+                                      "control eventfd setup failed: %s", std::strerror(errno));
+        if (event_fd_ >= 0)
+        {
+            close(event_fd_);
+            event_fd_ = -1;
+        }
+        epoll_.Close();
+        return false;
+    }
+
+    stopping_.store(false);
+    is_running_.store(true);
+
+    const size_t count = thread_count == 0 ? 1 : thread_count;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto thread = std::make_unique<platform::PlatformThread>(
+            "capture_reactor_" + std::to_string(i), [this]() { Loop(); });
+        if (!thread->Start())
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "capture_reactor",
+                                          "reactor thread %zu start failed", i);
+            Stop();
+            return false;
+        }
+        threads_.push_back(std::move(thread));
+    }
+    return true;
+}
+
+void CaptureReactor::Stop()
+{
+    if (!is_running_.exchange(false))
+    {
+        return;
+    }
+
+    // eventfd 保持可读（不在停止时读取），所有反应器线程都会被唤醒并退出
+    stopping_.store(true);
+    Notify();
+    for (auto& thread : threads_)
+    {
+        thread->Join();
+    }
+    threads_.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& entry : sources_)
+        {
+            entry.second->removed = true;
+        }
+        sources_.clear();
+        tasks_.clear();
+    }
+
+    if (event_fd_ >= 0)
+    {
+        close(event_fd_);
+        event_fd_ = -1;
+    }
+    epoll_.Close();
+}
+
+bool CaptureReactor::IsRunning() const
+{
+    return is_running_.load();
+}
+
+uint64_t CaptureReactor::AddSource(int fd, ReadyCallback callback, uint32_t events)
+{
+    if (!is_running_.load() || fd < 0 || !callback)
+    {
+        return 0;
+    }
+
+    auto source = std::make_shared<Source>();
+    source->fd = fd;
+    source->events = events | EPOLLONESHOT;
+    source->callback = std::move(callback);
+
+    uint64_t source_id = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        source_id = next_source_id_++;
+        sources_.emplace(source_id, source);
+    }
+
+    if (!epoll_.Add(fd, source->events, source_id))
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "capture_reactor",
+                                      "epoll add fd=%d failed: %s", fd, std::strerror(errno));
+        std::lock_guard<std::mutex> lock(mutex_);
+        sources_.erase(source_id);
+        return 0;
+    }
+    return source_id;
+}
+
+bool CaptureReactor::RemoveSource(uint64_t source_id)
+{
+    std::shared_ptr<Source> source;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sources_.find(source_id);
+        if (it == sources_.end())
+        {
+            return false;
+        }
+        source = it->second;
+        source->removed = true;
+        sources_.erase(it);
+    }
+
+    // 先从 epoll 摘除；进行中的回调返回后发现 removed，不会重新挂载
+    (void)epoll_.Remove(source->fd);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    const std::thread::id self = std::this_thread::get_id();
+    dispatch_cv_.wait(lock, [&]() {
+        return source->dispatching == 0 || source->dispatch_thread == self;
+    });
+    return true;
+}
+
+bool CaptureReactor::Post(Task task)
+{
+    if (!is_running_.load() || !task)
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    Notify();
+    return true;
+}
+
+CaptureReactor::Stats CaptureReactor::GetStats() const
+{
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.source_count = sources_.size();
+    }
+    stats.thread_count = threads_.size();
+    stats.wait_returns = wait_returns_.load(std::memory_order_relaxed);
+    stats.dispatches = dispatches_.load(std::memory_order_relaxed);
+    stats.control_wakeups = control_wakeups_.load(std::memory_order_relaxed);
+    stats.tasks_run = tasks_run_.load(std::memory_order_relaxed);
+    stats.error_removals = error_removals_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void CaptureReactor::Loop()
+{
+    struct epoll_event events[platform::PlatformEpoll::kMaxEvents];
+    while (!stopping_.load())
+    {
+        const int count = epoll_.Wait(-1, events);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            platform::PlatformLogger::Log(core::LogLevel::kError, "capture_reactor",
+                                          "epoll wait failed: %s", std::strerror(errno));
+            break;
+        }
+        wait_returns_.fetch_add(1, std::memory_order_relaxed);
+
+        for (int i = 0; i < count && !stopping_.load(); ++i)
+        {
+            if (events[i].data.u64 == kControlId)
+            {
+                HandleControl();
+            }
+            else
+            {
+                Dispatch(events[i].data.u64, events[i].events);
+            }
+        }
+    }
+}
+
+void CaptureReactor::Dispatch(uint64_t source_id, uint32_t events)
+{
+    std::shared_ptr<Source> source;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sources_.find(source_id);
+        if (it == sources_.end())
+        {
+            return;
+        }
+        source = it->second;
+        ++source->dispatching;
+        source->dispatch_thread = std::this_thread::get_id();
+    }
+
+    dispatches_.fetch_add(1, std::memory_order_relaxed);
+    const bool keep = source->callback(events);
+
+    bool rearm = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rearm = keep && !source->removed;
+        // 在锁内重新挂载：RemoveSource 置 removed 后摘除 fd，不会与此处交错成重新加入
+        if (rearm && !epoll_.Modify(source->fd, source->events, source_id))
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "capture_reactor",
+                                          "epoll re-arm fd=%d failed: %s", source->fd,
+                                          std::strerror(errno));
+            rearm = false;
+        }
+        --source->dispatching;
+        source->dispatch_thread = std::thread::id();
+    }
+    dispatch_cv_.notify_all();
+
+    if (!keep)
+    {
+        error_removals_.fetch_add(1, std::memory_order_relaxed);
+        (void)RemoveSource(source_id);
+    }
+}
+
+void CaptureReactor::HandleControl()
+{
+    control_wakeups_.fetch_add(1, std::memory_order_relaxed);
+    if (stopping_.load())
+    {
+        return;
+    }
+
+    uint64_t value = 0;
+    (void)read(event_fd_, &value, sizeof(value));
+
+    std::vector<Task> tasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks.swap(tasks_);
+    }
+    for (auto& task : tasks)
+    {
+        task();
+        tasks_run_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void CaptureReactor::Notify()
+{
+    if (event_fd_ < 0)
+    {
+        return;
+    }
+    const uint64_t one = 1;
+    (void)write(event_fd_, &one, sizeof(one));
+}
+
+} // namespace camera
+} // namespace camera_subsystem
@@ -0,0 +1,196 @@
+/**
+ * @file file_replay_capture_backend.cpp
+ * @brief 录制文件回放采集后端实现
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#include "camera_subsystem/camera/file_replay_capture_backend.h"
+
+#include "camera_subsystem/platform/platform_logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace camera_subsystem {
+namespace camera {
+
+FileReplayCaptureBackend::FileReplayCaptureBackend(std::string path)
+    : FileReplayCaptureBackend(std::move(path), Options())
+{
+}
+
+FileReplayCaptureBackend::FileReplayCaptureBackend(
+    std::string path, Options options, std::shared_ptr<core::DmaBufAllocator> allocator)
+    : PacedCaptureBackend(std::move(allocator))
+    , path_(std::move(path))
+    , options_(options)
+{
+}
+
+FileReplayCaptureBackend::~FileReplayCaptureBackend()
+{
+    UnmapFile();
+}
+
+const char* FileReplayCaptureBackend::Name() const
+{
+    return "FileReplay";
+}
+
+size_t FileReplayCaptureBackend::GetFrameCount() const
+{
+    return frames_.size();
+}
+
+size_t FileReplayCaptureBackend::PrepareFrames(const core::CameraConfig& config)
+{
+    UnmapFile();
+    if (!MapFile())
+    {
+        return 0;
+    }
+
+    frames_.clear();
+    cursor_ = 0;
+    if (config.format_ == core::PixelFormat::kMJPEG)
+    {
+        IndexJpegFrames();
+    }
+    else
+    {
+        const size_t frame_size = RawFrameSize(config);
+        for (size_t offset = 0; offset + frame_size <= file_size_; offset += frame_size)
+        {
+            frames_.push_back({offset, frame_size});
+        }
+        if (file_size_ % frame_size != 0)
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kWarning, "capture_backend",
+                                          "%s ignores %zu trailing bytes of %s", Name(),
+                                          file_size_ % frame_size, path_.c_str());
+        }
+    }
+
+    if (frames_.empty())
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "capture_backend",
+                                      "%s found no frames in %s (format=%u %ux%u)", Name(),
+                                      path_.c_str(), static_cast<uint32_t>(config.format_),
+                                      config.width_, config.height_);
+        UnmapFile();
+        return 0;
+    }
+
+    size_t max_length = 0;
+    for (const auto& frame : frames_)
+    {
+        max_length = std::max(max_length, frame.length);
+    }
+    return max_length;
+}
+
+size_t FileReplayCaptureBackend::FillFrame(uint8_t* data, size_t capacity, uint32_t /*sequence*/)
+{
+    if (frames_.empty() || (!options_.loop && cursor_ >= frames_.size()))
+    {
+        return 0;
+    }
+
+    const FrameSpan& frame = frames_[cursor_ % frames_.size()];
+    ++cursor_;
+    const size_t length = std::min(frame.length, capacity);
+    std::memcpy(data, file_data_ + frame.offset, length);
+    return length;
+}
+
+void FileReplayCaptureBackend::SkipFrames(uint64_t count)
+{
+    cursor_ += count;
+}
+
+bool FileReplayCaptureBackend::MapFile()
+{
+    const int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "capture_backend",
+                                      "open %s failed: %s", path_.c_str(), strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "capture_backend",
+                                      "%s is empty or not a regular file", path_.c_str());
+        close(fd);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "capture_backend",
+                                      "mmap %s failed: %s", path_.c_str(), strerror(errno));
+        return false;
+    }
+
+    madvise(data, size, MADV_SEQUENTIAL);
+    file_data_ = static_cast<const uint8_t*>(data);
+    file_size_ = size;
+    return true;
+}
+
+void FileReplayCaptureBackend::UnmapFile()
+{
+    if (file_data_ != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(file_data_), file_size_);
+    }
+    file_data_ = nullptr;
+    file_size_ = 0;
+    frames_.clear();
+}
+
+void FileReplayCaptureBackend::IndexJpegFrames()
+{
+    size_t pos = 0;
+    while (pos + 1 < file_size_)
+    {
+        if (file_data_[pos] != 0xFF || file_data_[pos + 1] != 0xD8)
+        {
+            ++pos;
+            continue;
+        }
+
+        const size_t start = pos;
+        size_t end = 0;
+        for (size_t i = start + 2; i + 1 < file_size_; ++i)
+        {
+            if (file_data_[i] == 0xFF && file_data_[i + 1] == 0xD9)
+            {
+                end = i + 2;
+                break;
+            }
+        }
+        if (end == 0)
+        {
+            // 末尾残缺帧
+            break;
+        }
+        frames_.push_back({start, end - start});
+        pos = end;
+    }
+}
+
+} // namespace camera
+} // namespace camera_subsystem
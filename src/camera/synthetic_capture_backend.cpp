@@ -0,0 +1,257 @@
+/**
+ * @file synthetic_capture_backend.cpp
+ * @brief 合成图案采集后端与 memfd 伪 DMA-BUF 后端实现
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#include "camera_subsystem/camera/synthetic_capture_backend.h"
+
+#include "camera_subsystem/platform/platform_logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace camera_subsystem {
+namespace camera {
+
+namespace {
+
+constexpr uint32_t kBarCount = 8;
+// BT.601 75% 色条：白、黄、青、绿、品红、红、蓝、黑
+constexpr uint8_t kBarY[kBarCount] = {235, 210, 170, 145, 106, 81, 41, 16};
+constexpr uint8_t kBarU[kBarCount] = {128, 16, 166, 54, 202, 90, 240, 128};
+constexpr uint8_t kBarV[kBarCount] = {128, 146, 16, 34, 222, 240, 110, 128};
+
+constexpr char kJpegComment[] = "camera_subsystem synthetic frame ";
+
+uint32_t BarAt(uint32_t x, uint32_t shift, uint32_t width)
+{
+    return static_cast<uint32_t>((static_cast<uint64_t>((x + shift) % width) * kBarCount) /
+                                 width);
+}
+
+void AppendMarker(std::vector<uint8_t>& out, uint8_t marker, uint16_t length)
+{
+    out.push_back(0xFF);
+    out.push_back(marker);
+    out.push_back(static_cast<uint8_t>(length >> 8));
+    out.push_back(static_cast<uint8_t>(length & 0xFF));
+}
+
+/**
+ * @brief 构造单分量灰度 baseline JPEG
+ *
+ * DC / AC Huffman 表各只有一个长度为 1 的码字（DC 差值 0、EOB），每个 8x8 块编码为 2 bit
+ * 的 0，整幅解码为 128 灰。扫描数据不含 0xFF，无需字节填充。
+ * @param sequence_offset 输出 COM 段中 4 字节帧号的偏移
+ */
+std::vector<uint8_t> BuildGrayJpeg(uint32_t width, uint32_t height, size_t& sequence_offset)
+{
+    std::vector<uint8_t> out;
+    out.push_back(0xFF);
+    out.push_back(0xD8); // SOI
+
+    const size_t comment_length = sizeof(kJpegComment) - 1;
+    AppendMarker(out, 0xFE, static_cast<uint16_t>(2 + comment_length + 4)); // COM
+    out.insert(out.end(), kJpegComment, kJpegComment + comment_length);
+    sequence_offset = out.size();
+    out.insert(out.end(), 4, 0);
+
+    AppendMarker(out, 0xDB, 67); // DQT
+    out.push_back(0x00);
+    out.insert(out.end(), 64, 1);
+
+    AppendMarker(out, 0xC0, 11); // SOF0
+    out.push_back(8);
+    out.push_back(static_cast<uint8_t>(height >> 8));
+    out.push_back(static_cast<uint8_t>(height & 0xFF));
+    out.push_back(static_cast<uint8_t>(width >> 8));
+    out.push_back(static_cast<uint8_t>(width & 0xFF));
+    out.push_back(1);    // 分量数
+    out.push_back(1);    // 分量 ID
+    out.push_back(0x11); // 采样因子
+    out.push_back(0);    // 量化表
+
+    for (const uint8_t table_class : {0x00, 0x10})
+    {
+        AppendMarker(out, 0xC4, 2 + 1 + 16 + 1); // DHT
+        out.push_back(table_class);
+        out.push_back(1); // 长度 1 的码字 1 个
+        out.insert(out.end(), 15, 0);
+        out.push_back(0x00); // DC 类别 0 / AC EOB
+    }
+
+    AppendMarker(out, 0xDA, 8); // SOS
+    out.push_back(1);
+    out.push_back(1);
+    out.push_back(0x00);
+    out.push_back(0);
+    out.push_back(63);
+    out.push_back(0);
+
+    const uint64_t blocks = static_cast<uint64_t>((width + 7) / 8) * ((height + 7) / 8);
+    const uint64_t bits = blocks * 2;
+    out.insert(out.end(), static_cast<size_t>((bits + 7) / 8), 0);
+    if (bits % 8 != 0)
+    {
+        // 末字节剩余位按规范以 1 填充
+        out.back() = static_cast<uint8_t>((1u << (8 - bits % 8)) - 1);
+    }
+
+    out.push_back(0xFF);
+    out.push_back(0xD9); // EOI
+    return out;
+}
+
+} // namespace
+
+SyntheticCaptureBackend::SyntheticCaptureBackend()
+    : SyntheticCaptureBackend(Options())
+{
+}
+
+SyntheticCaptureBackend::SyntheticCaptureBackend(
+    Options options, std::shared_ptr<core::DmaBufAllocator> allocator)
+    : PacedCaptureBackend(std::move(allocator))
+    , options_(options)
+{
+}
+
+const char* SyntheticCaptureBackend::Name() const
+{
+    return "Synthetic";
+}
+
+size_t SyntheticCaptureBackend::GetJpegSequenceOffset() const
+{
+    return jpeg_sequence_offset_;
+}
+
+size_t SyntheticCaptureBackend::PrepareFrames(const core::CameraConfig& config)
+{
+    jpeg_template_.clear();
+    switch (config.format_)
+    {
+        case core::PixelFormat::kNV12:
+            if (config.width_ % 2 != 0 || config.height_ % 2 != 0)
+            {
+                break;
+            }
+            return RawFrameSize(config);
+        case core::PixelFormat::kYUYV:
+            if (config.width_ % 2 != 0)
+            {
+                break;
+            }
+            return RawFrameSize(config);
+        case core::PixelFormat::kMJPEG:
+            if (config.width_ > 0xFFFF || config.height_ > 0xFFFF)
+            {
+                break;
+            }
+            jpeg_template_ = BuildGrayJpeg(config.width_, config.height_, jpeg_sequence_offset_);
+            return jpeg_template_.size();
+        default:
+            break;
+    }
+
+    platform::PlatformLogger::Log(core::LogLevel::kError, "capture_backend",
+                                  "%s backend does not support format=%u %ux%u", Name(),
+                                  static_cast<uint32_t>(config.format_), config.width_,
+                                  config.height_);
+    return 0;
+}
+
+void SyntheticCaptureBackend::InitBuffer(uint8_t* data, size_t /*capacity*/)
+{
+    if (Config().format_ == core::PixelFormat::kMJPEG)
+    {
+        std::memcpy(data, jpeg_template_.data(), jpeg_template_.size());
+        return;
+    }
+    DrawPattern(data, 0);
+}
+
+size_t SyntheticCaptureBackend::FillFrame(uint8_t* data, size_t capacity, uint32_t sequence)
+{
+    if (Config().format_ == core::PixelFormat::kMJPEG)
+    {
+        // 模板已在 InitBuffer 写入，逐帧只更新 COM 段中的帧号
+        std::memcpy(data + jpeg_sequence_offset_, &sequence, sizeof(sequence));
+        return jpeg_template_.size();
+    }
+
+    if (options_.animate)
+    {
+        DrawPattern(data, sequence * 4);
+    }
+    std::memcpy(data, &sequence, sizeof(sequence));
+    return std::min(RawFrameSize(Config()), capacity);
+}
+
+void SyntheticCaptureBackend::DrawPattern(uint8_t* data, uint32_t shift) const
+{
+    const uint32_t width = Config().width_;
+    const uint32_t height = Config().height_;
+
+    // 各行相同：先画首行再整行复制
+    if (Config().format_ == core::PixelFormat::kNV12)
+    {
+        uint8_t* y_plane = data;
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            y_plane[x] = kBarY[BarAt(x, shift, width)];
+        }
+        for (uint32_t row = 1; row < height; ++row)
+        {
+            std::memcpy(y_plane + static_cast<size_t>(row) * width, y_plane, width);
+        }
+
+        uint8_t* uv_plane = data + static_cast<size_t>(width) * height;
+        for (uint32_t x = 0; x < width; x += 2)
+        {
+            const uint32_t bar = BarAt(x, shift, width);
+            uv_plane[x] = kBarU[bar];
+            uv_plane[x + 1] = kBarV[bar];
+        }
+        for (uint32_t row = 1; row < height / 2; ++row)
+        {
+            std::memcpy(uv_plane + static_cast<size_t>(row) * width, uv_plane, width);
+        }
+        return;
+    }
+
+    const size_t line = static_cast<size_t>(width) * 2;
+    for (uint32_t x = 0; x < width; x += 2)
+    {
+        const uint32_t bar = BarAt(x, shift, width);
+        data[x * 2] = kBarY[bar];
+        data[x * 2 + 1] = kBarU[bar];
+        data[x * 2 + 2] = kBarY[bar];
+        data[x * 2 + 3] = kBarV[bar];
+    }
+    for (uint32_t row = 1; row < height; ++row)
+    {
+        std::memcpy(data + row * line, data, line);
+    }
+}
+
+MemfdCaptureBackend::MemfdCaptureBackend()
+    : MemfdCaptureBackend(Options())
+{
+}
+
+MemfdCaptureBackend::MemfdCaptureBackend(Options options)
+    : SyntheticCaptureBackend(options, std::make_shared<core::MemfdAllocator>())
+{
+}
+
+const char* MemfdCaptureBackend::Name() const
+{
+    return "Memfd";
+}
+
+} // namespace camera
+} // namespace camera_subsystem
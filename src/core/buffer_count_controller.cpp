@@ -0,0 +1,78 @@
+/**
+ * @file buffer_count_controller.cpp
+ * @brief 采集 buffer 数量控制器实现
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#include "camera_subsystem/core/buffer_count_controller.h"
+
+#include <algorithm>
+
+namespace camera_subsystem {
+namespace core {
+
+BufferCountController::BufferCountController()
+    : BufferCountController(Options())
+{
+}
+
+BufferCountController::BufferCountController(const Options& options)
+    : options_(options)
+{
+    options_.min_buffers = std::max<uint32_t>(options_.min_buffers, 2);
+    options_.max_buffers = std::max(options_.max_buffers, options_.min_buffers);
+}
+
+void BufferCountController::Reset()
+{
+    surplus_windows_ = 0;
+}
+
+uint32_t BufferCountController::Clamp(uint32_t count) const
+{
+    return std::min(std::max(count, options_.min_buffers), options_.max_buffers);
+}
+
+uint32_t BufferCountController::EstimateNeeded(const Window& window) const
+{
+    uint64_t held = 0;
+    if (window.leases > 0 && window.frame_interval_ns > 0)
+    {
+        held = (window.lease_hold_p99_ns + window.frame_interval_ns - 1) /
+               window.frame_interval_ns;
+    }
+    const uint64_t needed = options_.driver_headroom + 1 + held;
+    return static_cast<uint32_t>(std::min<uint64_t>(needed, UINT32_MAX));
+}
+
+uint32_t BufferCountController::Update(const Window& window)
+{
+    const uint32_t current = window.buffer_count;
+    const uint32_t needed = EstimateNeeded(window);
+    const bool underrun = window.lease_exhausted > 0 || window.min_queued == 0;
+
+    if (underrun || needed > current)
+    {
+        surplus_windows_ = 0;
+        // 欠载时至少加 1，即使持有时间估算尚未反映出来
+        return Clamp(std::max(needed, underrun ? current + 1 : current));
+    }
+
+    if (needed < current)
+    {
+        ++surplus_windows_;
+        if (surplus_windows_ >= options_.shrink_after_windows)
+        {
+            surplus_windows_ = 0;
+            return Clamp(needed);
+        }
+        return Clamp(current);
+    }
+
+    surplus_windows_ = 0;
+    return Clamp(current);
+}
+
+} // namespace core
+} // namespace camera_subsystem
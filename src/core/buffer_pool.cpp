@@ -9,13 +9,62 @@
 #include "camera_subsystem/core/buffer_guard.h"
 
 #include <algorithm>
+#include <cerrno>
 #include <chrono>
 #include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
 #include <thread>
+#include <unistd.h>
 
 namespace camera_subsystem {
 namespace core {
 
+namespace {
+
+constexpr size_t kMinSlotAlignment = 64;
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+constexpr size_t kDefaultMinSizeClass = 64 * 1024;
+constexpr size_t kDefaultMaxSizeClass = 8 * 1024 * 1024;
+
+size_t RoundUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+size_t PageSize()
+{
+    const long page_size = sysconf(_SC_PAGESIZE);
+    return page_size > 0 ? static_cast<size_t>(page_size) : 4096;
+}
+
+uint64_t NowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+/**
+ * @brief ID 入队直至成功
+ *
+ * 环形队列容量不小于 ID 总数，但并发出队者抢到槽位、尚未发布序号时入队会瞬时失败，
+ * 必须重试，否则该 ID 永久丢失。
+ */
+void PushId(BoundedMpmcRing<uint32_t>& ring, uint32_t id)
+{
+    uint32_t value = id;
+    while (!ring.TryPush(std::move(value)))
+    {
+        std::this_thread::yield();
+        value = id;
+    }
+}
+
+} // namespace
+
 BufferPool::BufferPool()
     : buffer_size_(0)
     , initialized_(false)
@@ -40,6 +89,11 @@ BufferPool::~BufferPool()
 }
 
 bool BufferPool::Initialize(size_t buffer_count, size_t buffer_size)
+{
+    return Initialize(buffer_count, buffer_size, Options());
+}
+
+bool BufferPool::Initialize(size_t buffer_count, size_t buffer_size, const Options& options)
 {
     if (buffer_count == 0 || buffer_size == 0)
     {
@@ -48,51 +102,286 @@ bool BufferPool::Initialize(size_t buffer_count, size_t buffer_size)
 
     Clear();
 
-    buffers_.resize(buffer_count);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (options.shareable)
+    {
+        // 共享模式不回退到堆：消费者依赖可传递的 fd
+        if (!MapMemfdLocked(buffer_count, buffer_size, options))
+        {
+            return false;
+        }
+    }
+    else if (!options.use_arena || !MapArenaLocked(buffer_count, buffer_size, options))
+    {
+        backing_ = BufferBacking::kHeap;
+        slot_stride_ = buffer_size;
+    }
+
+    buffers_.reset(new BufferEntry[buffer_count]);
+    classes_.reset(new SizeClass[1]);
+    class_count_ = 1;
+    class_capacity_ = buffer_count;
+    SizeClass& size_class = classes_[0];
+    size_class.buffer_size = buffer_size;
+    size_class.free_ids.reset(new BoundedMpmcRing<uint32_t>(buffer_count));
+    size_class.allocated.store(buffer_count, std::memory_order_relaxed);
     for (size_t i = 0; i < buffer_count; ++i)
     {
-        buffers_[i].storage = std::make_unique<uint8_t[]>(buffer_size);
+        if (arena_)
+        {
+            buffers_[i].block.data = static_cast<uint8_t*>(arena_) + i * slot_stride_;
+        }
+        else
+        {
+            buffers_[i].storage = std::make_unique<uint8_t[]>(buffer_size);
+            buffers_[i].block.data = buffers_[i].storage.get();
+        }
         buffers_[i].block.id = static_cast<uint32_t>(i);
-        buffers_[i].block.data = buffers_[i].storage.get();
         buffers_[i].block.size = buffer_size;
-        buffers_[i].state = BufferState::kFree;
-        free_ids_.push(static_cast<uint32_t>(i));
+        buffers_[i].state.store(BufferState::kFree, std::memory_order_relaxed);
+        uint32_t id = static_cast<uint32_t>(i);
+        size_class.free_ids->TryPush(std::move(id));
+    }
+
+    buffer_count_.store(buffer_count);
+    buffer_size_.store(buffer_size);
+    initialized_.store(true, std::memory_order_release);
+
+    return true;
+}
+
+bool BufferPool::InitializeElastic(const ElasticOptions& options)
+{
+    std::vector<size_t> class_sizes = options.class_sizes;
+    if (class_sizes.empty())
+    {
+        class_sizes = MakeSizeClasses(kDefaultMinSizeClass, kDefaultMaxSizeClass);
+    }
+    std::sort(class_sizes.begin(), class_sizes.end());
+    class_sizes.erase(std::unique(class_sizes.begin(), class_sizes.end()), class_sizes.end());
+    if (class_sizes.front() == 0 || options.max_buffers_per_class == 0 ||
+        options.min_buffers_per_class > options.max_buffers_per_class)
+    {
+        return false;
     }
 
-    buffer_size_ = buffer_size;
-    initialized_ = true;
+    Clear();
 
-    stats_ = Stats{};
-    stats_.total = buffer_count;
-    stats_.available = buffer_count;
-    stats_.in_use = 0;
-    stats_.in_flight = 0;
-    stats_.max_in_use = 0;
-    stats_.max_in_flight = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const size_t capacity = options.max_buffers_per_class;
+    const size_t slot_count = capacity * class_sizes.size();
+    backing_ = BufferBacking::kHeap;
+    slot_stride_ = 0;
+    elastic_ = true;
+    min_buffers_per_class_ = options.min_buffers_per_class;
+    max_total_bytes_ = options.max_total_bytes;
+    idle_trim_ns_ = options.idle_trim_ns;
+    trim_window_start_ns_ = NowNs();
+
+    buffers_.reset(new BufferEntry[slot_count]);
+    classes_.reset(new SizeClass[class_sizes.size()]);
+    class_count_ = class_sizes.size();
+    class_capacity_ = capacity;
+    for (size_t c = 0; c < class_count_; ++c)
+    {
+        SizeClass& size_class = classes_[c];
+        size_class.buffer_size = class_sizes[c];
+        size_class.first_id = static_cast<uint32_t>(c * capacity);
+        size_class.free_ids.reset(new BoundedMpmcRing<uint32_t>(capacity));
+        size_class.spare_ids.reset(new BoundedMpmcRing<uint32_t>(capacity));
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            const uint32_t id = size_class.first_id + static_cast<uint32_t>(i);
+            buffers_[id].block.id = id;
+            buffers_[id].state.store(BufferState::kFree, std::memory_order_relaxed);
+            PushId(*size_class.spare_ids, id);
+        }
+    }
+
+    buffer_count_.store(slot_count);
+    buffer_size_.store(class_sizes.back());
+    initialized_.store(true, std::memory_order_release);
+
+    // 预分配保底数量；超出总字节上限时保留已分配部分
+    for (size_t c = 0; c < class_count_; ++c)
+    {
+        for (size_t i = 0; i < min_buffers_per_class_; ++i)
+        {
+            uint32_t id = 0;
+            if (!GrowClass(classes_[c], &id))
+            {
+                break;
+            }
+            PushId(*classes_[c].free_ids, id);
+        }
+        classes_[c].grow_count.store(0, std::memory_order_relaxed);
+    }
 
     return true;
 }
 
+std::vector<size_t> BufferPool::MakeSizeClasses(size_t min_size, size_t max_size)
+{
+    std::vector<size_t> sizes;
+    if (min_size == 0)
+    {
+        return sizes;
+    }
+    size_t size = min_size;
+    sizes.push_back(size);
+    while (size < max_size)
+    {
+        size *= 2;
+        sizes.push_back(size);
+    }
+    return sizes;
+}
+
 std::shared_ptr<BufferGuard> BufferPool::Acquire()
+{
+    return Acquire(0);
+}
+
+std::shared_ptr<BufferGuard> BufferPool::Acquire(size_t size_hint)
+{
+    if (initialized_.load(std::memory_order_acquire))
+    {
+        for (size_t c = 0; c < class_count_; ++c)
+        {
+            SizeClass& size_class = classes_[c];
+            if (size_class.buffer_size < size_hint)
+            {
+                continue;
+            }
+
+            uint32_t id = 0;
+            if (size_class.free_ids->TryPop(&id))
+            {
+                if (elastic_)
+                {
+                    // 低水位为近似值：并发下的 load/store 竞争只影响收缩时机
+                    const size_t free_now = size_class.free_ids->Size();
+                    if (free_now < size_class.min_free.load(std::memory_order_relaxed))
+                    {
+                        size_class.min_free.store(free_now, std::memory_order_relaxed);
+                    }
+                }
+                return MakeGuard(id);
+            }
+            if (elastic_ && GrowClass(size_class, &id))
+            {
+                return MakeGuard(id);
+            }
+            // 当前档位已满且无法增长，退而使用更大的档位
+        }
+    }
+
+    stats_.acquire_fail.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+size_t BufferPool::TrimIdle()
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    if (!elastic_ || !initialized_.load(std::memory_order_acquire))
+    {
+        return 0;
+    }
 
-    stats_.acquire_count++;
-    if (!initialized_ || free_ids_.empty())
+    const uint64_t now_ns = NowNs();
+    if (now_ns - trim_window_start_ns_ < idle_trim_ns_)
     {
-        stats_.acquire_fail++;
-        return nullptr;
+        return 0;
     }
+    trim_window_start_ns_ = now_ns;
 
-    const uint32_t id = free_ids_.front();
-    free_ids_.pop();
+    size_t released = 0;
+    for (size_t c = 0; c < class_count_; ++c)
+    {
+        SizeClass& size_class = classes_[c];
+        // 整个窗口内始终空闲的 Buffer 没有被用到，每个窗口释放一半，持续空闲时几何衰减
+        size_t to_release = (size_class.min_free.load(std::memory_order_relaxed) + 1) / 2;
+        while (to_release > 0 &&
+               size_class.allocated.load(std::memory_order_relaxed) > min_buffers_per_class_)
+        {
+            uint32_t id = 0;
+            if (!size_class.free_ids->TryPop(&id))
+            {
+                break;
+            }
+            FreeStorage(size_class, id);
+            --to_release;
+            ++released;
+        }
+        size_class.min_free.store(size_class.free_ids->Size(), std::memory_order_relaxed);
+    }
+    return released;
+}
 
-    stats_.available = free_ids_.size();
-    stats_.in_use++;
-    stats_.max_in_use = std::max(stats_.max_in_use, stats_.in_use);
+BufferPool::SizeClass& BufferPool::ClassOf(uint32_t buffer_id)
+{
+    return class_count_ == 1 ? classes_[0] : classes_[buffer_id / class_capacity_];
+}
+
+bool BufferPool::GrowClass(SizeClass& size_class, uint32_t* buffer_id)
+{
+    uint32_t id = 0;
+    if (!size_class.spare_ids || !size_class.spare_ids->TryPop(&id))
+    {
+        return false;
+    }
+
+    const size_t size = size_class.buffer_size;
+    size_t bytes = allocated_bytes_.load(std::memory_order_relaxed);
+    do
+    {
+        if (max_total_bytes_ != 0 && bytes + size > max_total_bytes_)
+        {
+            PushId(*size_class.spare_ids, id);
+            return false;
+        }
+    } while (!allocated_bytes_.compare_exchange_weak(bytes, bytes + size,
+                                                     std::memory_order_relaxed));
+
+    BufferEntry& entry = buffers_[id];
+    entry.storage.reset(new (std::nothrow) uint8_t[size]);
+    if (!entry.storage)
+    {
+        allocated_bytes_.fetch_sub(size, std::memory_order_relaxed);
+        PushId(*size_class.spare_ids, id);
+        return false;
+    }
+    entry.block.data = entry.storage.get();
+    entry.block.size = size;
+
+    size_class.allocated.fetch_add(1, std::memory_order_relaxed);
+    size_class.grow_count.fetch_add(1, std::memory_order_relaxed);
+    // 发生增长说明本窗口内该档位曾经耗尽
+    size_class.min_free.store(0, std::memory_order_relaxed);
+    *buffer_id = id;
+    return true;
+}
+
+void BufferPool::FreeStorage(SizeClass& size_class, uint32_t buffer_id)
+{
+    BufferEntry& entry = buffers_[buffer_id];
+    entry.storage.reset();
+    entry.block.data = nullptr;
+    entry.block.size = 0;
+    allocated_bytes_.fetch_sub(size_class.buffer_size, std::memory_order_relaxed);
+    size_class.allocated.fetch_sub(1, std::memory_order_relaxed);
+    size_class.trim_count.fetch_add(1, std::memory_order_relaxed);
+    PushId(*size_class.spare_ids, buffer_id);
+}
 
-    buffers_[id].state = BufferState::kInUse;
-    active_guard_count_.fetch_add(1);  // ARCH-017: 增加活跃计数
+std::shared_ptr<BufferGuard> BufferPool::MakeGuard(uint32_t id)
+{
+    buffers_[id].state.store(BufferState::kInUse, std::memory_order_relaxed);
+    const uint32_t active = active_guard_count_.fetch_add(1) + 1;  // ARCH-017: 增加活跃计数
+    const size_t in_flight = stats_.in_flight.load(std::memory_order_relaxed);
+    UpdateMax(stats_.max_in_use, active > in_flight ? active - in_flight : 0);
 
     return std::shared_ptr<BufferGuard>(new BufferGuard(this, id, &buffers_[id].block));
 }
@@ -108,22 +397,82 @@ void BufferPool::Clear()
                      leaks.size());
     }
 
-    while (!free_ids_.empty())
-    {
-        free_ids_.pop();
-    }
-
-    buffers_.clear();
-    buffer_size_ = 0;
-    initialized_ = false;
-    stats_ = Stats{};
+    initialized_.store(false, std::memory_order_release);
+    classes_.reset();
+    class_count_ = 0;
+    class_capacity_ = 0;
+    buffers_.reset();
+    elastic_ = false;
+    allocated_bytes_.store(0, std::memory_order_relaxed);
+    UnmapArenaLocked();
+    buffer_count_.store(0);
+    buffer_size_.store(0);
+
+    stats_.in_flight.store(0, std::memory_order_relaxed);
+    stats_.max_in_use.store(0, std::memory_order_relaxed);
+    stats_.max_in_flight.store(0, std::memory_order_relaxed);
+    stats_.release_count.store(0, std::memory_order_relaxed);
+    stats_.acquire_fail.store(0, std::memory_order_relaxed);
 }
 
 BufferPool::Stats BufferPool::GetStats() const
 {
+    Stats stats;
+    stats.total = buffer_count_.load(std::memory_order_relaxed);
+    stats.max_in_use = stats_.max_in_use.load(std::memory_order_relaxed);
+    stats.max_in_flight = stats_.max_in_flight.load(std::memory_order_relaxed);
+    stats.release_count = stats_.release_count.load(std::memory_order_relaxed);
+    stats.acquire_fail = stats_.acquire_fail.load(std::memory_order_relaxed);
+    stats.acquire_count = stats.release_count + active_guard_count_.load() + stats.acquire_fail;
+
+    // 计数器保持无锁读取；遍历尺寸类与槽位需与 Clear() 释放存储互斥
     std::lock_guard<std::mutex> lock(mutex_);
-    Stats stats = stats_;
-    stats.available = free_ids_.size();
+    stats.backing = backing_;
+    stats.slot_stride = slot_stride_;
+    stats.arena_bytes = arena_bytes_;
+    stats.memory_locked = memory_locked_;
+    if (initialized_.load(std::memory_order_acquire))
+    {
+        for (size_t c = 0; c < class_count_; ++c)
+        {
+            const SizeClass& size_class = classes_[c];
+            stats.available += size_class.free_ids->Size();
+            if (!elastic_)
+            {
+                continue;
+            }
+            SizeClassStats class_stats;
+            class_stats.buffer_size = size_class.buffer_size;
+            class_stats.allocated = size_class.allocated.load(std::memory_order_relaxed);
+            class_stats.available = size_class.free_ids->Size();
+            class_stats.max_buffers = class_capacity_;
+            class_stats.grow_count = size_class.grow_count.load(std::memory_order_relaxed);
+            class_stats.trim_count = size_class.trim_count.load(std::memory_order_relaxed);
+            stats.size_classes.push_back(class_stats);
+        }
+        if (elastic_)
+        {
+            stats.total = 0;
+            for (const auto& class_stats : stats.size_classes)
+            {
+                stats.total += class_stats.allocated;
+            }
+            stats.allocated_bytes = allocated_bytes_.load(std::memory_order_relaxed);
+        }
+        const size_t slot_count = buffer_count_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < slot_count; ++i)
+        {
+            const BufferState state = buffers_[i].state.load(std::memory_order_relaxed);
+            if (state == BufferState::kInUse)
+            {
+                stats.in_use++;
+            }
+            else if (state == BufferState::kInFlight)
+            {
+                stats.in_flight++;
+            }
+        }
+    }
     return stats;
 }
 
@@ -136,11 +485,12 @@ std::vector<uint32_t> BufferPool::CheckLeaks() const
 std::vector<uint32_t> BufferPool::CollectLeaksLocked() const
 {
     std::vector<uint32_t> leaked;
-    for (const auto& entry : buffers_)
+    const size_t count = buffer_count_.load();
+    for (size_t i = 0; i < count; ++i)
     {
-        if (entry.state != BufferState::kFree)
+        if (buffers_[i].state.load() != BufferState::kFree)
         {
-            leaked.push_back(entry.block.id);
+            leaked.push_back(buffers_[i].block.id);
         }
     }
     return leaked;
@@ -148,121 +498,255 @@ std::vector<uint32_t> BufferPool::CollectLeaksLocked() const
 
 size_t BufferPool::GetBufferCount() const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return buffers_.size();
+    return buffer_count_.load();
 }
 
 size_t BufferPool::GetBufferSize() const
+{
+    return buffer_size_.load();
+}
+
+int BufferPool::GetShareFd() const
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    return buffer_size_;
+    return share_fd_;
 }
 
-void BufferPool::ReleaseInternal(uint32_t buffer_id)
+size_t BufferPool::GetSlotOffset(uint32_t buffer_id) const
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(buffer_id) * slot_stride_;
+}
 
-    if (!initialized_ || buffer_id >= buffers_.size())
+bool BufferPool::MapArenaLocked(size_t buffer_count, size_t buffer_size, const Options& options)
+{
+    const size_t page_size = PageSize();
+    size_t alignment = kMinSlotAlignment;
+    while (alignment < options.alignment && alignment < page_size)
     {
-        return;
+        alignment <<= 1;
     }
 
-    if (buffers_[buffer_id].state == BufferState::kInFlight)
+    const size_t stride = RoundUp(buffer_size, alignment);
+    const size_t payload = stride * buffer_count;
+
+    void* region = MAP_FAILED;
+    size_t bytes = 0;
+    BufferBacking backing = BufferBacking::kArena;
+
+#ifdef MAP_HUGETLB
+    if (options.huge_pages)
     {
-        if (stats_.in_flight > 0)
-        {
-            stats_.in_flight--;
-        }
+        bytes = RoundUp(payload, kHugePageSize);
+        region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        backing = BufferBacking::kArenaHugeTlb;
     }
-    else if (buffers_[buffer_id].state == BufferState::kInUse)
+#endif
+
+    if (region == MAP_FAILED)
     {
-        if (stats_.in_use > 0)
+        // 未预留 hugetlbfs 页时回退到普通映射，再尝试透明大页
+        bytes = RoundUp(payload, options.huge_pages ? kHugePageSize : page_size);
+        region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                      -1, 0);
+        backing = BufferBacking::kArena;
+        if (region == MAP_FAILED)
         {
-            stats_.in_use--;
+            std::fprintf(stderr, "BufferPool arena mmap of %zu bytes failed: %s, using heap\n",
+                         bytes, std::strerror(errno));
+            return false;
         }
+#ifdef MADV_HUGEPAGE
+        if (options.huge_pages && madvise(region, bytes, MADV_HUGEPAGE) == 0)
+        {
+            backing = BufferBacking::kArenaThp;
+        }
+#endif
     }
 
-    buffers_[buffer_id].state = BufferState::kFree;
-    free_ids_.push(buffer_id);
-    stats_.release_count++;
-    stats_.available = free_ids_.size();
-    
-    // ARCH-017: 减少活跃计数
-    if (active_guard_count_.load() > 0)
+    AdoptArenaLocked(region, bytes, stride, backing, options);
+    return true;
+}
+
+bool BufferPool::MapMemfdLocked(size_t buffer_count, size_t buffer_size, const Options& options)
+{
+    // 跨进程共享：槽位按页对齐，消费者可按槽位偏移单独映射
+    const size_t page_size = PageSize();
+    const size_t stride = RoundUp(buffer_size, page_size);
+    const size_t bytes = stride * buffer_count;
+
+    const int fd = memfd_create("camera_buffer_pool", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0)
     {
-        active_guard_count_.fetch_sub(1);
+        std::fprintf(stderr, "BufferPool memfd_create failed: %s\n", std::strerror(errno));
+        return false;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+        std::fprintf(stderr, "BufferPool memfd ftruncate of %zu bytes failed: %s\n", bytes,
+                     std::strerror(errno));
+        close(fd);
+        return false;
     }
+
+    void* region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (region == MAP_FAILED)
+    {
+        std::fprintf(stderr, "BufferPool memfd mmap of %zu bytes failed: %s\n", bytes,
+                     std::strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    // 尺寸封印后消费者无法截断导致发布端 SIGBUS；FUTURE_WRITE 阻止他方新建可写映射
+    int seals = F_SEAL_SHRINK | F_SEAL_GROW;
+#ifdef F_SEAL_FUTURE_WRITE
+    seals |= F_SEAL_FUTURE_WRITE;
+#endif
+    if (fcntl(fd, F_ADD_SEALS, seals) != 0 &&
+        fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW) != 0)
+    {
+        std::fprintf(stderr, "BufferPool memfd sealing failed: %s\n", std::strerror(errno));
+        munmap(region, bytes);
+        close(fd);
+        return false;
+    }
+    (void)fcntl(fd, F_ADD_SEALS, F_SEAL_SEAL);
+
+    AdoptArenaLocked(region, bytes, stride, BufferBacking::kMemfd, options);
+    share_fd_ = fd;
+    return true;
 }
 
-void BufferPool::MarkInFlight(uint32_t buffer_id)
+void BufferPool::AdoptArenaLocked(void* region, size_t bytes, size_t stride,
+                                  BufferBacking backing, const Options& options)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (!initialized_ || buffer_id >= buffers_.size())
+    if (options.prefault)
     {
-        return;
+        // 逐页写入完成缺页（大页映射下每个大页只触发一次）
+        const size_t page_size = PageSize();
+        volatile uint8_t* bytes_ptr = static_cast<uint8_t*>(region);
+        for (size_t offset = 0; offset < bytes; offset += page_size)
+        {
+            bytes_ptr[offset] = 0;
+        }
     }
 
-    if (buffers_[buffer_id].state == BufferState::kInUse)
+    bool locked = false;
+    if (options.lock_memory)
     {
-        buffers_[buffer_id].state = BufferState::kInFlight;
-        if (stats_.in_use > 0)
+        locked = mlock(region, bytes) == 0;
+        if (!locked)
         {
-            stats_.in_use--;
+            std::fprintf(stderr, "BufferPool arena mlock of %zu bytes failed: %s\n", bytes,
+                         std::strerror(errno));
         }
-        stats_.in_flight++;
-        stats_.max_in_flight = std::max(stats_.max_in_flight, stats_.in_flight);
     }
+
+    arena_ = region;
+    arena_bytes_ = bytes;
+    slot_stride_ = stride;
+    backing_ = backing;
+    memory_locked_ = locked;
 }
 
-void BufferPool::CancelInFlight(uint32_t buffer_id)
+void BufferPool::UnmapArenaLocked()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (!initialized_ || buffer_id >= buffers_.size())
+    if (arena_)
     {
-        return;
+        munmap(arena_, arena_bytes_);
     }
+    if (share_fd_ >= 0)
+    {
+        close(share_fd_);
+        share_fd_ = -1;
+    }
+    arena_ = nullptr;
+    arena_bytes_ = 0;
+    slot_stride_ = 0;
+    backing_ = BufferBacking::kHeap;
+    memory_locked_ = false;
+}
 
-    if (buffers_[buffer_id].state == BufferState::kInFlight)
+void BufferPool::UpdateMax(std::atomic<size_t>& max_value, size_t value)
+{
+    size_t current = max_value.load(std::memory_order_relaxed);
+    while (value > current &&
+           !max_value.compare_exchange_weak(current, value, std::memory_order_relaxed))
     {
-        buffers_[buffer_id].state = BufferState::kInUse;
-        if (stats_.in_flight > 0)
-        {
-            stats_.in_flight--;
-        }
-        stats_.in_use++;
     }
 }
 
-void BufferPool::MarkError(uint32_t buffer_id)
+void BufferPool::ReleaseInternal(uint32_t buffer_id)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_.load(std::memory_order_acquire) || buffer_id >= buffer_count_.load())
+    {
+        return;
+    }
 
-    if (!initialized_ || buffer_id >= buffers_.size())
+    // 只有最后一个持有者会归还，此时不存在并发状态转换，无需 RMW
+    BufferEntry& entry = buffers_[buffer_id];
+    const BufferState previous = entry.state.load(std::memory_order_relaxed);
+    if (previous == BufferState::kFree)
     {
+        // 重复归还：ID 已在空闲队列中，不能再次入队
         return;
     }
+    entry.state.store(BufferState::kFree, std::memory_order_relaxed);
+    if (previous == BufferState::kInFlight)
+    {
+        stats_.in_flight.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // release 语义保证数据写入对下一个 Acquire 方可见
+    PushId(*ClassOf(buffer_id).free_ids, buffer_id);
+    stats_.release_count.fetch_add(1, std::memory_order_relaxed);
 
-    buffers_[buffer_id].state = BufferState::kError;
+    // ARCH-017: 减少活跃计数
+    if (active_guard_count_.load() > 0)
+    {
+        active_guard_count_.fetch_sub(1);
+    }
 }
 
-bool BufferPool::TransitionState(uint32_t buffer_id, BufferState from, BufferState to)
+void BufferPool::MarkInFlight(uint32_t buffer_id)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    if (TransitionState(buffer_id, BufferState::kInUse, BufferState::kInFlight))
+    {
+        UpdateMax(stats_.max_in_flight,
+                  stats_.in_flight.fetch_add(1, std::memory_order_relaxed) + 1);
+    }
+}
 
-    if (!initialized_ || buffer_id >= buffers_.size())
+void BufferPool::CancelInFlight(uint32_t buffer_id)
+{
+    if (TransitionState(buffer_id, BufferState::kInFlight, BufferState::kInUse))
     {
-        return false;
+        stats_.in_flight.fetch_sub(1, std::memory_order_relaxed);
     }
+}
+
+void BufferPool::MarkError(uint32_t buffer_id)
+{
+    if (!initialized_.load(std::memory_order_acquire) || buffer_id >= buffer_count_.load())
+    {
+        return;
+    }
+
+    buffers_[buffer_id].state.store(BufferState::kError);
+}
 
-    if (buffers_[buffer_id].state != from)
+bool BufferPool::TransitionState(uint32_t buffer_id, BufferState from, BufferState to)
+{
+    if (!initialized_.load(std::memory_order_acquire) || buffer_id >= buffer_count_.load())
     {
         return false;
     }
 
-    buffers_[buffer_id].state = to;
-    return true;
+    return buffers_[buffer_id].state.compare_exchange_strong(from, to,
+                                                             std::memory_order_acq_rel);
 }
 
 } // namespace core
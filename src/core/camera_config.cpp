@@ -32,7 +32,7 @@ bool CameraConfig::IsValid() const
 {
     return (width_ > 0 && height_ > 0 && format_ != PixelFormat::kUnknown && fps_ > 0 &&
             buffer_count_ >= 2 && buffer_count_ <= 8 &&
-            io_method_ <= static_cast<uint32_t>(IoMethod::kUserPtr));
+            io_method_ <= static_cast<uint32_t>(IoMethod::kDmaBufImport));
 }
 
 void CameraConfig::Reset()
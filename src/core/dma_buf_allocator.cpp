@@ -0,0 +1,197 @@
+/**
+ * @file dma_buf_allocator.cpp
+ * @brief 外部 DMA-BUF 分配器实现
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#include "camera_subsystem/core/dma_buf_allocator.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/dma-heap.h>
+#include <linux/udmabuf.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <utility>
+
+namespace camera_subsystem {
+namespace core {
+
+namespace {
+
+size_t RoundUpToPage(size_t size)
+{
+    const long page = sysconf(_SC_PAGESIZE);
+    const size_t page_size = page > 0 ? static_cast<size_t>(page) : 4096;
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+/**
+ * @brief 创建指定大小的 memfd
+ * @param seal_shrink true 时加 F_SEAL_SHRINK（udmabuf 要求）
+ */
+int CreateMemfd(size_t bytes, bool seal_shrink)
+{
+    const unsigned int flags = MFD_CLOEXEC | (seal_shrink ? MFD_ALLOW_SEALING : 0u);
+    const int fd = memfd_create("camera_dmabuf_import", flags);
+    if (fd < 0)
+    {
+        std::fprintf(stderr, "DmaBufAllocator memfd_create failed: %s\n", std::strerror(errno));
+        return -1;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+        std::fprintf(stderr, "DmaBufAllocator memfd ftruncate of %zu bytes failed: %s\n", bytes,
+                     std::strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    if (seal_shrink && fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK) != 0)
+    {
+        std::fprintf(stderr, "DmaBufAllocator memfd sealing failed: %s\n", std::strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+std::unique_ptr<DmaBufAllocator> DmaBufAllocator::CreateDefault()
+{
+    auto heap = std::make_unique<DmaHeapAllocator>();
+    if (heap->IsAvailable())
+    {
+        return heap;
+    }
+
+    auto udmabuf = std::make_unique<UdmabufAllocator>();
+    if (udmabuf->IsAvailable())
+    {
+        return udmabuf;
+    }
+    return nullptr;
+}
+
+DmaHeapAllocator::DmaHeapAllocator(std::string heap_path)
+    : heap_path_(std::move(heap_path))
+{
+    heap_fd_ = open(heap_path_.c_str(), O_RDONLY | O_CLOEXEC);
+}
+
+DmaHeapAllocator::~DmaHeapAllocator()
+{
+    if (heap_fd_ >= 0)
+    {
+        close(heap_fd_);
+    }
+}
+
+bool DmaHeapAllocator::IsAvailable() const
+{
+    return heap_fd_ >= 0;
+}
+
+int DmaHeapAllocator::Allocate(size_t size)
+{
+    if (heap_fd_ < 0 || size == 0)
+    {
+        return -1;
+    }
+
+    struct dma_heap_allocation_data data;
+    std::memset(&data, 0, sizeof(data));
+    data.len = RoundUpToPage(size);
+    data.fd_flags = O_RDWR | O_CLOEXEC;
+    if (ioctl(heap_fd_, DMA_HEAP_IOCTL_ALLOC, &data) < 0)
+    {
+        std::fprintf(stderr, "DmaHeapAllocator %s alloc of %zu bytes failed: %s\n",
+                     heap_path_.c_str(), size, std::strerror(errno));
+        return -1;
+    }
+    return static_cast<int>(data.fd);
+}
+
+const char* DmaHeapAllocator::Name() const
+{
+    return "DmaHeap";
+}
+
+UdmabufAllocator::UdmabufAllocator()
+{
+    udmabuf_fd_ = open("/dev/udmabuf", O_RDWR | O_CLOEXEC);
+}
+
+UdmabufAllocator::~UdmabufAllocator()
+{
+    if (udmabuf_fd_ >= 0)
+    {
+        close(udmabuf_fd_);
+    }
+}
+
+bool UdmabufAllocator::IsAvailable() const
+{
+    return udmabuf_fd_ >= 0;
+}
+
+int UdmabufAllocator::Allocate(size_t size)
+{
+    if (udmabuf_fd_ < 0 || size == 0)
+    {
+        return -1;
+    }
+
+    const size_t bytes = RoundUpToPage(size);
+    const int memfd = CreateMemfd(bytes, true);
+    if (memfd < 0)
+    {
+        return -1;
+    }
+
+    struct udmabuf_create create;
+    std::memset(&create, 0, sizeof(create));
+    create.memfd = static_cast<uint32_t>(memfd);
+    create.flags = UDMABUF_FLAGS_CLOEXEC;
+    create.offset = 0;
+    create.size = bytes;
+    const int fd = ioctl(udmabuf_fd_, UDMABUF_CREATE, &create);
+    if (fd < 0)
+    {
+        std::fprintf(stderr, "UdmabufAllocator create of %zu bytes failed: %s\n", bytes,
+                     std::strerror(errno));
+    }
+
+    // dma-buf 持有 memfd 页的引用，memfd 本身可以关闭
+    close(memfd);
+    return fd;
+}
+
+const char* UdmabufAllocator::Name() const
+{
+    return "Udmabuf";
+}
+
+int MemfdAllocator::Allocate(size_t size)
+{
+    if (size == 0)
+    {
+        return -1;
+    }
+    return CreateMemfd(RoundUpToPage(size), false);
+}
+
+const char* MemfdAllocator::Name() const
+{
+    return "Memfd";
+}
+
+} // namespace core
+} // namespace camera_subsystem
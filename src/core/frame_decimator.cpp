@@ -0,0 +1,77 @@
+/**
+ * @file frame_decimator.cpp
+ * @brief 发送端抽帧器实现
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#include "camera_subsystem/core/frame_decimator.h"
+
+namespace camera_subsystem {
+namespace core {
+
+FrameDecimator::FrameDecimator(uint32_t target_fps, uint32_t frame_stride)
+{
+    Configure(target_fps, frame_stride);
+}
+
+void FrameDecimator::Configure(uint32_t target_fps, uint32_t frame_stride)
+{
+    if (target_fps == target_fps_ && frame_stride == frame_stride_)
+    {
+        return;
+    }
+    target_fps_ = target_fps;
+    frame_stride_ = frame_stride;
+    interval_ns_ = target_fps == 0 ? 0 : 1000000000ULL / target_fps;
+    Reset();
+}
+
+void FrameDecimator::Reset()
+{
+    stride_counter_ = 0;
+    next_due_ns_ = 0;
+    has_due_ = false;
+}
+
+bool FrameDecimator::Accept(uint64_t timestamp_ns)
+{
+    if (frame_stride_ > 1 && (stride_counter_++ % frame_stride_) != 0)
+    {
+        ++skipped_;
+        return false;
+    }
+
+    if (interval_ns_ != 0)
+    {
+        // 正常情况下本帧距截止时间不超过一个间隔；更早说明时间戳回退（如重启流），重新对齐
+        if (has_due_ && timestamp_ns + 2 * interval_ns_ < next_due_ns_)
+        {
+            has_due_ = false;
+        }
+
+        const uint64_t tolerance_ns = interval_ns_ / 8;
+        if (has_due_ && timestamp_ns + tolerance_ns < next_due_ns_)
+        {
+            ++skipped_;
+            return false;
+        }
+
+        // 落后一个间隔以上时以本帧重新对齐，否则沿截止时间累加保持平均帧率
+        if (!has_due_ || timestamp_ns >= next_due_ns_ + interval_ns_)
+        {
+            next_due_ns_ = timestamp_ns + interval_ns_;
+        }
+        else
+        {
+            next_due_ns_ += interval_ns_;
+        }
+        has_due_ = true;
+    }
+
+    ++accepted_;
+    return true;
+}
+
+} // namespace core
+} // namespace camera_subsystem
@@ -16,7 +16,8 @@ namespace core
 FrameHandle::FrameHandle()
     : frame_id_(0), camera_id_(0), timestamp_ns_(0), width_(0), height_(0),
       format_(PixelFormat::kUnknown), plane_count_(0), memory_type_(MemoryType::kMmap),
-      buffer_fd_(-1), virtual_address_(nullptr), buffer_size_(0), sequence_(0), flags_(0)
+      buffer_fd_(-1), virtual_address_(nullptr), buffer_size_(0), sequence_(0), flags_(0),
+      stream_generation_(0)
 {
     memset(line_stride_, 0, sizeof(line_stride_));
     memset(plane_offset_, 0, sizeof(plane_offset_));
@@ -66,6 +67,7 @@ void FrameHandle::Reset()
     buffer_size_ = 0;
     sequence_ = 0;
     flags_ = 0;
+    stream_generation_ = 0;
 
     memset(line_stride_, 0, sizeof(line_stride_));
     memset(plane_offset_, 0, sizeof(plane_offset_));
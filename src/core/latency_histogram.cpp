@@ -0,0 +1,144 @@
+/**
+ * @file latency_histogram.cpp
+ * @brief 无锁对数分桶延迟直方图实现
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#include "camera_subsystem/core/latency_histogram.h"
+
+#include <algorithm>
+
+namespace camera_subsystem {
+namespace core {
+
+namespace {
+
+uint64_t PercentileFromBuckets(const std::array<uint64_t, LatencyHistogram::kBucketCount>& buckets,
+                               uint64_t count, uint64_t max_ns, uint32_t per_mille)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    const uint64_t rank = std::max<uint64_t>(1, (count * per_mille + 999) / 1000);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            return std::min(LatencyHistogram::BucketUpperBound(i), max_ns);
+        }
+    }
+    return max_ns;
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram()
+{
+    for (auto& bucket : buckets_)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t LatencyHistogram::BucketIndex(uint64_t latency_ns)
+{
+    if (latency_ns < kSubBuckets)
+    {
+        return static_cast<size_t>(latency_ns);
+    }
+
+    const size_t msb = 63 - static_cast<size_t>(__builtin_clzll(latency_ns));
+    const size_t sub = static_cast<size_t>(latency_ns >> (msb - kSubBucketBits)) &
+                       (kSubBuckets - 1);
+    return (msb - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index)
+{
+    if (index < kSubBuckets)
+    {
+        return index;
+    }
+
+    const size_t msb = index / kSubBuckets + kSubBucketBits - 1;
+    const uint64_t width = 1ULL << (msb - kSubBucketBits);
+    const uint64_t lower = (1ULL << msb) + (index % kSubBuckets) * width;
+    return lower + (width - 1);
+}
+
+void LatencyHistogram::Record(uint64_t latency_ns)
+{
+    buckets_[BucketIndex(latency_ns)].fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+
+    uint64_t current = min_ns_.load(std::memory_order_relaxed);
+    while (latency_ns < current &&
+           !min_ns_.compare_exchange_weak(current, latency_ns, std::memory_order_relaxed))
+    {
+    }
+    current = max_ns_.load(std::memory_order_relaxed);
+    while (latency_ns > current &&
+           !max_ns_.compare_exchange_weak(current, latency_ns, std::memory_order_relaxed))
+    {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::GetSnapshot() const
+{
+    std::array<uint64_t, kBucketCount> buckets;
+    for (size_t i = 0; i < kBucketCount; ++i)
+    {
+        buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    return BuildSnapshot(buckets, sum_ns_.load(std::memory_order_relaxed),
+                         min_ns_.load(std::memory_order_relaxed),
+                         max_ns_.load(std::memory_order_relaxed));
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::TakeSnapshot()
+{
+    std::array<uint64_t, kBucketCount> buckets;
+    for (size_t i = 0; i < kBucketCount; ++i)
+    {
+        buckets[i] = buckets_[i].exchange(0, std::memory_order_relaxed);
+    }
+    return BuildSnapshot(buckets, sum_ns_.exchange(0, std::memory_order_relaxed),
+                         min_ns_.exchange(UINT64_MAX, std::memory_order_relaxed),
+                         max_ns_.exchange(0, std::memory_order_relaxed));
+}
+
+void LatencyHistogram::Reset()
+{
+    (void)TakeSnapshot();
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::BuildSnapshot(
+    const std::array<uint64_t, kBucketCount>& buckets, uint64_t sum_ns, uint64_t min_ns,
+    uint64_t max_ns) const
+{
+    Snapshot snapshot;
+    for (const uint64_t bucket : buckets)
+    {
+        snapshot.count += bucket;
+    }
+    if (snapshot.count == 0)
+    {
+        return snapshot;
+    }
+
+    snapshot.sum_ns = sum_ns;
+    snapshot.min_ns = min_ns == UINT64_MAX ? 0 : min_ns;
+    snapshot.max_ns = max_ns;
+    snapshot.p50_ns = PercentileFromBuckets(buckets, snapshot.count, max_ns, 500);
+    snapshot.p90_ns = PercentileFromBuckets(buckets, snapshot.count, max_ns, 900);
+    snapshot.p99_ns = PercentileFromBuckets(buckets, snapshot.count, max_ns, 990);
+    return snapshot;
+}
+
+} // namespace core
+} // namespace camera_subsystem
@@ -7,6 +7,8 @@
 
 #include "camera_subsystem/ipc/camera_control_client.h"
 
+#include "camera_subsystem/ipc/camera_shm_ring.h"
+
 #include "camera_subsystem/platform/platform_logger.h"
 
 #include <cerrno>
@@ -88,10 +90,18 @@ bool CameraControlClient::IsConnected() const
 bool CameraControlClient::Subscribe(const std::string& client_id,
                                     CameraClientRole role,
                                     const CameraEndpoint& endpoint,
-                                    CameraControlResponse* response)
+                                    CameraControlResponse* response,
+                                    uint32_t target_fps,
+                                    uint32_t frame_stride,
+                                    uint32_t coalesce_window_ms,
+                                    uint32_t data_plane_features)
 {
-    const CameraControlRequest request =
+    CameraControlRequest request =
         MakeControlRequest(CameraControlCommand::kSubscribe, role, endpoint, client_id.c_str());
+    request.target_fps = target_fps;
+    request.frame_stride = frame_stride;
+    request.coalesce_window_ms = coalesce_window_ms;
+    request.data_plane_features = data_plane_features;
     return SendRequest(request, response);
 }
 
@@ -105,6 +115,39 @@ bool CameraControlClient::Unsubscribe(const std::string& client_id,
     return SendRequest(request, response);
 }
 
+bool CameraControlClient::Reconfigure(const std::string& client_id,
+                                      CameraClientRole role,
+                                      const CameraEndpoint& endpoint,
+                                      const CameraStreamFormat& format,
+                                      CameraControlResponse* response)
+{
+    CameraControlRequest request =
+        MakeControlRequest(CameraControlCommand::kReconfigure, role, endpoint, client_id.c_str());
+    request.stream_format = format;
+    return SendRequest(request, response);
+}
+
+bool CameraControlClient::OpenShmRing(const std::string& client_id,
+                                      CameraClientRole role,
+                                      const CameraEndpoint& endpoint,
+                                      CameraShmRingReader* reader,
+                                      CameraControlResponse* response)
+{
+    if (socket_fd_ < 0 || reader == nullptr || response == nullptr)
+    {
+        return false;
+    }
+
+    int memfd = -1;
+    int eventfd = -1;
+    if (!RequestCameraShmRing(socket_fd_, endpoint, client_id.c_str(), role, response, &memfd,
+                              &eventfd))
+    {
+        return false;
+    }
+    return reader->Open(memfd, eventfd, response->shm_ring_consumer_index);
+}
+
 bool CameraControlClient::Ping(CameraControlResponse* response)
 {
     const CameraEndpoint endpoint = MakeDefaultCameraEndpoint(0);
@@ -15,6 +15,7 @@
 #include <cstring>
 #include <fcntl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <thread>
 #include <unistd.h>
@@ -175,6 +176,9 @@ void CameraControlServer::Stop()
     {
         std::lock_guard<std::mutex> lock(clients_mutex_);
         client_subscriptions_.clear();
+        client_shm_rings_.clear();
+        client_pids_.clear();
+        contract_generation_.fetch_add(1);
     }
 
     if (!socket_path_.empty())
@@ -240,10 +244,19 @@ void CameraControlServer::AcceptLoop()
             continue;
         }
 
+        struct ucred credentials;
+        socklen_t credentials_length = sizeof(credentials);
+        pid_t peer_pid = 0;
+        if (getsockopt(client_fd, SOL_SOCKET, SO_PEERCRED, &credentials, &credentials_length) == 0)
+        {
+            peer_pid = credentials.pid;
+        }
+
         {
             std::lock_guard<std::mutex> lock(clients_mutex_);
             client_fds_.insert(client_fd);
             client_subscriptions_[client_fd] = std::vector<ClientSubscription>();
+            client_pids_[client_fd] = peer_pid;
         }
 
         client_threads_.emplace_back(&CameraControlServer::ClientLoop, this, client_fd);
@@ -260,18 +273,23 @@ void CameraControlServer::ClientLoop(int client_fd)
             break;
         }
 
-        const CameraControlResponse response = ProcessRequest(client_fd, request);
-        if (!WriteFull(client_fd, &response, sizeof(response)))
+        ShmRingGrant grant;
+        const CameraControlResponse response = ProcessRequest(client_fd, request, &grant);
+        if (!SendResponse(client_fd, response, grant))
         {
             break;
         }
     }
 
+    CloseShmRings(client_fd, nullptr);
     CleanupClientSubscriptions(client_fd);
 
     {
         std::lock_guard<std::mutex> lock(clients_mutex_);
         client_subscriptions_.erase(client_fd);
+        client_shm_rings_.erase(client_fd);
+        client_pids_.erase(client_fd);
+        contract_generation_.fetch_add(1);
         auto it = client_fds_.find(client_fd);
         if (it != client_fds_.end())
         {
@@ -303,7 +321,8 @@ void CameraControlServer::CleanupClientSubscriptions(int client_fd)
 }
 
 CameraControlResponse CameraControlServer::ProcessRequest(int client_fd,
-                                                          const CameraControlRequest& request)
+                                                          const CameraControlRequest& request,
+                                                          ShmRingGrant* grant)
 {
     if (!IsControlRequestHeaderValid(request))
     {
@@ -345,8 +364,14 @@ CameraControlResponse CameraControlServer::ProcessRequest(int client_fd,
         ok = session_manager_->Subscribe(client_id, request.role, endpoint);
         if (ok)
         {
+            FrameRateContract contract;
+            contract.target_fps = request.target_fps;
+            contract.frame_stride = request.frame_stride;
+            contract.coalesce_window_ms =
+                std::min(request.coalesce_window_ms, kCameraControlMaxCoalesceWindowMs);
+            contract.data_plane_features = request.data_plane_features;
             std::lock_guard<std::mutex> lock(clients_mutex_);
-            AddClientSubscriptionLocked(client_fd, client_id, endpoint);
+            AddClientSubscriptionLocked(client_fd, client_id, endpoint, contract);
         }
     }
     else if (request.command == CameraControlCommand::kUnsubscribe)
@@ -354,10 +379,19 @@ CameraControlResponse CameraControlServer::ProcessRequest(int client_fd,
         ok = session_manager_->Unsubscribe(client_id, endpoint);
         if (ok)
         {
+            CloseShmRings(client_fd, &endpoint);
             std::lock_guard<std::mutex> lock(clients_mutex_);
             RemoveClientSubscriptionLocked(client_fd, client_id, endpoint);
         }
     }
+    else if (request.command == CameraControlCommand::kReconfigure)
+    {
+        ok = session_manager_->Reconfigure(client_id, endpoint, request.stream_format);
+    }
+    else if (request.command == CameraControlCommand::kOpenShmRing)
+    {
+        return OpenShmRing(client_fd, client_id, endpoint, grant);
+    }
     else
     {
         return MakeControlResponse(CameraControlStatus::kInvalidMessage, 0,
@@ -374,9 +408,145 @@ CameraControlResponse CameraControlServer::ProcessRequest(int client_fd,
     return MakeControlResponse(CameraControlStatus::kOk, active_count, "ok");
 }
 
+CameraControlResponse CameraControlServer::OpenShmRing(int client_fd,
+                                                       const std::string& client_id,
+                                                       const CameraEndpoint& endpoint,
+                                                       ShmRingGrant* grant)
+{
+    if (!shm_ring_provider_.open)
+    {
+        return MakeControlResponse(CameraControlStatus::kShmRingUnavailable, 0,
+                                   "shm ring is not provided");
+    }
+
+    pid_t peer_pid = 0;
+    bool subscribed = false;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        auto pid_it = client_pids_.find(client_fd);
+        peer_pid = pid_it == client_pids_.end() ? 0 : pid_it->second;
+        auto it = client_subscriptions_.find(client_fd);
+        if (it != client_subscriptions_.end())
+        {
+            for (const ClientSubscription& item : it->second)
+            {
+                subscribed = subscribed || (item.client_id == client_id &&
+                                            EndpointEquals(item.endpoint, endpoint));
+            }
+        }
+    }
+    if (!subscribed)
+    {
+        return MakeControlResponse(CameraControlStatus::kSessionOperationFailed, 0,
+                                   "subscribe before opening shm ring");
+    }
+
+    // 重复申请时先归还同一端点上的旧位置
+    CloseShmRings(client_fd, &endpoint);
+    if (!shm_ring_provider_.open(peer_pid, endpoint, grant) || grant->memfd < 0 ||
+        grant->eventfd < 0)
+    {
+        *grant = ShmRingGrant();
+        return MakeControlResponse(CameraControlStatus::kShmRingUnavailable, 0,
+                                   "shm ring allocation failed");
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        client_shm_rings_[client_fd].push_back(ClientShmRing{endpoint, *grant});
+    }
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_control_server",
+                                  "shm ring opened: client=%s pid=%d consumer=%u",
+                                  client_id.c_str(), static_cast<int>(peer_pid),
+                                  grant->consumer_index);
+
+    CameraControlResponse response = MakeControlResponse(
+        CameraControlStatus::kOk, session_manager_->GetSubscriberCount(endpoint), "ok");
+    response.shm_ring_consumer_index = grant->consumer_index;
+    return response;
+}
+
+void CameraControlServer::CloseShmRings(int client_fd, const CameraEndpoint* endpoint)
+{
+    std::vector<ClientShmRing> closed;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        auto it = client_shm_rings_.find(client_fd);
+        if (it == client_shm_rings_.end())
+        {
+            return;
+        }
+        std::vector<ClientShmRing>& rings = it->second;
+        auto keep_end = std::partition(rings.begin(), rings.end(),
+                                       [&](const ClientShmRing& item)
+                                       {
+                                           return endpoint != nullptr &&
+                                                  !EndpointEquals(item.endpoint, *endpoint);
+                                       });
+        closed.assign(keep_end, rings.end());
+        rings.erase(keep_end, rings.end());
+    }
+
+    for (const ClientShmRing& item : closed)
+    {
+        if (shm_ring_provider_.close)
+        {
+            shm_ring_provider_.close(item.endpoint, item.grant);
+        }
+    }
+}
+
+bool CameraControlServer::SendResponse(int fd,
+                                       const CameraControlResponse& response,
+                                       const ShmRingGrant& grant)
+{
+    if (grant.memfd < 0)
+    {
+        return WriteFull(fd, &response, sizeof(response));
+    }
+
+    // memfd + eventfd 随应答的首段字节发送，剩余字节（若有）照常写出
+    const int fds[2] = {grant.memfd, grant.eventfd};
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(fds))];
+    std::memset(control, 0, sizeof(control));
+
+    struct iovec iov;
+    iov.iov_base = const_cast<CameraControlResponse*>(&response);
+    iov.iov_len = sizeof(response);
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    ssize_t sent = -1;
+    do
+    {
+        sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    if (sent <= 0)
+    {
+        return false;
+    }
+    return WriteFull(fd, reinterpret_cast<const uint8_t*>(&response) + sent,
+                     sizeof(response) - static_cast<size_t>(sent));
+}
+
+void CameraControlServer::SetShmRingProvider(ShmRingProvider provider)
+{
+    shm_ring_provider_ = std::move(provider);
+}
+
 bool CameraControlServer::AddClientSubscriptionLocked(int client_fd,
                                                       const std::string& client_id,
-                                                      const CameraEndpoint& endpoint)
+                                                      const CameraEndpoint& endpoint,
+                                                      const FrameRateContract& contract)
 {
     auto it = client_subscriptions_.find(client_fd);
     if (it == client_subscriptions_.end())
@@ -384,11 +554,14 @@ bool CameraControlServer::AddClientSubscriptionLocked(int client_fd,
         return false;
     }
 
+    contract_generation_.fetch_add(1);
     std::vector<ClientSubscription>& subscriptions = it->second;
-    for (const ClientSubscription& item : subscriptions)
+    for (ClientSubscription& item : subscriptions)
     {
         if (item.client_id == client_id && EndpointEquals(item.endpoint, endpoint))
         {
+            // 重复订阅用于更新帧率约定
+            item.contract = contract;
             return true;
         }
     }
@@ -396,6 +569,7 @@ bool CameraControlServer::AddClientSubscriptionLocked(int client_fd,
     ClientSubscription subscription;
     subscription.client_id = client_id;
     subscription.endpoint = endpoint;
+    subscription.contract = contract;
     subscriptions.push_back(subscription);
     return true;
 }
@@ -410,6 +584,7 @@ void CameraControlServer::RemoveClientSubscriptionLocked(int client_fd,
         return;
     }
 
+    contract_generation_.fetch_add(1);
     std::vector<ClientSubscription>& subscriptions = it->second;
     subscriptions.erase(
         std::remove_if(subscriptions.begin(), subscriptions.end(),
@@ -421,6 +596,77 @@ void CameraControlServer::RemoveClientSubscriptionLocked(int client_fd,
         subscriptions.end());
 }
 
+bool CameraControlServer::GetFrameRateContract(pid_t peer_pid,
+                                               FrameRateContract* contract) const
+{
+    return MergeFrameRateContract(peer_pid, nullptr, contract);
+}
+
+bool CameraControlServer::GetFrameRateContract(pid_t peer_pid,
+                                               const CameraEndpoint& endpoint,
+                                               FrameRateContract* contract) const
+{
+    return MergeFrameRateContract(peer_pid, &endpoint, contract);
+}
+
+bool CameraControlServer::MergeFrameRateContract(pid_t peer_pid,
+                                                 const CameraEndpoint* endpoint,
+                                                 FrameRateContract* contract) const
+{
+    if (contract == nullptr || peer_pid <= 0)
+    {
+        return false;
+    }
+
+    bool found = false;
+    FrameRateContract merged;
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    for (const auto& entry : client_subscriptions_)
+    {
+        auto pid_it = client_pids_.find(entry.first);
+        if (pid_it == client_pids_.end() || pid_it->second != peer_pid)
+        {
+            continue;
+        }
+        for (const ClientSubscription& item : entry.second)
+        {
+            if (endpoint != nullptr && !EndpointEquals(item.endpoint, *endpoint))
+            {
+                continue;
+            }
+            // 0 表示不限制，合并时取最宽松的值
+            const FrameRateContract& next = item.contract;
+            if (!found)
+            {
+                merged = next;
+                found = true;
+                continue;
+            }
+            merged.target_fps = (merged.target_fps == 0 || next.target_fps == 0)
+                                    ? 0
+                                    : std::max(merged.target_fps, next.target_fps);
+            merged.frame_stride = (merged.frame_stride <= 1 || next.frame_stride <= 1)
+                                      ? 0
+                                      : std::min(merged.frame_stride, next.frame_stride);
+            merged.coalesce_window_ms =
+                std::min(merged.coalesce_window_ms, next.coalesce_window_ms);
+            // 能力位决定数据面编码，只启用同一进程所有订阅都支持的部分
+            merged.data_plane_features &= next.data_plane_features;
+        }
+    }
+
+    if (found)
+    {
+        *contract = merged;
+    }
+    return found;
+}
+
+uint64_t CameraControlServer::GetFrameRateContractGeneration() const
+{
+    return contract_generation_.load();
+}
+
 bool CameraControlServer::EndpointEquals(const CameraEndpoint& lhs, const CameraEndpoint& rhs)
 {
     return lhs.camera_id == rhs.camera_id &&
@@ -5,6 +5,7 @@
 #include <chrono>
 #include <cstring>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <thread>
@@ -52,6 +53,67 @@ bool IsValidFdList(const int* fds, uint32_t fd_count)
     return true;
 }
 
+constexpr size_t kSendBatchMaxMessages = 32;
+
+/**
+ * @brief 描述符是否随附 SCM_RIGHTS
+ *
+ * 槽位帧引用已 announce 的池 fd，缓存帧引用已注册的 buffer fd，二者都不附带 fd。
+ */
+bool CarriesFdsV2(const CameraDataFrameDescriptorV2& descriptor)
+{
+    return !IsCameraShmSlotDescriptorV2(descriptor) &&
+           !IsCameraBufferCachedDescriptorV2(descriptor);
+}
+
+struct DescriptorControlBuffer
+{
+    alignas(struct cmsghdr) char data[CMSG_SPACE(sizeof(int) * kCameraDataV2MaxFds)];
+};
+
+/**
+ * @brief 组装一条描述符消息；iov / control 需保持有效直到消息发出
+ */
+bool BuildDescriptorMessage(const CameraDataFrameDescriptorV2& descriptor,
+                            const int* fds,
+                            uint32_t fd_count,
+                            struct iovec* iov,
+                            DescriptorControlBuffer* control,
+                            struct msghdr* msg)
+{
+    if (!IsCameraDataFrameDescriptorV2Valid(descriptor))
+    {
+        return false;
+    }
+
+    iov->iov_base = const_cast<CameraDataFrameDescriptorV2*>(&descriptor);
+    iov->iov_len = sizeof(descriptor);
+    std::memset(msg, 0, sizeof(*msg));
+    msg->msg_iov = iov;
+    msg->msg_iovlen = 1;
+
+    if (!CarriesFdsV2(descriptor))
+    {
+        return fd_count == 0;
+    }
+
+    if (!IsValidFdList(fds, fd_count) || fd_count != descriptor.fd_count)
+    {
+        return false;
+    }
+
+    std::memset(control->data, 0, sizeof(control->data));
+    msg->msg_control = control->data;
+    msg->msg_controllen = CMSG_SPACE(sizeof(int) * fd_count);
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fd_count);
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * fd_count);
+    return true;
+}
+
 bool WriteFull(int fd, const void* data, size_t length)
 {
     const uint8_t* ptr = static_cast<const uint8_t*>(data);
@@ -124,6 +186,7 @@ CameraDataFrameDescriptorV2 MakeCameraDataFrameDescriptorV2(
     data.fd_count = descriptor.fd_count;
     data.total_bytes_used = descriptor.total_bytes_used;
     data.flags = descriptor.flags;
+    data.stream_generation = descriptor.stream_generation;
 
     const uint32_t plane_count = std::min<uint32_t>(descriptor.plane_count, kCameraDataV2MaxPlanes);
     for (uint32_t i = 0; i < plane_count; ++i)
@@ -166,6 +229,79 @@ bool IsCameraDataFrameDescriptorV2Valid(const CameraDataFrameDescriptorV2& descr
     return true;
 }
 
+CameraDataFrameDescriptorV2 MakeCameraShmPoolAnnounceV2(uint32_t stream_id,
+                                                        uint32_t slot_count,
+                                                        uint32_t slot_stride,
+                                                        uint32_t pool_bytes)
+{
+    CameraDataFrameDescriptorV2 data;
+    std::memset(&data, 0, sizeof(data));
+
+    data.magic = kCameraDataV2Magic;
+    data.version = kCameraDataV2Version;
+    data.header_size = sizeof(CameraDataFrameDescriptorV2);
+    data.stream_id = stream_id;
+    data.buffer_id = slot_count;
+    // announce 不是图像帧，宽高填 1 以通过通用校验
+    data.width = 1;
+    data.height = 1;
+    data.memory_type = static_cast<uint32_t>(CameraDataV2MemoryType::kShm);
+    data.plane_count = 1;
+    data.fd_count = 1;
+    data.total_bytes_used = pool_bytes;
+    data.flags = kCameraDataV2FlagShmPoolAnnounce;
+    data.planes[0].fd_index = 0;
+    data.planes[0].offset = 0;
+    data.planes[0].stride = slot_stride;
+    data.planes[0].length = pool_bytes;
+    data.planes[0].bytes_used = pool_bytes;
+    return data;
+}
+
+CameraDataFrameDescriptorV2 MakeCameraShmSlotDescriptorV2(const core::FrameDescriptor& descriptor,
+                                                          uint32_t slot_offset)
+{
+    CameraDataFrameDescriptorV2 data = MakeCameraDataFrameDescriptorV2(descriptor);
+    data.memory_type = static_cast<uint32_t>(CameraDataV2MemoryType::kShm);
+    data.fd_count = 1;
+    data.flags = (data.flags & ~kCameraDataV2FlagShmPoolAnnounce) | kCameraDataV2FlagShmSlot;
+
+    const uint32_t plane_count = std::min<uint32_t>(data.plane_count, kCameraDataV2MaxPlanes);
+    for (uint32_t i = 0; i < plane_count; ++i)
+    {
+        data.planes[i].fd_index = 0;
+        data.planes[i].offset += slot_offset;
+    }
+    return data;
+}
+
+bool IsCameraShmSlotDescriptorV2(const CameraDataFrameDescriptorV2& descriptor)
+{
+    return descriptor.memory_type == static_cast<uint32_t>(CameraDataV2MemoryType::kShm) &&
+           (descriptor.flags & kCameraDataV2FlagShmSlot) != 0;
+}
+
+CameraDataFrameDescriptorV2 MakeCameraBufferRegisterV2(const core::FrameDescriptor& descriptor)
+{
+    CameraDataFrameDescriptorV2 data = MakeCameraDataFrameDescriptorV2(descriptor);
+    data.flags = (data.flags & ~kCameraDataV2FlagBufferCached) | kCameraDataV2FlagBufferRegister;
+    return data;
+}
+
+CameraDataFrameDescriptorV2 MakeCameraBufferCachedDescriptorV2(
+    const core::FrameDescriptor& descriptor)
+{
+    CameraDataFrameDescriptorV2 data = MakeCameraDataFrameDescriptorV2(descriptor);
+    data.flags = (data.flags & ~kCameraDataV2FlagBufferRegister) | kCameraDataV2FlagBufferCached;
+    return data;
+}
+
+bool IsCameraBufferCachedDescriptorV2(const CameraDataFrameDescriptorV2& descriptor)
+{
+    return (descriptor.flags & kCameraDataV2FlagBufferCached) != 0 &&
+           !IsCameraShmSlotDescriptorV2(descriptor);
+}
+
 CameraReleaseFrameV2 MakeCameraReleaseFrameV2(uint32_t stream_id,
                                              uint64_t frame_id,
                                              uint32_t buffer_id,
@@ -199,36 +335,77 @@ bool SendCameraDataFrameDescriptorV2(int socket_fd,
                                      const int* fds,
                                      uint32_t fd_count)
 {
-    if (socket_fd < 0 || !IsCameraDataFrameDescriptorV2Valid(descriptor) ||
-        !IsValidFdList(fds, fd_count) || fd_count != descriptor.fd_count)
+    if (socket_fd < 0)
     {
         return false;
     }
 
     struct iovec iov;
-    iov.iov_base = const_cast<CameraDataFrameDescriptorV2*>(&descriptor);
-    iov.iov_len = sizeof(descriptor);
-
-    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * kCameraDataV2MaxFds)];
-    std::memset(control, 0, sizeof(control));
-
+    DescriptorControlBuffer control;
     struct msghdr msg;
-    std::memset(&msg, 0, sizeof(msg));
-    msg.msg_iov = &iov;
-    msg.msg_iovlen = 1;
-    msg.msg_control = control;
-    msg.msg_controllen = CMSG_SPACE(sizeof(int) * fd_count);
-
-    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
-    cmsg->cmsg_level = SOL_SOCKET;
-    cmsg->cmsg_type = SCM_RIGHTS;
-    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fd_count);
-    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * fd_count);
+    if (!BuildDescriptorMessage(descriptor, fds, fd_count, &iov, &control, &msg))
+    {
+        return false;
+    }
 
     const ssize_t sent = sendmsg(socket_fd, &msg, MSG_NOSIGNAL);
     return sent == static_cast<ssize_t>(sizeof(descriptor));
 }
 
+size_t SendCameraDataFrameDescriptorsV2(int socket_fd,
+                                        const CameraDataFrameSendV2* items,
+                                        size_t count,
+                                        uint64_t* syscall_count)
+{
+    if (socket_fd < 0 || items == nullptr)
+    {
+        return 0;
+    }
+
+    struct iovec iovs[kSendBatchMaxMessages];
+    DescriptorControlBuffer controls[kSendBatchMaxMessages];
+    struct mmsghdr messages[kSendBatchMaxMessages];
+
+    size_t sent_total = 0;
+    while (sent_total < count)
+    {
+        // 只发送有效的前缀；遇到无效描述符时停在该条之前
+        size_t batch = 0;
+        while (batch < kSendBatchMaxMessages && sent_total + batch < count)
+        {
+            const CameraDataFrameSendV2& item = items[sent_total + batch];
+            std::memset(&messages[batch], 0, sizeof(messages[batch]));
+            if (!BuildDescriptorMessage(item.descriptor, item.fds, item.fd_count, &iovs[batch],
+                                        &controls[batch], &messages[batch].msg_hdr))
+            {
+                break;
+            }
+            ++batch;
+        }
+        if (batch == 0)
+        {
+            break;
+        }
+
+        const int sent = sendmmsg(socket_fd, messages, static_cast<unsigned int>(batch),
+                                  MSG_NOSIGNAL);
+        if (syscall_count != nullptr)
+        {
+            ++*syscall_count;
+        }
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent <= 0)
+        {
+            break;
+        }
+        sent_total += static_cast<size_t>(sent);
+    }
+    return sent_total;
+}
+
 bool ReceiveCameraDataFrameDescriptorV2(int socket_fd,
                                         CameraDataFrameDescriptorV2* descriptor,
                                         int* fds,
@@ -293,9 +470,10 @@ bool ReceiveCameraDataFrameDescriptorV2(int socket_fd,
         break;
     }
 
+    const uint32_t expected_fd_count = CarriesFdsV2(*descriptor) ? descriptor->fd_count : 0;
     const bool valid = IsCameraDataFrameDescriptorV2Valid(*descriptor) &&
-                       actual_fd_count == descriptor->fd_count &&
-                       *received_fd_count == descriptor->fd_count;
+                       actual_fd_count == expected_fd_count &&
+                       *received_fd_count == expected_fd_count;
     if (!valid)
     {
         for (uint32_t i = 0; i < *received_fd_count; ++i)
@@ -334,6 +512,133 @@ bool ReceiveCameraReleaseFrameV2(int socket_fd, CameraReleaseFrameV2* release)
            IsCameraReleaseFrameV2Valid(*release);
 }
 
+CameraDataV2BufferCache::~CameraDataV2BufferCache()
+{
+    Clear();
+}
+
+bool CameraDataV2BufferCache::Handles(const CameraDataFrameDescriptorV2& descriptor)
+{
+    return IsCameraBufferCachedDescriptorV2(descriptor) ||
+           ((descriptor.flags & kCameraDataV2FlagBufferRegister) != 0 &&
+            !IsCameraShmSlotDescriptorV2(descriptor));
+}
+
+const CameraDataV2BufferCache::Buffer* CameraDataV2BufferCache::Resolve(
+    const CameraDataFrameDescriptorV2& descriptor,
+    const int* fds,
+    uint32_t fd_count)
+{
+    if (!Handles(descriptor))
+    {
+        return nullptr;
+    }
+
+    auto generation_it = stream_generations_.find(descriptor.stream_id);
+    if (generation_it == stream_generations_.end() ||
+        generation_it->second != descriptor.stream_generation)
+    {
+        InvalidateStream(descriptor.stream_id);
+        stream_generations_[descriptor.stream_id] = descriptor.stream_generation;
+    }
+
+    const uint64_t key = MakeKey(descriptor.stream_id, descriptor.buffer_id);
+    if (IsCameraBufferCachedDescriptorV2(descriptor))
+    {
+        auto it = buffers_.find(key);
+        if (it == buffers_.end())
+        {
+            ++stats_.misses;
+            return nullptr;
+        }
+        ++stats_.hits;
+        return &it->second;
+    }
+
+    Buffer& buffer = buffers_[key];
+    ReleaseBuffer(&buffer);
+    const uint32_t count = std::min<uint32_t>(fd_count, kCameraDataV2MaxFds);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        buffer.fds[i] = fds[i];
+        // 按各 plane 在该 fd 内的最大范围映射，同一 buffer 的后续帧布局不变
+        size_t bytes = 0;
+        for (uint32_t p = 0; p < descriptor.plane_count && p < kCameraDataV2MaxPlanes; ++p)
+        {
+            const CameraDataPlaneDescriptorV2& plane = descriptor.planes[p];
+            if (plane.fd_index == i)
+            {
+                bytes = std::max<size_t>(bytes, static_cast<size_t>(plane.offset) + plane.length);
+            }
+        }
+        void* mapped = bytes > 0 ? mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fds[i], 0)
+                                 : MAP_FAILED;
+        buffer.mapped[i] = mapped != MAP_FAILED ? static_cast<const uint8_t*>(mapped) : nullptr;
+        buffer.mapped_bytes[i] = mapped != MAP_FAILED ? bytes : 0;
+    }
+    buffer.fd_count = count;
+    ++stats_.registrations;
+    return &buffer;
+}
+
+void CameraDataV2BufferCache::Clear()
+{
+    for (auto& entry : buffers_)
+    {
+        ReleaseBuffer(&entry.second);
+    }
+    buffers_.clear();
+    stream_generations_.clear();
+}
+
+size_t CameraDataV2BufferCache::GetBufferCount() const
+{
+    return buffers_.size();
+}
+
+CameraDataV2BufferCache::Stats CameraDataV2BufferCache::GetStats() const
+{
+    return stats_;
+}
+
+uint64_t CameraDataV2BufferCache::MakeKey(uint32_t stream_id, uint32_t buffer_id)
+{
+    return (static_cast<uint64_t>(stream_id) << 32) | buffer_id;
+}
+
+void CameraDataV2BufferCache::ReleaseBuffer(Buffer* buffer)
+{
+    for (uint32_t i = 0; i < buffer->fd_count; ++i)
+    {
+        if (buffer->mapped[i] != nullptr)
+        {
+            munmap(const_cast<uint8_t*>(buffer->mapped[i]), buffer->mapped_bytes[i]);
+        }
+        if (buffer->fds[i] >= 0)
+        {
+            close(buffer->fds[i]);
+        }
+    }
+    buffer->fd_count = 0;
+}
+
+void CameraDataV2BufferCache::InvalidateStream(uint32_t stream_id)
+{
+    for (auto it = buffers_.begin(); it != buffers_.end();)
+    {
+        if (static_cast<uint32_t>(it->first >> 32) == stream_id)
+        {
+            ReleaseBuffer(&it->second);
+            it = buffers_.erase(it);
+            ++stats_.invalidations;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
 CameraReleaseTracker::CameraReleaseTracker(std::chrono::milliseconds release_timeout)
     : release_timeout_(release_timeout)
     , mutex_()
@@ -357,7 +662,8 @@ bool CameraReleaseTracker::RegisterFrame(
     frame.key.stream_id = stream_id;
     frame.key.frame_id = frame_id;
     frame.key.buffer_id = buffer_id;
-    frame.deadline = std::chrono::steady_clock::now() + release_timeout_;
+    frame.registered_at = std::chrono::steady_clock::now();
+    frame.deadline = frame.registered_at + release_timeout_;
     frame.expected_consumers.insert(expected_consumers.begin(), expected_consumers.end());
 
     if (frame.expected_consumers.empty())
@@ -366,12 +672,18 @@ bool CameraReleaseTracker::RegisterFrame(
     }
 
     std::lock_guard<std::mutex> lock(mutex_);
-    const bool inserted = pending_frames_.emplace(frame.key, std::move(frame)).second;
-    if (inserted)
+    const auto result = pending_frames_.emplace(frame.key, std::move(frame));
+    if (result.second)
     {
         ++stats_.registered_frames;
+        for (const uint32_t consumer_id : result.first->second.expected_consumers)
+        {
+            ConsumerState& consumer = ConsumerLocked(consumer_id);
+            ++consumer.stats.leases_held;
+            ++consumer.stats.leases_granted;
+        }
     }
-    return inserted;
+    return result.second;
 }
 
 std::vector<CameraReleaseReclaim> CameraReleaseTracker::MarkReleased(
@@ -405,6 +717,17 @@ std::vector<CameraReleaseReclaim> CameraReleaseTracker::MarkReleased(
         return reclaims;
     }
 
+    ConsumerState& consumer = ConsumerLocked(release.consumer_id);
+    if (consumer.stats.leases_held > 0)
+    {
+        --consumer.stats.leases_held;
+    }
+    ++consumer.stats.releases;
+    consumer.hold_time->Record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - frame.registered_at)
+            .count()));
+
     if (frame.released_consumers.size() == frame.expected_consumers.size())
     {
         reclaims.push_back(MakeReclaimLocked(frame, CameraReleaseStatus::kOk));
@@ -425,6 +748,19 @@ std::vector<CameraReleaseReclaim> CameraReleaseTracker::ReclaimExpired()
     {
         if (it->second.deadline <= now)
         {
+            for (const uint32_t consumer_id : it->second.expected_consumers)
+            {
+                if (it->second.released_consumers.count(consumer_id) != 0)
+                {
+                    continue;
+                }
+                ConsumerState& consumer = ConsumerLocked(consumer_id);
+                if (consumer.stats.leases_held > 0)
+                {
+                    --consumer.stats.leases_held;
+                }
+                ++consumer.stats.timeouts;
+            }
             reclaims.push_back(MakeReclaimLocked(it->second, CameraReleaseStatus::kTimeout));
             it = pending_frames_.erase(it);
             ++stats_.reclaimed_frames;
@@ -465,9 +801,46 @@ std::vector<CameraReleaseReclaim> CameraReleaseTracker::ReclaimConsumerDisconnec
         }
     }
 
+    // 断开的消费者不会再出现，其 lease 已全部视为归还
+    consumers_.erase(consumer_id);
     return reclaims;
 }
 
+void CameraReleaseTracker::SetDefaultConsumerQuota(uint32_t max_in_flight)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    default_consumer_quota_ = max_in_flight;
+}
+
+void CameraReleaseTracker::SetConsumerQuota(uint32_t consumer_id, uint32_t max_in_flight)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ConsumerState& consumer = ConsumerLocked(consumer_id);
+    consumer.has_quota = true;
+    consumer.quota = max_in_flight;
+}
+
+std::vector<uint32_t> CameraReleaseTracker::AdmitConsumers(
+    const std::vector<uint32_t>& candidates)
+{
+    std::vector<uint32_t> admitted;
+    admitted.reserve(candidates.size());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const uint32_t consumer_id : candidates)
+    {
+        ConsumerState& consumer = ConsumerLocked(consumer_id);
+        const uint32_t quota = QuotaLocked(consumer);
+        if (quota != 0 && consumer.stats.leases_held >= quota)
+        {
+            ++consumer.stats.skipped_frames;
+            continue;
+        }
+        admitted.push_back(consumer_id);
+    }
+    return admitted;
+}
+
 size_t CameraReleaseTracker::PendingFrameCount() const
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -480,6 +853,28 @@ CameraReleaseTrackerStats CameraReleaseTracker::GetStats() const
     return stats_;
 }
 
+std::vector<CameraReleaseConsumerStats> CameraReleaseTracker::GetConsumerStats() const
+{
+    std::vector<CameraReleaseConsumerStats> result;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.reserve(consumers_.size());
+    for (const auto& entry : consumers_)
+    {
+        CameraReleaseConsumerStats stats = entry.second.stats;
+        stats.consumer_id = entry.first;
+        stats.quota = QuotaLocked(entry.second);
+        stats.hold_time = entry.second.hold_time->GetSnapshot();
+        result.push_back(stats);
+    }
+    std::sort(result.begin(), result.end(),
+              [](const CameraReleaseConsumerStats& lhs, const CameraReleaseConsumerStats& rhs)
+              {
+                  return lhs.consumer_id < rhs.consumer_id;
+              });
+    return result;
+}
+
 bool CameraReleaseTracker::FrameKey::operator==(const FrameKey& other) const
 {
     return stream_id == other.stream_id &&
@@ -509,6 +904,21 @@ CameraReleaseReclaim CameraReleaseTracker::MakeReclaimLocked(
     return reclaim;
 }
 
+CameraReleaseTracker::ConsumerState& CameraReleaseTracker::ConsumerLocked(uint32_t consumer_id)
+{
+    ConsumerState& consumer = consumers_[consumer_id];
+    if (!consumer.hold_time)
+    {
+        consumer.hold_time = std::make_unique<core::LatencyHistogram>();
+    }
+    return consumer;
+}
+
+uint32_t CameraReleaseTracker::QuotaLocked(const ConsumerState& consumer) const
+{
+    return consumer.has_quota ? consumer.quota : default_consumer_quota_;
+}
+
 CameraReleaseServer::CameraReleaseServer(std::chrono::milliseconds release_timeout)
     : tracker_(release_timeout)
 {
@@ -520,7 +930,8 @@ CameraReleaseServer::~CameraReleaseServer()
 }
 
 bool CameraReleaseServer::Start(const std::string& socket_path,
-                                ReclaimCallback reclaim_callback)
+                                ReclaimCallback reclaim_callback,
+                                DisconnectCallback disconnect_callback)
 {
     if (is_running_.load())
     {
@@ -566,6 +977,7 @@ bool CameraReleaseServer::Start(const std::string& socket_path,
     server_fd_ = fd;
     socket_path_ = socket_path;
     reclaim_callback_ = std::move(reclaim_callback);
+    disconnect_callback_ = std::move(disconnect_callback);
     is_running_.store(true);
     accept_thread_ = std::thread(&CameraReleaseServer::AcceptLoop, this);
     expire_thread_ = std::thread(&CameraReleaseServer::ExpireLoop, this);
@@ -649,6 +1061,22 @@ std::vector<CameraReleaseReclaim> CameraReleaseServer::ReclaimConsumerDisconnect
     return reclaims;
 }
 
+void CameraReleaseServer::SetDefaultConsumerQuota(uint32_t max_in_flight)
+{
+    tracker_.SetDefaultConsumerQuota(max_in_flight);
+}
+
+void CameraReleaseServer::SetConsumerQuota(uint32_t consumer_id, uint32_t max_in_flight)
+{
+    tracker_.SetConsumerQuota(consumer_id, max_in_flight);
+}
+
+std::vector<uint32_t> CameraReleaseServer::AdmitConsumers(
+    const std::vector<uint32_t>& candidates)
+{
+    return tracker_.AdmitConsumers(candidates);
+}
+
 CameraReleaseServerStats CameraReleaseServer::GetServerStats() const
 {
     std::lock_guard<std::mutex> lock(stats_mutex_);
@@ -660,6 +1088,11 @@ CameraReleaseTrackerStats CameraReleaseServer::GetTrackerStats() const
     return tracker_.GetStats();
 }
 
+std::vector<CameraReleaseConsumerStats> CameraReleaseServer::GetConsumerStats() const
+{
+    return tracker_.GetConsumerStats();
+}
+
 size_t CameraReleaseServer::PendingFrameCount() const
 {
     return tracker_.PendingFrameCount();
@@ -730,6 +1163,10 @@ void CameraReleaseServer::ClientLoop(int client_fd)
     for (const uint32_t consumer_id : seen_consumers)
     {
         EmitReclaims(tracker_.ReclaimConsumerDisconnected(consumer_id));
+        if (disconnect_callback_)
+        {
+            disconnect_callback_(consumer_id);
+        }
     }
 
     {
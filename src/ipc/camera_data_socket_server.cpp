@@ -0,0 +1,998 @@
+/**
+ * @file camera_data_socket_server.cpp
+ * @brief v1 数据面服务端实现
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#include "camera_subsystem/ipc/camera_data_socket_server.h"
+
+#include "camera_subsystem/platform/platform_logger.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// 旧版 libc 头文件可能缺少零拷贝相关定义，取值与内核 UAPI 一致
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+
+namespace camera_subsystem
+{
+namespace ipc
+{
+
+namespace
+{
+
+constexpr size_t kUnixSocketPathMaxLength = sizeof(sockaddr_un::sun_path);
+
+// epoll 用户数据：0 / UINT64_MAX - 1 为 Unix / TCP 监听 socket，UINT64_MAX 为唤醒 eventfd，
+// 其余为 client_id
+constexpr uint64_t kListenId = 0;
+constexpr uint64_t kTcpListenId = UINT64_MAX - 1;
+constexpr uint64_t kWakeId = UINT64_MAX;
+
+// 小于此长度的帧直接拷贝：固定页与完成通知的开销超过拷贝本身
+constexpr size_t kZeroCopyMinBytes = 64 * 1024;
+
+uint64_t NowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+pid_t GetPeerPid(int fd)
+{
+    ucred credentials;
+    socklen_t length = sizeof(credentials);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0)
+    {
+        return 0;
+    }
+    return credentials.pid;
+}
+
+/// @brief 按 32 位回绕比较内核零拷贝序号
+bool SeqBefore(uint32_t lhs, uint32_t rhs)
+{
+    return static_cast<int32_t>(lhs - rhs) < 0;
+}
+
+} // namespace
+
+CameraDataSocketServer::CameraDataSocketServer()
+    : CameraDataSocketServer(Options())
+{
+}
+
+CameraDataSocketServer::CameraDataSocketServer(const Options& options)
+    : options_(options)
+{
+    options_.max_queued_frames = std::max<size_t>(options_.max_queued_frames, 1);
+}
+
+CameraDataSocketServer::~CameraDataSocketServer()
+{
+    Stop();
+}
+
+bool CameraDataSocketServer::Start(const std::string& socket_path)
+{
+    if (is_running_.load())
+    {
+        return true;
+    }
+
+    if (socket_path.empty() || socket_path.size() >= kUnixSocketPathMaxLength)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_data_server",
+                                      "Start failed: invalid socket_path=%s",
+                                      socket_path.c_str());
+        return false;
+    }
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_data_server",
+                                      "socket failed: %s", strerror(errno));
+        return false;
+    }
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    unlink(socket_path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_data_server",
+                                      "bind failed: path=%s err=%s", socket_path.c_str(),
+                                      strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    if (listen(fd, 16) < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_data_server",
+                                      "listen failed: %s", strerror(errno));
+        close(fd);
+        unlink(socket_path.c_str());
+        return false;
+    }
+
+    event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (event_fd_ < 0 || !epoll_.Create() || !epoll_.Add(fd, EPOLLIN, kListenId) ||
+        !epoll_.Add(event_fd_, EPOLLIN, kWakeId))
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_data_server",
+                                      "epoll setup failed: %s", strerror(errno));
+        if (event_fd_ >= 0)
+        {
+            close(event_fd_);
+            event_fd_ = -1;
+        }
+        epoll_.Close();
+        close(fd);
+        unlink(socket_path.c_str());
+        return false;
+    }
+
+    server_fd_ = fd;
+    socket_path_ = socket_path;
+    if (options_.tcp_enabled && !StartTcpListener())
+    {
+        close(event_fd_);
+        event_fd_ = -1;
+        epoll_.Close();
+        close(server_fd_);
+        server_fd_ = -1;
+        unlink(socket_path_.c_str());
+        socket_path_.clear();
+        return false;
+    }
+
+    is_running_.store(true);
+    writer_thread_ = std::thread(&CameraDataSocketServer::WriterLoop, this);
+    return true;
+}
+
+void CameraDataSocketServer::Stop()
+{
+    if (!is_running_.exchange(false))
+    {
+        return;
+    }
+
+    Notify();
+    if (writer_thread_.joinable())
+    {
+        writer_thread_.join();
+    }
+
+    std::unordered_map<uint32_t, std::shared_ptr<ClientState>> clients;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        clients.swap(clients_);
+    }
+    for (auto& item : clients)
+    {
+        std::lock_guard<std::mutex> lock(item.second->mutex);
+        item.second->closing = true;
+        item.second->queue.clear();
+        item.second->zero_copy_inflight.clear();
+        shutdown(item.second->fd, SHUT_RDWR);
+        close(item.second->fd);
+    }
+
+    if (server_fd_ >= 0)
+    {
+        close(server_fd_);
+        server_fd_ = -1;
+    }
+    if (tcp_server_fd_ >= 0)
+    {
+        close(tcp_server_fd_);
+        tcp_server_fd_ = -1;
+        tcp_port_ = 0;
+    }
+    if (event_fd_ >= 0)
+    {
+        close(event_fd_);
+        event_fd_ = -1;
+    }
+    epoll_.Close();
+
+    if (!socket_path_.empty())
+    {
+        unlink(socket_path_.c_str());
+        socket_path_.clear();
+    }
+}
+
+bool CameraDataSocketServer::IsRunning() const
+{
+    return is_running_.load();
+}
+
+uint16_t CameraDataSocketServer::GetTcpPort() const
+{
+    return is_running_.load() ? tcp_port_ : 0;
+}
+
+bool CameraDataSocketServer::Enqueue(uint32_t client_id,
+                                     const CameraDataFrameHeader& header,
+                                     const void* data,
+                                     size_t length,
+                                     std::shared_ptr<core::BufferGuard> buffer)
+{
+    const std::shared_ptr<ClientState> client = FindClient(client_id);
+    if (!client)
+    {
+        return false;
+    }
+
+    PendingFrame frame;
+    frame.header = std::make_unique<CameraDataFrameHeader>(header);
+    frame.length = length;
+    frame.enqueue_ns = NowNs();
+    if (buffer)
+    {
+        frame.data = static_cast<const uint8_t*>(data);
+        frame.owner = std::move(buffer);
+        frame.pooled = true;
+    }
+    else
+    {
+        auto copy = std::make_shared<std::vector<uint8_t>>(
+            static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + length);
+        frame.data = copy->data();
+        frame.owner = std::move(copy);
+    }
+
+    bool wake = false;
+    size_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(client->mutex);
+        if (client->closing)
+        {
+            return false;
+        }
+        dropped = DropFramesLocked(*client);
+        client->queue.push_back(std::move(frame));
+        ++client->enqueued_frames;
+        client->peak_queued_frames = std::max(client->peak_queued_frames, client->queue.size());
+        // 写线程正在发送时会继续取下一帧；EAGAIN 时等 EPOLLOUT，都不必唤醒
+        wake = client->writable && !client->writing;
+    }
+
+    if (dropped > 0)
+    {
+        dropped_frames_.fetch_add(dropped, std::memory_order_relaxed);
+    }
+    if (wake)
+    {
+        Notify();
+    }
+    return true;
+}
+
+size_t CameraDataSocketServer::DropQueuedFrames(uint32_t camera_id)
+{
+    std::vector<std::shared_ptr<ClientState>> clients;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        clients.reserve(clients_.size());
+        for (const auto& item : clients_)
+        {
+            clients.push_back(item.second);
+        }
+    }
+
+    size_t total = 0;
+    for (const auto& client : clients)
+    {
+        std::lock_guard<std::mutex> lock(client->mutex);
+        const bool head_pinned =
+            !client->queue.empty() && (client->writing || client->queue.front().sent > 0);
+        const auto first = client->queue.begin() + (head_pinned ? 1 : 0);
+        const auto kept = std::remove_if(first, client->queue.end(),
+                                         [camera_id](const PendingFrame& frame)
+                                         {
+                                             return frame.pooled &&
+                                                    frame.header->camera_id == camera_id;
+                                         });
+        const size_t dropped = static_cast<size_t>(client->queue.end() - kept);
+        client->queue.erase(kept, client->queue.end());
+        client->dropped_frames += dropped;
+        total += dropped;
+
+        if (head_pinned && client->queue.front().pooled &&
+            client->queue.front().header->camera_id == camera_id)
+        {
+            if (client->writing)
+            {
+                client->detach_head = true;
+            }
+            else
+            {
+                DetachHeadLocked(*client);
+            }
+        }
+    }
+
+    if (total > 0)
+    {
+        dropped_frames_.fetch_add(total, std::memory_order_relaxed);
+    }
+    return total;
+}
+
+bool CameraDataSocketServer::SetClientQueuePolicy(uint32_t client_id,
+                                                  QueuePolicy policy,
+                                                  size_t max_queued_frames)
+{
+    const std::shared_ptr<ClientState> client = FindClient(client_id);
+    if (!client)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(client->mutex);
+    client->policy = policy;
+    client->max_queued_frames = std::max<size_t>(max_queued_frames, 1);
+    return true;
+}
+
+void CameraDataSocketServer::RemoveClient(uint32_t client_id)
+{
+    const std::shared_ptr<ClientState> client = FindClient(client_id);
+    if (!client)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(client->mutex);
+        client->closing = true;
+    }
+    Notify();
+}
+
+std::vector<CameraDataSocketServer::Client> CameraDataSocketServer::GetClientsSnapshot() const
+{
+    std::vector<Client> clients;
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    clients.reserve(clients_.size());
+    for (const auto& item : clients_)
+    {
+        clients.push_back(Client{item.second->client_id, item.second->pid});
+    }
+    return clients;
+}
+
+size_t CameraDataSocketServer::GetClientCount() const
+{
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    return clients_.size();
+}
+
+std::vector<CameraDataSocketServer::ClientStats> CameraDataSocketServer::GetClientStats() const
+{
+    std::vector<std::shared_ptr<ClientState>> clients;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        clients.reserve(clients_.size());
+        for (const auto& item : clients_)
+        {
+            clients.push_back(item.second);
+        }
+    }
+
+    std::vector<ClientStats> stats;
+    stats.reserve(clients.size());
+    for (const auto& client : clients)
+    {
+        ClientStats item;
+        item.client_id = client->client_id;
+        item.pid = client->pid;
+        {
+            std::lock_guard<std::mutex> lock(client->mutex);
+            item.policy = client->policy;
+            item.max_queued_frames = client->max_queued_frames;
+            item.queued_frames = client->queue.size();
+            item.peak_queued_frames = client->peak_queued_frames;
+            item.enqueued_frames = client->enqueued_frames;
+            item.sent_frames = client->sent_frames;
+            item.dropped_frames = client->dropped_frames;
+            item.sent_bytes = client->sent_bytes;
+            item.blocked_count = client->blocked_count;
+            item.send_calls = client->send_calls;
+            item.tcp = client->tcp;
+            item.zero_copy = client->zero_copy;
+            item.zero_copy_sends = client->zero_copy_sends;
+            item.zero_copy_copied = client->zero_copy_copied;
+            item.zero_copy_inflight = client->zero_copy_inflight.size();
+        }
+        item.send_lag = client->send_lag.GetSnapshot();
+        stats.push_back(item);
+    }
+    std::sort(stats.begin(), stats.end(),
+              [](const ClientStats& lhs, const ClientStats& rhs)
+              {
+                  return lhs.client_id < rhs.client_id;
+              });
+    return stats;
+}
+
+CameraDataSocketServer::ServerStats CameraDataSocketServer::GetServerStats() const
+{
+    ServerStats stats;
+    stats.accepted_clients = accepted_clients_.load(std::memory_order_relaxed);
+    stats.closed_clients = closed_clients_.load(std::memory_order_relaxed);
+    stats.sent_frames = sent_frames_.load(std::memory_order_relaxed);
+    stats.sent_bytes = sent_bytes_.load(std::memory_order_relaxed);
+    stats.dropped_frames = dropped_frames_.load(std::memory_order_relaxed);
+    stats.send_calls = send_calls_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void CameraDataSocketServer::WriterLoop()
+{
+    struct epoll_event events[platform::PlatformEpoll::kMaxEvents];
+    while (is_running_.load())
+    {
+        const int count = epoll_.Wait(-1, events);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_data_server",
+                                          "epoll wait failed: %s", strerror(errno));
+            break;
+        }
+
+        bool woken = false;
+        for (int i = 0; i < count && is_running_.load(); ++i)
+        {
+            const uint64_t id = events[i].data.u64;
+            if (id == kListenId)
+            {
+                AcceptClients(server_fd_, false);
+            }
+            else if (id == kTcpListenId)
+            {
+                AcceptClients(tcp_server_fd_, true);
+            }
+            else if (id == kWakeId)
+            {
+                uint64_t value = 0;
+                (void)read(event_fd_, &value, sizeof(value));
+                woken = true;
+            }
+            else
+            {
+                const std::shared_ptr<ClientState> client =
+                    FindClient(static_cast<uint32_t>(id));
+                if (client)
+                {
+                    HandleClientEvent(client, events[i].events);
+                }
+            }
+        }
+
+        if (woken && is_running_.load())
+        {
+            FlushPendingClients();
+        }
+    }
+}
+
+bool CameraDataSocketServer::StartTcpListener()
+{
+    const int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_data_server",
+                                      "tcp socket failed: %s", strerror(errno));
+        return false;
+    }
+
+    const int reuse = 1;
+    (void)setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(options_.tcp_port);
+    socklen_t addr_length = sizeof(addr);
+    if (inet_pton(AF_INET, options_.tcp_bind_host.c_str(), &addr.sin_addr) != 1 ||
+        bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(fd, 16) < 0 ||
+        getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addr_length) < 0 ||
+        !epoll_.Add(fd, EPOLLIN, kTcpListenId))
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_data_server",
+                                      "tcp listen failed: %s:%u err=%s",
+                                      options_.tcp_bind_host.c_str(), options_.tcp_port,
+                                      strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    tcp_server_fd_ = fd;
+    tcp_port_ = ntohs(addr.sin_port);
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_data_server",
+                                  "tcp listening: %s:%u zero_copy=%d",
+                                  options_.tcp_bind_host.c_str(), tcp_port_,
+                                  options_.tcp_zero_copy ? 1 : 0);
+    return true;
+}
+
+void CameraDataSocketServer::AcceptClients(int listen_fd, bool tcp)
+{
+    while (true)
+    {
+        const int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_data_server",
+                                              "accept failed: %s", strerror(errno));
+            }
+            return;
+        }
+
+        auto client = std::make_shared<ClientState>();
+        client->fd = fd;
+        client->pid = tcp ? 0 : GetPeerPid(fd);
+        client->tcp = tcp;
+        if (!tcp && options_.unix_send_buffer_bytes > 0)
+        {
+            // TCP 保留内核自动调优，不设置 SO_SNDBUF
+            const int size = static_cast<int>(
+                std::min<size_t>(options_.unix_send_buffer_bytes, INT32_MAX / 2));
+            (void)setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+        }
+        if (tcp && options_.tcp_zero_copy)
+        {
+            const int enable = 1;
+            client->zero_copy =
+                setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) == 0;
+        }
+        client->policy = options_.policy;
+        client->max_queued_frames = options_.max_queued_frames;
+        size_t total = 0;
+        {
+            std::lock_guard<std::mutex> lock(clients_mutex_);
+            client->client_id = next_client_id_++;
+            clients_.emplace(client->client_id, client);
+            total = clients_.size();
+        }
+
+        // EPOLLOUT 边沿触发：只在 socket 从写满恢复可写时通知一次
+        if (!epoll_.Add(fd, EPOLLIN | EPOLLRDHUP | EPOLLOUT | EPOLLET, client->client_id))
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_data_server",
+                                          "epoll add client failed: %s", strerror(errno));
+            CloseClient(client);
+            continue;
+        }
+
+        accepted_clients_.fetch_add(1, std::memory_order_relaxed);
+        platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_data_server",
+                                      "client connected: id=%u pid=%d transport=%s "
+                                      "zero_copy=%d total=%zu",
+                                      client->client_id, static_cast<int>(client->pid),
+                                      tcp ? "tcp" : "unix", client->zero_copy ? 1 : 0, total);
+    }
+}
+
+void CameraDataSocketServer::HandleClientEvent(const std::shared_ptr<ClientState>& client,
+                                               uint32_t events)
+{
+    if ((events & EPOLLERR) != 0 && client->tcp)
+    {
+        // 零拷贝完成通知经错误队列投递，同样以 EPOLLERR 报告；只有 SO_ERROR 才是真正的错误
+        ReapZeroCopyCompletions(*client);
+        int error = 0;
+        socklen_t length = sizeof(error);
+        if (getsockopt(client->fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0)
+        {
+            events &= ~static_cast<uint32_t>(EPOLLERR);
+        }
+    }
+
+    if ((events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) != 0)
+    {
+        CloseClient(client);
+        return;
+    }
+
+    if ((events & EPOLLIN) != 0)
+    {
+        // v1 客户端不发送数据，读到 EOF 即断开；其他内容丢弃
+        uint8_t scratch[256];
+        while (true)
+        {
+            const ssize_t n = recv(client->fd, scratch, sizeof(scratch), MSG_DONTWAIT);
+            if (n > 0)
+            {
+                continue;
+            }
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+            {
+                CloseClient(client);
+                return;
+            }
+            if (errno != EINTR)
+            {
+                break;
+            }
+        }
+    }
+
+    if ((events & EPOLLOUT) != 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(client->mutex);
+            client->writable = true;
+        }
+        if (!FlushClient(client))
+        {
+            CloseClient(client);
+        }
+    }
+}
+
+void CameraDataSocketServer::FlushPendingClients()
+{
+    std::vector<std::shared_ptr<ClientState>> clients;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        clients.reserve(clients_.size());
+        for (const auto& item : clients_)
+        {
+            clients.push_back(item.second);
+        }
+    }
+
+    for (const auto& client : clients)
+    {
+        bool closing = false;
+        {
+            std::lock_guard<std::mutex> lock(client->mutex);
+            closing = client->closing;
+        }
+        if (closing || !FlushClient(client))
+        {
+            CloseClient(client);
+        }
+    }
+}
+
+bool CameraDataSocketServer::FlushClient(const std::shared_ptr<ClientState>& client)
+{
+    bool copy_once = false;
+    while (true)
+    {
+        iovec iov[2];
+        int iov_count = 0;
+        size_t total = 0;
+        bool use_zero_copy = false;
+        {
+            std::lock_guard<std::mutex> lock(client->mutex);
+            if (client->closing)
+            {
+                return false;
+            }
+            if (client->queue.empty() || !client->writable)
+            {
+                return true;
+            }
+            // 持有 writing 期间 Enqueue 不会丢弃队首，锁外发送时数据保持有效
+            client->writing = true;
+            const PendingFrame& frame = client->queue.front();
+            const size_t header_size = sizeof(CameraDataFrameHeader);
+            total = header_size + frame.length;
+            use_zero_copy = client->zero_copy && !copy_once && frame.length >= kZeroCopyMinBytes;
+            if (frame.sent < header_size)
+            {
+                iov[iov_count].iov_base = reinterpret_cast<uint8_t*>(frame.header.get()) +
+                                          frame.sent;
+                iov[iov_count].iov_len = header_size - frame.sent;
+                ++iov_count;
+                iov[iov_count].iov_base = const_cast<uint8_t*>(frame.data);
+                iov[iov_count].iov_len = frame.length;
+                ++iov_count;
+            }
+            else
+            {
+                const size_t offset = frame.sent - header_size;
+                iov[iov_count].iov_base = const_cast<uint8_t*>(frame.data) + offset;
+                iov[iov_count].iov_len = frame.length - offset;
+                ++iov_count;
+            }
+        }
+
+        msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_iov = iov;
+        message.msg_iovlen = static_cast<size_t>(iov_count);
+        const int flags = MSG_NOSIGNAL | MSG_DONTWAIT | (use_zero_copy ? MSG_ZEROCOPY : 0);
+        const ssize_t n = sendmsg(client->fd, &message, flags);
+        const int error_no = errno;
+
+        std::lock_guard<std::mutex> lock(client->mutex);
+        client->writing = false;
+        ++client->send_calls;
+        send_calls_.fetch_add(1, std::memory_order_relaxed);
+        if (n < 0)
+        {
+            if (error_no == EINTR)
+            {
+                continue;
+            }
+            if (error_no == ENOBUFS && use_zero_copy)
+            {
+                // 在途零拷贝占满 optmem，本次改为普通发送
+                copy_once = true;
+                continue;
+            }
+            if (error_no == EAGAIN || error_no == EWOULDBLOCK)
+            {
+                client->writable = false;
+                ++client->blocked_count;
+                if (client->detach_head)
+                {
+                    DetachHeadLocked(*client);
+                }
+                return true;
+            }
+            return false;
+        }
+
+        copy_once = false;
+        PendingFrame& frame = client->queue.front();
+        frame.sent += static_cast<size_t>(n);
+        if (use_zero_copy)
+        {
+            frame.zero_copy = true;
+            frame.zero_copy_seq = client->zero_copy_next_seq++;
+            ++client->zero_copy_sends;
+        }
+        if (frame.sent < total)
+        {
+            if (client->detach_head)
+            {
+                // DropQueuedFrames 时本帧正在发送，sendmsg 返回后才能切换数据来源
+                DetachHeadLocked(*client);
+            }
+            continue;
+        }
+        client->detach_head = false;
+
+        client->send_lag.Record(NowNs() - frame.enqueue_ns);
+        ++client->sent_frames;
+        client->sent_bytes += frame.length;
+        sent_frames_.fetch_add(1, std::memory_order_relaxed);
+        sent_bytes_.fetch_add(frame.length, std::memory_order_relaxed);
+        if (frame.zero_copy)
+        {
+            // 内核仍引用帧内存，BufferGuard 留到完成通知后再释放
+            client->zero_copy_inflight.push_back(std::move(frame));
+        }
+        client->queue.pop_front();
+    }
+}
+
+void CameraDataSocketServer::ReapZeroCopyCompletions(ClientState& client)
+{
+    uint64_t copied = 0;
+    while (true)
+    {
+        char control[CMSG_SPACE(sizeof(sock_extended_err)) * 4];
+        msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        if (recvmsg(client.fd, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+             cmsg = CMSG_NXTHDR(&message, cmsg))
+        {
+            const bool is_recverr =
+                (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+            if (!is_recverr)
+            {
+                continue;
+            }
+            sock_extended_err error;
+            std::memcpy(&error, CMSG_DATA(cmsg), sizeof(error));
+            if (error.ee_errno != 0 || error.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+            {
+                continue;
+            }
+            if ((error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0)
+            {
+                ++copied;
+            }
+            std::lock_guard<std::mutex> lock(client.mutex);
+            client.zero_copy_ranges[error.ee_info] = error.ee_data;
+        }
+    }
+
+    bool fell_back = false;
+    {
+        std::lock_guard<std::mutex> lock(client.mutex);
+        for (auto it = client.zero_copy_ranges.find(client.zero_copy_completed);
+             it != client.zero_copy_ranges.end();
+             it = client.zero_copy_ranges.find(client.zero_copy_completed))
+        {
+            client.zero_copy_completed = it->second + 1;
+            client.zero_copy_ranges.erase(it);
+        }
+        while (!client.zero_copy_inflight.empty() &&
+               SeqBefore(client.zero_copy_inflight.front().zero_copy_seq,
+                         client.zero_copy_completed))
+        {
+            client.zero_copy_inflight.pop_front();
+        }
+
+        // 内核退化为拷贝（如回环投递）时零拷贝只剩额外开销，改回普通发送
+        client.zero_copy_copied += copied;
+        fell_back = copied > 0 && client.zero_copy;
+        if (fell_back)
+        {
+            client.zero_copy = false;
+        }
+    }
+
+    if (fell_back)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_data_server",
+                                      "client %u: kernel copied zero-copy sends, "
+                                      "falling back to regular send",
+                                      client.client_id);
+    }
+}
+
+void CameraDataSocketServer::CloseClient(const std::shared_ptr<ClientState>& client)
+{
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        if (clients_.erase(client->client_id) == 0)
+        {
+            return;
+        }
+    }
+
+    (void)epoll_.Remove(client->fd);
+    {
+        std::lock_guard<std::mutex> lock(client->mutex);
+        client->closing = true;
+        // 释放排队帧与在途零拷贝帧持有的 BufferGuard
+        client->queue.clear();
+        client->zero_copy_inflight.clear();
+    }
+    shutdown(client->fd, SHUT_RDWR);
+    close(client->fd);
+    closed_clients_.fetch_add(1, std::memory_order_relaxed);
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "camera_data_server",
+                                  "client closed: id=%u pid=%d", client->client_id,
+                                  static_cast<int>(client->pid));
+}
+
+void CameraDataSocketServer::Notify()
+{
+    if (event_fd_ >= 0)
+    {
+        const uint64_t value = 1;
+        (void)write(event_fd_, &value, sizeof(value));
+    }
+}
+
+std::shared_ptr<CameraDataSocketServer::ClientState>
+CameraDataSocketServer::FindClient(uint32_t client_id) const
+{
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    auto it = clients_.find(client_id);
+    return it == clients_.end() ? nullptr : it->second;
+}
+
+size_t CameraDataSocketServer::DropFramesLocked(ClientState& client)
+{
+    // 已开始发送或正在发送的队首帧必须完整发出
+    const bool head_pinned =
+        !client.queue.empty() && (client.writing || client.queue.front().sent > 0);
+    const size_t first_droppable = head_pinned ? 1 : 0;
+
+    size_t dropped = 0;
+    if (client.policy == QueuePolicy::kKeepLatest)
+    {
+        dropped = client.queue.size() - first_droppable;
+        client.queue.erase(client.queue.begin() + static_cast<std::ptrdiff_t>(first_droppable),
+                           client.queue.end());
+    }
+    else
+    {
+        while (client.queue.size() >= client.max_queued_frames &&
+               client.queue.size() > first_droppable)
+        {
+            client.queue.erase(client.queue.begin() +
+                               static_cast<std::ptrdiff_t>(first_droppable));
+            ++dropped;
+        }
+    }
+    client.dropped_frames += dropped;
+    return dropped;
+}
+
+void CameraDataSocketServer::DetachHeadLocked(ClientState& client)
+{
+    client.detach_head = false;
+    if (client.queue.empty() || !client.queue.front().pooled)
+    {
+        return;
+    }
+
+    // 未发送部分的偏移保持不变，整帧拷贝后续发即可保证字节流连续
+    PendingFrame& head = client.queue.front();
+    auto copy = std::make_shared<std::vector<uint8_t>>(head.data, head.data + head.length);
+    if (head.zero_copy)
+    {
+        // 已发出的零拷贝片段仍引用原帧头与帧内存，二者转入在途列表等内核完成通知后释放
+        PendingFrame retired;
+        retired.header = std::move(head.header);
+        retired.owner = std::move(head.owner);
+        retired.zero_copy = true;
+        retired.zero_copy_seq = head.zero_copy_seq;
+        head.header = std::make_unique<CameraDataFrameHeader>(*retired.header);
+        head.zero_copy = false;
+        client.zero_copy_inflight.push_back(std::move(retired));
+    }
+    head.data = copy->data();
+    head.owner = std::move(copy);
+    head.pooled = false;
+}
+
+} // namespace ipc
+} // namespace camera_subsystem
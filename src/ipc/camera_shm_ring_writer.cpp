@@ -0,0 +1,413 @@
+/**
+ * @file camera_shm_ring_writer.cpp
+ * @brief 共享内存帧环发布端实现
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ */
+
+#include "camera_subsystem/ipc/camera_shm_ring_writer.h"
+
+#include "camera_subsystem/platform/platform_logger.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace camera_subsystem
+{
+namespace ipc
+{
+
+namespace
+{
+
+std::atomic<uint64_t> g_next_ring_id{1};
+
+size_t RoundUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+CameraShmRingWriter::CameraShmRingWriter()
+{
+    eventfds_.fill(-1);
+}
+
+CameraShmRingWriter::~CameraShmRingWriter()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Destroy();
+}
+
+bool CameraShmRingWriter::Create(uint32_t slot_count, size_t slot_capacity, uint32_t max_consumers)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Destroy();
+
+    if (slot_count < 2 || slot_count > kCameraShmRingMaxSlots || slot_capacity == 0 ||
+        max_consumers == 0 || max_consumers > kCameraShmRingMaxConsumers)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_shm_ring",
+                                      "invalid ring geometry: slots=%u capacity=%zu consumers=%u",
+                                      slot_count, slot_capacity, max_consumers);
+        return false;
+    }
+
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t header_bytes = RoundUp(sizeof(CameraShmRingHeader), page_size);
+    const size_t slot_stride = RoundUp(kCameraShmRingSlotHeaderSize + slot_capacity, page_size);
+    const size_t bytes = header_bytes + slot_stride * slot_count;
+
+    const int fd = memfd_create("camera_shm_ring", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_shm_ring",
+                                      "memfd_create failed: %s", std::strerror(errno));
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_shm_ring",
+                                      "ftruncate of %zu bytes failed: %s", bytes,
+                                      std::strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    // 消费者需要可写映射头部以更新读游标，只封印尺寸
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW) != 0)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_shm_ring",
+                                      "memfd sealing failed: %s", std::strerror(errno));
+        close(fd);
+        return false;
+    }
+    (void)fcntl(fd, F_ADD_SEALS, F_SEAL_SEAL);
+
+    void* region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (region == MAP_FAILED)
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kError, "camera_shm_ring",
+                                      "mmap of %zu bytes failed: %s", bytes,
+                                      std::strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    // memfd 初始全 0，原子成员按地址无关的无锁原子直接构造
+    header_ = new (region) CameraShmRingHeader();
+    header_->magic = kCameraShmRingMagic;
+    header_->version = kCameraShmRingVersion;
+    header_->slot_count = slot_count;
+    header_->max_consumers = max_consumers;
+    header_->slot_capacity = slot_capacity;
+    header_->slot_stride = slot_stride;
+    header_->slots_offset = header_bytes;
+    header_->write_seq.store(0);
+    header_->closed.store(0);
+    for (uint32_t i = 0; i < kCameraShmRingMaxSlots; ++i)
+    {
+        header_->frames[i].seq.store(kCameraShmRingSeqEmpty);
+        header_->frames[i].slot.store(kCameraShmRingNoSlot);
+    }
+    for (uint32_t i = 0; i < kCameraShmRingMaxConsumers; ++i)
+    {
+        header_->consumers[i].active.store(0);
+        header_->consumers[i].pinned_slot.store(kCameraShmRingNoSlot);
+    }
+
+    memfd_ = fd;
+    mapped_bytes_ = bytes;
+    slots_ = static_cast<uint8_t*>(region) + header_bytes;
+    slot_count_ = slot_count;
+    slot_capacity_ = slot_capacity;
+    slot_stride_ = slot_stride;
+    max_consumers_ = max_consumers;
+    for (uint32_t i = 0; i < slot_count; ++i)
+    {
+        CameraShmRingSlot* slot = new (SlotAt(i)) CameraShmRingSlot();
+        slot->seq.store(kCameraShmRingSeqEmpty);
+    }
+    eventfds_.fill(-1);
+    consumer_pids_.fill(0);
+    next_slot_ = 0;
+    write_seq_ = 0;
+    closed_ = false;
+    ring_id_ = g_next_ring_id.fetch_add(1);
+    published_frames_ = 0;
+    dropped_frames_ = 0;
+    return true;
+}
+
+bool CameraShmRingWriter::AttachConsumer(pid_t pid, uint32_t* index, int* eventfd_out)
+{
+    if (index == nullptr || eventfd_out == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (header_ == nullptr || closed_)
+    {
+        return false;
+    }
+
+    // 占用情况以写端持有的 eventfd 为准，不信任消费者可写的 active 字段
+    for (uint32_t i = 0; i < max_consumers_; ++i)
+    {
+        if (eventfds_[i] >= 0)
+        {
+            continue;
+        }
+
+        const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd < 0)
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "camera_shm_ring",
+                                          "eventfd failed: %s", std::strerror(errno));
+            return false;
+        }
+        CameraShmRingConsumer& consumer = header_->consumers[i];
+        consumer.pinned_slot.store(kCameraShmRingNoSlot);
+        consumer.read_seq.store(write_seq_);
+        consumer.frames_read.store(0);
+        consumer.overruns.store(0);
+        consumer.pid = static_cast<int32_t>(pid);
+        consumer.active.store(1);
+        eventfds_[i] = fd;
+        consumer_pids_[i] = pid;
+        *index = i;
+        *eventfd_out = fd;
+        return true;
+    }
+
+    platform::PlatformLogger::Log(core::LogLevel::kWarning, "camera_shm_ring",
+                                  "ring %llu has no free consumer slot",
+                                  static_cast<unsigned long long>(ring_id_));
+    return false;
+}
+
+void CameraShmRingWriter::DetachConsumer(uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (header_ == nullptr || index >= max_consumers_)
+    {
+        return;
+    }
+
+    CameraShmRingConsumer& consumer = header_->consumers[index];
+    consumer.active.store(0);
+    consumer.pinned_slot.store(kCameraShmRingNoSlot);
+    if (eventfds_[index] >= 0)
+    {
+        close(eventfds_[index]);
+        eventfds_[index] = -1;
+    }
+    consumer_pids_[index] = 0;
+}
+
+bool CameraShmRingWriter::Publish(const CameraDataFrameHeader& header,
+                                  const void* data,
+                                  size_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (header_ == nullptr || closed_ || size > slot_capacity_ || (size > 0 && data == nullptr))
+    {
+        return false;
+    }
+
+    const uint32_t slot_count = slot_count_;
+    const uint64_t seq = write_seq_;
+
+    // 先标记写入再检查固定，与读取器“先固定再核对序号”配对，二者不会同时成功
+    CameraShmRingSlot* slot = nullptr;
+    uint32_t slot_index = kCameraShmRingNoSlot;
+    for (uint32_t attempt = 0; attempt < slot_count; ++attempt)
+    {
+        const uint32_t candidate = (next_slot_ + attempt) % slot_count;
+        CameraShmRingSlot* candidate_slot = SlotAt(candidate);
+        const uint64_t previous = candidate_slot->seq.exchange(kCameraShmRingSeqWriting);
+        if (!IsSlotPinnedLocked(candidate))
+        {
+            slot = candidate_slot;
+            slot_index = candidate;
+            break;
+        }
+        candidate_slot->seq.store(previous);
+    }
+    if (slot == nullptr)
+    {
+        ++dropped_frames_;
+        return false;
+    }
+    next_slot_ = (slot_index + 1) % slot_count;
+
+    slot->header = header;
+    slot->header.frame_size = static_cast<uint32_t>(size);
+    if (size > 0)
+    {
+        std::memcpy(reinterpret_cast<uint8_t*>(slot) + kCameraShmRingSlotHeaderSize, data, size);
+    }
+    slot->seq.store(seq, std::memory_order_release);
+
+    CameraShmRingFrameEntry& entry = header_->frames[seq % slot_count];
+    entry.slot.store(slot_index, std::memory_order_relaxed);
+    entry.seq.store(seq, std::memory_order_release);
+    write_seq_ = seq + 1;
+    header_->write_seq.store(write_seq_, std::memory_order_release);
+    ++published_frames_;
+
+    for (uint32_t i = 0; i < max_consumers_; ++i)
+    {
+        if (eventfds_[i] >= 0)
+        {
+            Notify(eventfds_[i]);
+        }
+    }
+    return true;
+}
+
+void CameraShmRingWriter::Close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (header_ == nullptr)
+    {
+        return;
+    }
+    closed_ = true;
+    header_->closed.store(1, std::memory_order_release);
+    for (const int fd : eventfds_)
+    {
+        if (fd >= 0)
+        {
+            Notify(fd);
+        }
+    }
+}
+
+int CameraShmRingWriter::GetMemFd() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memfd_;
+}
+
+uint64_t CameraShmRingWriter::GetRingId() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_id_;
+}
+
+size_t CameraShmRingWriter::GetSlotCapacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return header_ != nullptr ? slot_capacity_ : 0;
+}
+
+size_t CameraShmRingWriter::GetConsumerCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const int fd : eventfds_)
+    {
+        count += fd >= 0 ? 1 : 0;
+    }
+    return count;
+}
+
+CameraShmRingWriter::Stats CameraShmRingWriter::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    if (header_ == nullptr)
+    {
+        return stats;
+    }
+
+    stats.ring_id = ring_id_;
+    stats.slot_count = slot_count_;
+    stats.slot_capacity = slot_capacity_;
+    stats.published_frames = published_frames_;
+    stats.dropped_frames = dropped_frames_;
+    for (uint32_t i = 0; i < max_consumers_; ++i)
+    {
+        const CameraShmRingConsumer& consumer = header_->consumers[i];
+        if (eventfds_[i] < 0)
+        {
+            continue;
+        }
+        ConsumerStats item;
+        item.index = i;
+        item.pid = consumer_pids_[i];
+        item.frames_read = consumer.frames_read.load(std::memory_order_relaxed);
+        item.overruns = consumer.overruns.load(std::memory_order_relaxed);
+        const uint64_t read_seq = consumer.read_seq.load(std::memory_order_relaxed);
+        // read_seq 由消费者写入，超出已发布范围的值按无积压处理
+        item.lag = write_seq_ > read_seq ? write_seq_ - read_seq : 0;
+        stats.consumers.push_back(item);
+    }
+    return stats;
+}
+
+CameraShmRingSlot* CameraShmRingWriter::SlotAt(uint32_t slot_index) const
+{
+    return reinterpret_cast<CameraShmRingSlot*>(slots_ + slot_stride_ * slot_index);
+}
+
+bool CameraShmRingWriter::IsSlotPinnedLocked(uint32_t slot_index) const
+{
+    // 只读取写端确认已附着的消费者；pinned_slot 仅用于比较，越界值不会命中任何槽位
+    for (uint32_t i = 0; i < max_consumers_; ++i)
+    {
+        const CameraShmRingConsumer& consumer = header_->consumers[i];
+        if (eventfds_[i] >= 0 && consumer.pinned_slot.load() == slot_index)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CameraShmRingWriter::Notify(int fd) const
+{
+    const uint64_t value = 1;
+    // 计数溢出（EAGAIN）说明消费者早已有未处理的通知，可以忽略
+    (void)!write(fd, &value, sizeof(value));
+}
+
+void CameraShmRingWriter::Destroy()
+{
+    for (int& fd : eventfds_)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        fd = -1;
+    }
+    if (header_ != nullptr)
+    {
+        munmap(header_, mapped_bytes_);
+        header_ = nullptr;
+        slots_ = nullptr;
+        mapped_bytes_ = 0;
+    }
+    slot_count_ = 0;
+    slot_capacity_ = 0;
+    slot_stride_ = 0;
+    max_consumers_ = 0;
+    if (memfd_ >= 0)
+    {
+        close(memfd_);
+        memfd_ = -1;
+    }
+}
+
+} // namespace ipc
+} // namespace camera_subsystem
@@ -65,6 +65,22 @@ bool PlatformEpoll::Modify(int fd, uint32_t events)
     return ret == 0;
 }
 
+bool PlatformEpoll::Modify(int fd, uint32_t events, uint64_t data)
+{
+    if (epoll_fd_ < 0 || fd < 0)
+    {
+        return false;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.u64 = data;
+
+    int ret = epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev);
+    return ret == 0;
+}
+
 bool PlatformEpoll::Remove(int fd)
 {
     if (epoll_fd_ < 0 || fd < 0)
@@ -139,6 +139,25 @@ bool PlatformThread::SetPriority(int priority)
 #endif
 }
 
+bool PlatformThread::SetRealtimePriority(int priority)
+{
+    if (!is_running_ || !native_thread_)
+    {
+        return false;
+    }
+
+#ifdef __linux__
+    sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+
+    int ret = pthread_setschedparam(native_thread_->native_handle(), SCHED_FIFO, &param);
+    return ret == 0;
+#else
+    return false;
+#endif
+}
+
 bool PlatformThread::SetCpuAffinity(const std::vector<int>& cpu_ids)
 {
     if (!is_running_ || !native_thread_ || cpu_ids.empty())
@@ -177,11 +196,11 @@ bool PlatformThread::IsStopRequested() const
 
 void PlatformThread::ThreadEntry()
 {
-    // 设置线程名称（仅前16个字符有效）
+    // 设置线程名称（内核限制 16 字节，含结尾 '\0'）
     if (!thread_name_.empty())
     {
 #ifdef __linux__
-        pthread_setname_np(pthread_self(), thread_name_.substr(0, 16).c_str());
+        pthread_setname_np(pthread_self(), thread_name_.substr(0, 15).c_str());
 #endif
     }
 
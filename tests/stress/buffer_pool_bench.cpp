@@ -0,0 +1,297 @@
+/**
+ * @file buffer_pool_bench.cpp
+ * @brief BufferPool Acquire/归还吞吐微基准
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ *
+ * 用法：
+ *   ./buffer_pool_bench [frames]
+ *
+ * 参数：
+ *   frames: 每种配置采集线程获取的 Buffer 总数，默认 200000
+ *
+ * 测试目的：
+ * 1. 对比旧实现（单把互斥锁 + std::queue 空闲列表）与无锁空闲列表实现的
+ *    Acquire -> MarkInFlight -> 跨线程归还 吞吐。
+ * 2. 覆盖 1 / 2 / 4 / 8 个归还线程，观察采集线程与归还线程的争用。
+ *
+ * 测试流程：
+ * 1. 采集线程循环 Acquire，调用 MarkInFlight 后轮询交给各归还线程，
+ *    每 64 帧调用一次 GetStats 模拟监控。
+ * 2. 归还线程取到 Buffer 后立即释放，使其回到池中。
+ * 3. 输出每种配置的吞吐（Mops/s）、获取失败次数及相对旧实现的比例。
+ *
+ * 结果判定：
+ * 1. 程序正常退出，所有 Buffer 最终归还（available == total）。
+ * 2. 无锁实现在多归还线程下的吞吐应不低于旧实现。
+ */
+
+#include "camera_subsystem/core/bounded_mpmc_ring.h"
+#include "camera_subsystem/core/buffer_guard.h"
+#include "camera_subsystem/core/buffer_pool.h"
+#include "camera_subsystem/platform/platform_logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace camera_subsystem;
+
+namespace
+{
+
+constexpr size_t kBufferCount = 16;
+constexpr size_t kBufferSize = 4096;
+constexpr size_t kHandoffCapacity = 64;
+constexpr uint64_t kStatsInterval = 64;
+
+/**
+ * @brief 旧版 BufferPool 的复刻，作为对比基线
+ *
+ * Acquire / 归还 / MarkInFlight / GetStats 共用一把互斥锁，空闲列表为 std::queue。
+ */
+class LegacyBufferPool
+{
+public:
+    class Guard
+    {
+    public:
+        Guard(LegacyBufferPool* pool, uint32_t id)
+            : pool_(pool)
+            , id_(id)
+        {
+        }
+
+        ~Guard()
+        {
+            pool_->Release(id_);
+        }
+
+        void MarkInFlight()
+        {
+            pool_->MarkInFlight(id_);
+        }
+
+    private:
+        LegacyBufferPool* pool_;
+        uint32_t id_;
+    };
+
+    explicit LegacyBufferPool(size_t count)
+        : storage_(count)
+        , states_(count, core::BufferState::kFree)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            storage_[i] = std::make_unique<uint8_t[]>(kBufferSize);
+            free_ids_.push(static_cast<uint32_t>(i));
+        }
+        stats_.total = count;
+        stats_.available = count;
+    }
+
+    std::shared_ptr<Guard> Acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.acquire_count++;
+        if (free_ids_.empty())
+        {
+            stats_.acquire_fail++;
+            return nullptr;
+        }
+        const uint32_t id = free_ids_.front();
+        free_ids_.pop();
+        stats_.available = free_ids_.size();
+        stats_.in_use++;
+        stats_.max_in_use = std::max(stats_.max_in_use, stats_.in_use);
+        states_[id] = core::BufferState::kInUse;
+        return std::shared_ptr<Guard>(new Guard(this, id));
+    }
+
+    core::BufferPool::Stats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        core::BufferPool::Stats stats = stats_;
+        stats.available = free_ids_.size();
+        return stats;
+    }
+
+private:
+    void Release(uint32_t id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (states_[id] == core::BufferState::kInFlight)
+        {
+            stats_.in_flight--;
+        }
+        else if (states_[id] == core::BufferState::kInUse)
+        {
+            stats_.in_use--;
+        }
+        states_[id] = core::BufferState::kFree;
+        free_ids_.push(id);
+        stats_.release_count++;
+        stats_.available = free_ids_.size();
+    }
+
+    void MarkInFlight(uint32_t id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (states_[id] == core::BufferState::kInUse)
+        {
+            states_[id] = core::BufferState::kInFlight;
+            stats_.in_use--;
+            stats_.in_flight++;
+            stats_.max_in_flight = std::max(stats_.max_in_flight, stats_.in_flight);
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<uint8_t[]>> storage_;
+    std::vector<core::BufferState> states_;
+    std::queue<uint32_t> free_ids_;
+    core::BufferPool::Stats stats_;
+};
+
+struct BenchResult
+{
+    double mops = 0.0;
+    uint64_t acquire_fail = 0;
+    bool drained = false;
+};
+
+/**
+ * @brief 采集线程获取 Buffer 并轮询交给 releaser_count 个归还线程
+ */
+template <typename Pool>
+BenchResult RunHandoff(Pool& pool, size_t releaser_count, uint64_t frames)
+{
+    using GuardPtr = decltype(pool.Acquire());
+
+    std::vector<std::unique_ptr<core::BoundedMpmcRing<GuardPtr>>> handoff;
+    for (size_t i = 0; i < releaser_count; ++i)
+    {
+        handoff.push_back(std::make_unique<core::BoundedMpmcRing<GuardPtr>>(kHandoffCapacity));
+    }
+
+    std::atomic<bool> producing{true};
+    std::vector<std::thread> releasers;
+    for (size_t i = 0; i < releaser_count; ++i)
+    {
+        releasers.emplace_back([&, i]() {
+            GuardPtr guard;
+            while (producing.load(std::memory_order_relaxed) || !handoff[i]->Empty())
+            {
+                if (handoff[i]->TryPop(&guard))
+                {
+                    guard.reset();
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    uint64_t acquire_fail = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (uint64_t frame = 0; frame < frames; ++frame)
+    {
+        GuardPtr guard = pool.Acquire();
+        while (!guard)
+        {
+            ++acquire_fail;
+            std::this_thread::yield();
+            guard = pool.Acquire();
+        }
+        guard->MarkInFlight();
+
+        auto& ring = *handoff[frame % releaser_count];
+        while (!ring.TryPush(std::move(guard)))
+        {
+            std::this_thread::yield();
+        }
+
+        if (frame % kStatsInterval == 0)
+        {
+            (void)pool.GetStats();
+        }
+    }
+    producing.store(false);
+    for (auto& releaser : releasers)
+    {
+        releaser.join();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    BenchResult result;
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    result.mops = seconds > 0.0 ? static_cast<double>(frames) / seconds / 1e6 : 0.0;
+    result.acquire_fail = acquire_fail;
+    result.drained = pool.GetStats().available == kBufferCount;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (!platform::PlatformLogger::Initialize(std::string(), core::LogLevel::kInfo))
+    {
+        return 1;
+    }
+
+    uint64_t frames = 200000;
+    if (argc > 1)
+    {
+        frames = static_cast<uint64_t>(std::max(1, std::atoi(argv[1])));
+    }
+
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "pool_bench",
+                                  "BufferPool bench start, frames=%lu, buffers=%zu", frames,
+                                  kBufferCount);
+
+    bool ok = true;
+    for (size_t releaser_count : {1, 2, 4, 8})
+    {
+        LegacyBufferPool legacy_pool(kBufferCount);
+        const BenchResult legacy = RunHandoff(legacy_pool, releaser_count, frames);
+
+        core::BufferPool pool;
+        if (!pool.Initialize(kBufferCount, kBufferSize))
+        {
+            platform::PlatformLogger::Log(core::LogLevel::kError, "pool_bench",
+                                          "BufferPool initialize failed");
+            platform::PlatformLogger::Shutdown();
+            return 1;
+        }
+        const BenchResult lock_free = RunHandoff(pool, releaser_count, frames);
+        ok = ok && legacy.drained && lock_free.drained;
+
+        platform::PlatformLogger::Log(
+            core::LogLevel::kInfo,
+            "pool_bench",
+            "releasers=%zu legacy=%6.2f Mops/s (fail=%lu) lock_free=%6.2f Mops/s (fail=%lu) "
+            "ratio=%.2fx%s",
+            releaser_count,
+            legacy.mops,
+            legacy.acquire_fail,
+            lock_free.mops,
+            lock_free.acquire_fail,
+            legacy.mops > 0.0 ? lock_free.mops / legacy.mops : 0.0,
+            (legacy.drained && lock_free.drained) ? "" : " [not drained]"
+        );
+    }
+
+    platform::PlatformLogger::Shutdown();
+    return ok ? 0 : 1;
+}
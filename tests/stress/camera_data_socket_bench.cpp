@@ -0,0 +1,460 @@
+/**
+ * @file camera_data_socket_bench.cpp
+ * @brief v1 数据面发送开销基准：旧版双 write 与 sendmsg / TCP / MSG_ZEROCOPY 对比
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ *
+ * 用法：
+ *   ./camera_data_socket_bench [frames] [clients]
+ *
+ * 参数：
+ *   frames : 每种模式按 30fps 节拍发布的帧数，默认 150
+ *   clients: 订阅进程数，默认 3
+ *
+ * 测试目的：
+ * 1. 以 1080p YUYV（1920x1080x2 字节）帧对比四种发送方式的系统调用数与 CPU 占用：
+ *    - legacy      : 旧版示例实现，采集线程对每个客户端阻塞 write 帧头、再 write 帧数据
+ *    - unix        : CameraDataSocketServer，Unix socket，帧头 + 数据一次 sendmsg
+ *    - tcp         : CameraDataSocketServer，TCP 回环，普通 sendmsg
+ *    - tcp_zerocopy: CameraDataSocketServer，TCP 回环，MSG_ZEROCOPY
+ * 2. 订阅端为 fork 出的独立进程，CPU 占用只统计发布进程（getrusage RUSAGE_SELF）。
+ *
+ * 输出说明：
+ * - send_calls/frame: 每个客户端每帧的发送系统调用次数（不含零拷贝完成通知的 recvmsg）
+ * - cpu             : 发布进程 (utime + stime) / 墙钟时间
+ * - capture_max_us  : 采集线程单帧分发（写 socket 或入队）的最长耗时
+ * - zc_sends / zc_copied: 零拷贝发送次数与内核报告退化为拷贝的完成通知数；
+ *   回环投递时内核会拷贝，服务端随即改回普通发送
+ *
+ * 结果判定：
+ * 1. 所有订阅进程收到的帧头均合法，且各模式无发送失败。
+ */
+
+#include "camera_subsystem/core/buffer_pool.h"
+#include "camera_subsystem/ipc/camera_data_ipc.h"
+#include "camera_subsystem/ipc/camera_data_socket_server.h"
+#include "camera_subsystem/platform/platform_logger.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <netinet/in.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace camera_subsystem;
+
+namespace
+{
+
+constexpr uint32_t kWidth = 1920;
+constexpr uint32_t kHeight = 1080;
+constexpr size_t kFrameSize = static_cast<size_t>(kWidth) * kHeight * 2;
+constexpr uint32_t kFps = 30;
+constexpr size_t kPoolBuffers = 16;
+
+enum class Mode
+{
+    kLegacy,
+    kUnix,
+    kTcp,
+    kTcpZeroCopy
+};
+
+const char* ModeName(Mode mode)
+{
+    switch (mode)
+    {
+        case Mode::kLegacy:
+            return "legacy";
+        case Mode::kUnix:
+            return "unix";
+        case Mode::kTcp:
+            return "tcp";
+        case Mode::kTcpZeroCopy:
+            return "tcp_zerocopy";
+    }
+    return "unknown";
+}
+
+struct BenchResult
+{
+    uint64_t sent_frames = 0;
+    uint64_t dropped_frames = 0;
+    uint64_t send_calls = 0;
+    uint64_t zero_copy_sends = 0;
+    uint64_t zero_copy_copied = 0;
+    uint64_t capture_max_ns = 0;
+    double cpu_percent = 0.0;
+    bool ok = true;
+};
+
+uint64_t NowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+uint64_t CpuTimeNs()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    const auto to_ns = [](const timeval& tv)
+    {
+        return static_cast<uint64_t>(tv.tv_sec) * 1000000000ULL +
+               static_cast<uint64_t>(tv.tv_usec) * 1000ULL;
+    };
+    return to_ns(usage.ru_utime) + to_ns(usage.ru_stime);
+}
+
+ipc::CameraDataFrameHeader MakeHeader(uint64_t frame_id)
+{
+    ipc::CameraDataFrameHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = ipc::kCameraDataMagic;
+    header.version = ipc::kCameraDataVersion;
+    header.frame_id = frame_id;
+    header.width = kWidth;
+    header.height = kHeight;
+    header.pixel_format = static_cast<uint32_t>(core::PixelFormat::kYUYV);
+    header.frame_size = static_cast<uint32_t>(kFrameSize);
+    return header;
+}
+
+bool ReadFull(int fd, void* buffer, size_t length)
+{
+    auto* out = static_cast<uint8_t*>(buffer);
+    size_t total = 0;
+    while (total < length)
+    {
+        const ssize_t n = read(fd, out + total, length - total);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        total += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief 旧版示例的发送方式：阻塞 write，帧头与帧数据各一次（部分写时继续）
+ */
+bool WriteFull(int fd, const void* buffer, size_t length, uint64_t* calls)
+{
+    const auto* data = static_cast<const uint8_t*>(buffer);
+    size_t total = 0;
+    while (total < length)
+    {
+        const ssize_t n = send(fd, data + total, length - total, MSG_NOSIGNAL);
+        ++*calls;
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        total += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+int ConnectTo(Mode mode, const std::string& path, uint16_t port)
+{
+    if (mode == Mode::kTcp || mode == Mode::kTcpZeroCopy)
+    {
+        const int fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+        {
+            return -1;
+        }
+        return fd;
+    }
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief fork 订阅进程：读到 EOF 为止，帧头非法时以 1 退出
+ */
+pid_t SpawnReader(Mode mode, const std::string& path, uint16_t port)
+{
+    const pid_t pid = fork();
+    if (pid != 0)
+    {
+        return pid;
+    }
+
+    const int fd = ConnectTo(mode, path, port);
+    if (fd < 0)
+    {
+        _exit(1);
+    }
+    std::vector<uint8_t> payload(kFrameSize);
+    ipc::CameraDataFrameHeader header;
+    while (ReadFull(fd, &header, sizeof(header)))
+    {
+        if (!ipc::IsCameraDataFrameHeaderValid(header) || header.frame_size != kFrameSize ||
+            !ReadFull(fd, payload.data(), payload.size()))
+        {
+            _exit(1);
+        }
+    }
+    _exit(0);
+}
+
+bool WaitReaders(const std::vector<pid_t>& readers)
+{
+    bool ok = true;
+    for (pid_t pid : readers)
+    {
+        int status = 0;
+        ok = waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+             WEXITSTATUS(status) == 0 && ok;
+    }
+    return ok;
+}
+
+/**
+ * @brief 按 30fps 节拍调用 publish，统计采集线程单帧耗时与进程 CPU
+ */
+template <typename Publish>
+void RunPaced(uint64_t frames, BenchResult* result, Publish publish)
+{
+    const uint64_t cpu_begin = CpuTimeNs();
+    const auto begin = std::chrono::steady_clock::now();
+    for (uint64_t frame = 0; frame < frames; ++frame)
+    {
+        std::this_thread::sleep_until(begin + std::chrono::nanoseconds(1000000000ULL / kFps) *
+                                                  static_cast<int64_t>(frame));
+        const uint64_t start_ns = NowNs();
+        publish(frame);
+        result->capture_max_ns = std::max(result->capture_max_ns, NowNs() - start_ns);
+    }
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin)
+                            .count();
+    result->cpu_percent =
+        wall > 0.0 ? static_cast<double>(CpuTimeNs() - cpu_begin) / 1e9 / wall * 100.0 : 0.0;
+}
+
+BenchResult RunLegacy(uint64_t frames, size_t client_count, const std::vector<uint8_t>& payload)
+{
+    BenchResult result;
+    const std::string path = "/tmp/camera_data_bench_legacy_" + std::to_string(getpid()) + ".sock";
+    const int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(path.c_str());
+    if (server_fd < 0 || bind(server_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(server_fd, 16) != 0)
+    {
+        result.ok = false;
+        return result;
+    }
+
+    std::vector<pid_t> readers;
+    std::vector<int> clients;
+    for (size_t i = 0; i < client_count; ++i)
+    {
+        readers.push_back(SpawnReader(Mode::kLegacy, path, 0));
+        clients.push_back(accept(server_fd, nullptr, nullptr));
+    }
+
+    RunPaced(frames, &result,
+             [&](uint64_t frame)
+             {
+                 const ipc::CameraDataFrameHeader header = MakeHeader(frame);
+                 for (int fd : clients)
+                 {
+                     if (WriteFull(fd, &header, sizeof(header), &result.send_calls) &&
+                         WriteFull(fd, payload.data(), payload.size(), &result.send_calls))
+                     {
+                         ++result.sent_frames;
+                     }
+                     else
+                     {
+                         result.ok = false;
+                     }
+                 }
+             });
+
+    for (int fd : clients)
+    {
+        close(fd);
+    }
+    close(server_fd);
+    unlink(path.c_str());
+    result.ok = WaitReaders(readers) && result.ok;
+    return result;
+}
+
+BenchResult RunServer(Mode mode, uint64_t frames, size_t client_count)
+{
+    BenchResult result;
+    ipc::CameraDataSocketServer::Options options;
+    options.tcp_enabled = mode != Mode::kUnix;
+    options.tcp_zero_copy = mode == Mode::kTcpZeroCopy;
+    ipc::CameraDataSocketServer server(options);
+    const std::string path = "/tmp/camera_data_bench_" + std::to_string(getpid()) + ".sock";
+    core::BufferPool pool;
+    if (!server.Start(path) || !pool.Initialize(kPoolBuffers, kFrameSize))
+    {
+        result.ok = false;
+        return result;
+    }
+    for (size_t i = 0; i < kPoolBuffers; ++i)
+    {
+        // 预先写满各槽位，避免首次缺页计入发布开销
+        auto buffer = pool.Acquire();
+        std::memset(buffer->Data(), 0x5a, kFrameSize);
+    }
+
+    std::vector<pid_t> readers;
+    for (size_t i = 0; i < client_count; ++i)
+    {
+        readers.push_back(SpawnReader(mode, path, server.GetTcpPort()));
+    }
+    for (int i = 0; i < 400 && server.GetClientCount() < client_count; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    uint64_t pool_misses = 0;
+    RunPaced(frames, &result,
+             [&](uint64_t frame)
+             {
+                 std::shared_ptr<core::BufferGuard> buffer = pool.Acquire();
+                 if (!buffer)
+                 {
+                     ++pool_misses;
+                     return;
+                 }
+                 const ipc::CameraDataFrameHeader header = MakeHeader(frame);
+                 for (const auto& client : server.GetClientsSnapshot())
+                 {
+                     (void)server.Enqueue(client.client_id, header, buffer->Data(), kFrameSize,
+                                          buffer);
+                 }
+             });
+
+    // 等待队列与在途零拷贝帧清空
+    for (int i = 0; i < 400; ++i)
+    {
+        bool drained = true;
+        for (const auto& client : server.GetClientStats())
+        {
+            drained = drained && client.queued_frames == 0 && client.zero_copy_inflight == 0;
+        }
+        if (drained)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    for (const auto& client : server.GetClientStats())
+    {
+        result.zero_copy_sends += client.zero_copy_sends;
+        result.zero_copy_copied += client.zero_copy_copied;
+    }
+    const ipc::CameraDataSocketServer::ServerStats stats = server.GetServerStats();
+    result.sent_frames = stats.sent_frames;
+    result.dropped_frames = stats.dropped_frames + pool_misses;
+    result.send_calls = stats.send_calls;
+    result.ok = stats.closed_clients == 0;
+    server.Stop();
+    result.ok = WaitReaders(readers) && result.ok;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (!platform::PlatformLogger::Initialize(std::string(), core::LogLevel::kInfo))
+    {
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    uint64_t frames = 150;
+    size_t client_count = 3;
+    if (argc > 1)
+    {
+        frames = static_cast<uint64_t>(std::max(1, std::atoi(argv[1])));
+    }
+    if (argc > 2)
+    {
+        client_count = static_cast<size_t>(std::max(1, std::atoi(argv[2])));
+    }
+
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "data_bench",
+                                  "v1 data socket bench start, frames=%lu clients=%zu "
+                                  "frame=%ux%u YUYV (%zu bytes) fps=%u",
+                                  frames, client_count, kWidth, kHeight, kFrameSize, kFps);
+
+    std::vector<uint8_t> payload(kFrameSize, 0x5a);
+    bool ok = true;
+    for (Mode mode : {Mode::kLegacy, Mode::kUnix, Mode::kTcp, Mode::kTcpZeroCopy})
+    {
+        const BenchResult result = mode == Mode::kLegacy
+                                       ? RunLegacy(frames, client_count, payload)
+                                       : RunServer(mode, frames, client_count);
+        ok = ok && result.ok;
+        platform::PlatformLogger::Log(
+            core::LogLevel::kInfo,
+            "data_bench",
+            "mode=%-12s sent=%lu dropped=%lu send_calls/frame=%.2f cpu=%5.1f%% "
+            "capture_max_us=%lu zc_sends=%lu zc_copied=%lu%s",
+            ModeName(mode),
+            result.sent_frames,
+            result.dropped_frames,
+            result.sent_frames > 0 ? static_cast<double>(result.send_calls) /
+                                         static_cast<double>(result.sent_frames)
+                                   : 0.0,
+            result.cpu_percent,
+            result.capture_max_ns / 1000,
+            result.zero_copy_sends,
+            result.zero_copy_copied,
+            result.ok ? "" : " [FAILED]"
+        );
+    }
+
+    platform::PlatformLogger::Shutdown();
+    return ok ? 0 : 1;
+}
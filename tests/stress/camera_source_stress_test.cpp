@@ -9,7 +9,8 @@
  * 
  * 参数:
  *   duration_seconds: 测试持续时间（秒），默认 20 秒
- *   device_path: Camera 设备路径，默认 /dev/video0
+ *   device_path: Camera 设备路径，默认 /dev/video0；也可指定无硬件采集后端：
+ *                synthetic（合成色条）或 replay:<file>（按 fps 回放录制的 NV12 原始帧）
  *   output_dir: 图片输出目录，默认 ./stress_frames
  * 
  * 示例:
@@ -19,6 +20,9 @@
  *   # 自定义测试（30 秒，/dev/video1）
  *   sudo ./camera_source_stress_test 30 /dev/video1
  *
+ *   # 无摄像头时以合成图案压测整条采集 → 分发链路
+ *   ./camera_source_stress_test 10 synthetic
+ *
  *   # 自定义输出目录
  *   sudo ./camera_source_stress_test 20 /dev/video0 ./stress_frames
  * 
@@ -50,6 +54,8 @@
 
 #include "camera_subsystem/broker/frame_broker.h"
 #include "camera_subsystem/camera/camera_source.h"
+#include "camera_subsystem/camera/file_replay_capture_backend.h"
+#include "camera_subsystem/camera/synthetic_capture_backend.h"
 #include "camera_subsystem/platform/platform_logger.h"
 
 #include <algorithm>
@@ -331,6 +337,24 @@ int main(int argc, char* argv[])
 
     camera::CameraSource camera_source;
     camera_source.SetDevicePath(device_path);
+    const std::string replay_prefix = "replay:";
+    if (device_path == "synthetic")
+    {
+        camera_source.SetCaptureBackend(std::make_shared<camera::SyntheticCaptureBackend>());
+    }
+    else if (device_path.compare(0, replay_prefix.size(), replay_prefix) == 0)
+    {
+        camera_source.SetCaptureBackend(std::make_shared<camera::FileReplayCaptureBackend>(
+            device_path.substr(replay_prefix.size())));
+    }
+    // 与发布端一致使用预缺页的大页 arena
+    core::BufferPool::Options pool_options;
+    pool_options.use_arena = true;
+    pool_options.huge_pages = true;
+    pool_options.alignment = 4096;
+    pool_options.prefault = true;
+    camera_source.SetBufferPoolOptions(pool_options);
+
     auto config = core::CameraConfig::GetDefault();
     config.fps_ = 30;
     config.buffer_count_ = 4;
@@ -0,0 +1,378 @@
+/**
+ * @file frame_broker_publish_bench.cpp
+ * @brief FrameBroker PublishFrame 发布开销微基准
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ *
+ * 用法：
+ *   ./frame_broker_publish_bench [rounds]
+ *
+ * 参数：
+ *   rounds: 每种配置执行的突发轮数，默认 2000 轮（每轮 32 帧）
+ *
+ * 测试目的：
+ * 1. 对比旧发布路径（每帧加订阅者锁、构建 vector、按 GetPriority 排序）与
+ *    RCU 快照发布路径的单帧发布开销。
+ * 2. 覆盖 1 / 4 / 16 个订阅者，以及共享队列与每订阅者环形队列两种分发模式。
+ *
+ * 测试流程：
+ * 1. 每轮连续发布 32 帧，仅统计 PublishFrame 调用耗时。
+ * 2. 三种配置均使用 2 个 Worker，轮与轮之间等待分发完毕，不计入耗时。
+ * 3. 输出每种配置的平均单帧发布耗时（ns/frame）及相对旧路径的比例。
+ *
+ * 结果判定：
+ * 1. 程序正常退出且所有帧均被分发（无丢帧）。
+ * 2. 快照路径的单帧发布耗时应低于旧路径，且随订阅者数增长更平缓。
+ */
+
+#include "camera_subsystem/broker/frame_broker.h"
+#include "camera_subsystem/platform/platform_logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace camera_subsystem;
+
+namespace
+{
+
+constexpr int kBurstFrames = 32;
+constexpr size_t kWorkerCount = 2;
+
+class BenchSubscriber : public broker::IFrameSubscriber
+{
+public:
+    BenchSubscriber(std::string name, uint8_t priority)
+        : name_(std::move(name))
+        , priority_(priority)
+    {
+    }
+
+    void OnFrame(const core::FrameHandle& /*frame*/) override
+    {
+        received_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const char* GetSubscriberName() const override
+    {
+        return name_.c_str();
+    }
+
+    uint8_t GetPriority() const override
+    {
+        return priority_;
+    }
+
+    uint64_t GetReceivedCount() const
+    {
+        return received_.load();
+    }
+
+private:
+    std::string name_;
+    uint8_t priority_;
+    std::atomic<uint64_t> received_{0};
+};
+
+/**
+ * @brief 旧版 FrameBroker 发布/分发路径的复刻，作为对比基线
+ *
+ * 每帧：加订阅者锁并清理过期 weak_ptr、构建 shared_ptr vector、按 GetPriority()
+ * 排序，再加队列锁逐个订阅者压入优先级队列并 notify_all；Worker 逻辑与旧版一致。
+ */
+class LegacyPublisher
+{
+public:
+    struct Task
+    {
+        core::FrameHandle frame;
+        std::shared_ptr<broker::IFrameSubscriber> subscriber;
+        uint8_t priority = 0;
+        uint64_t sequence = 0;
+    };
+
+    struct TaskCompare
+    {
+        bool operator()(const Task& a, const Task& b) const
+        {
+            if (a.priority != b.priority)
+            {
+                return a.priority < b.priority;
+            }
+            return a.sequence > b.sequence;
+        }
+    };
+
+    ~LegacyPublisher()
+    {
+        Stop();
+    }
+
+    void Start(size_t worker_count)
+    {
+        running_ = true;
+        for (size_t i = 0; i < worker_count; ++i)
+        {
+            workers_.emplace_back(&LegacyPublisher::WorkerLoop, this);
+        }
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            running_ = false;
+        }
+        queue_cv_.notify_all();
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+        workers_.clear();
+    }
+
+    void Subscribe(const std::shared_ptr<broker::IFrameSubscriber>& subscriber)
+    {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        subscribers_.push_back(subscriber);
+    }
+
+    void PublishFrame(const core::FrameHandle& frame)
+    {
+        std::vector<std::shared_ptr<broker::IFrameSubscriber>> subscribers;
+        {
+            std::lock_guard<std::mutex> lock(subscribers_mutex_);
+            subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
+                                              [](const std::weak_ptr<broker::IFrameSubscriber>& w)
+                                              { return w.expired(); }),
+                               subscribers_.end());
+            for (const auto& weak_sub : subscribers_)
+            {
+                auto sub = weak_sub.lock();
+                if (sub)
+                {
+                    subscribers.push_back(sub);
+                }
+            }
+        }
+
+        std::sort(subscribers.begin(), subscribers.end(),
+                  [](const std::shared_ptr<broker::IFrameSubscriber>& a,
+                     const std::shared_ptr<broker::IFrameSubscriber>& b)
+                  { return a->GetPriority() > b->GetPriority(); });
+
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            for (const auto& sub : subscribers)
+            {
+                Task task;
+                task.frame = frame;
+                task.subscriber = sub;
+                task.priority = sub->GetPriority();
+                task.sequence = sequence_++;
+                queue_.push(std::move(task));
+            }
+        }
+        queue_cv_.notify_all();
+    }
+
+private:
+    void WorkerLoop()
+    {
+        while (true)
+        {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex_);
+                queue_cv_.wait(lock, [&]() { return !queue_.empty() || !running_; });
+                if (!running_ && queue_.empty())
+                {
+                    return;
+                }
+                task = std::move(const_cast<Task&>(queue_.top()));
+                queue_.pop();
+            }
+            task.subscriber->OnFrame(task.frame);
+        }
+    }
+
+    std::condition_variable queue_cv_;
+    std::vector<std::thread> workers_;
+    bool running_ = false;
+    std::mutex subscribers_mutex_;
+    std::vector<std::weak_ptr<broker::IFrameSubscriber>> subscribers_;
+    std::mutex queue_mutex_;
+    std::priority_queue<Task, std::vector<Task>, TaskCompare> queue_;
+    uint64_t sequence_ = 0;
+};
+
+core::FrameHandle BuildTestFrame(uint32_t frame_id)
+{
+    core::FrameHandle frame;
+    frame.Reset();
+    frame.frame_id_ = frame_id;
+    frame.width_ = 1920;
+    frame.height_ = 1080;
+    frame.format_ = core::PixelFormat::kNV12;
+    frame.buffer_size_ = 1920 * 1080 * 3 / 2;
+    return frame;
+}
+
+std::vector<std::shared_ptr<BenchSubscriber>> MakeSubscribers(int count)
+{
+    std::vector<std::shared_ptr<BenchSubscriber>> subscribers;
+    for (int i = 0; i < count; ++i)
+    {
+        subscribers.push_back(std::make_shared<BenchSubscriber>(
+            "bench_" + std::to_string(i), static_cast<uint8_t>(64 + (i * 37) % 128)));
+    }
+    return subscribers;
+}
+
+bool WaitDelivered(const std::vector<std::shared_ptr<BenchSubscriber>>& subscribers,
+                   uint64_t expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::any_of(subscribers.begin(), subscribers.end(),
+                       [&](const std::shared_ptr<BenchSubscriber>& sub)
+                       { return sub->GetReceivedCount() < expected; }))
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+bool RunLegacy(int subscriber_count, int rounds, double* ns_per_frame)
+{
+    auto subscribers = MakeSubscribers(subscriber_count);
+    LegacyPublisher publisher;
+    publisher.Start(kWorkerCount);
+    for (const auto& sub : subscribers)
+    {
+        publisher.Subscribe(sub);
+    }
+
+    uint32_t frame_id = 0;
+    std::chrono::nanoseconds total(0);
+    for (int round = 0; round < rounds; ++round)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < kBurstFrames; ++i)
+        {
+            publisher.PublishFrame(BuildTestFrame(frame_id++));
+        }
+        total += std::chrono::steady_clock::now() - begin;
+
+        if (!WaitDelivered(subscribers, frame_id))
+        {
+            return false;
+        }
+    }
+
+    publisher.Stop();
+    *ns_per_frame = static_cast<double>(total.count()) / frame_id;
+    return true;
+}
+
+bool RunBroker(broker::FrameBroker::DispatchMode mode, int subscriber_count, int rounds,
+               double* ns_per_frame)
+{
+    auto subscribers = MakeSubscribers(subscriber_count);
+    broker::FrameBroker broker;
+    broker.SetDispatchMode(mode);
+    broker.SetMaxQueueSize(static_cast<size_t>(kBurstFrames) * subscriber_count * 2);
+    broker.SetSubscriberQueueCapacity(kBurstFrames * 2);
+    broker.Start(kWorkerCount);
+    for (const auto& sub : subscribers)
+    {
+        broker.Subscribe(sub);
+    }
+
+    uint32_t frame_id = 0;
+    std::chrono::nanoseconds total(0);
+    for (int round = 0; round < rounds; ++round)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < kBurstFrames; ++i)
+        {
+            broker.PublishFrame(BuildTestFrame(frame_id++));
+        }
+        total += std::chrono::steady_clock::now() - begin;
+
+        if (!WaitDelivered(subscribers, frame_id))
+        {
+            broker.Stop();
+            return false;
+        }
+    }
+
+    const auto stats = broker.GetStats();
+    broker.Stop();
+    *ns_per_frame = static_cast<double>(total.count()) / frame_id;
+    return stats.dropped_tasks == 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (!platform::PlatformLogger::Initialize(std::string(), core::LogLevel::kInfo))
+    {
+        return 1;
+    }
+
+    int rounds = 2000;
+    if (argc > 1)
+    {
+        rounds = std::max(1, std::atoi(argv[1]));
+    }
+
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "publish_bench",
+                                  "FrameBroker publish bench start, rounds=%d, burst=%d", rounds,
+                                  kBurstFrames);
+
+    bool ok = true;
+    for (int subscriber_count : {1, 4, 16})
+    {
+        double legacy_ns = 0.0;
+        double shared_ns = 0.0;
+        double ring_ns = 0.0;
+        const bool legacy_ok = RunLegacy(subscriber_count, rounds, &legacy_ns);
+        const bool shared_ok = RunBroker(broker::FrameBroker::DispatchMode::kSharedQueue,
+                                         subscriber_count, rounds, &shared_ns);
+        const bool ring_ok = RunBroker(broker::FrameBroker::DispatchMode::kPerSubscriberRing,
+                                       subscriber_count, rounds, &ring_ns);
+        ok = ok && legacy_ok && shared_ok && ring_ok;
+
+        platform::PlatformLogger::Log(
+            core::LogLevel::kInfo,
+            "publish_bench",
+            "subscribers=%2d legacy=%8.1f ns/frame shared=%8.1f ns/frame (%.2fx) "
+            "ring=%8.1f ns/frame (%.2fx)%s",
+            subscriber_count,
+            legacy_ns,
+            shared_ns,
+            shared_ns > 0.0 ? legacy_ns / shared_ns : 0.0,
+            ring_ns,
+            ring_ns > 0.0 ? legacy_ns / ring_ns : 0.0,
+            (legacy_ok && shared_ok && ring_ok) ? "" : " [incomplete]"
+        );
+    }
+
+    platform::PlatformLogger::Shutdown();
+    return ok ? 0 : 1;
+}
@@ -5,10 +5,14 @@
  * @date 2026-01-31
  *
  * 用法：
- *   ./frame_broker_stress_test [duration_seconds]
+ *   ./frame_broker_stress_test [duration_seconds] [shared|ring|groups] [publish_interval_us]
  *
  * 参数：
  *   duration_seconds: 压测时长（秒），默认 5 秒
+ *   dispatch_mode: shared 为共享优先级队列（默认），ring 为每订阅者无锁环形队列，
+ *                  groups 为环形队列 + 大小核线程组（编码订阅者绑定高编号核并尝试
+ *                  SCHED_FIFO，预览订阅者绑定低编号核）
+ *   publish_interval_us: 两帧之间的发布间隔（微秒），默认 0 表示满速发布
  *
  * 测试目的：
  * 1. 验证 FrameBroker 在多订阅者下的并发分发稳定性。
@@ -25,6 +29,9 @@
  * 1. 程序在限定时长内可正常退出且无异常崩溃。
  * 2. published/dispatched 指标单调增长，queue 受上限控制。
  * 3. 订阅者接收计数与 Broker 统计结果趋势一致。
+ * 4. 汇总输出每个订阅者的队列深度、丢弃数与竞争计数，以及每个 Worker 的
+ *    分发/窃取计数。
+ * 5. 按订阅者类别（encode/preview）输出发布到回调的 p50/p99 分发延迟。
  */
 
 #include "camera_subsystem/broker/frame_broker.h"
@@ -51,6 +58,13 @@ void SignalHandler(int signal)
     g_running_.store(false);
 }
 
+uint64_t NowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
 class StressSubscriber : public broker::IFrameSubscriber
 {
 public:
@@ -58,12 +72,15 @@ public:
         : name_(std::move(name))
         , priority_(priority)
         , received_count_(0)
+        , latency_samples_(kMaxLatencySamples, 0)
     {
     }
 
-    void OnFrame(const core::FrameHandle& /*frame*/) override
+    void OnFrame(const core::FrameHandle& frame) override
     {
-        received_count_.fetch_add(1);
+        const uint64_t count = received_count_.fetch_add(1);
+        // 环形保留最近的延迟样本（发布时刻 -> 回调开始）
+        latency_samples_[count % kMaxLatencySamples] = NowNs() - frame.timestamp_ns_;
     }
 
     const char* GetSubscriberName() const override
@@ -81,12 +98,50 @@ public:
         return received_count_.load();
     }
 
+    void AppendLatencySamples(std::vector<uint64_t>* out) const
+    {
+        const size_t count =
+            static_cast<size_t>(std::min<uint64_t>(received_count_.load(), kMaxLatencySamples));
+        out->insert(out->end(), latency_samples_.begin(), latency_samples_.begin() + count);
+    }
+
 private:
+    static constexpr size_t kMaxLatencySamples = 1 << 16;
+
     std::string name_;
     uint8_t priority_;
     std::atomic<uint64_t> received_count_;
+    std::vector<uint64_t> latency_samples_;
 };
 
+void ReportLatency(const char* label, std::vector<uint64_t> samples)
+{
+    if (samples.empty())
+    {
+        platform::PlatformLogger::Log(core::LogLevel::kInfo, "broker_stress",
+                                      "latency[%s]: no samples", label);
+        return;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const auto percentile = [&](double p)
+    { return samples[static_cast<size_t>(p * static_cast<double>(samples.size() - 1))]; };
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "broker_stress",
+                                  "latency[%s]: samples=%zu p50=%.1fus p99=%.1fus max=%.1fus",
+                                  label, samples.size(), percentile(0.50) / 1000.0,
+                                  percentile(0.99) / 1000.0, samples.back() / 1000.0);
+}
+
+std::vector<int> CpuRange(int first, int last)
+{
+    std::vector<int> cpus;
+    for (int cpu = first; cpu < last; ++cpu)
+    {
+        cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
 core::FrameHandle BuildTestFrame(uint32_t frame_id)
 {
     core::FrameHandle frame;
@@ -123,24 +178,68 @@ int main(int argc, char* argv[])
         duration_seconds = std::max(1, std::atoi(argv[1]));
     }
 
+    const std::string mode_name = argc > 2 ? argv[2] : "shared";
+    const bool groups_mode = mode_name == "groups";
+    auto dispatch_mode = broker::FrameBroker::DispatchMode::kSharedQueue;
+    if (mode_name == "ring" || groups_mode)
+    {
+        dispatch_mode = broker::FrameBroker::DispatchMode::kPerSubscriberRing;
+    }
+
+    int publish_interval_us = 0;
+    if (argc > 3)
+    {
+        publish_interval_us = std::max(0, std::atoi(argv[3]));
+    }
+
     const int kSubscriberCount = 8;
+    const int kEncodeSubscriberCount = 4;
     const int kWorkerCount = 4;
+    const uint8_t kEncodePriorityThreshold = 192;
 
     platform::PlatformLogger::Log(core::LogLevel::kInfo, "broker_stress",
-                                  "FrameBroker stress test start, duration=%ds, subscribers=%d",
-                                  duration_seconds, kSubscriberCount);
+                                  "FrameBroker stress test start, duration=%ds, subscribers=%d, "
+                                  "mode=%s, interval=%dus",
+                                  duration_seconds, kSubscriberCount, mode_name.c_str(),
+                                  publish_interval_us);
 
     broker::FrameBroker broker;
+    broker.SetDispatchMode(dispatch_mode);
     broker.SetMaxQueueSize(4096);
+    broker.SetSubscriberQueueCapacity(512);
+
+    if (groups_mode)
+    {
+        // 高编号核视为大核（如 RK3576 的 A72），低编号核视为小核（A53）
+        const int cpu_count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        const int split = std::max(1, cpu_count / 2);
+
+        broker::FrameBroker::WorkerGroupConfig encode_group;
+        encode_group.name = "encode";
+        encode_group.worker_count = kWorkerCount / 2;
+        encode_group.cpu_ids = cpu_count > 1 ? CpuRange(split, cpu_count) : CpuRange(0, 1);
+        encode_group.realtime_priority = 10;
+        encode_group.min_subscriber_priority = kEncodePriorityThreshold;
+
+        broker::FrameBroker::WorkerGroupConfig preview_group;
+        preview_group.name = "preview";
+        preview_group.worker_count = kWorkerCount / 2;
+        preview_group.cpu_ids = CpuRange(0, split);
+        preview_group.min_subscriber_priority = 0;
+
+        broker.SetWorkerGroups({encode_group, preview_group});
+    }
     broker.Start(kWorkerCount);
 
+    // 前半为编码路径订阅者（高优先级），后半为预览/分析订阅者
     std::vector<std::shared_ptr<StressSubscriber>> subscribers;
     subscribers.reserve(kSubscriberCount);
     for (int i = 0; i < kSubscriberCount; ++i)
     {
+        const bool encode = i < kEncodeSubscriberCount;
         auto subscriber = std::make_shared<StressSubscriber>(
-            "subscriber_" + std::to_string(i),
-            static_cast<uint8_t>(128 + i)
+            (encode ? "encode_" : "preview_") + std::to_string(i),
+            static_cast<uint8_t>(encode ? kEncodePriorityThreshold + 8 + i : 64 + i)
         );
         broker.Subscribe(subscriber);
         subscribers.push_back(subscriber);
@@ -158,7 +257,13 @@ int main(int argc, char* argv[])
             break;
         }
 
-        broker.PublishFrame(BuildTestFrame(frame_id++));
+        core::FrameHandle frame = BuildTestFrame(frame_id++);
+        frame.timestamp_ns_ = NowNs();
+        broker.PublishFrame(frame);
+        if (publish_interval_us > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(publish_interval_us));
+        }
 
         auto since_report = std::chrono::steady_clock::now() - last_report;
         if (std::chrono::duration_cast<std::chrono::seconds>(since_report).count() >= 1)
@@ -189,12 +294,63 @@ int main(int argc, char* argv[])
     platform::PlatformLogger::Log(
         core::LogLevel::kInfo,
         "broker_stress",
-        "Summary: published=%lu dispatched=%lu dropped=%lu received=%lu",
+        "Summary: published=%lu dispatched=%lu dropped=%lu expired=%lu received=%lu",
         final_stats.published_frames,
         final_stats.dispatched_tasks,
         final_stats.dropped_tasks,
+        final_stats.expired_tasks,
         total_received
     );
+    platform::PlatformLogger::Log(core::LogLevel::kInfo, "broker_stress",
+                                  "queue_lock_contention=%lu",
+                                  final_stats.queue_lock_contention);
+    for (const auto& sub : final_stats.subscribers)
+    {
+        platform::PlatformLogger::Log(
+            core::LogLevel::kInfo,
+            "broker_stress",
+            "  %s prio=%u enqueued=%lu dispatched=%lu dropped=%lu expired=%lu depth=%zu/%zu "
+            "enqueue_contention=%lu dispatch_contention=%lu",
+            sub.name.c_str(),
+            static_cast<unsigned>(sub.priority),
+            sub.enqueued,
+            sub.dispatched,
+            sub.dropped,
+            sub.expired,
+            sub.queue_depth,
+            sub.queue_capacity,
+            sub.enqueue_contention,
+            sub.dispatch_contention
+        );
+    }
+    for (const auto& worker : final_stats.workers)
+    {
+        platform::PlatformLogger::Log(
+            core::LogLevel::kInfo,
+            "broker_stress",
+            "  worker %s group=%s dispatched=%lu stolen=%lu wakeups=%lu affinity=%s fifo=%s",
+            worker.name.c_str(),
+            worker.group.c_str(),
+            worker.dispatched,
+            worker.stolen,
+            worker.wakeups,
+            worker.affinity_applied ? "yes" : "no",
+            worker.realtime_applied ? "yes" : "no"
+        );
+    }
+
+    std::vector<uint64_t> encode_samples;
+    std::vector<uint64_t> preview_samples;
+    for (int i = 0; i < kSubscriberCount; ++i)
+    {
+        subscribers[i]->AppendLatencySamples(i < kEncodeSubscriberCount ? &encode_samples
+                                                                        : &preview_samples);
+    }
+    std::vector<uint64_t> all_samples(encode_samples);
+    all_samples.insert(all_samples.end(), preview_samples.begin(), preview_samples.end());
+    ReportLatency("encode", std::move(encode_samples));
+    ReportLatency("preview", std::move(preview_samples));
+    ReportLatency("all", std::move(all_samples));
 
     platform::PlatformLogger::Shutdown();
     return 0;
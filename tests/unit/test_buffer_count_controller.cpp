@@ -0,0 +1,77 @@
+#include "camera_subsystem/core/buffer_count_controller.h"
+
+#include <gtest/gtest.h>
+
+using namespace camera_subsystem::core;
+
+namespace
+{
+
+BufferCountController::Window MakeWindow(uint32_t buffer_count, uint64_t hold_p99_ms)
+{
+    BufferCountController::Window window;
+    window.buffer_count = buffer_count;
+    window.frame_interval_ns = 33000000ULL;
+    window.leases = 30;
+    window.lease_hold_p99_ns = hold_p99_ms * 1000000ULL;
+    window.min_queued = 2;
+    return window;
+}
+
+} // namespace
+
+TEST(BufferCountControllerTest, EstimateCoversHoldTime)
+{
+    BufferCountController controller;
+    // 持有 1 帧以内：headroom(2) + 在分发(1) + 1
+    EXPECT_EQ(controller.EstimateNeeded(MakeWindow(4, 10)), 4u);
+    // 持有 100ms ≈ 4 帧
+    EXPECT_EQ(controller.EstimateNeeded(MakeWindow(4, 100)), 7u);
+
+    auto idle = MakeWindow(4, 100);
+    idle.leases = 0;
+    EXPECT_EQ(controller.EstimateNeeded(idle), 3u);
+}
+
+TEST(BufferCountControllerTest, GrowsImmediatelyAndClampsToMax)
+{
+    BufferCountController controller;
+    EXPECT_EQ(controller.Update(MakeWindow(4, 100)), 7u);
+    EXPECT_EQ(controller.Update(MakeWindow(4, 1000)), 8u);
+}
+
+TEST(BufferCountControllerTest, UnderrunGrowsByAtLeastOne)
+{
+    BufferCountController controller;
+    auto window = MakeWindow(4, 10);
+    window.min_queued = 0;
+    EXPECT_EQ(controller.Update(window), 5u);
+
+    window = MakeWindow(5, 10);
+    window.lease_exhausted = 3;
+    EXPECT_EQ(controller.Update(window), 6u);
+}
+
+TEST(BufferCountControllerTest, ShrinksOnlyAfterConsecutiveSurplusWindows)
+{
+    BufferCountController::Options options;
+    options.shrink_after_windows = 3;
+    BufferCountController controller(options);
+
+    EXPECT_EQ(controller.Update(MakeWindow(8, 10)), 8u);
+    EXPECT_EQ(controller.Update(MakeWindow(8, 10)), 8u);
+    // 中途一个吃紧的窗口重置计数
+    EXPECT_EQ(controller.Update(MakeWindow(8, 200)), 8u);
+    EXPECT_EQ(controller.Update(MakeWindow(8, 10)), 8u);
+    EXPECT_EQ(controller.Update(MakeWindow(8, 10)), 8u);
+    EXPECT_EQ(controller.Update(MakeWindow(8, 10)), 4u);
+}
+
+TEST(BufferCountControllerTest, RespectsMinimum)
+{
+    BufferCountController::Options options;
+    options.min_buffers = 6;
+    options.shrink_after_windows = 1;
+    BufferCountController controller(options);
+    EXPECT_EQ(controller.Update(MakeWindow(8, 1)), 6u);
+}
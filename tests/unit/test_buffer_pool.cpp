@@ -8,17 +8,34 @@
  * 1. 验证 BufferPool 初始化、获取、归还与复用逻辑。
  * 2. 验证统计计数器（acquire/release/fail）与状态计数一致性。
  * 3. 验证 InFlight 状态转换及泄漏检查行为。
+ * 4. 验证多线程并发 Acquire/归还时 Buffer 独占且统计最终一致。
+ * 5. 验证 arena 后端的槽位对齐、连续布局与后端类型上报。
+ * 6. 验证共享 memfd 后端的封印与跨映射可见性。
+ * 7. 验证弹性多档位模式的档位选择、按需增长、上限约束与空闲收缩。
  *
  * 测试流程：
  * 1. 初始化不同规模的 BufferPool 并执行连续 Acquire。
  * 2. 触发池耗尽场景，校验返回空指针与失败计数增长。
  * 3. 释放后再次 Acquire，验证 Buffer ID 复用。
  * 4. 执行 MarkInFlight 与 CheckLeaks，校验状态机与统计输出。
+ * 5. 多线程循环 Acquire -> MarkInFlight -> 归还，校验同一 Buffer 不会被同时持有。
+ * 6. 以 arena 选项初始化，校验每个槽位按页对齐、可读写且 Stats 报告 arena 后端。
+ * 7. 以 shareable 选项初始化，经独立只读映射读取槽位数据并校验尺寸封印。
+ * 8. 以弹性模式初始化，按 size_hint 获取并校验档位、增长计数、总字节上限与 TrimIdle。
  */
 
 #include <gtest/gtest.h>
 #include "camera_subsystem/core/buffer_guard.h"
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
 using namespace camera_subsystem::core;
 
 TEST(BufferPoolTest, InitializeAndAcquire)
@@ -122,3 +139,278 @@ TEST(BufferPoolTest, InFlightStateAndLeakCheck)
     EXPECT_EQ(stats.in_flight, 0u);
     EXPECT_EQ(stats.available, 2u);
 }
+
+TEST(BufferPoolTest, ConcurrentAcquireRelease)
+{
+    constexpr size_t kBufferCount = 8;
+    constexpr int kThreads = 4;
+    constexpr int kIterations = 20000;
+
+    BufferPool pool;
+    ASSERT_TRUE(pool.Initialize(kBufferCount, 64));
+
+    std::vector<std::atomic<bool>> owned(kBufferCount);
+    for (auto& flag : owned)
+    {
+        flag.store(false);
+    }
+    std::atomic<int> double_owned{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < kIterations; ++i)
+            {
+                auto buffer = pool.Acquire();
+                if (!buffer)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (owned[buffer->Id()].exchange(true))
+                {
+                    double_owned.fetch_add(1);
+                }
+                buffer->MarkInFlight();
+                owned[buffer->Id()].store(false);
+                buffer.reset();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(double_owned.load(), 0);
+    const auto stats = pool.GetStats();
+    EXPECT_EQ(stats.available, kBufferCount);
+    EXPECT_EQ(stats.in_use, 0u);
+    EXPECT_EQ(stats.in_flight, 0u);
+    EXPECT_EQ(stats.acquire_count, static_cast<uint64_t>(kThreads) * kIterations);
+    EXPECT_EQ(stats.acquire_count, stats.release_count + stats.acquire_fail);
+    EXPECT_LE(stats.max_in_flight, kBufferCount);
+    EXPECT_TRUE(pool.CheckLeaks().empty());
+}
+
+TEST(BufferPoolTest, HeapBackingByDefault)
+{
+    BufferPool pool;
+    ASSERT_TRUE(pool.Initialize(2, 1000));
+
+    const auto stats = pool.GetStats();
+    EXPECT_EQ(stats.backing, BufferBacking::kHeap);
+    EXPECT_EQ(stats.arena_bytes, 0u);
+    EXPECT_FALSE(stats.memory_locked);
+}
+
+TEST(BufferPoolTest, ArenaBackingAlignsSlots)
+{
+    constexpr size_t kBufferCount = 4;
+    constexpr size_t kBufferSize = 1000;
+
+    BufferPool::Options options;
+    options.use_arena = true;
+    options.alignment = 4096;
+    options.prefault = true;
+    options.lock_memory = true;  // 无权限时仅告警，不影响初始化
+
+    BufferPool pool;
+    ASSERT_TRUE(pool.Initialize(kBufferCount, kBufferSize, options));
+
+    const auto stats = pool.GetStats();
+    EXPECT_NE(stats.backing, BufferBacking::kHeap);
+    EXPECT_EQ(stats.slot_stride, 4096u);
+    EXPECT_GE(stats.arena_bytes, kBufferCount * stats.slot_stride);
+
+    std::vector<std::shared_ptr<BufferGuard>> guards;
+    for (size_t i = 0; i < kBufferCount; ++i)
+    {
+        auto guard = pool.Acquire();
+        ASSERT_NE(guard, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(guard->Data()) % 4096, 0u);
+        EXPECT_EQ(guard->Size(), kBufferSize);
+        std::memset(guard->Data(), static_cast<int>(guard->Id() + 1), guard->Size());
+        guards.push_back(guard);
+    }
+
+    // 槽位连续排布：相邻 ID 的起始地址相差 slot_stride
+    for (const auto& guard : guards)
+    {
+        EXPECT_EQ(guard->Data()[kBufferSize - 1], static_cast<uint8_t>(guard->Id() + 1));
+        const uint8_t* base = guard->Data() - guard->Id() * stats.slot_stride;
+        EXPECT_EQ(base, guards[0]->Data() - guards[0]->Id() * stats.slot_stride);
+    }
+
+    guards.clear();
+    EXPECT_EQ(pool.GetStats().available, kBufferCount);
+
+    pool.Clear();
+    EXPECT_EQ(pool.GetStats().backing, BufferBacking::kHeap);
+}
+
+TEST(BufferPoolTest, ShareableMemfdBackingIsSealedAndVisibleThroughFd)
+{
+    constexpr size_t kBufferCount = 3;
+    constexpr size_t kBufferSize = 5000;
+
+    BufferPool::Options options;
+    options.shareable = true;
+
+    BufferPool pool;
+    ASSERT_TRUE(pool.Initialize(kBufferCount, kBufferSize, options));
+
+    const auto stats = pool.GetStats();
+    ASSERT_EQ(stats.backing, BufferBacking::kMemfd);
+    EXPECT_EQ(stats.slot_stride % static_cast<size_t>(sysconf(_SC_PAGESIZE)), 0u);
+    EXPECT_EQ(stats.arena_bytes, kBufferCount * stats.slot_stride);
+
+    const int fd = pool.GetShareFd();
+    ASSERT_GE(fd, 0);
+    const int seals = fcntl(fd, F_GET_SEALS);
+    EXPECT_NE(seals & F_SEAL_SHRINK, 0);
+    EXPECT_NE(seals & F_SEAL_GROW, 0);
+    EXPECT_NE(seals & F_SEAL_SEAL, 0);
+
+    void* mapped = mmap(nullptr, stats.arena_bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ASSERT_NE(mapped, MAP_FAILED);
+
+    auto guard = pool.Acquire();
+    ASSERT_NE(guard, nullptr);
+    std::memset(guard->Data(), 0x3c, guard->Size());
+    const uint8_t* view = static_cast<const uint8_t*>(mapped) + pool.GetSlotOffset(guard->Id());
+    EXPECT_EQ(view[0], 0x3c);
+    EXPECT_EQ(view[kBufferSize - 1], 0x3c);
+
+    munmap(mapped, stats.arena_bytes);
+    guard.reset();
+    pool.Clear();
+    EXPECT_EQ(pool.GetShareFd(), -1);
+}
+
+TEST(BufferPoolTest, ElasticAcquirePicksSmallestFittingClass)
+{
+    BufferPool::ElasticOptions options;
+    options.class_sizes = BufferPool::MakeSizeClasses(1024, 8192);
+    options.max_buffers_per_class = 2;
+
+    BufferPool pool;
+    ASSERT_TRUE(pool.InitializeElastic(options));
+    EXPECT_EQ(options.class_sizes, (std::vector<size_t>{1024, 2048, 4096, 8192}));
+
+    // 初始未分配任何 Buffer
+    auto stats = pool.GetStats();
+    EXPECT_EQ(stats.total, 0u);
+    EXPECT_EQ(stats.allocated_bytes, 0u);
+    ASSERT_EQ(stats.size_classes.size(), 4u);
+
+    auto small = pool.Acquire(100);
+    auto medium = pool.Acquire(3000);
+    auto exact = pool.Acquire(8192);
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE(medium, nullptr);
+    ASSERT_NE(exact, nullptr);
+    EXPECT_EQ(small->Size(), 1024u);
+    EXPECT_EQ(medium->Size(), 4096u);
+    EXPECT_EQ(exact->Size(), 8192u);
+    std::memset(exact->Data(), 0x11, exact->Size());
+    EXPECT_EQ(pool.Acquire(8193), nullptr);
+
+    stats = pool.GetStats();
+    EXPECT_EQ(stats.total, 3u);
+    EXPECT_EQ(stats.in_use, 3u);
+    EXPECT_EQ(stats.allocated_bytes, 1024u + 4096u + 8192u);
+    EXPECT_EQ(stats.size_classes[2].grow_count, 1u);
+
+    // 归还后复用同一 Buffer，不再增长
+    const uint32_t medium_id = medium->Id();
+    medium.reset();
+    auto again = pool.Acquire(4000);
+    ASSERT_NE(again, nullptr);
+    EXPECT_EQ(again->Id(), medium_id);
+    EXPECT_EQ(pool.GetStats().size_classes[2].grow_count, 1u);
+}
+
+TEST(BufferPoolTest, ElasticGrowthRespectsCapsAndFallsBackToLargerClass)
+{
+    BufferPool::ElasticOptions options;
+    options.class_sizes = {1024, 4096};
+    options.max_buffers_per_class = 2;
+    options.max_total_bytes = 1024 * 2 + 4096;
+
+    BufferPool pool;
+    ASSERT_TRUE(pool.InitializeElastic(options));
+
+    std::vector<std::shared_ptr<BufferGuard>> guards;
+    for (int i = 0; i < 2; ++i)
+    {
+        guards.push_back(pool.Acquire(512));
+        ASSERT_NE(guards.back(), nullptr);
+        EXPECT_EQ(guards.back()->Size(), 1024u);
+    }
+
+    // 小档位已达数量上限，回退到更大档位
+    guards.push_back(pool.Acquire(512));
+    ASSERT_NE(guards.back(), nullptr);
+    EXPECT_EQ(guards.back()->Size(), 4096u);
+
+    // 总字节上限已用尽
+    EXPECT_EQ(pool.Acquire(512), nullptr);
+    EXPECT_EQ(pool.Acquire(4096), nullptr);
+
+    const auto stats = pool.GetStats();
+    EXPECT_EQ(stats.allocated_bytes, options.max_total_bytes);
+    EXPECT_EQ(stats.acquire_fail, 2u);
+
+    guards.clear();
+    EXPECT_EQ(pool.GetStats().available, 3u);
+    EXPECT_TRUE(pool.CheckLeaks().empty());
+}
+
+TEST(BufferPoolTest, ElasticTrimIdleReleasesBuffersUnusedForAWindow)
+{
+    BufferPool::ElasticOptions options;
+    options.class_sizes = {1024};
+    options.max_buffers_per_class = 8;
+    options.min_buffers_per_class = 1;
+    options.idle_trim_ns = 0;
+
+    BufferPool pool;
+    ASSERT_TRUE(pool.InitializeElastic(options));
+    EXPECT_EQ(pool.GetStats().total, 1u);
+
+    {
+        std::vector<std::shared_ptr<BufferGuard>> burst;
+        for (int i = 0; i < 8; ++i)
+        {
+            burst.push_back(pool.Acquire(1024));
+            ASSERT_NE(burst.back(), nullptr);
+        }
+    }
+    EXPECT_EQ(pool.GetStats().total, 8u);
+
+    // 第一个窗口内发生过增长（低水位为 0），不收缩；之后只使用 1 个 Buffer
+    EXPECT_EQ(pool.TrimIdle(), 0u);
+    for (int round = 0; round < 4; ++round)
+    {
+        auto guard = pool.Acquire(1024);
+        ASSERT_NE(guard, nullptr);
+        guard.reset();
+        pool.TrimIdle();
+    }
+
+    const auto stats = pool.GetStats();
+    EXPECT_LT(stats.total, 8u);
+    EXPECT_GE(stats.total, 1u);
+    EXPECT_EQ(stats.allocated_bytes, stats.total * 1024u);
+    EXPECT_GT(stats.size_classes[0].trim_count, 0u);
+
+    // 收缩后仍可再次增长
+    std::vector<std::shared_ptr<BufferGuard>> burst;
+    for (int i = 0; i < 8; ++i)
+    {
+        burst.push_back(pool.Acquire(1024));
+        ASSERT_NE(burst.back(), nullptr);
+    }
+}
@@ -196,6 +196,13 @@ TEST(CameraConfigTest, DifferentIoMethods)
     CameraConfig config_userptr(1920, 1080, PixelFormat::kNV12, 30, 4,
                                 static_cast<uint32_t>(IoMethod::kUserPtr));
     EXPECT_TRUE(config_userptr.IsValid());
+
+    CameraConfig config_import(1920, 1080, PixelFormat::kNV12, 30, 4,
+                               static_cast<uint32_t>(IoMethod::kDmaBufImport));
+    EXPECT_TRUE(config_import.IsValid());
+
+    config_import.io_method_ = static_cast<uint32_t>(IoMethod::kDmaBufImport) + 1;
+    EXPECT_FALSE(config_import.IsValid());
 }
 
 int main(int argc, char** argv)
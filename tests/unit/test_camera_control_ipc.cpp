@@ -8,6 +8,8 @@
  * 1. 验证 Unix Domain Socket 控制面请求/响应链路可用。
  * 2. 验证订阅与退订可正确驱动 CameraSessionManager 的按路启停。
  * 3. 验证客户端异常断连后，服务端可自动清理会话引用。
+ * 4. 验证订阅请求携带的帧率约定按对端 pid 记录，多个订阅取最宽松约定。
+ * 5. 验证热切换请求只接受会话成员，并把流格式原样交给发布端回调。
  *
  * 测试流程：
  * 1. 启动 CameraSessionManager，并注册唯一核心发布端。
@@ -43,6 +45,9 @@ using camera_subsystem::ipc::CameraControlResponse;
 using camera_subsystem::ipc::CameraControlServer;
 using camera_subsystem::ipc::CameraControlStatus;
 using camera_subsystem::ipc::CameraEndpoint;
+using camera_subsystem::ipc::CameraStreamFormat;
+using camera_subsystem::ipc::kCameraControlMaxCoalesceWindowMs;
+using camera_subsystem::ipc::kCameraDataPlaneFeatureV2BufferCache;
 
 namespace
 {
@@ -240,3 +245,147 @@ TEST_F(CameraControlIpcFixture, Ping)
     EXPECT_TRUE(client.Ping(&response));
     EXPECT_EQ(response.status, CameraControlStatus::kOk);
 }
+
+TEST_F(CameraControlIpcFixture, RecordsFrameRateContractByPeerPid)
+{
+    CameraControlServer::FrameRateContract contract;
+    EXPECT_FALSE(server_->GetFrameRateContract(getpid(), &contract));
+
+    CameraControlClient client;
+    ASSERT_TRUE(client.Connect(socket_path_));
+    const CameraEndpoint endpoint = MakeEndpoint(0, "/dev/video0");
+    CameraControlResponse response;
+
+    const uint64_t generation = server_->GetFrameRateContractGeneration();
+    ASSERT_TRUE(client.Subscribe("preview", CameraClientRole::kSubscriber, endpoint, &response,
+                                 15, 0));
+    EXPECT_NE(server_->GetFrameRateContractGeneration(), generation);
+    ASSERT_TRUE(server_->GetFrameRateContract(getpid(), &contract));
+    EXPECT_EQ(contract.target_fps, 15u);
+    EXPECT_EQ(contract.frame_stride, 0u);
+
+    // 同一进程再订阅一路 30fps：数据面无法区分订阅，取较宽松的 30fps
+    ASSERT_TRUE(client.Subscribe("analytics", CameraClientRole::kSubscriber, endpoint, &response,
+                                 30, 2));
+    ASSERT_TRUE(server_->GetFrameRateContract(getpid(), &contract));
+    EXPECT_EQ(contract.target_fps, 30u);
+    EXPECT_EQ(contract.frame_stride, 0u);
+
+    // 重复订阅更新约定
+    ASSERT_TRUE(client.Subscribe("preview", CameraClientRole::kSubscriber, endpoint, &response,
+                                 60, 2));
+    ASSERT_TRUE(server_->GetFrameRateContract(getpid(), &contract));
+    EXPECT_EQ(contract.target_fps, 60u);
+    EXPECT_EQ(contract.frame_stride, 2u);
+
+    ASSERT_TRUE(client.Unsubscribe("preview", CameraClientRole::kSubscriber, endpoint, &response));
+    ASSERT_TRUE(client.Unsubscribe("analytics", CameraClientRole::kSubscriber, endpoint,
+                                   &response));
+    EXPECT_FALSE(server_->GetFrameRateContract(getpid(), &contract));
+}
+
+TEST_F(CameraControlIpcFixture, MergesCoalesceWindowByPeerPid)
+{
+    CameraControlClient client;
+    ASSERT_TRUE(client.Connect(socket_path_));
+    const CameraEndpoint endpoint = MakeEndpoint(0, "/dev/video0");
+    CameraControlResponse response;
+    CameraControlServer::FrameRateContract contract;
+
+    // 超过上限按上限记录
+    ASSERT_TRUE(client.Subscribe("analytics", CameraClientRole::kSubscriber, endpoint, &response,
+                                 0, 0, 500));
+    ASSERT_TRUE(server_->GetFrameRateContract(getpid(), &contract));
+    EXPECT_EQ(contract.coalesce_window_ms, kCameraControlMaxCoalesceWindowMs);
+
+    ASSERT_TRUE(client.Subscribe("tracker", CameraClientRole::kSubscriber, endpoint, &response,
+                                 0, 0, 40));
+    ASSERT_TRUE(server_->GetFrameRateContract(getpid(), &contract));
+    EXPECT_EQ(contract.coalesce_window_ms, 40u);
+
+    // 同一进程的任一订阅要求实时，数据面连接即逐帧发送
+    ASSERT_TRUE(client.Subscribe("preview", CameraClientRole::kSubscriber, endpoint, &response));
+    ASSERT_TRUE(server_->GetFrameRateContract(getpid(), &contract));
+    EXPECT_EQ(contract.coalesce_window_ms, 0u);
+
+    ASSERT_TRUE(client.Unsubscribe("preview", CameraClientRole::kSubscriber, endpoint, &response));
+    ASSERT_TRUE(server_->GetFrameRateContract(getpid(), &contract));
+    EXPECT_EQ(contract.coalesce_window_ms, 40u);
+
+    ASSERT_TRUE(client.Unsubscribe("tracker", CameraClientRole::kSubscriber, endpoint,
+                                   &response));
+    ASSERT_TRUE(client.Unsubscribe("analytics", CameraClientRole::kSubscriber, endpoint,
+                                   &response));
+}
+
+TEST_F(CameraControlIpcFixture, DataPlaneFeaturesRequireEverySubscription)
+{
+    CameraControlClient client;
+    ASSERT_TRUE(client.Connect(socket_path_));
+    const CameraEndpoint endpoint = MakeEndpoint(0, "/dev/video0");
+    CameraControlResponse response;
+    CameraControlServer::FrameRateContract contract;
+
+    ASSERT_TRUE(client.Subscribe("analytics", CameraClientRole::kSubscriber, endpoint, &response,
+                                 0, 0, 0, kCameraDataPlaneFeatureV2BufferCache));
+    ASSERT_TRUE(server_->GetFrameRateContract(getpid(), &contract));
+    EXPECT_EQ(contract.data_plane_features, kCameraDataPlaneFeatureV2BufferCache);
+
+    // 同一进程的数据面连接只有一条，任一订阅不支持即整体关闭
+    ASSERT_TRUE(client.Subscribe("legacy", CameraClientRole::kSubscriber, endpoint, &response));
+    ASSERT_TRUE(server_->GetFrameRateContract(getpid(), &contract));
+    EXPECT_EQ(contract.data_plane_features, 0u);
+
+    ASSERT_TRUE(client.Unsubscribe("legacy", CameraClientRole::kSubscriber, endpoint, &response));
+    ASSERT_TRUE(server_->GetFrameRateContract(getpid(), &contract));
+    EXPECT_EQ(contract.data_plane_features, kCameraDataPlaneFeatureV2BufferCache);
+
+    ASSERT_TRUE(client.Unsubscribe("analytics", CameraClientRole::kSubscriber, endpoint,
+                                   &response));
+}
+
+TEST_F(CameraControlIpcFixture, ReconfigureRequiresSessionMember)
+{
+    std::vector<CameraStreamFormat> formats;
+    session_manager_->SetReconfigureCallback(
+        [&](const CameraEndpoint& endpoint, const CameraStreamFormat& format)
+        {
+            EXPECT_STREQ(endpoint.device_path, "/dev/video0");
+            std::lock_guard<std::mutex> lock(records_mutex_);
+            formats.push_back(format);
+            return format.width != 0;
+        });
+
+    CameraControlClient client;
+    ASSERT_TRUE(client.Connect(socket_path_));
+    const CameraEndpoint endpoint = MakeEndpoint(0, "/dev/video0");
+    CameraControlResponse response;
+    CameraStreamFormat format = {1920, 1080, 0, 30};
+
+    // 未订阅的客户端不能切换别人的流
+    EXPECT_FALSE(client.Reconfigure("preview", CameraClientRole::kSubscriber, endpoint, format,
+                                    &response));
+    EXPECT_EQ(response.status, CameraControlStatus::kSessionOperationFailed);
+
+    ASSERT_TRUE(client.Subscribe("preview", CameraClientRole::kSubscriber, endpoint, &response));
+    ASSERT_TRUE(client.Reconfigure("preview", CameraClientRole::kSubscriber, endpoint, format,
+                                   &response));
+    EXPECT_EQ(response.active_subscriber_count, 1u);
+
+    // 回调拒绝时返回失败，订阅不受影响
+    format.width = 0;
+    EXPECT_FALSE(client.Reconfigure("preview", CameraClientRole::kSubscriber, endpoint, format,
+                                    &response));
+    EXPECT_EQ(session_manager_->GetSubscriberCount(endpoint), 1u);
+
+    {
+        std::lock_guard<std::mutex> lock(records_mutex_);
+        ASSERT_EQ(formats.size(), 2u);
+        EXPECT_EQ(formats[0].width, 1920u);
+        EXPECT_EQ(formats[0].height, 1080u);
+        EXPECT_EQ(formats[0].fps, 30u);
+        EXPECT_EQ(start_count_, 1u);
+        EXPECT_EQ(stop_count_, 0u);
+    }
+    ASSERT_TRUE(client.Unsubscribe("preview", CameraClientRole::kSubscriber, endpoint, &response));
+}
@@ -1,3 +1,5 @@
+#include "camera_subsystem/core/buffer_guard.h"
+#include "camera_subsystem/core/buffer_pool.h"
 #include "camera_subsystem/ipc/camera_data_plane_v2.h"
 
 #include <fcntl.h>
@@ -8,10 +10,12 @@
 #include <cstring>
 #include <dirent.h>
 #include <mutex>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <thread>
 #include <unistd.h>
+#include <vector>
 
 using namespace camera_subsystem::core;
 using namespace camera_subsystem::ipc;
@@ -252,6 +256,69 @@ TEST(CameraReleaseTrackerTest, TracksDuplicateReleaseBeforeReclaim)
     EXPECT_EQ(tracker.PendingFrameCount(), 1u);
 }
 
+TEST(CameraReleaseTrackerTest, SkipsConsumerAtQuotaWithoutStarvingOthers)
+{
+    CameraReleaseTracker tracker(std::chrono::milliseconds(100));
+    tracker.SetDefaultConsumerQuota(2);
+
+    // 消费者 7 从不归还，消费者 8 每帧都归还
+    for (uint64_t frame_id = 0; frame_id < 5; ++frame_id)
+    {
+        const auto admitted = tracker.AdmitConsumers({7, 8});
+        ASSERT_FALSE(admitted.empty());
+        ASSERT_TRUE(tracker.RegisterFrame(1, frame_id, 0, admitted));
+        tracker.MarkReleased(
+            MakeCameraReleaseFrameV2(1, frame_id, 0, 8, CameraReleaseStatus::kOk, 0));
+    }
+
+    const auto consumers = tracker.GetConsumerStats();
+    ASSERT_EQ(consumers.size(), 2u);
+    EXPECT_EQ(consumers[0].consumer_id, 7u);
+    EXPECT_EQ(consumers[0].quota, 2u);
+    EXPECT_EQ(consumers[0].leases_held, 2u);
+    EXPECT_EQ(consumers[0].leases_granted, 2u);
+    EXPECT_EQ(consumers[0].skipped_frames, 3u);
+    EXPECT_EQ(consumers[1].consumer_id, 8u);
+    EXPECT_EQ(consumers[1].leases_held, 0u);
+    EXPECT_EQ(consumers[1].leases_granted, 5u);
+    EXPECT_EQ(consumers[1].releases, 5u);
+    EXPECT_EQ(consumers[1].skipped_frames, 0u);
+    EXPECT_EQ(consumers[1].hold_time.count, 5u);
+
+    // 只有被 7 持有的两帧仍未回收
+    EXPECT_EQ(tracker.PendingFrameCount(), 2u);
+}
+
+TEST(CameraReleaseTrackerTest, ReleaseAndTimeoutRestoreQuota)
+{
+    CameraReleaseTracker tracker(std::chrono::milliseconds(1));
+    tracker.SetDefaultConsumerQuota(0);
+    tracker.SetConsumerQuota(7, 1);
+
+    ASSERT_TRUE(tracker.RegisterFrame(1, 1, 0, tracker.AdmitConsumers({7})));
+    EXPECT_TRUE(tracker.AdmitConsumers({7}).empty());
+    EXPECT_EQ(tracker.AdmitConsumers({8}).size(), 1u);
+
+    tracker.MarkReleased(MakeCameraReleaseFrameV2(1, 1, 0, 7, CameraReleaseStatus::kOk, 0));
+    ASSERT_EQ(tracker.AdmitConsumers({7}).size(), 1u);
+
+    ASSERT_TRUE(tracker.RegisterFrame(1, 2, 0, {7}));
+    std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    ASSERT_EQ(tracker.ReclaimExpired().size(), 1u);
+    EXPECT_EQ(tracker.AdmitConsumers({7}).size(), 1u);
+
+    const auto consumers = tracker.GetConsumerStats();
+    ASSERT_EQ(consumers.size(), 2u);
+    EXPECT_EQ(consumers[0].quota, 1u);
+    EXPECT_EQ(consumers[0].leases_held, 0u);
+    EXPECT_EQ(consumers[0].timeouts, 1u);
+    EXPECT_EQ(consumers[0].skipped_frames, 1u);
+    EXPECT_EQ(consumers[1].quota, 0u);
+
+    tracker.ReclaimConsumerDisconnected(7);
+    EXPECT_EQ(tracker.GetConsumerStats().size(), 1u);
+}
+
 TEST(CameraReleaseServerTest, ReceivesReleaseAndEmitsReclaim)
 {
     const char* socket_path = "/tmp/camera_release_server_test.sock";
@@ -442,6 +509,63 @@ TEST(CameraReleaseServerTest, EmitsTimeoutAfterPartialRelease)
     unlink(socket_path);
 }
 
+TEST(CameraReleaseServerTest, NotifiesDisconnectAfterReclaimingConsumerFrames)
+{
+    const char* socket_path = "/tmp/camera_release_server_disconnect_test.sock";
+    unlink(socket_path);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<CameraReleaseReclaim> reclaims;
+    std::vector<uint32_t> disconnected;
+    size_t reclaims_before_disconnect = 0;
+
+    CameraReleaseServer server(std::chrono::milliseconds(1000));
+    if (!server.Start(
+            socket_path,
+            [&](const CameraReleaseReclaim& reclaim)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                reclaims.push_back(reclaim);
+                cv.notify_all();
+            },
+            [&](uint32_t consumer_id)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                reclaims_before_disconnect = reclaims.size();
+                disconnected.push_back(consumer_id);
+                cv.notify_all();
+            }))
+    {
+        GTEST_SKIP() << "Skip because unix socket bind may be denied by environment: "
+                     << socket_path;
+    }
+    ASSERT_TRUE(server.RegisterFrame(1, 24, 8, {9}));
+    ASSERT_TRUE(server.RegisterFrame(1, 25, 9, {9}));
+
+    const int client_fd = ConnectUnixSocket(socket_path);
+    ASSERT_GE(client_fd, 0);
+    ASSERT_TRUE(SendCameraReleaseFrameV2(
+        client_fd, MakeCameraReleaseFrameV2(1, 24, 8, 9, CameraReleaseStatus::kOk, 0)));
+    close(client_fd);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(1), [&]() {
+            return !disconnected.empty();
+        }));
+    }
+
+    ASSERT_EQ(disconnected.size(), 1u);
+    EXPECT_EQ(disconnected[0], 9u);
+    // 断开回调晚于该 consumer 未归还帧的回收
+    EXPECT_EQ(reclaims_before_disconnect, 2u);
+    EXPECT_EQ(server.PendingFrameCount(), 0u);
+
+    server.Stop();
+    unlink(socket_path);
+}
+
 TEST(CameraDataPlaneV2Test, SendAndReceiveDescriptorWithScmRights)
 {
     int sockets[2] = {-1, -1};
@@ -506,3 +630,222 @@ TEST(CameraDataPlaneV2Test, InvalidDescriptorWithScmRightsDoesNotLeakFd)
     close(sockets[0]);
     close(sockets[1]);
 }
+
+TEST(CameraDataPlaneV2Test, ShmPoolAnnounceThenSlotDescriptorsWithoutFds)
+{
+    BufferPool pool;
+    BufferPool::Options options;
+    options.shareable = true;
+    ASSERT_TRUE(pool.Initialize(2, 1024, options));
+    const BufferPool::Stats stats = pool.GetStats();
+    const int pool_fd = pool.GetShareFd();
+    ASSERT_GE(pool_fd, 0);
+
+    int sockets[2] = {-1, -1};
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets), 0);
+
+    const CameraDataFrameDescriptorV2 announce = MakeCameraShmPoolAnnounceV2(
+        3, static_cast<uint32_t>(stats.total), static_cast<uint32_t>(stats.slot_stride),
+        static_cast<uint32_t>(stats.arena_bytes));
+    ASSERT_TRUE(SendCameraDataFrameDescriptorV2(sockets[0], announce, &pool_fd, 1));
+
+    auto guard = pool.Acquire();
+    ASSERT_NE(guard, nullptr);
+    std::memset(guard->Data(), 0x5a, 1024);
+
+    FrameDescriptor source = MakeTestDescriptor(-1);
+    source.memory_type = MemoryType::kShm;
+    source.buffer_id = guard->Id();
+    const uint32_t slot_offset = static_cast<uint32_t>(pool.GetSlotOffset(guard->Id()));
+    const CameraDataFrameDescriptorV2 slot = MakeCameraShmSlotDescriptorV2(source, slot_offset);
+    EXPECT_TRUE(IsCameraShmSlotDescriptorV2(slot));
+    EXPECT_FALSE(SendCameraDataFrameDescriptorV2(sockets[0], slot, &pool_fd, 1));
+    ASSERT_TRUE(SendCameraDataFrameDescriptorV2(sockets[0], slot, nullptr, 0));
+
+    CameraDataFrameDescriptorV2 received;
+    int received_fds[kCameraDataV2MaxFds] = {-1, -1, -1};
+    uint32_t received_fd_count = 0;
+    ASSERT_TRUE(ReceiveCameraDataFrameDescriptorV2(
+        sockets[1], &received, received_fds, kCameraDataV2MaxFds, &received_fd_count));
+    ASSERT_EQ(received_fd_count, 1u);
+    EXPECT_NE(received.flags & kCameraDataV2FlagShmPoolAnnounce, 0u);
+    EXPECT_EQ(received.buffer_id, 2u);
+    EXPECT_EQ(received.planes[0].length, stats.arena_bytes);
+
+    const size_t pool_bytes = received.planes[0].length;
+    void* mapped = mmap(nullptr, pool_bytes, PROT_READ, MAP_SHARED, received_fds[0], 0);
+    ASSERT_NE(mapped, MAP_FAILED);
+    // 池已封印尺寸，消费者无法截断
+    EXPECT_NE(ftruncate(received_fds[0], 0), 0);
+    close(received_fds[0]);
+
+    ASSERT_TRUE(ReceiveCameraDataFrameDescriptorV2(
+        sockets[1], &received, received_fds, kCameraDataV2MaxFds, &received_fd_count));
+    EXPECT_EQ(received_fd_count, 0u);
+    EXPECT_TRUE(IsCameraShmSlotDescriptorV2(received));
+    EXPECT_EQ(received.frame_id, source.frame_id);
+    EXPECT_EQ(received.planes[0].offset, slot_offset);
+
+    const uint8_t* slot_data = static_cast<const uint8_t*>(mapped) + received.planes[0].offset;
+    EXPECT_EQ(slot_data[0], 0x5a);
+    EXPECT_EQ(slot_data[received.planes[0].bytes_used - 1], 0x5a);
+
+    munmap(mapped, pool_bytes);
+    guard.reset();
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+TEST(CameraDataPlaneV2Test, BatchSendKeepsOrderAndFdsPerMessage)
+{
+    int sockets[2] = {-1, -1};
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets), 0);
+
+    const int fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    ASSERT_GE(fd, 0);
+
+    // 超过单次 sendmmsg 的批量上限，验证分段发送
+    constexpr size_t kCount = 40;
+    std::vector<CameraDataFrameSendV2> items(kCount);
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        FrameDescriptor source = MakeTestDescriptor(fd);
+        source.frame_id = 1000 + i;
+        items[i].descriptor = MakeCameraDataFrameDescriptorV2(source);
+        items[i].fds[0] = fd;
+        items[i].fd_count = 1;
+    }
+
+    uint64_t syscalls = 0;
+    ASSERT_EQ(SendCameraDataFrameDescriptorsV2(sockets[0], items.data(), items.size(), &syscalls),
+              kCount);
+    EXPECT_EQ(syscalls, 2u);
+
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        CameraDataFrameDescriptorV2 received;
+        int received_fds[kCameraDataV2MaxFds] = {-1, -1, -1};
+        uint32_t received_fd_count = 0;
+        ASSERT_TRUE(ReceiveCameraDataFrameDescriptorV2(
+            sockets[1], &received, received_fds, kCameraDataV2MaxFds, &received_fd_count));
+        EXPECT_EQ(received.frame_id, 1000 + i);
+        ASSERT_EQ(received_fd_count, 1u);
+        EXPECT_GE(received_fds[0], 0);
+        close(received_fds[0]);
+    }
+
+    close(fd);
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+TEST(CameraDataPlaneV2Test, BatchSendStopsBeforeInvalidDescriptor)
+{
+    int sockets[2] = {-1, -1};
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets), 0);
+
+    const int fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    ASSERT_GE(fd, 0);
+
+    CameraDataFrameSendV2 items[3];
+    for (auto& item : items)
+    {
+        item.descriptor = MakeCameraDataFrameDescriptorV2(MakeTestDescriptor(fd));
+        item.fds[0] = fd;
+        item.fd_count = 1;
+    }
+    items[1].fd_count = 0;
+
+    uint64_t syscalls = 0;
+    EXPECT_EQ(SendCameraDataFrameDescriptorsV2(sockets[0], items, 3, &syscalls), 1u);
+    EXPECT_EQ(syscalls, 1u);
+    EXPECT_EQ(SendCameraDataFrameDescriptorsV2(-1, items, 3, &syscalls), 0u);
+
+    CameraDataFrameDescriptorV2 received;
+    int received_fds[kCameraDataV2MaxFds] = {-1, -1, -1};
+    uint32_t received_fd_count = 0;
+    ASSERT_TRUE(ReceiveCameraDataFrameDescriptorV2(
+        sockets[1], &received, received_fds, kCameraDataV2MaxFds, &received_fd_count));
+    close(received_fds[0]);
+    // 无效描述符及其后的消息均未发送
+    EXPECT_EQ(recv(sockets[1], &received, sizeof(received), MSG_DONTWAIT), -1);
+
+    close(fd);
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+TEST(CameraDataPlaneV2Test, RegisteredBufferIsReferencedWithoutFds)
+{
+    int sockets[2] = {-1, -1};
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets), 0);
+
+    const int fd = memfd_create("data_v2_register_test", MFD_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ftruncate(fd, 4096), 0);
+    ASSERT_EQ(pwrite(fd, "frame", 5, 0), 5);
+
+    const FrameDescriptor source = MakeTestDescriptor(fd);
+    const CameraDataFrameDescriptorV2 registration = MakeCameraBufferRegisterV2(source);
+    const CameraDataFrameDescriptorV2 cached = MakeCameraBufferCachedDescriptorV2(source);
+    EXPECT_TRUE(IsCameraBufferCachedDescriptorV2(cached));
+    EXPECT_FALSE(IsCameraBufferCachedDescriptorV2(registration));
+    ASSERT_TRUE(SendCameraDataFrameDescriptorV2(sockets[0], registration, &fd, 1));
+    EXPECT_FALSE(SendCameraDataFrameDescriptorV2(sockets[0], cached, &fd, 1));
+    ASSERT_TRUE(SendCameraDataFrameDescriptorV2(sockets[0], cached, nullptr, 0));
+    close(fd);
+
+    CameraDataV2BufferCache cache;
+    CameraDataFrameDescriptorV2 received;
+    int received_fds[kCameraDataV2MaxFds] = {-1, -1, -1};
+    uint32_t received_fd_count = 0;
+    ASSERT_TRUE(ReceiveCameraDataFrameDescriptorV2(
+        sockets[1], &received, received_fds, kCameraDataV2MaxFds, &received_fd_count));
+    ASSERT_EQ(received_fd_count, 1u);
+    ASSERT_TRUE(CameraDataV2BufferCache::Handles(received));
+    const CameraDataV2BufferCache::Buffer* registered =
+        cache.Resolve(received, received_fds, received_fd_count);
+    ASSERT_NE(registered, nullptr);
+    ASSERT_NE(registered->mapped[0], nullptr);
+    EXPECT_EQ(std::memcmp(registered->mapped[0], "frame", 5), 0);
+
+    ASSERT_TRUE(ReceiveCameraDataFrameDescriptorV2(
+        sockets[1], &received, received_fds, kCameraDataV2MaxFds, &received_fd_count));
+    EXPECT_EQ(received_fd_count, 0u);
+    EXPECT_EQ(received.fd_count, 1u);
+    const CameraDataV2BufferCache::Buffer* hit = cache.Resolve(received, nullptr, 0);
+    ASSERT_EQ(hit, registered);
+    EXPECT_EQ(hit->fd_count, 1u);
+
+    const CameraDataV2BufferCache::Stats stats = cache.GetStats();
+    EXPECT_EQ(stats.registrations, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(cache.GetBufferCount(), 1u);
+
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+TEST(CameraDataPlaneV2Test, BufferCacheDropsRegistrationsOnNewGeneration)
+{
+    const int fd = memfd_create("data_v2_generation_test", MFD_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ftruncate(fd, 4096), 0);
+
+    FrameDescriptor source = MakeTestDescriptor(fd);
+    CameraDataV2BufferCache cache;
+    const int owned_fd = dup(fd);
+    ASSERT_NE(cache.Resolve(MakeCameraBufferRegisterV2(source), &owned_fd, 1), nullptr);
+    EXPECT_EQ(cache.Resolve(MakeCameraDataFrameDescriptorV2(source), &fd, 1), nullptr);
+
+    // 重新分配后的 buffer 必须重新注册，不能沿用旧映射
+    source.stream_generation = 1;
+    EXPECT_EQ(cache.Resolve(MakeCameraBufferCachedDescriptorV2(source), nullptr, 0), nullptr);
+    EXPECT_EQ(cache.GetBufferCount(), 0u);
+    EXPECT_EQ(fcntl(owned_fd, F_GETFD), -1);
+
+    const CameraDataV2BufferCache::Stats stats = cache.GetStats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.invalidations, 1u);
+    close(fd);
+}
@@ -0,0 +1,416 @@
+/**
+ * @file test_camera_data_socket_server.cpp
+ * @brief v1 数据面服务端单元测试
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ *
+ * 测试目标：
+ * 1. 验证帧头与帧数据按入队顺序完整送达。
+ * 2. 验证客户端不读时 Enqueue 不阻塞，队列有界，按 drop-oldest / keep-latest 丢弃旧帧，
+ *    恢复读取后字节流不错位且最后一帧为最新帧。
+ * 3. 验证被丢弃和已发送的帧及时归还 BufferGuard。
+ * 4. 验证帧头与帧数据一次 sendmsg 发出；TCP 客户端的零拷贝帧在完成通知后才归还 BufferGuard。
+ * 5. 验证 DropQueuedFrames 归还排队帧与已部分发送队首帧的 BufferGuard，字节流不错位。
+ */
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include "camera_subsystem/core/buffer_pool.h"
+#include "camera_subsystem/ipc/camera_data_socket_server.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using camera_subsystem::core::BufferPool;
+using camera_subsystem::ipc::CameraDataFrameHeader;
+using camera_subsystem::ipc::CameraDataSocketServer;
+
+namespace
+{
+
+std::string MakeSocketPath(const char* name)
+{
+    return "/tmp/camera_data_server_" + std::string(name) + "_" + std::to_string(getpid()) +
+           ".sock";
+}
+
+int ConnectClient(const std::string& path)
+{
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int ConnectTcpClient(uint16_t port)
+{
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool ReadFull(int fd, void* buffer, size_t length)
+{
+    auto* out = static_cast<uint8_t*>(buffer);
+    size_t total = 0;
+    while (total < length)
+    {
+        const ssize_t n = recv(fd, out + total, length - total, 0);
+        if (n <= 0)
+        {
+            return false;
+        }
+        total += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief 等待服务端登记连接，返回其 client_id
+ */
+uint32_t WaitClient(const CameraDataSocketServer& server)
+{
+    for (int i = 0; i < 200; ++i)
+    {
+        const auto clients = server.GetClientsSnapshot();
+        if (!clients.empty())
+        {
+            return clients.front().client_id;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return 0;
+}
+
+CameraDataFrameHeader MakeHeader(uint64_t frame_id, size_t length)
+{
+    CameraDataFrameHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = camera_subsystem::ipc::kCameraDataMagic;
+    header.version = camera_subsystem::ipc::kCameraDataVersion;
+    header.frame_size = static_cast<uint32_t>(length);
+    header.frame_id = frame_id;
+    return header;
+}
+
+/**
+ * @brief 读取一帧并校验数据内容为 frame_id 的低 8 位
+ */
+bool ReadFrame(int fd, CameraDataFrameHeader* header)
+{
+    if (!ReadFull(fd, header, sizeof(*header)) ||
+        !camera_subsystem::ipc::IsCameraDataFrameHeaderValid(*header))
+    {
+        return false;
+    }
+    std::vector<uint8_t> payload(header->frame_size);
+    if (!ReadFull(fd, payload.data(), payload.size()))
+    {
+        return false;
+    }
+    for (uint8_t value : payload)
+    {
+        if (value != static_cast<uint8_t>(header->frame_id))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 客户端不读时连续入队，返回最后一帧 frame_id；同时检查 Enqueue 耗时与队列上限
+ */
+uint64_t FloodClient(CameraDataSocketServer& server, uint32_t client_id, size_t frame_count,
+                     size_t frame_size, size_t queue_limit)
+{
+    std::vector<uint8_t> payload(frame_size);
+    const auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < frame_count; ++i)
+    {
+        std::memset(payload.data(), static_cast<int>(i), payload.size());
+        EXPECT_TRUE(server.Enqueue(client_id, MakeHeader(i, payload.size()), payload.data(),
+                                   payload.size(), nullptr));
+        const auto stats = server.GetClientStats();
+        EXPECT_LE(stats.front().queued_frames, queue_limit + 1);
+    }
+    // 每次入队只做一次拷贝，远低于阻塞写的耗时
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(2));
+    return frame_count - 1;
+}
+
+} // namespace
+
+TEST(CameraDataSocketServerTest, DeliversFramesInOrder)
+{
+    const std::string path = MakeSocketPath("order");
+    CameraDataSocketServer server;
+    ASSERT_TRUE(server.Start(path));
+    const int fd = ConnectClient(path);
+    ASSERT_GE(fd, 0);
+    const uint32_t client_id = WaitClient(server);
+    ASSERT_NE(client_id, 0u);
+
+    for (uint64_t i = 0; i < 2; ++i)
+    {
+        std::vector<uint8_t> payload(4096 + i, static_cast<uint8_t>(i));
+        ASSERT_TRUE(server.Enqueue(client_id, MakeHeader(i, payload.size()), payload.data(),
+                                   payload.size(), nullptr));
+        CameraDataFrameHeader header;
+        ASSERT_TRUE(ReadFrame(fd, &header));
+        EXPECT_EQ(header.frame_id, i);
+        EXPECT_EQ(header.frame_size, 4096 + i);
+    }
+
+    EXPECT_FALSE(server.Enqueue(client_id + 100, MakeHeader(0, 1), "x", 1, nullptr));
+    const auto stats = server.GetClientStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].sent_frames, 2u);
+    EXPECT_EQ(stats[0].dropped_frames, 0u);
+    EXPECT_EQ(stats[0].send_lag.count, 2u);
+    // 帧头与数据聚合在一次 sendmsg 中
+    EXPECT_EQ(stats[0].send_calls, 2u);
+    EXPECT_FALSE(stats[0].tcp);
+    EXPECT_FALSE(stats[0].zero_copy);
+
+    close(fd);
+    for (int i = 0; i < 200 && server.GetClientCount() > 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(server.GetClientCount(), 0u);
+    EXPECT_EQ(server.GetServerStats().closed_clients, 1u);
+    server.Stop();
+}
+
+TEST(CameraDataSocketServerTest, SlowClientDropsOldestWithoutBlocking)
+{
+    const std::string path = MakeSocketPath("drop_oldest");
+    CameraDataSocketServer::Options options;
+    options.max_queued_frames = 3;
+    CameraDataSocketServer server(options);
+    ASSERT_TRUE(server.Start(path));
+    const int fd = ConnectClient(path);
+    ASSERT_GE(fd, 0);
+    const uint32_t client_id = WaitClient(server);
+    ASSERT_NE(client_id, 0u);
+
+    const uint64_t last = FloodClient(server, client_id, 64, 1 << 20, options.max_queued_frames);
+    const auto stats = server.GetClientStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_GT(stats[0].dropped_frames, 0u);
+    EXPECT_GT(stats[0].blocked_count, 0u);
+
+    // 恢复读取：帧完整、序号递增，最后一帧为最新入队的帧
+    uint64_t previous = 0;
+    bool first = true;
+    CameraDataFrameHeader header;
+    do
+    {
+        ASSERT_TRUE(ReadFrame(fd, &header));
+        EXPECT_TRUE(first || header.frame_id > previous);
+        previous = header.frame_id;
+        first = false;
+    } while (header.frame_id != last);
+
+    close(fd);
+    server.Stop();
+}
+
+TEST(CameraDataSocketServerTest, KeepLatestHoldsOnlyNewestFrame)
+{
+    const std::string path = MakeSocketPath("keep_latest");
+    CameraDataSocketServer server;
+    ASSERT_TRUE(server.Start(path));
+    const int fd = ConnectClient(path);
+    ASSERT_GE(fd, 0);
+    const uint32_t client_id = WaitClient(server);
+    ASSERT_NE(client_id, 0u);
+    ASSERT_TRUE(server.SetClientQueuePolicy(client_id,
+                                            CameraDataSocketServer::QueuePolicy::kKeepLatest, 1));
+
+    const uint64_t last = FloodClient(server, client_id, 32, 1 << 20, 1);
+    EXPECT_GT(server.GetServerStats().dropped_frames, 0u);
+
+    CameraDataFrameHeader header;
+    do
+    {
+        ASSERT_TRUE(ReadFrame(fd, &header));
+    } while (header.frame_id != last);
+
+    close(fd);
+    server.Stop();
+}
+
+TEST(CameraDataSocketServerTest, ReleasesBufferGuardsAfterSendOrDrop)
+{
+    const std::string path = MakeSocketPath("guards");
+    CameraDataSocketServer::Options options;
+    options.max_queued_frames = 1;
+    CameraDataSocketServer server(options);
+    ASSERT_TRUE(server.Start(path));
+    const int fd = ConnectClient(path);
+    ASSERT_GE(fd, 0);
+    const uint32_t client_id = WaitClient(server);
+    ASSERT_NE(client_id, 0u);
+
+    const size_t frame_size = 1 << 20;
+    BufferPool pool;
+    ASSERT_TRUE(pool.Initialize(4, frame_size));
+    for (uint64_t i = 0; i < 16; ++i)
+    {
+        auto buffer = pool.Acquire();
+        ASSERT_NE(buffer, nullptr) << "pool exhausted at frame " << i;
+        std::memset(buffer->Data(), static_cast<int>(i), frame_size);
+        ASSERT_TRUE(server.Enqueue(client_id, MakeHeader(i, frame_size), buffer->Data(),
+                                   frame_size, buffer));
+    }
+    // 至多一帧发送中 + 一帧排队
+    EXPECT_LE(pool.GetStats().in_use, 2u);
+
+    CameraDataFrameHeader header;
+    do
+    {
+        ASSERT_TRUE(ReadFrame(fd, &header));
+    } while (header.frame_id != 15);
+
+    for (int i = 0; i < 200 && pool.GetStats().in_use > 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(pool.GetStats().in_use, 0u);
+
+    close(fd);
+    server.Stop();
+}
+
+TEST(CameraDataSocketServerTest, DropQueuedFramesReleasesPinnedHead)
+{
+    const std::string path = MakeSocketPath("drop_queued");
+    CameraDataSocketServer::Options options;
+    options.max_queued_frames = 4;
+    CameraDataSocketServer server(options);
+    ASSERT_TRUE(server.Start(path));
+    const int fd = ConnectClient(path);
+    ASSERT_GE(fd, 0);
+    const uint32_t client_id = WaitClient(server);
+    ASSERT_NE(client_id, 0u);
+
+    // 客户端不读：队首帧发送到一半阻塞在 EAGAIN，其余帧排队
+    const size_t frame_size = 8 << 20;
+    BufferPool pool;
+    ASSERT_TRUE(pool.Initialize(4, frame_size));
+    for (uint64_t i = 0; i < 3; ++i)
+    {
+        auto buffer = pool.Acquire();
+        ASSERT_NE(buffer, nullptr);
+        std::memset(buffer->Data(), static_cast<int>(i), frame_size);
+        ASSERT_TRUE(server.Enqueue(client_id, MakeHeader(i, frame_size), buffer->Data(),
+                                   frame_size, buffer));
+    }
+    for (int i = 0; i < 200 && server.GetClientStats().front().blocked_count == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_GT(server.GetClientStats().front().blocked_count, 0u);
+
+    // 其他 camera 的帧不受影响
+    EXPECT_EQ(server.DropQueuedFrames(7), 0u);
+    EXPECT_EQ(server.DropQueuedFrames(0), 2u);
+    for (int i = 0; i < 200 && pool.GetStats().in_use > 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(pool.GetStats().in_use, 0u);
+
+    std::vector<uint8_t> payload(1024, 9);
+    ASSERT_TRUE(server.Enqueue(client_id, MakeHeader(9, payload.size()), payload.data(),
+                               payload.size(), nullptr));
+
+    CameraDataFrameHeader header;
+    ASSERT_TRUE(ReadFrame(fd, &header));
+    EXPECT_EQ(header.frame_id, 0u);
+    ASSERT_TRUE(ReadFrame(fd, &header));
+    EXPECT_EQ(header.frame_id, 9u);
+
+    close(fd);
+    server.Stop();
+}
+
+TEST(CameraDataSocketServerTest, TcpClientHoldsZeroCopyBuffersUntilCompletion)
+{
+    const std::string path = MakeSocketPath("tcp");
+    CameraDataSocketServer::Options options;
+    options.max_queued_frames = 4;
+    options.tcp_enabled = true;
+    CameraDataSocketServer server(options);
+    ASSERT_TRUE(server.Start(path));
+    ASSERT_NE(server.GetTcpPort(), 0);
+    const int fd = ConnectTcpClient(server.GetTcpPort());
+    ASSERT_GE(fd, 0);
+    const uint32_t client_id = WaitClient(server);
+    ASSERT_NE(client_id, 0u);
+
+    const size_t frame_size = 256 * 1024;
+    BufferPool pool;
+    ASSERT_TRUE(pool.Initialize(8, frame_size));
+    for (uint64_t i = 0; i < 4; ++i)
+    {
+        auto buffer = pool.Acquire();
+        ASSERT_NE(buffer, nullptr);
+        std::memset(buffer->Data(), static_cast<int>(i), frame_size);
+        ASSERT_TRUE(server.Enqueue(client_id, MakeHeader(i, frame_size), buffer->Data(),
+                                   frame_size, buffer));
+    }
+    for (uint64_t i = 0; i < 4; ++i)
+    {
+        CameraDataFrameHeader header;
+        ASSERT_TRUE(ReadFrame(fd, &header));
+        EXPECT_EQ(header.frame_id, i);
+    }
+
+    // 零拷贝帧等内核完成通知后归还；回环投递会退化为拷贝，此时改回普通发送
+    for (int i = 0; i < 200 && pool.GetStats().in_use > 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(pool.GetStats().in_use, 0u);
+    const auto stats = server.GetClientStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_TRUE(stats[0].tcp);
+    EXPECT_EQ(stats[0].sent_frames, 4u);
+    EXPECT_EQ(stats[0].zero_copy_inflight, 0u);
+    if (stats[0].zero_copy_copied > 0)
+    {
+        EXPECT_FALSE(stats[0].zero_copy);
+    }
+
+    close(fd);
+    server.Stop();
+    EXPECT_EQ(server.GetTcpPort(), 0);
+}
@@ -0,0 +1,388 @@
+/**
+ * @file test_camera_shm_ring.cpp
+ * @brief 共享内存帧环单元测试
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ *
+ * 测试目标：
+ * 1. 验证一帧只写一次，多个消费者按各自游标原地读到相同内容。
+ * 2. 验证落后超过环长度的消费者跳到最旧的可读帧并计入 overruns，latest_only 只取最新帧。
+ * 3. 验证被固定的槽位不会被覆盖，全部槽位被固定时发布端丢帧而不是等待。
+ * 4. 验证关闭环后消费者被唤醒并得到 kClosed。
+ * 5. 验证消费者篡改共享头部的几何参数与游标不影响发布端的槽位寻址。
+ * 6. 验证经控制面协商下发 memfd / eventfd，未订阅或未提供时拒绝，断连后归还消费者位置。
+ */
+
+#include <gtest/gtest.h>
+
+#include "camera_subsystem/camera/camera_session_manager.h"
+#include "camera_subsystem/ipc/camera_control_client.h"
+#include "camera_subsystem/ipc/camera_control_server.h"
+#include "camera_subsystem/ipc/camera_shm_ring.h"
+#include "camera_subsystem/ipc/camera_shm_ring_writer.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using camera_subsystem::camera::CameraSessionManager;
+using camera_subsystem::ipc::CameraBusType;
+using camera_subsystem::ipc::CameraClientRole;
+using camera_subsystem::ipc::CameraControlClient;
+using camera_subsystem::ipc::CameraControlResponse;
+using camera_subsystem::ipc::CameraControlServer;
+using camera_subsystem::ipc::CameraControlStatus;
+using camera_subsystem::ipc::CameraDataFrameHeader;
+using camera_subsystem::ipc::CameraEndpoint;
+using camera_subsystem::ipc::CameraShmRingReader;
+using camera_subsystem::ipc::CameraShmRingWriter;
+
+namespace
+{
+
+constexpr size_t kFrameBytes = 8192;
+
+CameraDataFrameHeader MakeHeader(uint32_t frame_id)
+{
+    CameraDataFrameHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = camera_subsystem::ipc::kCameraDataMagic;
+    header.version = camera_subsystem::ipc::kCameraDataVersion;
+    header.frame_id = frame_id;
+    header.width = 64;
+    header.height = 64;
+    return header;
+}
+
+std::vector<uint8_t> MakePayload(uint32_t frame_id)
+{
+    std::vector<uint8_t> payload(kFrameBytes);
+    for (size_t i = 0; i < payload.size(); ++i)
+    {
+        payload[i] = static_cast<uint8_t>(frame_id * 31 + i);
+    }
+    return payload;
+}
+
+bool Publish(CameraShmRingWriter& writer, uint32_t frame_id)
+{
+    const std::vector<uint8_t> payload = MakePayload(frame_id);
+    return writer.Publish(MakeHeader(frame_id), payload.data(), payload.size());
+}
+
+bool PayloadMatches(const CameraShmRingReader::Frame& frame, uint32_t frame_id)
+{
+    const std::vector<uint8_t> expected = MakePayload(frame_id);
+    return frame.size == expected.size() &&
+           std::memcmp(frame.data, expected.data(), expected.size()) == 0;
+}
+
+/// @brief 模拟消费者进程：读取器接管 dup 出的 fd
+bool AttachReader(CameraShmRingWriter& writer, CameraShmRingReader* reader, uint32_t* index)
+{
+    int eventfd = -1;
+    if (!writer.AttachConsumer(getpid(), index, &eventfd))
+    {
+        return false;
+    }
+    return reader->Open(dup(writer.GetMemFd()), dup(eventfd), *index);
+}
+
+std::string MakeUniqueSocketPath()
+{
+    const long long now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now().time_since_epoch())
+                                 .count();
+    return "/tmp/camera_shm_ring_test_" + std::to_string(getpid()) + "_" +
+           std::to_string(now_ns) + ".sock";
+}
+
+bool WaitUntil(const std::function<bool()>& predicate, std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (predicate())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return predicate();
+}
+
+} // namespace
+
+TEST(CameraShmRingTest, ConsumersReadEachFrameInPlace)
+{
+    CameraShmRingWriter writer;
+    ASSERT_TRUE(writer.Create(4, kFrameBytes, 4));
+
+    CameraShmRingReader reader_a;
+    CameraShmRingReader reader_b;
+    uint32_t index_a = 0;
+    uint32_t index_b = 0;
+    ASSERT_TRUE(AttachReader(writer, &reader_a, &index_a));
+    ASSERT_TRUE(AttachReader(writer, &reader_b, &index_b));
+    EXPECT_NE(index_a, index_b);
+    EXPECT_EQ(writer.GetConsumerCount(), 2u);
+
+    CameraShmRingReader::Frame frame;
+    EXPECT_EQ(reader_a.Acquire(&frame), CameraShmRingReader::Result::kEmpty);
+
+    for (uint32_t id = 1; id <= 3; ++id)
+    {
+        ASSERT_TRUE(Publish(writer, id));
+    }
+    EXPECT_TRUE(reader_a.WaitReadable(100));
+
+    for (CameraShmRingReader* reader : {&reader_a, &reader_b})
+    {
+        for (uint32_t id = 1; id <= 3; ++id)
+        {
+            ASSERT_EQ(reader->Acquire(&frame), CameraShmRingReader::Result::kFrame);
+            EXPECT_EQ(frame.header->frame_id, id);
+            EXPECT_EQ(frame.header->frame_size, kFrameBytes);
+            EXPECT_EQ(frame.seq, id - 1);
+            EXPECT_TRUE(PayloadMatches(frame, id));
+        }
+        EXPECT_EQ(reader->Acquire(&frame), CameraShmRingReader::Result::kEmpty);
+        EXPECT_EQ(reader->GetOverruns(), 0u);
+    }
+
+    const CameraShmRingWriter::Stats stats = writer.GetStats();
+    EXPECT_EQ(stats.published_frames, 3u);
+    EXPECT_EQ(stats.dropped_frames, 0u);
+    ASSERT_EQ(stats.consumers.size(), 2u);
+    EXPECT_EQ(stats.consumers[0].frames_read, 3u);
+    EXPECT_EQ(stats.consumers[0].lag, 0u);
+}
+
+TEST(CameraShmRingTest, SlowConsumerSkipsOverwrittenFrames)
+{
+    CameraShmRingWriter writer;
+    ASSERT_TRUE(writer.Create(4, kFrameBytes, 2));
+
+    CameraShmRingReader reader;
+    CameraShmRingReader latest;
+    uint32_t index = 0;
+    uint32_t latest_index = 0;
+    ASSERT_TRUE(AttachReader(writer, &reader, &index));
+    ASSERT_TRUE(AttachReader(writer, &latest, &latest_index));
+
+    for (uint32_t id = 0; id < 10; ++id)
+    {
+        ASSERT_TRUE(Publish(writer, id));
+    }
+
+    CameraShmRingReader::Frame frame;
+    ASSERT_EQ(reader.Acquire(&frame), CameraShmRingReader::Result::kFrame);
+    EXPECT_EQ(frame.header->frame_id, 6u);
+    EXPECT_TRUE(PayloadMatches(frame, 6));
+    EXPECT_EQ(reader.GetOverruns(), 6u);
+
+    ASSERT_EQ(latest.Acquire(&frame, true), CameraShmRingReader::Result::kFrame);
+    EXPECT_EQ(frame.header->frame_id, 9u);
+    EXPECT_EQ(latest.GetOverruns(), 0u);
+    EXPECT_EQ(latest.Acquire(&frame, true), CameraShmRingReader::Result::kEmpty);
+}
+
+TEST(CameraShmRingTest, PinnedSlotIsNeverOverwritten)
+{
+    CameraShmRingWriter writer;
+    ASSERT_TRUE(writer.Create(2, kFrameBytes, 2));
+
+    CameraShmRingReader reader_a;
+    CameraShmRingReader reader_b;
+    uint32_t index_a = 0;
+    uint32_t index_b = 0;
+    ASSERT_TRUE(AttachReader(writer, &reader_a, &index_a));
+    ASSERT_TRUE(AttachReader(writer, &reader_b, &index_b));
+
+    CameraShmRingReader::Frame frame_a;
+    ASSERT_TRUE(Publish(writer, 100));
+    ASSERT_EQ(reader_a.Acquire(&frame_a), CameraShmRingReader::Result::kFrame);
+
+    // 其余槽位可用时，发布端持续绕开被固定的槽位
+    for (uint32_t id = 101; id < 110; ++id)
+    {
+        ASSERT_TRUE(Publish(writer, id));
+    }
+    EXPECT_EQ(frame_a.header->frame_id, 100u);
+    EXPECT_TRUE(PayloadMatches(frame_a, 100));
+
+    // 两个槽位都被固定时丢帧
+    CameraShmRingReader::Frame frame_b;
+    ASSERT_EQ(reader_b.Acquire(&frame_b, true), CameraShmRingReader::Result::kFrame);
+    EXPECT_EQ(frame_b.header->frame_id, 109u);
+    EXPECT_FALSE(Publish(writer, 110));
+    EXPECT_EQ(writer.GetStats().dropped_frames, 1u);
+    EXPECT_TRUE(PayloadMatches(frame_a, 100));
+    EXPECT_TRUE(PayloadMatches(frame_b, 109));
+
+    reader_a.Release();
+    EXPECT_TRUE(Publish(writer, 111));
+    ASSERT_EQ(reader_b.Acquire(&frame_b), CameraShmRingReader::Result::kFrame);
+    EXPECT_EQ(frame_b.header->frame_id, 111u);
+    EXPECT_TRUE(PayloadMatches(frame_b, 111));
+}
+
+TEST(CameraShmRingTest, CloseWakesConsumers)
+{
+    CameraShmRingWriter writer;
+    ASSERT_TRUE(writer.Create(4, kFrameBytes, 2));
+
+    CameraShmRingReader reader;
+    uint32_t index = 0;
+    ASSERT_TRUE(AttachReader(writer, &reader, &index));
+    EXPECT_FALSE(reader.WaitReadable(0));
+
+    std::vector<uint8_t> oversized(kFrameBytes * 2);
+    EXPECT_FALSE(writer.Publish(MakeHeader(1), oversized.data(), oversized.size()));
+
+    writer.Close();
+    EXPECT_TRUE(reader.WaitReadable(100));
+    CameraShmRingReader::Frame frame;
+    EXPECT_EQ(reader.Acquire(&frame), CameraShmRingReader::Result::kClosed);
+    EXPECT_FALSE(Publish(writer, 2));
+
+    uint32_t another = 0;
+    int eventfd = -1;
+    EXPECT_FALSE(writer.AttachConsumer(getpid(), &another, &eventfd));
+}
+
+TEST(CameraShmRingTest, WriterIgnoresTamperedSharedHeader)
+{
+    CameraShmRingWriter writer;
+    ASSERT_TRUE(writer.Create(2, kFrameBytes, 2));
+
+    CameraShmRingReader reader;
+    uint32_t index = 0;
+    ASSERT_TRUE(AttachReader(writer, &reader, &index));
+
+    // 消费者以读写方式映射头部，可以任意改写其中的字段
+    const size_t header_bytes = sizeof(camera_subsystem::ipc::CameraShmRingHeader);
+    void* mapped = mmap(nullptr, header_bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        writer.GetMemFd(), 0);
+    ASSERT_NE(mapped, MAP_FAILED);
+    auto* shared = static_cast<camera_subsystem::ipc::CameraShmRingHeader*>(mapped);
+    shared->slot_count = 0xFFFFFFFFu;
+    shared->max_consumers = 0xFFFFFFFFu;
+    shared->slot_capacity = ~0ull;
+    shared->slot_stride = ~0ull;
+    shared->write_seq.store(~0ull);
+    shared->closed.store(1);
+    shared->consumers[index].pinned_slot.store(0xFFFFFFF0u);
+    shared->consumers[index].read_seq.store(~0ull);
+    shared->consumers[1 - index].active.store(1);
+
+    std::vector<uint8_t> oversized(kFrameBytes * 2);
+    EXPECT_FALSE(writer.Publish(MakeHeader(1), oversized.data(), oversized.size()));
+    for (uint32_t id = 1; id <= 4; ++id)
+    {
+        EXPECT_TRUE(Publish(writer, id));
+    }
+    EXPECT_EQ(writer.GetSlotCapacity(), kFrameBytes);
+
+    const CameraShmRingWriter::Stats stats = writer.GetStats();
+    EXPECT_EQ(stats.slot_count, 2u);
+    EXPECT_EQ(stats.published_frames, 4u);
+    ASSERT_EQ(stats.consumers.size(), 1u);
+    EXPECT_EQ(stats.consumers[0].lag, 0u);
+
+    // 被改写为 active 的空位仍可分配
+    uint32_t another = 0;
+    int eventfd = -1;
+    EXPECT_TRUE(writer.AttachConsumer(getpid(), &another, &eventfd));
+    EXPECT_EQ(another, 1 - index);
+    munmap(mapped, header_bytes);
+}
+
+TEST(CameraShmRingTest, NegotiatedOverControlSocket)
+{
+    CameraSessionManager session_manager([](const CameraEndpoint&) { return true; },
+                                         [](const CameraEndpoint&) {});
+    ASSERT_TRUE(session_manager.RegisterCorePublisher("publisher_core_test"));
+
+    CameraShmRingWriter writer;
+    ASSERT_TRUE(writer.Create(4, kFrameBytes, 4));
+
+    CameraControlServer server(&session_manager);
+    CameraControlServer::ShmRingProvider provider;
+    provider.open = [&](pid_t pid, const CameraEndpoint&, CameraControlServer::ShmRingGrant* grant)
+    {
+        grant->memfd = writer.GetMemFd();
+        grant->ring_id = writer.GetRingId();
+        return writer.AttachConsumer(pid, &grant->consumer_index, &grant->eventfd);
+    };
+    provider.close = [&](const CameraEndpoint&, const CameraControlServer::ShmRingGrant& grant)
+    { writer.DetachConsumer(grant.consumer_index); };
+    server.SetShmRingProvider(provider);
+
+    const std::string socket_path = MakeUniqueSocketPath();
+    if (!server.Start(socket_path))
+    {
+        const int error_no = server.GetLastErrorNo();
+        if (server.GetLastErrorStage() == "bind" && (error_no == EPERM || error_no == EACCES))
+        {
+            GTEST_SKIP() << "Skip because unix socket bind is denied by environment.";
+        }
+        FAIL() << "CameraControlServer::Start failed: " << server.GetLastErrorMessage();
+    }
+
+    const CameraEndpoint endpoint =
+        camera_subsystem::ipc::MakeCameraEndpoint(0, CameraBusType::kUsb, 0, "/dev/video0");
+    CameraControlResponse response;
+    CameraShmRingReader reader;
+    {
+        CameraControlClient client;
+        ASSERT_TRUE(client.Connect(socket_path));
+
+        EXPECT_FALSE(client.OpenShmRing("app_0", CameraClientRole::kSubscriber, endpoint, &reader,
+                                        &response));
+        EXPECT_EQ(response.status, CameraControlStatus::kSessionOperationFailed);
+
+        ASSERT_TRUE(client.Subscribe("app_0", CameraClientRole::kSubscriber, endpoint, &response));
+        ASSERT_TRUE(client.OpenShmRing("app_0", CameraClientRole::kSubscriber, endpoint, &reader,
+                                       &response));
+        EXPECT_EQ(response.status, CameraControlStatus::kOk);
+        EXPECT_EQ(writer.GetConsumerCount(), 1u);
+
+        ASSERT_TRUE(Publish(writer, 7));
+        ASSERT_TRUE(reader.WaitReadable(100));
+        CameraShmRingReader::Frame frame;
+        ASSERT_EQ(reader.Acquire(&frame), CameraShmRingReader::Result::kFrame);
+        EXPECT_EQ(frame.header->frame_id, 7u);
+        EXPECT_TRUE(PayloadMatches(frame, 7));
+
+        // 控制面仍可继续使用
+        EXPECT_TRUE(client.Ping(&response));
+    }
+
+    // 控制连接断开后发布端回收消费者位置
+    EXPECT_TRUE(WaitUntil([&]() { return writer.GetConsumerCount() == 0; },
+                          std::chrono::milliseconds(1000)));
+    reader.Close();
+    server.Stop();
+
+    CameraControlServer plain_server(&session_manager);
+    ASSERT_TRUE(plain_server.Start(socket_path));
+    CameraControlClient client;
+    ASSERT_TRUE(client.Connect(socket_path));
+    ASSERT_TRUE(client.Subscribe("app_1", CameraClientRole::kSubscriber, endpoint, &response));
+    EXPECT_FALSE(client.OpenShmRing("app_1", CameraClientRole::kSubscriber, endpoint, &reader,
+                                    &response));
+    EXPECT_EQ(response.status, CameraControlStatus::kShmRingUnavailable);
+    EXPECT_FALSE(reader.IsOpen());
+    client.Disconnect();
+    plain_server.Stop();
+    unlink(socket_path.c_str());
+}
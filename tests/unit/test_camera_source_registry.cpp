@@ -0,0 +1,180 @@
+/**
+ * @file test_camera_source_registry.cpp
+ * @brief CameraSourceRegistry 多路采集单元测试
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ *
+ * 测试目标：
+ * 1. 验证多个端点在共享采集反应器上同时出流，帧携带各自的 camera_id，互不串流。
+ * 2. 验证停止一个端点不影响其他端点继续出帧，统计按端点独立。
+ * 3. 验证 camera_id 冲突或 setup 拒绝时不登记端点。
+ */
+
+#include <gtest/gtest.h>
+
+#include "camera_subsystem/camera/camera_source_registry.h"
+#include "camera_subsystem/camera/synthetic_capture_backend.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using camera_subsystem::camera::CameraSource;
+using camera_subsystem::camera::CameraSourceRegistry;
+using camera_subsystem::camera::SyntheticCaptureBackend;
+using camera_subsystem::core::CameraConfig;
+using camera_subsystem::core::PixelFormat;
+using camera_subsystem::ipc::CameraBusType;
+using camera_subsystem::ipc::CameraEndpoint;
+using camera_subsystem::ipc::MakeCameraEndpoint;
+
+namespace
+{
+
+CameraConfig MakeConfig(uint32_t fps)
+{
+    return CameraConfig(64, 32, PixelFormat::kNV12, fps, 4, 0);
+}
+
+/**
+ * @brief 为每个 source 挂合成后端，按回调中的 camera_id 统计帧数并记录串流
+ */
+class FrameCounter
+{
+public:
+    CameraSourceRegistry::SourceSetup MakeSetup()
+    {
+        return [this](const CameraEndpoint& endpoint, CameraSource& source)
+        {
+            source.SetCaptureBackend(std::make_shared<SyntheticCaptureBackend>());
+            const uint32_t expected = endpoint.camera_id;
+            source.SetFrameCallback(
+                [this, expected](const camera_subsystem::core::FrameHandle& frame)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    ++frames_[frame.camera_id_];
+                    if (frame.camera_id_ != expected)
+                    {
+                        ++mismatched_;
+                    }
+                });
+            return true;
+        };
+    }
+
+    uint64_t Frames(uint32_t camera_id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = frames_.find(camera_id);
+        return it == frames_.end() ? 0 : it->second;
+    }
+
+    uint64_t Mismatched() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return mismatched_;
+    }
+
+    bool WaitFrames(uint32_t camera_id, uint64_t count, int timeout_ms) const
+    {
+        for (int i = 0; i < timeout_ms / 5 && Frames(camera_id) < count; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return Frames(camera_id) >= count;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::map<uint32_t, uint64_t> frames_;
+    uint64_t mismatched_ = 0;
+};
+
+} // namespace
+
+TEST(CameraSourceRegistryTest, EndpointsStreamConcurrentlyOnSharedReactor)
+{
+    FrameCounter counter;
+    CameraSourceRegistry registry(counter.MakeSetup());
+    ASSERT_NE(registry.GetCaptureReactor(), nullptr);
+
+    const CameraEndpoint front = MakeCameraEndpoint(3, CameraBusType::kMipi, 0, "/dev/video3");
+    const CameraEndpoint rear = MakeCameraEndpoint(7, CameraBusType::kUsb, 1, "/dev/video7");
+    ASSERT_TRUE(registry.Start(front, MakeConfig(200)));
+    ASSERT_TRUE(registry.Start(rear, MakeConfig(100)));
+    EXPECT_EQ(registry.GetSourceCount(), 2u);
+    EXPECT_EQ(registry.GetCaptureReactor()->GetStats().source_count, 2u);
+
+    EXPECT_TRUE(counter.WaitFrames(3, 20, 2000));
+    EXPECT_TRUE(counter.WaitFrames(7, 10, 2000));
+    EXPECT_EQ(counter.Mismatched(), 0u);
+
+    const auto stats = registry.GetStats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].endpoint.camera_id, 3u);
+    EXPECT_EQ(stats[1].endpoint.camera_id, 7u);
+    EXPECT_TRUE(stats[0].running);
+    EXPECT_TRUE(stats[1].running);
+    EXPECT_EQ(stats[0].config.fps_, 200u);
+    EXPECT_EQ(stats[1].config.fps_, 100u);
+    EXPECT_GT(stats[0].frames, 0u);
+    EXPECT_GT(stats[1].frames, 0u);
+
+    // 停掉一路后另一路继续出帧
+    registry.Stop(front);
+    EXPECT_EQ(registry.GetSourceCount(), 1u);
+    EXPECT_EQ(registry.Find(front), nullptr);
+    ASSERT_NE(registry.Find(rear), nullptr);
+    const uint64_t front_frames = counter.Frames(3);
+    const uint64_t rear_frames = counter.Frames(7);
+    EXPECT_TRUE(counter.WaitFrames(7, rear_frames + 10, 2000));
+    EXPECT_EQ(counter.Frames(3), front_frames);
+    EXPECT_TRUE(registry.Find(rear)->IsRunning());
+
+    registry.StopAll();
+    EXPECT_EQ(registry.GetSourceCount(), 0u);
+    EXPECT_EQ(counter.Mismatched(), 0u);
+}
+
+TEST(CameraSourceRegistryTest, RestartingEndpointReusesSource)
+{
+    FrameCounter counter;
+    CameraSourceRegistry registry(counter.MakeSetup());
+    const CameraEndpoint endpoint = MakeCameraEndpoint(1, CameraBusType::kUsb, 0, "/dev/video1");
+
+    ASSERT_TRUE(registry.Start(endpoint, MakeConfig(200)));
+    const std::shared_ptr<CameraSource> source = registry.Find(endpoint);
+    ASSERT_NE(source, nullptr);
+    EXPECT_TRUE(counter.WaitFrames(1, 5, 2000));
+
+    ASSERT_TRUE(registry.Start(endpoint, MakeConfig(100)));
+    EXPECT_EQ(registry.Find(endpoint), source);
+    EXPECT_EQ(registry.GetSourceCount(), 1u);
+    EXPECT_EQ(source->GetConfig().fps_, 100u);
+    const uint64_t frames = counter.Frames(1);
+    EXPECT_TRUE(counter.WaitFrames(1, frames + 5, 2000));
+}
+
+TEST(CameraSourceRegistryTest, RejectsDuplicateCameraIdAndFailedSetup)
+{
+    FrameCounter counter;
+    CameraSourceRegistry registry(counter.MakeSetup());
+    const CameraEndpoint first = MakeCameraEndpoint(2, CameraBusType::kUsb, 0, "/dev/video2");
+    const CameraEndpoint clash = MakeCameraEndpoint(2, CameraBusType::kUsb, 1, "/dev/video4");
+
+    ASSERT_TRUE(registry.Start(first, MakeConfig(100)));
+    EXPECT_FALSE(registry.Start(clash, MakeConfig(100)));
+    EXPECT_EQ(registry.GetSourceCount(), 1u);
+    EXPECT_EQ(registry.Find(clash), nullptr);
+
+    CameraSourceRegistry rejecting(
+        [](const CameraEndpoint&, CameraSource&)
+        {
+            return false;
+        });
+    EXPECT_FALSE(rejecting.Start(first, MakeConfig(100)));
+    EXPECT_EQ(rejecting.GetSourceCount(), 0u);
+}
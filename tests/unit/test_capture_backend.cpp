@@ -0,0 +1,569 @@
+/**
+ * @file test_capture_backend.cpp
+ * @brief 采集后端（合成 / memfd / 文件回放）单元测试
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ *
+ * 测试目标：
+ * 1. 验证后端按 fps 定时出帧，时间戳为等间隔的理想曝光时刻。
+ * 2. 验证合成 MJPEG 帧结构完整且携带帧号。
+ * 3. 验证原始帧与 MJPEG 拼接文件按帧回放，非循环模式播完即停。
+ * 4. 验证 CameraSource 挂载后端后走拷贝路径与 DMA-BUF（memfd）路径，lease 释放后 buffer
+ *    回到后端继续出帧。
+ * 5. 验证消费者长时间持有 lease 时自适应控制器给出更大的 buffer 数，并在重新初始化后生效。
+ * 6. 验证 Reconfigure 在不停止订阅回调的前提下切换分辨率，帧序号连续、流代数递增；
+ *    跨代持有的 lease 释放时不会把旧 buffer 排回新的队列。
+ * 7. 验证 Reconfigure 停流后调用排空回调，上层借此归还排队帧的 BufferGuard。
+ * 8. 验证 DMA-BUF 路径建立与 Reconfigure 改变 buffer 数时上报新的 lease 预算。
+ */
+
+#include <gtest/gtest.h>
+
+#include "camera_subsystem/camera/camera_source.h"
+#include "camera_subsystem/camera/file_replay_capture_backend.h"
+#include "camera_subsystem/camera/synthetic_capture_backend.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <poll.h>
+#include <string>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using camera_subsystem::camera::CameraSource;
+using camera_subsystem::camera::CaptureBackend;
+using camera_subsystem::camera::FileReplayCaptureBackend;
+using camera_subsystem::camera::MemfdCaptureBackend;
+using camera_subsystem::camera::SyntheticCaptureBackend;
+using camera_subsystem::core::CameraConfig;
+using camera_subsystem::core::IoMethod;
+using camera_subsystem::core::PixelFormat;
+
+namespace
+{
+
+CameraConfig MakeConfig(PixelFormat format, uint32_t fps, IoMethod io_method = IoMethod::kMmap)
+{
+    return CameraConfig(64, 32, format, fps, 4, static_cast<uint32_t>(io_method));
+}
+
+/**
+ * @brief 等待后端出一帧，最多 timeout_ms
+ */
+bool WaitFrame(CaptureBackend& backend, CaptureBackend::CapturedFrame& frame, int timeout_ms)
+{
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        struct pollfd pfd = {backend.GetPollFd(), POLLIN, 0};
+        poll(&pfd, 1, 10);
+        if (backend.Dequeue(frame))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string WriteTempFile(const std::vector<uint8_t>& data)
+{
+    char path[] = "/tmp/capture_backend_test_XXXXXX";
+    const int fd = mkstemp(path);
+    EXPECT_GE(fd, 0);
+    EXPECT_EQ(write(fd, data.data(), data.size()), static_cast<ssize_t>(data.size()));
+    close(fd);
+    return path;
+}
+
+} // namespace
+
+TEST(CaptureBackendTest, SyntheticFramesArePacedAtFps)
+{
+    SyntheticCaptureBackend backend;
+    ASSERT_TRUE(backend.Open(MakeConfig(PixelFormat::kNV12, 100), 4));
+    ASSERT_EQ(backend.GetBufferCount(), 4u);
+    EXPECT_EQ(backend.GetBytesPerLine(), 64u);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(backend.Queue(i));
+    }
+    EXPECT_FALSE(backend.Queue(0)); // 重复 QBUF
+    ASSERT_TRUE(backend.StartStreaming());
+
+    std::vector<CaptureBackend::CapturedFrame> frames;
+    for (int i = 0; i < 3; ++i)
+    {
+        CaptureBackend::CapturedFrame frame;
+        ASSERT_TRUE(WaitFrame(backend, frame, 500));
+        EXPECT_EQ(frame.bytes_used, 64u * 32u * 3u / 2u);
+
+        uint32_t stamped = 0;
+        std::memcpy(&stamped, backend.GetBuffer(frame.index).start, sizeof(stamped));
+        EXPECT_EQ(stamped, frame.sequence);
+        frames.push_back(frame);
+        ASSERT_TRUE(backend.Queue(frame.index));
+    }
+    backend.StopStreaming();
+
+    for (size_t i = 1; i < frames.size(); ++i)
+    {
+        const uint32_t ticks = frames[i].sequence - frames[i - 1].sequence;
+        ASSERT_GE(ticks, 1u);
+        EXPECT_EQ(frames[i].timestamp_ns - frames[i - 1].timestamp_ns, ticks * 10000000ULL);
+    }
+}
+
+TEST(CaptureBackendTest, SyntheticMjpegFrameIsWellFormed)
+{
+    SyntheticCaptureBackend backend;
+    ASSERT_TRUE(backend.Open(MakeConfig(PixelFormat::kMJPEG, 200), 2));
+    EXPECT_EQ(backend.GetBytesPerLine(), 0u);
+    ASSERT_TRUE(backend.Queue(0));
+    ASSERT_TRUE(backend.StartStreaming());
+
+    CaptureBackend::CapturedFrame frame;
+    ASSERT_TRUE(WaitFrame(backend, frame, 500));
+    backend.StopStreaming();
+
+    const auto* data = static_cast<const uint8_t*>(backend.GetBuffer(frame.index).start);
+    ASSERT_GT(frame.bytes_used, 4u);
+    EXPECT_EQ(data[0], 0xFF);
+    EXPECT_EQ(data[1], 0xD8);
+    EXPECT_EQ(data[frame.bytes_used - 2], 0xFF);
+    EXPECT_EQ(data[frame.bytes_used - 1], 0xD9);
+
+    uint32_t sequence = UINT32_MAX;
+    std::memcpy(&sequence, data + backend.GetJpegSequenceOffset(), sizeof(sequence));
+    EXPECT_EQ(sequence, frame.sequence);
+}
+
+TEST(CaptureBackendTest, StarvedBackendDropsFrames)
+{
+    SyntheticCaptureBackend backend;
+    ASSERT_TRUE(backend.Open(MakeConfig(PixelFormat::kYUYV, 200), 2));
+    ASSERT_TRUE(backend.StartStreaming());
+
+    // 没有任何 buffer 入队，节拍到来时只能丢帧
+    CaptureBackend::CapturedFrame frame;
+    EXPECT_FALSE(WaitFrame(backend, frame, 50));
+    EXPECT_GT(backend.GetStarvedFrameCount(), 0u);
+    backend.StopStreaming();
+}
+
+TEST(CaptureBackendTest, RawFileReplayStopsAtEndWithoutLoop)
+{
+    const CameraConfig config = MakeConfig(PixelFormat::kYUYV, 200);
+    const size_t frame_size = 64 * 32 * 2;
+    std::vector<uint8_t> data;
+    for (uint8_t value = 1; value <= 3; ++value)
+    {
+        data.insert(data.end(), frame_size, value);
+    }
+    data.insert(data.end(), 10, 0xEE); // 尾部残帧被忽略
+    const std::string path = WriteTempFile(data);
+
+    FileReplayCaptureBackend::Options options;
+    options.loop = false;
+    FileReplayCaptureBackend backend(path, options);
+    ASSERT_TRUE(backend.Open(config, 4));
+    EXPECT_EQ(backend.GetFrameCount(), 3u);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(backend.Queue(i));
+    }
+    ASSERT_TRUE(backend.StartStreaming());
+
+    std::vector<uint8_t> seen;
+    CaptureBackend::CapturedFrame frame;
+    while (WaitFrame(backend, frame, 100))
+    {
+        EXPECT_EQ(frame.bytes_used, frame_size);
+        seen.push_back(static_cast<const uint8_t*>(backend.GetBuffer(frame.index).start)[0]);
+        ASSERT_TRUE(backend.Queue(frame.index));
+    }
+    backend.Close();
+    unlink(path.c_str());
+
+    // 200fps 下可能错过节拍而跳帧，但顺序不变且不超出文件
+    ASSERT_FALSE(seen.empty());
+    EXPECT_LE(seen.size(), 3u);
+    for (size_t i = 1; i < seen.size(); ++i)
+    {
+        EXPECT_GT(seen[i], seen[i - 1]);
+    }
+}
+
+TEST(CaptureBackendTest, MjpegFileReplaySplitsOnMarkers)
+{
+    const std::vector<uint8_t> first = {0xFF, 0xD8, 0x01, 0x02, 0xFF, 0xD9};
+    const std::vector<uint8_t> second = {0xFF, 0xD8, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xD9};
+    std::vector<uint8_t> data = {0x00, 0x11}; // 首帧前的垃圾数据被跳过
+    data.insert(data.end(), first.begin(), first.end());
+    data.insert(data.end(), second.begin(), second.end());
+    data.insert(data.end(), {0xFF, 0xD8, 0x07}); // 残缺帧
+    const std::string path = WriteTempFile(data);
+
+    FileReplayCaptureBackend backend(path);
+    ASSERT_TRUE(backend.Open(MakeConfig(PixelFormat::kMJPEG, 100), 2));
+    EXPECT_EQ(backend.GetFrameCount(), 2u);
+    ASSERT_TRUE(backend.Queue(0));
+    ASSERT_TRUE(backend.StartStreaming());
+
+    CaptureBackend::CapturedFrame frame;
+    ASSERT_TRUE(WaitFrame(backend, frame, 500));
+    EXPECT_TRUE(frame.bytes_used == first.size() || frame.bytes_used == second.size());
+    backend.Close();
+    unlink(path.c_str());
+}
+
+TEST(CaptureBackendTest, CameraSourceCopyPathWithSyntheticBackend)
+{
+    CameraSource source;
+    source.SetCaptureBackend(std::make_shared<SyntheticCaptureBackend>());
+    ASSERT_TRUE(source.Initialize(MakeConfig(PixelFormat::kNV12, 200)));
+    EXPECT_FALSE(source.IsDmaBufPathEnabled());
+
+    std::mutex mutex;
+    std::vector<uint32_t> stamps;
+    std::atomic<int> frames{0};
+    source.SetFrameCallbackWithBuffer(
+        [&](const camera_subsystem::core::FrameHandle& frame,
+            const std::shared_ptr<camera_subsystem::core::BufferGuard>&)
+        {
+            uint32_t stamped = 0;
+            std::memcpy(&stamped, frame.virtual_address_, sizeof(stamped));
+            EXPECT_EQ(stamped, frame.sequence_);
+            EXPECT_EQ(frame.line_stride_[0], 64u);
+            std::lock_guard<std::mutex> lock(mutex);
+            stamps.push_back(stamped);
+            frames.fetch_add(1);
+        });
+
+    ASSERT_TRUE(source.Start());
+    for (int i = 0; i < 200 && frames.load() < 10; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    source.Stop();
+
+    EXPECT_GE(frames.load(), 10);
+    const auto latency = source.GetCaptureLatencyStats();
+    EXPECT_GT(latency.driver_timestamp_frames, 0u);
+    EXPECT_EQ(latency.fallback_timestamp_frames, 0u);
+}
+
+TEST(CaptureBackendTest, CameraSourceDmaBufPathWithMemfdBackend)
+{
+    CameraSource source;
+    source.SetCaptureBackend(std::make_shared<MemfdCaptureBackend>());
+    ASSERT_TRUE(source.Initialize(MakeConfig(PixelFormat::kNV12, 200, IoMethod::kDmaBuf)));
+    ASSERT_TRUE(source.IsDmaBufPathEnabled());
+
+    std::atomic<int> frames{0};
+    std::atomic<int> content_ok{0};
+    source.SetFramePacketCallback(
+        [&](const camera_subsystem::core::FramePacket& packet)
+        {
+            ASSERT_GE(packet.descriptor.fds[0], 0);
+            void* map = mmap(nullptr, packet.descriptor.total_bytes_used, PROT_READ, MAP_SHARED,
+                             packet.descriptor.fds[0], 0);
+            ASSERT_NE(map, MAP_FAILED);
+            uint32_t stamped = 0;
+            std::memcpy(&stamped, map, sizeof(stamped));
+            if (stamped == packet.descriptor.sequence)
+            {
+                content_ok.fetch_add(1);
+            }
+            munmap(map, packet.descriptor.total_bytes_used);
+            frames.fetch_add(1);
+            // packet 析构时 lease 释放，buffer 回到后端队列
+        });
+
+    ASSERT_TRUE(source.Start());
+    // 帧数超过 buffer 数，说明 lease 释放后 buffer 被重新入队
+    for (int i = 0; i < 200 && frames.load() < 12; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    source.Stop();
+
+    EXPECT_GE(frames.load(), 12);
+    EXPECT_EQ(content_ok.load(), frames.load());
+    EXPECT_EQ(source.GetDmaBufFrameCount(), static_cast<uint64_t>(frames.load()));
+    EXPECT_EQ(source.GetDmaBufActiveLeaseCount(), 0u);
+}
+
+TEST(CaptureBackendTest, AdaptiveBufferCountGrowsOnRestart)
+{
+    CameraSource source;
+    camera_subsystem::core::BufferCountController::Options options;
+    options.window_ms = 50;
+    source.SetAdaptiveBufferCount(true, options);
+    source.SetCaptureBackend(std::make_shared<MemfdCaptureBackend>());
+    const CameraConfig config = MakeConfig(PixelFormat::kNV12, 200, IoMethod::kDmaBuf);
+    ASSERT_TRUE(source.Initialize(config));
+    ASSERT_TRUE(source.IsDmaBufPathEnabled());
+    EXPECT_EQ(source.GetDmaBufLeaseInFlightMax(), 2u);
+
+    // 每个 packet 持有 30ms（约 6 帧）后由另一线程释放，4 个 buffer 无法覆盖
+    using Clock = std::chrono::steady_clock;
+    std::mutex held_mutex;
+    std::deque<std::pair<Clock::time_point, camera_subsystem::core::FramePacket>> held;
+    source.SetFramePacketCallback(
+        [&held, &held_mutex](const camera_subsystem::core::FramePacket& packet)
+        {
+            std::lock_guard<std::mutex> lock(held_mutex);
+            held.emplace_back(Clock::now(), packet);
+        });
+
+    std::atomic<bool> running(true);
+    std::thread releaser(
+        [&]()
+        {
+            while (running.load())
+            {
+                {
+                    std::lock_guard<std::mutex> lock(held_mutex);
+                    while (!held.empty() &&
+                           Clock::now() - held.front().first > std::chrono::milliseconds(30))
+                    {
+                        held.pop_front();
+                    }
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        });
+
+    ASSERT_TRUE(source.Start());
+    for (int i = 0; i < 100 && source.GetAdaptiveBufferStats().windows < 3; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    source.Stop();
+    running = false;
+    releaser.join();
+    held.clear();
+
+    const auto stats = source.GetAdaptiveBufferStats();
+    EXPECT_TRUE(stats.enabled);
+    EXPECT_GE(stats.windows, 3u);
+    EXPECT_GT(stats.target_buffer_count, 4u);
+    EXPECT_GT(stats.lease_hold.p99_ns, 0u);
+    // memfd 后端不支持在线扩容，新的 buffer 数在重新初始化时生效
+    EXPECT_EQ(stats.live_grow_count, 0u);
+    EXPECT_EQ(stats.orphaned_buffers, 0u);
+
+    ASSERT_TRUE(source.Initialize(config));
+    EXPECT_EQ(source.GetConfig().buffer_count_, stats.target_buffer_count);
+    EXPECT_EQ(source.GetDmaBufLeaseInFlightMax(), stats.target_buffer_count - 2u);
+}
+
+TEST(CaptureBackendTest, ReconfigureSwitchesResolutionInPlace)
+{
+    CameraSource source;
+    source.SetCaptureBackend(std::make_shared<SyntheticCaptureBackend>());
+    ASSERT_TRUE(source.Initialize(CameraConfig(1280, 720, PixelFormat::kNV12, 200, 4, 0)));
+    EXPECT_EQ(source.GetStreamGeneration(), 0u);
+
+    struct Seen
+    {
+        uint32_t frame_id;
+        uint32_t width;
+        uint32_t generation;
+    };
+    std::mutex mutex;
+    std::vector<Seen> seen;
+    source.SetFrameCallbackWithBuffer(
+        [&](const camera_subsystem::core::FrameHandle& frame,
+            const std::shared_ptr<camera_subsystem::core::BufferGuard>&)
+        {
+            EXPECT_EQ(frame.buffer_size_, frame.width_ * frame.height_ * 3u / 2u);
+            std::lock_guard<std::mutex> lock(mutex);
+            seen.push_back({frame.frame_id_, frame.width_, frame.stream_generation_});
+        });
+    auto count_generation = [&](uint32_t generation)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t count = 0;
+        for (const auto& item : seen)
+        {
+            count += item.generation == generation ? 1 : 0;
+        }
+        return count;
+    };
+
+    ASSERT_TRUE(source.Start());
+    for (int i = 0; i < 200 && count_generation(0) < 5; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    ASSERT_TRUE(source.Reconfigure(CameraConfig(1920, 1080, PixelFormat::kNV12, 200, 4, 0)));
+    EXPECT_TRUE(source.IsRunning());
+    EXPECT_EQ(source.GetStreamGeneration(), 1u);
+    EXPECT_EQ(source.GetConfig().width_, 1920u);
+    EXPECT_GT(source.GetLastReconfigureDurationNs(), 0u);
+    EXPECT_LT(source.GetLastReconfigureDurationNs(), 100000000ULL);
+
+    for (int i = 0; i < 200 && count_generation(1) < 5; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    source.Stop();
+
+    EXPECT_GE(count_generation(1), 5u);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 1; i < seen.size(); ++i)
+    {
+        // 同一回调持续收帧，帧序号不因切换归零，代数只增不减
+        EXPECT_EQ(seen[i].frame_id, seen[i - 1].frame_id + 1);
+        EXPECT_GE(seen[i].generation, seen[i - 1].generation);
+        EXPECT_EQ(seen[i].width, seen[i].generation == 0 ? 1280u : 1920u);
+    }
+}
+
+TEST(CaptureBackendTest, ReconfigureRunsDrainCallbackBeforeWaiting)
+{
+    CameraSource source;
+    source.SetCaptureBackend(std::make_shared<SyntheticCaptureBackend>());
+    ASSERT_TRUE(source.Initialize(CameraConfig(1280, 720, PixelFormat::kNV12, 200, 4, 0)));
+
+    // 模拟发送队列：持有 BufferGuard 直到排空回调丢弃
+    std::mutex mutex;
+    std::deque<std::shared_ptr<camera_subsystem::core::BufferGuard>> queued;
+    std::atomic<int> drain_calls{0};
+    source.SetFrameCallbackWithBuffer(
+        [&](const camera_subsystem::core::FrameHandle&,
+            const std::shared_ptr<camera_subsystem::core::BufferGuard>& buffer)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queued.size() < 2)
+            {
+                queued.push_back(buffer);
+            }
+        });
+    source.SetDrainCallback(
+        [&]()
+        {
+            drain_calls.fetch_add(1);
+            std::lock_guard<std::mutex> lock(mutex);
+            queued.clear();
+        });
+
+    ASSERT_TRUE(source.Start());
+    for (int i = 0; i < 200; ++i)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queued.size() == 2)
+            {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    EXPECT_TRUE(source.Reconfigure(CameraConfig(1920, 1080, PixelFormat::kNV12, 200, 4, 0)));
+    EXPECT_EQ(drain_calls.load(), 1);
+    EXPECT_EQ(source.GetConfig().width_, 1920u);
+    source.Stop();
+}
+
+TEST(CaptureBackendTest, LeaseBudgetCallbackFollowsBufferCount)
+{
+    CameraSource source;
+    source.SetCaptureBackend(std::make_shared<MemfdCaptureBackend>());
+    std::mutex mutex;
+    std::vector<size_t> budgets;
+    source.SetLeaseBudgetCallback(
+        [&](size_t lease_max)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            budgets.push_back(lease_max);
+        });
+
+    ASSERT_TRUE(source.Initialize(MakeConfig(PixelFormat::kNV12, 200, IoMethod::kDmaBuf)));
+    ASSERT_TRUE(source.IsDmaBufPathEnabled());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_EQ(budgets.size(), 1u);
+        EXPECT_EQ(budgets.back(), source.GetDmaBufLeaseInFlightMax());
+    }
+
+    CameraConfig larger = MakeConfig(PixelFormat::kNV12, 200, IoMethod::kDmaBuf);
+    larger.buffer_count_ = 8;
+    ASSERT_TRUE(source.Reconfigure(larger));
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(budgets.size(), 2u);
+    EXPECT_EQ(budgets.back(), source.GetDmaBufLeaseInFlightMax());
+    EXPECT_GT(budgets.back(), budgets.front());
+}
+
+TEST(CaptureBackendTest, ReconfigureAbandonsLeasesFromPreviousGeneration)
+{
+    CameraSource source;
+    source.SetCaptureBackend(std::make_shared<MemfdCaptureBackend>());
+    ASSERT_TRUE(source.Initialize(MakeConfig(PixelFormat::kNV12, 200, IoMethod::kDmaBuf)));
+    ASSERT_TRUE(source.IsDmaBufPathEnabled());
+
+    std::mutex mutex;
+    camera_subsystem::core::FramePacket held;
+    std::atomic<int> new_generation_frames{0};
+    source.SetFramePacketCallback(
+        [&](const camera_subsystem::core::FramePacket& packet)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (packet.descriptor.stream_generation == 0 && !held.lease)
+            {
+                held = packet;
+            }
+            if (packet.descriptor.stream_generation == 1)
+            {
+                EXPECT_EQ(packet.descriptor.width, 128u);
+                EXPECT_EQ(packet.handle.stream_generation_, 1u);
+                new_generation_frames.fetch_add(1);
+            }
+        });
+
+    ASSERT_TRUE(source.Start());
+    for (int i = 0; i < 200 && source.GetDmaBufActiveLeaseCount() == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(source.GetDmaBufActiveLeaseCount(), 1u);
+
+    // 消费者不归还 lease：等待有上限，超时后放弃该 lease 继续切换
+    CameraConfig next = MakeConfig(PixelFormat::kNV12, 200, IoMethod::kDmaBuf);
+    next.width_ = 128;
+    ASSERT_TRUE(source.Reconfigure(next, std::chrono::milliseconds(10)));
+    EXPECT_EQ(source.GetDmaBufActiveLeaseCount(), 0u);
+
+    for (int i = 0; i < 200 && new_generation_frames.load() < 12; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_GE(new_generation_frames.load(), 12);
+
+    // 旧 lease 晚到的释放既不 QBUF 也不影响新一代的计数
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        held = camera_subsystem::core::FramePacket();
+    }
+    const int before = new_generation_frames.load();
+    for (int i = 0; i < 200 && new_generation_frames.load() < before + 12; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    source.Stop();
+    EXPECT_GE(new_generation_frames.load(), before + 12);
+    EXPECT_EQ(source.GetDmaBufActiveLeaseCount(), 0u);
+}
@@ -0,0 +1,249 @@
+/**
+ * @file test_capture_reactor.cpp
+ * @brief CaptureReactor 单元测试
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ *
+ * 测试目标：
+ * 1. 验证单个反应器线程可以分发多个设备 fd 的就绪事件。
+ * 2. 验证 Stop 经 eventfd 立即唤醒，不依赖等待超时。
+ * 3. 验证 RemoveSource 返回前等待进行中的回调结束，之后不再回调。
+ * 4. 验证回调返回 false 时源被移除，以及 Post 任务在反应器线程执行。
+ *
+ * 测试流程：
+ * 1. 以 eventfd 模拟 V4L2 设备：写入计数即“有帧就绪”，回调中读取即 DQBUF。
+ * 2. 注册多个假设备，分别触发就绪并统计回调次数与所在线程。
+ * 3. 在无事件时 Stop，测量耗时；在回调执行期间 RemoveSource，校验时序。
+ */
+
+#include <gtest/gtest.h>
+
+#include "camera_subsystem/camera/capture_reactor.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sys/eventfd.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using camera_subsystem::camera::CaptureReactor;
+
+namespace
+{
+
+/**
+ * @brief eventfd 假设备：Signal 模拟驱动完成一帧，Drain 模拟 DQBUF
+ */
+class FakeDevice
+{
+public:
+    FakeDevice()
+        : fd_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+    {
+    }
+
+    ~FakeDevice()
+    {
+        if (fd_ >= 0)
+        {
+            close(fd_);
+        }
+    }
+
+    int Fd() const
+    {
+        return fd_;
+    }
+
+    void Signal(uint64_t frames = 1)
+    {
+        ASSERT_EQ(write(fd_, &frames, sizeof(frames)), static_cast<ssize_t>(sizeof(frames)));
+    }
+
+    uint64_t Drain()
+    {
+        uint64_t frames = 0;
+        if (read(fd_, &frames, sizeof(frames)) != static_cast<ssize_t>(sizeof(frames)))
+        {
+            return 0;
+        }
+        return frames;
+    }
+
+private:
+    int fd_;
+};
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate, std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(CaptureReactorTest, DispatchesAllDevicesFromOneThread)
+{
+    CaptureReactor reactor;
+    ASSERT_TRUE(reactor.Start(1));
+
+    constexpr size_t kDevices = 4;
+    std::vector<std::unique_ptr<FakeDevice>> devices;
+    std::atomic<uint64_t> frames[kDevices];
+    std::mutex thread_mutex;
+    std::set<std::thread::id> dispatch_threads;
+
+    for (size_t i = 0; i < kDevices; ++i)
+    {
+        devices.push_back(std::make_unique<FakeDevice>());
+        frames[i].store(0);
+        FakeDevice* device = devices.back().get();
+        const uint64_t id = reactor.AddSource(device->Fd(), [&, device, i](uint32_t events) {
+            EXPECT_NE(events & EPOLLIN, 0u);
+            frames[i].fetch_add(device->Drain());
+            std::lock_guard<std::mutex> lock(thread_mutex);
+            dispatch_threads.insert(std::this_thread::get_id());
+            return true;
+        });
+        ASSERT_NE(id, 0u);
+    }
+
+    for (int round = 0; round < 3; ++round)
+    {
+        for (auto& device : devices)
+        {
+            device->Signal();
+        }
+        ASSERT_TRUE(WaitFor([&]() {
+            for (size_t i = 0; i < kDevices; ++i)
+            {
+                if (frames[i].load() < static_cast<uint64_t>(round + 1))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }, std::chrono::milliseconds(2000)));
+    }
+
+    EXPECT_EQ(dispatch_threads.size(), 1u);
+    const auto stats = reactor.GetStats();
+    EXPECT_EQ(stats.thread_count, 1u);
+    EXPECT_EQ(stats.source_count, kDevices);
+    EXPECT_GE(stats.dispatches, kDevices * 3);
+    reactor.Stop();
+}
+
+TEST(CaptureReactorTest, StopWakesIdleReactorPromptly)
+{
+    CaptureReactor reactor;
+    ASSERT_TRUE(reactor.Start(2));
+
+    FakeDevice device;
+    ASSERT_NE(reactor.AddSource(device.Fd(), [](uint32_t) { return true; }), 0u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    const auto begin = std::chrono::steady_clock::now();
+    reactor.Stop();
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_FALSE(reactor.IsRunning());
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+    EXPECT_EQ(reactor.GetStats().source_count, 0u);
+}
+
+TEST(CaptureReactorTest, RemoveSourceWaitsForInFlightCallback)
+{
+    CaptureReactor reactor;
+    ASSERT_TRUE(reactor.Start(1));
+
+    FakeDevice device;
+    std::atomic<bool> in_callback{false};
+    std::atomic<bool> callback_done{false};
+    std::atomic<int> calls{0};
+    const uint64_t id = reactor.AddSource(device.Fd(), [&](uint32_t) {
+        calls.fetch_add(1);
+        device.Drain();
+        in_callback.store(true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        callback_done.store(true);
+        return true;
+    });
+    ASSERT_NE(id, 0u);
+
+    device.Signal();
+    ASSERT_TRUE(WaitFor([&]() { return in_callback.load(); }, std::chrono::milliseconds(2000)));
+
+    EXPECT_TRUE(reactor.RemoveSource(id));
+    EXPECT_TRUE(callback_done.load());
+    EXPECT_FALSE(reactor.RemoveSource(id));
+
+    // 注销后再就绪不会回调
+    device.Signal();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(calls.load(), 1);
+    reactor.Stop();
+}
+
+TEST(CaptureReactorTest, FailingCallbackRemovesSource)
+{
+    CaptureReactor reactor;
+    ASSERT_TRUE(reactor.Start(1));
+
+    FakeDevice broken;
+    FakeDevice healthy;
+    std::atomic<int> broken_calls{0};
+    std::atomic<uint64_t> healthy_frames{0};
+    ASSERT_NE(reactor.AddSource(broken.Fd(), [&](uint32_t) {
+        broken_calls.fetch_add(1);
+        return false;
+    }), 0u);
+    ASSERT_NE(reactor.AddSource(healthy.Fd(), [&](uint32_t) {
+        healthy_frames.fetch_add(healthy.Drain());
+        return true;
+    }), 0u);
+
+    broken.Signal();
+    ASSERT_TRUE(WaitFor([&]() { return reactor.GetStats().error_removals == 1; },
+                        std::chrono::milliseconds(2000)));
+    EXPECT_EQ(reactor.GetStats().source_count, 1u);
+
+    // 未读取的 eventfd 仍可读，但源已移除，不会再回调
+    healthy.Signal(2);
+    ASSERT_TRUE(WaitFor([&]() { return healthy_frames.load() == 2; },
+                        std::chrono::milliseconds(2000)));
+    EXPECT_EQ(broken_calls.load(), 1);
+    reactor.Stop();
+}
+
+TEST(CaptureReactorTest, PostRunsTaskOnReactorThread)
+{
+    CaptureReactor reactor;
+    EXPECT_FALSE(reactor.Post([]() {}));
+    ASSERT_TRUE(reactor.Start(1));
+
+    std::atomic<bool> ran{false};
+    std::thread::id task_thread;
+    ASSERT_TRUE(reactor.Post([&]() {
+        task_thread = std::this_thread::get_id();
+        ran.store(true);
+    }));
+    ASSERT_TRUE(WaitFor([&]() { return ran.load(); }, std::chrono::milliseconds(2000)));
+    EXPECT_NE(task_thread, std::this_thread::get_id());
+    EXPECT_EQ(reactor.GetStats().tasks_run, 1u);
+    reactor.Stop();
+}
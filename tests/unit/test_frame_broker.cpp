@@ -0,0 +1,696 @@
+/**
+ * @file test_frame_broker.cpp
+ * @brief FrameBroker 单元测试
+ * @author CameraSubsystem Team
+ * @date 2026-10-16
+ *
+ * 测试目标：
+ * 1. 验证两种分发模式（共享队列 / 每订阅者环形队列）均能把帧送达所有订阅者。
+ * 2. 验证环形队列满时按订阅者独立丢帧，且不影响其他订阅者。
+ * 3. 验证每订阅者统计（入队、分发、丢弃、队列深度）与 BufferGuard 生命周期。
+ * 4. 验证 kKeepLatest / kDropOldest 投递策略只影响声明该策略的订阅者。
+ * 5. 验证 Worker 线程组按订阅者优先级归属，以及组内空闲 Worker 的工作窃取。
+ * 6. 验证超过最大帧龄的帧在出队时被跳过、Buffer 立即归还并计入 expired。
+ *
+ * 测试流程：
+ * 1. 构造计数订阅者与可阻塞订阅者，分别在两种模式下发布帧。
+ * 2. 阻塞慢订阅者使其环形队列填满，校验丢帧只记在该订阅者上。
+ * 3. 发布携带 BufferGuard 的帧，校验所有订阅者处理后 Buffer 归还到池。
+ * 4. 阻塞 kKeepLatest 订阅者并连续发布，校验其最多占用一个 Buffer 且替换计数正确。
+ * 5. 阻塞某 Worker 上的订阅者，校验同一 Worker 就绪队列中的其他订阅者被窃取执行。
+ * 6. 阻塞声明最大帧龄的订阅者直至积压帧超龄，校验恢复后只投递新帧。
+ */
+
+#include <gtest/gtest.h>
+#include "camera_subsystem/broker/frame_broker.h"
+#include "camera_subsystem/core/bounded_mpmc_ring.h"
+#include "camera_subsystem/core/buffer_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace camera_subsystem;
+
+namespace
+{
+
+class CountingSubscriber : public broker::IFrameSubscriber
+{
+public:
+    CountingSubscriber(std::string name, uint8_t priority,
+                       broker::DeliveryPolicy policy = broker::DeliveryPolicy::kQueue,
+                       size_t max_depth = 0)
+        : name_(std::move(name)), priority_(priority), policy_(policy), max_depth_(max_depth)
+    {
+    }
+
+    void OnFrame(const core::FrameHandle& frame) override
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            entered_ = true;
+            entered_cv_.notify_all();
+            gate_cv_.wait(lock, [&]() { return !blocked_; });
+            last_frame_id_ = frame.frame_id_;
+        }
+        received_.fetch_add(1);
+    }
+
+    broker::DeliveryPolicy GetDeliveryPolicy() const override
+    {
+        return policy_;
+    }
+
+    size_t GetMaxQueueDepth() const override
+    {
+        return max_depth_;
+    }
+
+    const char* GetSubscriberName() const override
+    {
+        return name_.c_str();
+    }
+
+    uint8_t GetPriority() const override
+    {
+        return priority_;
+    }
+
+    uint64_t GetMaxFrameAgeNs() const override
+    {
+        return max_age_ns_;
+    }
+
+    /// 需在 Subscribe 之前设置
+    void SetMaxFrameAgeNs(uint64_t max_age_ns)
+    {
+        max_age_ns_ = max_age_ns;
+    }
+
+    void SetBlocked(bool blocked)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            blocked_ = blocked;
+        }
+        gate_cv_.notify_all();
+    }
+
+    uint64_t Received() const
+    {
+        return received_.load();
+    }
+
+    /// 等待回调进入（可能阻塞在闸门处）
+    bool WaitEntered(int timeout_ms = 2000)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return entered_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                    [&]() { return entered_; });
+    }
+
+    uint32_t LastFrameId()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return last_frame_id_;
+    }
+
+private:
+    std::string name_;
+    uint8_t priority_;
+    broker::DeliveryPolicy policy_;
+    size_t max_depth_;
+    uint64_t max_age_ns_ = 0;
+    std::atomic<uint64_t> received_{0};
+    std::mutex mutex_;
+    std::condition_variable gate_cv_;
+    std::condition_variable entered_cv_;
+    bool blocked_ = false;
+    bool entered_ = false;
+    uint32_t last_frame_id_ = 0;
+};
+
+core::FrameHandle MakeFrame(uint32_t frame_id)
+{
+    core::FrameHandle frame;
+    frame.Reset();
+    frame.frame_id_ = frame_id;
+    return frame;
+}
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate, int timeout_ms = 2000)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (predicate())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return predicate();
+}
+
+const broker::FrameBroker::SubscriberStats* FindStats(const broker::FrameBroker::Stats& stats,
+                                                      const std::string& name)
+{
+    for (const auto& sub : stats.subscribers)
+    {
+        if (sub.name == name)
+        {
+            return &sub;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST(BoundedMpmcRingTest, PushPopAndCapacity)
+{
+    core::BoundedMpmcRing<int> ring(3);
+    EXPECT_EQ(ring.Capacity(), 4u);
+    EXPECT_TRUE(ring.Empty());
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int value = i;
+        EXPECT_TRUE(ring.TryPush(std::move(value)));
+    }
+    int overflow = 99;
+    EXPECT_FALSE(ring.TryPush(std::move(overflow)));
+    EXPECT_EQ(ring.Size(), 4u);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int value = -1;
+        EXPECT_TRUE(ring.TryPop(&value));
+        EXPECT_EQ(value, i);
+    }
+    int value = -1;
+    EXPECT_FALSE(ring.TryPop(&value));
+}
+
+TEST(BoundedMpmcRingTest, SingleSlotCapacity)
+{
+    core::BoundedMpmcRing<int> ring(1);
+    EXPECT_EQ(ring.Capacity(), 1u);
+
+    for (int round = 0; round < 3; ++round)
+    {
+        int first = round;
+        int second = round + 100;
+        EXPECT_TRUE(ring.TryPush(std::move(first)));
+        EXPECT_FALSE(ring.TryPush(std::move(second)));
+
+        int value = -1;
+        EXPECT_TRUE(ring.TryPop(&value));
+        EXPECT_EQ(value, round);
+        EXPECT_FALSE(ring.TryPop(&value));
+    }
+}
+
+TEST(BoundedMpmcRingTest, ConcurrentProducersConsumers)
+{
+    core::BoundedMpmcRing<uint64_t> ring(64);
+    constexpr int kProducers = 4;
+    constexpr uint64_t kPerProducer = 20000;
+    std::atomic<uint64_t> consumed_sum{0};
+    std::atomic<uint64_t> consumed_count{0};
+    std::atomic<bool> producers_done{false};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        threads.emplace_back([&]() {
+            for (uint64_t i = 1; i <= kPerProducer; ++i)
+            {
+                uint64_t v = i;
+                while (!ring.TryPush(std::move(v)))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 2; ++c)
+    {
+        consumers.emplace_back([&]() {
+            uint64_t v = 0;
+            while (!producers_done.load() || !ring.Empty())
+            {
+                if (ring.TryPop(&v))
+                {
+                    consumed_sum.fetch_add(v);
+                    consumed_count.fetch_add(1);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    producers_done.store(true);
+    for (auto& t : consumers)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(consumed_count.load(), kProducers * kPerProducer);
+    EXPECT_EQ(consumed_sum.load(), kProducers * (kPerProducer * (kPerProducer + 1) / 2));
+}
+
+class FrameBrokerModeTest : public ::testing::TestWithParam<broker::FrameBroker::DispatchMode>
+{
+};
+
+TEST_P(FrameBrokerModeTest, DeliversToAllSubscribers)
+{
+    broker::FrameBroker broker;
+    ASSERT_TRUE(broker.SetDispatchMode(GetParam()));
+    broker.SetSubscriberQueueCapacity(256);
+    ASSERT_TRUE(broker.Start(2));
+
+    auto high = std::make_shared<CountingSubscriber>("high", 200);
+    auto low = std::make_shared<CountingSubscriber>("low", 50);
+    EXPECT_TRUE(broker.Subscribe(high));
+    EXPECT_TRUE(broker.Subscribe(low));
+    EXPECT_FALSE(broker.Subscribe(high));
+    EXPECT_EQ(broker.GetSubscriberCount(), 2u);
+
+    constexpr uint32_t kFrames = 100;
+    for (uint32_t i = 0; i < kFrames; ++i)
+    {
+        broker.PublishFrame(MakeFrame(i));
+    }
+
+    EXPECT_TRUE(WaitFor([&]() { return high->Received() == kFrames && low->Received() == kFrames; }));
+
+    const auto stats = broker.GetStats();
+    EXPECT_EQ(stats.dispatch_mode, GetParam());
+    EXPECT_EQ(stats.published_frames, kFrames);
+    EXPECT_EQ(stats.dispatched_tasks, 2u * kFrames);
+    EXPECT_EQ(stats.dropped_tasks, 0u);
+    ASSERT_EQ(stats.subscribers.size(), 2u);
+    EXPECT_EQ(stats.subscribers[0].name, "high");
+    EXPECT_EQ(stats.subscribers[1].name, "low");
+    for (const auto& sub : stats.subscribers)
+    {
+        EXPECT_EQ(sub.enqueued, kFrames);
+        EXPECT_EQ(sub.dispatched, kFrames);
+        EXPECT_EQ(sub.queue_depth, 0u);
+    }
+
+    broker.Unsubscribe(low);
+    EXPECT_EQ(broker.GetSubscriberCount(), 1u);
+    broker.Stop();
+}
+
+TEST_P(FrameBrokerModeTest, ReleasesBufferAfterAllSubscribers)
+{
+    core::BufferPool pool;
+    ASSERT_TRUE(pool.Initialize(2, 64));
+
+    broker::FrameBroker broker;
+    ASSERT_TRUE(broker.SetDispatchMode(GetParam()));
+    ASSERT_TRUE(broker.Start(2));
+
+    auto a = std::make_shared<CountingSubscriber>("a", 128);
+    auto b = std::make_shared<CountingSubscriber>("b", 128);
+    broker.Subscribe(a);
+    broker.Subscribe(b);
+
+    {
+        auto guard = pool.Acquire();
+        ASSERT_NE(guard, nullptr);
+        broker.PublishFrame(MakeFrame(1), guard);
+    }
+
+    EXPECT_TRUE(WaitFor([&]() { return pool.GetStats().available == 2u; }));
+    EXPECT_EQ(a->Received(), 1u);
+    EXPECT_EQ(b->Received(), 1u);
+    broker.Stop();
+}
+
+TEST_P(FrameBrokerModeTest, KeepLatestHoldsAtMostOneBuffer)
+{
+    core::BufferPool pool;
+    ASSERT_TRUE(pool.Initialize(4, 64));
+
+    broker::FrameBroker broker;
+    ASSERT_TRUE(broker.SetDispatchMode(GetParam()));
+    ASSERT_TRUE(broker.Start(2));
+
+    auto preview = std::make_shared<CountingSubscriber>("preview", 200,
+                                                        broker::DeliveryPolicy::kKeepLatest);
+    auto recorder = std::make_shared<CountingSubscriber>("recorder", 100);
+    broker.Subscribe(preview);
+    broker.Subscribe(recorder);
+
+    preview->SetBlocked(true);
+    broker.PublishFrame(MakeFrame(0));
+    ASSERT_TRUE(preview->WaitEntered());
+
+    // preview 阻塞期间持续发布：其邮箱只保留最新一帧，旧帧的 Buffer 立即归还
+    constexpr uint32_t kFrames = 20;
+    for (uint32_t i = 1; i <= kFrames; ++i)
+    {
+        auto guard = pool.Acquire();
+        ASSERT_NE(guard, nullptr) << "frame " << i;
+        broker.PublishFrame(MakeFrame(i), guard);
+        guard.reset();
+        ASSERT_TRUE(WaitFor([&]() { return recorder->Received() == i + 1; }));
+        EXPECT_GE(pool.GetStats().available, 3u);
+    }
+
+    auto stats = broker.GetStats();
+    const auto* preview_stats = FindStats(stats, "preview");
+    const auto* recorder_stats = FindStats(stats, "recorder");
+    ASSERT_NE(preview_stats, nullptr);
+    ASSERT_NE(recorder_stats, nullptr);
+    EXPECT_EQ(preview_stats->policy, broker::DeliveryPolicy::kKeepLatest);
+    EXPECT_EQ(preview_stats->queue_capacity, 1u);
+    EXPECT_EQ(preview_stats->replaced, kFrames - 1);
+    EXPECT_EQ(preview_stats->dropped, 0u);
+    EXPECT_EQ(recorder_stats->dropped, 0u);
+    EXPECT_EQ(recorder_stats->replaced, 0u);
+    EXPECT_EQ(stats.replaced_tasks, kFrames - 1);
+
+    preview->SetBlocked(false);
+    EXPECT_TRUE(WaitFor([&]() { return preview->Received() == 2u; }));
+    EXPECT_EQ(preview->LastFrameId(), kFrames);
+    EXPECT_TRUE(WaitFor([&]() { return pool.GetStats().available == 4u; }));
+    broker.Stop();
+}
+
+TEST_P(FrameBrokerModeTest, DropOldestKeepsNewestFrames)
+{
+    broker::FrameBroker broker;
+    ASSERT_TRUE(broker.SetDispatchMode(GetParam()));
+    ASSERT_TRUE(broker.Start(1));
+
+    auto analytics = std::make_shared<CountingSubscriber>("analytics", 128,
+                                                          broker::DeliveryPolicy::kDropOldest, 4);
+    broker.Subscribe(analytics);
+
+    analytics->SetBlocked(true);
+    broker.PublishFrame(MakeFrame(0));
+    ASSERT_TRUE(analytics->WaitEntered());
+
+    constexpr uint32_t kFrames = 10;
+    for (uint32_t i = 1; i <= kFrames; ++i)
+    {
+        broker.PublishFrame(MakeFrame(i));
+    }
+
+    auto stats = broker.GetStats();
+    ASSERT_EQ(stats.subscribers.size(), 1u);
+    EXPECT_EQ(stats.subscribers[0].queue_capacity, 4u);
+    EXPECT_EQ(stats.subscribers[0].queue_depth, 4u);
+    EXPECT_EQ(stats.subscribers[0].dropped, kFrames - 4);
+    EXPECT_EQ(stats.subscribers[0].replaced, 0u);
+
+    analytics->SetBlocked(false);
+    EXPECT_TRUE(WaitFor([&]() { return analytics->Received() == 5u; }));
+    EXPECT_EQ(analytics->LastFrameId(), kFrames);
+    broker.Stop();
+}
+
+TEST_P(FrameBrokerModeTest, ExpiredFramesAreSkippedAtDequeue)
+{
+    core::BufferPool pool;
+    ASSERT_TRUE(pool.Initialize(6, 64));
+
+    broker::FrameBroker broker;
+    ASSERT_TRUE(broker.SetDispatchMode(GetParam()));
+    // 单 Worker：保证积压帧在 realtime 恢复前不会被其他 Worker 提前取走
+    ASSERT_TRUE(broker.Start(1));
+
+    constexpr uint64_t kMaxAgeNs = 100ULL * 1000 * 1000;
+    auto realtime = std::make_shared<CountingSubscriber>("realtime", 200);
+    realtime->SetMaxFrameAgeNs(kMaxAgeNs);
+    auto recorder = std::make_shared<CountingSubscriber>("recorder", 100);
+    broker.Subscribe(realtime);
+    broker.Subscribe(recorder);
+
+    realtime->SetBlocked(true);
+    broker.PublishFrame(MakeFrame(0));
+    ASSERT_TRUE(realtime->WaitEntered());
+
+    // realtime 阻塞期间积压的帧在其恢复前全部超龄
+    constexpr uint32_t kStaleFrames = 4;
+    for (uint32_t i = 1; i <= kStaleFrames; ++i)
+    {
+        auto guard = pool.Acquire();
+        ASSERT_NE(guard, nullptr);
+        broker.PublishFrame(MakeFrame(i), guard);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    const uint32_t fresh_id = kStaleFrames + 1;
+    broker.PublishFrame(MakeFrame(fresh_id));
+    realtime->SetBlocked(false);
+
+    EXPECT_TRUE(WaitFor([&]() { return realtime->Received() == 2u; }));
+    EXPECT_EQ(realtime->LastFrameId(), fresh_id);
+    EXPECT_TRUE(WaitFor([&]() { return recorder->Received() == fresh_id + 1; }));
+    EXPECT_TRUE(WaitFor([&]() { return pool.GetStats().available == 6u; }));
+
+    const auto stats = broker.GetStats();
+    const auto* realtime_stats = FindStats(stats, "realtime");
+    const auto* recorder_stats = FindStats(stats, "recorder");
+    ASSERT_NE(realtime_stats, nullptr);
+    ASSERT_NE(recorder_stats, nullptr);
+    EXPECT_EQ(realtime_stats->max_frame_age_ns, kMaxAgeNs);
+    EXPECT_EQ(realtime_stats->expired, kStaleFrames);
+    EXPECT_EQ(realtime_stats->dispatched, 2u);
+    EXPECT_EQ(recorder_stats->expired, 0u);
+    EXPECT_EQ(stats.expired_tasks, kStaleFrames);
+    broker.Stop();
+}
+
+TEST(FrameBrokerSharedTest, QueueDepthLimitIsolatesSlowSubscriber)
+{
+    broker::FrameBroker broker;
+    broker.SetMaxQueueSize(24);
+    ASSERT_TRUE(broker.Start(1));
+
+    auto slow = std::make_shared<CountingSubscriber>("slow", 200, broker::DeliveryPolicy::kQueue,
+                                                     2);
+    auto fast = std::make_shared<CountingSubscriber>("fast", 100);
+    broker.Subscribe(slow);
+    broker.Subscribe(fast);
+
+    slow->SetBlocked(true);
+    broker.PublishFrame(MakeFrame(0));
+    ASSERT_TRUE(slow->WaitEntered());
+
+    // 唯一的 Worker 阻塞在 slow 上：slow 最多排队 2 帧，共享队列不会被其占满
+    constexpr uint32_t kFrames = 16;
+    for (uint32_t i = 1; i < kFrames; ++i)
+    {
+        broker.PublishFrame(MakeFrame(i));
+    }
+
+    auto stats = broker.GetStats();
+    const auto* slow_stats = FindStats(stats, "slow");
+    const auto* fast_stats = FindStats(stats, "fast");
+    ASSERT_NE(slow_stats, nullptr);
+    ASSERT_NE(fast_stats, nullptr);
+    EXPECT_EQ(slow_stats->queue_capacity, 2u);
+    EXPECT_EQ(slow_stats->queue_depth, 2u);
+    EXPECT_EQ(slow_stats->dropped, kFrames - 3);
+    EXPECT_EQ(fast_stats->dropped, 0u);
+    EXPECT_EQ(fast_stats->queue_depth, kFrames);
+
+    slow->SetBlocked(false);
+    EXPECT_TRUE(WaitFor([&]() { return fast->Received() == kFrames; }));
+    EXPECT_TRUE(WaitFor([&]() { return slow->Received() == 3u; }));
+    broker.Stop();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DispatchModes, FrameBrokerModeTest,
+    ::testing::Values(broker::FrameBroker::DispatchMode::kSharedQueue,
+                      broker::FrameBroker::DispatchMode::kPerSubscriberRing));
+
+TEST(FrameBrokerRingTest, SlowSubscriberDropsIndependently)
+{
+    broker::FrameBroker broker;
+    ASSERT_TRUE(broker.SetDispatchMode(broker::FrameBroker::DispatchMode::kPerSubscriberRing));
+    broker.SetSubscriberQueueCapacity(4);
+    ASSERT_TRUE(broker.Start(2));
+
+    auto slow = std::make_shared<CountingSubscriber>("slow", 128);
+    auto fast = std::make_shared<CountingSubscriber>("fast", 64);
+    broker.Subscribe(slow);
+    broker.Subscribe(fast);
+
+    slow->SetBlocked(true);
+    constexpr uint32_t kFrames = 32;
+    for (uint32_t i = 0; i < kFrames; ++i)
+    {
+        broker.PublishFrame(MakeFrame(i));
+        // 给快订阅者留出消费时间，使其环形队列不会因突发而溢出
+        WaitFor([&]() { return fast->Received() == i + 1; }, 500);
+    }
+
+    EXPECT_EQ(fast->Received(), kFrames);
+
+    auto stats = broker.GetStats();
+    const auto* slow_stats = FindStats(stats, "slow");
+    const auto* fast_stats = FindStats(stats, "fast");
+    ASSERT_NE(slow_stats, nullptr);
+    ASSERT_NE(fast_stats, nullptr);
+    EXPECT_EQ(slow_stats->queue_capacity, 4u);
+    EXPECT_GT(slow_stats->dropped, 0u);
+    EXPECT_EQ(fast_stats->dropped, 0u);
+    EXPECT_EQ(slow_stats->enqueued + slow_stats->dropped, kFrames);
+    EXPECT_EQ(stats.dropped_tasks, slow_stats->dropped);
+
+    slow->SetBlocked(false);
+    EXPECT_TRUE(WaitFor([&]() { return slow->Received() == slow_stats->enqueued; }));
+    broker.Stop();
+}
+
+TEST(FrameBrokerRingTest, DispatchModeLockedWhileRunning)
+{
+    broker::FrameBroker broker;
+    EXPECT_EQ(broker.GetDispatchMode(), broker::FrameBroker::DispatchMode::kSharedQueue);
+    ASSERT_TRUE(broker.Start(1));
+    EXPECT_FALSE(broker.SetDispatchMode(broker::FrameBroker::DispatchMode::kPerSubscriberRing));
+    broker.Stop();
+    EXPECT_TRUE(broker.SetDispatchMode(broker::FrameBroker::DispatchMode::kPerSubscriberRing));
+}
+
+TEST(FrameBrokerRingTest, UnsubscribeDiscardsPendingFrames)
+{
+    core::BufferPool pool;
+    ASSERT_TRUE(pool.Initialize(1, 64));
+
+    broker::FrameBroker broker;
+    ASSERT_TRUE(broker.SetDispatchMode(broker::FrameBroker::DispatchMode::kPerSubscriberRing));
+    ASSERT_TRUE(broker.Start(1));
+
+    auto blocker = std::make_shared<CountingSubscriber>("blocker", 200);
+    auto victim = std::make_shared<CountingSubscriber>("victim", 100);
+    broker.Subscribe(blocker);
+    broker.Subscribe(victim);
+
+    blocker->SetBlocked(true);
+    {
+        auto guard = pool.Acquire();
+        ASSERT_NE(guard, nullptr);
+        broker.PublishFrame(MakeFrame(1), guard);
+    }
+
+    // 唯一的 Worker 阻塞在 blocker 上，victim 的帧仍在环形队列中
+    broker.Unsubscribe(victim);
+    blocker->SetBlocked(false);
+
+    EXPECT_TRUE(WaitFor([&]() { return pool.GetStats().available == 1u; }));
+    EXPECT_TRUE(WaitFor([&]() { return broker.GetStats().queue_size == 0u; }));
+    broker.Stop();
+}
+
+TEST(FrameBrokerWorkerGroupTest, GroupsRouteByPriority)
+{
+    broker::FrameBroker broker;
+
+    broker::FrameBroker::WorkerGroupConfig encode;
+    encode.name = "encode";
+    encode.worker_count = 1;
+    encode.min_subscriber_priority = 192;
+    broker::FrameBroker::WorkerGroupConfig preview;
+    preview.name = "preview";
+    preview.worker_count = 2;
+    preview.min_subscriber_priority = 0;
+
+    broker::FrameBroker::WorkerGroupConfig empty_group;
+    empty_group.worker_count = 0;
+    // 共享队列模式无法按组路由，线程组须配合 kPerSubscriberRing
+    EXPECT_FALSE(broker.SetWorkerGroups({encode, preview}));
+    ASSERT_TRUE(broker.SetDispatchMode(broker::FrameBroker::DispatchMode::kPerSubscriberRing));
+    EXPECT_FALSE(broker.SetWorkerGroups({encode, empty_group}));
+    ASSERT_TRUE(broker.SetWorkerGroups({encode, preview}));
+    EXPECT_FALSE(broker.SetDispatchMode(broker::FrameBroker::DispatchMode::kSharedQueue));
+    ASSERT_TRUE(broker.Start());
+    EXPECT_FALSE(broker.SetWorkerGroups({preview}));
+
+    auto encoder = std::make_shared<CountingSubscriber>("encoder", 220);
+    auto display = std::make_shared<CountingSubscriber>("display", 100);
+    broker.Subscribe(encoder);
+    broker.Subscribe(display);
+
+    // 阻塞编码订阅者：唯一的 encode Worker 被占用，preview 组不受影响
+    encoder->SetBlocked(true);
+    constexpr uint32_t kFrames = 8;
+    for (uint32_t i = 0; i < kFrames; ++i)
+    {
+        broker.PublishFrame(MakeFrame(i));
+    }
+    EXPECT_TRUE(WaitFor([&]() { return display->Received() == kFrames; }));
+    EXPECT_EQ(encoder->Received(), 0u);
+
+    encoder->SetBlocked(false);
+    EXPECT_TRUE(WaitFor([&]() { return encoder->Received() == kFrames; }));
+
+    const auto stats = broker.GetStats();
+    ASSERT_EQ(stats.workers.size(), 3u);
+    EXPECT_EQ(stats.workers[0].name, "encode_0");
+    EXPECT_EQ(stats.workers[0].group, "encode");
+    EXPECT_EQ(stats.workers[0].dispatched, kFrames);
+    EXPECT_EQ(stats.workers[1].group, "preview");
+    EXPECT_EQ(stats.workers[2].group, "preview");
+    EXPECT_EQ(stats.workers[1].dispatched + stats.workers[2].dispatched, kFrames);
+    broker.Stop();
+}
+
+TEST(FrameBrokerWorkerGroupTest, IdleWorkerStealsFromBusyWorker)
+{
+    broker::FrameBroker broker;
+    ASSERT_TRUE(broker.SetDispatchMode(broker::FrameBroker::DispatchMode::kPerSubscriberRing));
+    ASSERT_TRUE(broker.Start(2));
+
+    // 首选槽位按订阅顺序轮转：a -> worker 0, b -> worker 1, c -> worker 0
+    auto a = std::make_shared<CountingSubscriber>("a", 128);
+    auto b = std::make_shared<CountingSubscriber>("b", 128);
+    auto c = std::make_shared<CountingSubscriber>("c", 128);
+    broker.Subscribe(a);
+    broker.Subscribe(b);
+    broker.Subscribe(c);
+
+    a->SetBlocked(true);
+    broker.PublishFrame(MakeFrame(0));
+    ASSERT_TRUE(a->WaitEntered());
+
+    // worker 0 阻塞在 a 上，c 的帧只能由 worker 1 窃取执行
+    broker.PublishFrame(MakeFrame(1));
+    EXPECT_TRUE(WaitFor([&]() { return c->Received() == 2u && b->Received() == 2u; }));
+
+    auto stats = broker.GetStats();
+    ASSERT_EQ(stats.workers.size(), 2u);
+    EXPECT_GT(stats.workers[1].stolen, 0u);
+    const auto* c_stats = FindStats(stats, "c");
+    ASSERT_NE(c_stats, nullptr);
+    EXPECT_GT(c_stats->dispatch_contention, 0u);
+
+    a->SetBlocked(false);
+    EXPECT_TRUE(WaitFor([&]() { return a->Received() == 2u; }));
+    broker.Stop();
+}
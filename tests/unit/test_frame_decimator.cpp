@@ -0,0 +1,96 @@
+#include "camera_subsystem/core/frame_decimator.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace camera_subsystem::core;
+
+namespace
+{
+
+/// @brief 按 fps 生成带 ±jitter 抖动的时间戳序列，返回被接受的帧号
+std::vector<uint32_t> FeedFrames(FrameDecimator& decimator, uint32_t source_fps, uint32_t frames,
+                          int64_t jitter_ns = 0)
+{
+    std::vector<uint32_t> accepted;
+    const uint64_t interval = 1000000000ULL / source_fps;
+    for (uint32_t i = 0; i < frames; ++i)
+    {
+        const int64_t jitter = (i % 2 == 0) ? jitter_ns : -jitter_ns;
+        const uint64_t timestamp = 1000000000ULL + i * interval + jitter;
+        if (decimator.Accept(timestamp))
+        {
+            accepted.push_back(i);
+        }
+    }
+    return accepted;
+}
+
+} // namespace
+
+TEST(FrameDecimatorTest, PassThroughByDefault)
+{
+    FrameDecimator decimator;
+    EXPECT_TRUE(decimator.IsPassThrough());
+    EXPECT_EQ(FeedFrames(decimator, 30, 10).size(), 10u);
+    EXPECT_EQ(decimator.GetSkippedCount(), 0u);
+}
+
+TEST(FrameDecimatorTest, TargetFpsKeepsEveryFourthFrameDespiteJitter)
+{
+    // 60fps -> 15fps，时间戳有 ±2ms 抖动
+    FrameDecimator decimator(15, 0);
+    const auto accepted = FeedFrames(decimator, 60, 120, 2000000);
+    ASSERT_EQ(accepted.size(), 30u);
+    for (size_t i = 1; i < accepted.size(); ++i)
+    {
+        EXPECT_EQ(accepted[i] - accepted[i - 1], 4u);
+    }
+    EXPECT_EQ(decimator.GetSkippedCount(), 90u);
+}
+
+TEST(FrameDecimatorTest, NonIntegerRatioKeepsAverageRate)
+{
+    // 30fps -> 20fps：每 3 帧取 2 帧
+    FrameDecimator decimator(20, 0);
+    EXPECT_EQ(FeedFrames(decimator, 30, 90).size(), 60u);
+}
+
+TEST(FrameDecimatorTest, SlowerSourceIsNotDecimated)
+{
+    FrameDecimator decimator(30, 0);
+    EXPECT_EQ(FeedFrames(decimator, 15, 30).size(), 30u);
+}
+
+TEST(FrameDecimatorTest, FrameStrideAndFpsCombine)
+{
+    FrameDecimator stride_only(0, 3);
+    EXPECT_EQ(FeedFrames(stride_only, 30, 9), (std::vector<uint32_t>{0, 3, 6}));
+
+    // 先每 2 帧取 1（60 -> 30），再限到 15fps
+    FrameDecimator combined(15, 2);
+    EXPECT_EQ(FeedFrames(combined, 60, 16), (std::vector<uint32_t>{0, 4, 8, 12}));
+}
+
+TEST(FrameDecimatorTest, RealignsAfterTimestampGoesBackwards)
+{
+    FrameDecimator decimator(10, 0);
+    EXPECT_TRUE(decimator.Accept(5000000000ULL));
+    EXPECT_FALSE(decimator.Accept(5050000000ULL));
+    // 流重启后时间戳从更小的值开始
+    EXPECT_TRUE(decimator.Accept(1000000000ULL));
+    EXPECT_FALSE(decimator.Accept(1050000000ULL));
+    EXPECT_TRUE(decimator.Accept(1100000000ULL));
+}
+
+TEST(FrameDecimatorTest, ConfigureKeepsPhaseWhenUnchanged)
+{
+    FrameDecimator decimator(0, 2);
+    EXPECT_TRUE(decimator.Accept(0));
+    decimator.Configure(0, 2);
+    EXPECT_FALSE(decimator.Accept(1));
+    decimator.Configure(0, 3);
+    EXPECT_TRUE(decimator.Accept(2));
+}
@@ -0,0 +1,103 @@
+#include "camera_subsystem/core/latency_histogram.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace camera_subsystem::core;
+
+TEST(LatencyHistogramTest, BucketBoundsContainValue)
+{
+    const uint64_t samples[] = {0, 1, 3, 4, 5, 7, 8, 1000, 123456789, UINT64_MAX};
+    for (const uint64_t value : samples)
+    {
+        const size_t index = LatencyHistogram::BucketIndex(value);
+        ASSERT_LT(index, LatencyHistogram::kBucketCount);
+        EXPECT_GE(LatencyHistogram::BucketUpperBound(index), value);
+        if (index > 0)
+        {
+            EXPECT_LT(LatencyHistogram::BucketUpperBound(index - 1), value);
+        }
+    }
+}
+
+TEST(LatencyHistogramTest, EmptySnapshotIsZero)
+{
+    LatencyHistogram histogram;
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.count, 0u);
+    EXPECT_EQ(snapshot.min_ns, 0u);
+    EXPECT_EQ(snapshot.max_ns, 0u);
+    EXPECT_EQ(snapshot.p99_ns, 0u);
+    EXPECT_EQ(snapshot.MeanNs(), 0u);
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinBucketError)
+{
+    LatencyHistogram histogram;
+    for (uint64_t i = 1; i <= 1000; ++i)
+    {
+        histogram.Record(i * 1000);
+    }
+
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.count, 1000u);
+    EXPECT_EQ(snapshot.min_ns, 1000u);
+    EXPECT_EQ(snapshot.max_ns, 1000000u);
+    EXPECT_EQ(snapshot.MeanNs(), 500500u);
+
+    // 分位数取桶上界，误差不超过 25%
+    EXPECT_GE(snapshot.p50_ns, 500000u);
+    EXPECT_LE(snapshot.p50_ns, 625000u);
+    EXPECT_GE(snapshot.p90_ns, 900000u);
+    EXPECT_LE(snapshot.p90_ns, 1000000u);
+    EXPECT_GE(snapshot.p99_ns, 990000u);
+    EXPECT_LE(snapshot.p99_ns, snapshot.max_ns);
+}
+
+TEST(LatencyHistogramTest, TakeSnapshotStartsNewWindow)
+{
+    LatencyHistogram histogram;
+    histogram.Record(100);
+    histogram.Record(200);
+
+    const auto first = histogram.TakeSnapshot();
+    EXPECT_EQ(first.count, 2u);
+    EXPECT_EQ(first.sum_ns, 300u);
+
+    EXPECT_EQ(histogram.GetSnapshot().count, 0u);
+
+    histogram.Record(50);
+    const auto second = histogram.TakeSnapshot();
+    EXPECT_EQ(second.count, 1u);
+    EXPECT_EQ(second.min_ns, 50u);
+    EXPECT_EQ(second.max_ns, 50u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordKeepsCount)
+{
+    LatencyHistogram histogram;
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 10000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&histogram, t]() {
+            for (int i = 0; i < kPerThread; ++i)
+            {
+                histogram.Record(static_cast<uint64_t>(t * kPerThread + i + 1));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.count, static_cast<uint64_t>(kThreads * kPerThread));
+    EXPECT_EQ(snapshot.min_ns, 1u);
+    EXPECT_EQ(snapshot.max_ns, static_cast<uint64_t>(kThreads * kPerThread));
+}